@@ -0,0 +1,83 @@
+/**
+ * @brief
+ * This file is part of the MeetiX Operating System.
+ * Copyright (c) 2017-2022, Marco Cicognani (marco.cicognani@meetixos.org)
+ *
+ * @developers
+ * Marco Cicognani (marco.cicognani@meetixos.org)
+ *
+ * @license
+ * GNU General Public License version 3
+ */
+
+#pragma once
+
+#include <CCLang/Forward.hh>
+
+#include <CCLang/Alloc/New.hh>
+#include <CCLang/Core/ErrorOr.hh>
+#include <CCLang/Lang/Cxx.hh>
+#include <CCLang/Lang/IntTypes.hh>
+#include <CCLang/Lang/Try.hh>
+
+/**
+ * @brief Memory source of the CCLang.Alloc containers.
+ * The returned memory must be zero-filled like the one of the global heap, and the containers always give back
+ * the same size they have requested. The allocator must outlive the containers (and the clones of the Strings) using it
+ */
+class Allocator {
+public:
+    /**
+     * @brief Allocates at least size bytes of zero-filled memory
+     */
+    virtual auto try_alloc(usize size) -> ErrorOr<void*> = 0;
+
+    /**
+     * @brief Gives back the memory obtained with try_alloc() with the same size
+     */
+    virtual auto dealloc(void* ptr, usize size) -> void = 0;
+
+    /**
+     * @brief Resizes the memory obtained with try_alloc(), keeping its content and zero-filling the grown part.
+     * The allocators able to resize in place override it, the others move the content into a new block
+     */
+    virtual auto try_realloc(void* ptr, usize size, usize new_size) -> ErrorOr<void*> {
+        auto const new_ptr = try$(try_alloc(new_size));
+        Cxx::memcpy(new_ptr, ptr, usize::min(size, new_size));
+        dealloc(ptr, size);
+        return new_ptr;
+    }
+
+protected:
+    virtual ~Allocator() = default;
+};
+
+namespace Details {
+
+/* The containers keep a nullable Allocator*, nullptr selects the global heap without any indirect call */
+
+inline auto allocator_alloc(Allocator* allocator, usize size) -> ErrorOr<void*> {
+    if ( allocator == nullptr ) {
+        return internal_heap_alloc(size);
+    } else {
+        return allocator->try_alloc(size);
+    }
+}
+
+inline auto allocator_realloc(Allocator* allocator, void* ptr, usize size, usize new_size) -> ErrorOr<void*> {
+    if ( allocator == nullptr ) {
+        return internal_heap_realloc(ptr, size, new_size);
+    } else {
+        return allocator->try_realloc(ptr, size, new_size);
+    }
+}
+
+inline auto allocator_dealloc(Allocator* allocator, void* ptr, usize size) -> void {
+    if ( allocator == nullptr ) {
+        internal_heap_dealloc(ptr, size);
+    } else {
+        allocator->dealloc(ptr, size);
+    }
+}
+
+} /* namespace Details */
@@ -0,0 +1,134 @@
+/**
+ * @brief
+ * This file is part of the MeetiX Operating System.
+ * Copyright (c) 2017-2022, Marco Cicognani (marco.cicognani@meetixos.org)
+ *
+ * @developers
+ * Marco Cicognani (marco.cicognani@meetixos.org)
+ *
+ * @license
+ * GNU General Public License version 3
+ */
+
+#include <CCLang/Alloc/ArenaAllocator.hh>
+
+#include <CCLang/Alloc/New.hh>
+#include <CCLang/Core/Assertions.hh>
+#include <CCLang/Lang/Cxx.hh>
+#include <CCLang/Lang/Try.hh>
+
+namespace Details {
+
+static auto arena_align_up(usize size) -> usize {
+    auto const aligned_size = (size.unwrap() + ArenaAllocator::C_ALIGNMENT - 1) & ~(ArenaAllocator::C_ALIGNMENT - 1);
+    return aligned_size == 0 ? ArenaAllocator::C_ALIGNMENT : aligned_size;
+}
+
+} /* namespace Details */
+
+auto ArenaAllocator::empty() -> ArenaAllocator {
+    return ArenaAllocator{ C_DEFAULT_CHUNK_SIZE };
+}
+
+auto ArenaAllocator::with_chunk_size(usize chunk_size) -> ArenaAllocator {
+    verify_greater$(chunk_size, 0);
+    return ArenaAllocator{ Details::arena_align_up(chunk_size) };
+}
+
+ArenaAllocator::~ArenaAllocator() {
+    while ( m_current_chunk != nullptr ) {
+        release_chunk(Cxx::exchange(m_current_chunk, m_current_chunk->m_prev_chunk));
+    }
+}
+
+auto ArenaAllocator::try_alloc(usize size) -> ErrorOr<void*> {
+    size = Details::arena_align_up(size);
+    if ( m_current_chunk == nullptr || m_chunk_offset + size > m_current_chunk->m_data_size ) {
+        try$(try_push_chunk(size));
+    }
+
+    /* the chunks are clean when obtained and cleaned again when given back, so there is nothing to fill */
+    auto const ptr = chunk_data(m_current_chunk) + m_chunk_offset.unwrap();
+    m_chunk_offset += size;
+    ++m_allocations_count;
+    return ptr;
+}
+
+auto ArenaAllocator::try_realloc(void* ptr, usize size, usize new_size) -> ErrorOr<void*> {
+    size     = Details::arena_align_up(size);
+    new_size = Details::arena_align_up(new_size);
+    if ( !is_last_allocation(ptr, size) || m_chunk_offset - size + new_size > m_current_chunk->m_data_size ) {
+        return Allocator::try_realloc(ptr, size, new_size);
+    }
+
+    /* the space after the last allocation is clean, only the released part needs to be cleaned */
+    if ( new_size < size ) {
+        Cxx::memset(static_cast<u8::NativeInt*>(ptr) + new_size.unwrap(), 0, size - new_size);
+    }
+    m_chunk_offset = m_chunk_offset - size + new_size;
+    return ptr;
+}
+
+auto ArenaAllocator::dealloc(void* ptr, usize size) -> void {
+    size = Details::arena_align_up(size);
+    if ( is_last_allocation(ptr, size) ) {
+        Cxx::memset(ptr, 0, size);
+        m_chunk_offset -= size;
+    }
+}
+
+auto ArenaAllocator::reset() -> void {
+    if ( m_current_chunk == nullptr ) {
+        return;
+    }
+
+    /* keep only the last chunk, which is also the biggest when an allocation exceeded the chunk size */
+    while ( m_current_chunk->m_prev_chunk != nullptr ) {
+        release_chunk(Cxx::exchange(m_current_chunk->m_prev_chunk, m_current_chunk->m_prev_chunk->m_prev_chunk));
+    }
+
+    Cxx::memset(chunk_data(m_current_chunk), 0, m_chunk_offset);
+    m_chunk_offset = 0;
+}
+
+auto ArenaAllocator::allocations_count() const -> usize {
+    return m_allocations_count;
+}
+
+auto ArenaAllocator::chunk_allocations_count() const -> usize {
+    return m_chunk_allocations_count;
+}
+
+auto ArenaAllocator::chunk_size() const -> usize {
+    return m_chunk_size;
+}
+
+ArenaAllocator::ArenaAllocator(usize chunk_size)
+    : m_chunk_size(chunk_size) {
+}
+
+auto ArenaAllocator::try_push_chunk(usize min_data_size) -> ErrorOr<void> {
+    auto const data_size = usize::max(m_chunk_size, min_data_size);
+    auto const chunk_ptr = try$(Details::internal_heap_alloc(data_size + C_CHUNK_HEADER_SIZE));
+
+    /* the remaining space of the previous chunk is left unused until the reset */
+    m_current_chunk = new (chunk_ptr) Chunk{ m_current_chunk, data_size };
+    m_chunk_offset  = 0;
+    ++m_chunk_allocations_count;
+    return {};
+}
+
+auto ArenaAllocator::is_last_allocation(void* ptr, usize aligned_size) const -> bool {
+    if ( ptr == nullptr || m_current_chunk == nullptr ) {
+        return false;
+    }
+    return static_cast<u8::NativeInt*>(ptr) + aligned_size.unwrap() == chunk_data(m_current_chunk) + m_chunk_offset.unwrap();
+}
+
+auto ArenaAllocator::chunk_data(Chunk* chunk) -> u8::NativeInt* {
+    return reinterpret_cast<u8::NativeInt*>(chunk) + C_CHUNK_HEADER_SIZE;
+}
+
+auto ArenaAllocator::release_chunk(Chunk* chunk) -> void {
+    Details::internal_heap_dealloc(chunk, chunk->m_data_size + C_CHUNK_HEADER_SIZE);
+}
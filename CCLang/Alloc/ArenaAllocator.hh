@@ -0,0 +1,92 @@
+/**
+ * @brief
+ * This file is part of the MeetiX Operating System.
+ * Copyright (c) 2017-2022, Marco Cicognani (marco.cicognani@meetixos.org)
+ *
+ * @developers
+ * Marco Cicognani (marco.cicognani@meetixos.org)
+ *
+ * @license
+ * GNU General Public License version 3
+ */
+
+#pragma once
+
+#include <CCLang/Forward.hh>
+
+#include <CCLang/Alloc/Allocator.hh>
+#include <CCLang/Core/ErrorOr.hh>
+#include <CCLang/Lang/DenyCopy.hh>
+#include <CCLang/Lang/DenyMove.hh>
+#include <CCLang/Lang/IntTypes.hh>
+
+/**
+ * @brief Bump allocator for request-scoped work.
+ * Allocations are carved sequentially from chunks obtained from the global heap and are released all together with
+ * reset(), which keeps the last chunk for the next round
+ */
+class ArenaAllocator final : public Allocator,
+                             public DenyCopy,
+                             public DenyMove {
+public:
+    static constexpr usize::NativeInt C_DEFAULT_CHUNK_SIZE = 16 * 1024;
+    static constexpr usize::NativeInt C_ALIGNMENT          = 16;
+
+public:
+    /**
+     * @brief Non-Error safe factory functions
+     */
+    static auto empty() -> ArenaAllocator;
+    static auto with_chunk_size(usize chunk_size) -> ArenaAllocator;
+
+    ~ArenaAllocator() override;
+
+    /**
+     * @brief Allocator implementation.
+     * try_realloc() resizes in place and dealloc() gives back immediately only the last allocation (which makes
+     * cheap the growth of the last Vector), the others are released by reset()
+     */
+    auto try_alloc(usize size) -> ErrorOr<void*> override;
+    auto try_realloc(void* ptr, usize size, usize new_size) -> ErrorOr<void*> override;
+    auto dealloc(void* ptr, usize size) -> void override;
+
+    /**
+     * @brief Releases all the allocations at once
+     */
+    auto reset() -> void;
+
+    /**
+     * @brief Getters
+     */
+    [[nodiscard]]
+    auto allocations_count() const -> usize;
+    [[nodiscard]]
+    auto chunk_allocations_count() const -> usize;
+    [[nodiscard]]
+    auto chunk_size() const -> usize;
+
+private:
+    struct Chunk {
+        Chunk* m_prev_chunk;
+        usize  m_data_size;
+    };
+
+    static constexpr usize::NativeInt C_CHUNK_HEADER_SIZE = (sizeof(Chunk) + C_ALIGNMENT - 1) & ~(C_ALIGNMENT - 1);
+
+private:
+    explicit ArenaAllocator(usize chunk_size);
+
+    auto try_push_chunk(usize min_data_size) -> ErrorOr<void>;
+
+    auto is_last_allocation(void* ptr, usize aligned_size) const -> bool;
+
+    static auto chunk_data(Chunk* chunk) -> u8::NativeInt*;
+    static auto release_chunk(Chunk* chunk) -> void;
+
+private:
+    Chunk* m_current_chunk           = nullptr;
+    usize  m_chunk_offset            = 0;
+    usize  m_chunk_size              = C_DEFAULT_CHUNK_SIZE;
+    usize  m_allocations_count       = 0;
+    usize  m_chunk_allocations_count = 0;
+};
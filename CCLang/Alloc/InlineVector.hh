@@ -0,0 +1,329 @@
+/**
+ * @brief
+ * This file is part of the MeetiX Operating System.
+ * Copyright (c) 2017-2022, Marco Cicognani (marco.cicognani@meetixos.org)
+ *
+ * @developers
+ * Marco Cicognani (marco.cicognani@meetixos.org)
+ *
+ * @license
+ * GNU General Public License version 3
+ */
+
+#pragma once
+
+#include <CCLang/Forward.hh>
+
+#include <CCLang/Alloc/Allocator.hh>
+#include <CCLang/Alloc/New.hh>
+#include <CCLang/Core/Assertions.hh>
+#include <CCLang/Core/ErrorOr.hh>
+#include <CCLang/Core/Meta.hh>
+#include <CCLang/Core/TypeTraits.hh>
+#include <CCLang/Lang/Cxx.hh>
+#include <CCLang/Lang/DenyCopy.hh>
+#include <CCLang/Lang/IntTypes.hh>
+#include <CCLang/Lang/Must.hh>
+#include <CCLang/Lang/Range.hh>
+#include <CCLang/Lang/Try.hh>
+
+/**
+ * @brief Vector which stores the first InlineCapacity values into itself and goes to the allocator only when
+ * they are exceeded, for the short sequences built and dropped on the hot paths
+ */
+template<typename T, __SIZE_TYPE__ InlineCapacity>
+class InlineVector final : public DenyCopy {
+    static_assert(InlineCapacity > 0, "InlineVector<T, 0> has no reason to exist, use Vector<T>");
+
+public:
+    using Iterator      = T*;
+    using ConstIterator = T const*;
+
+public:
+    /**
+     * @brief Non-Error safe factory functions
+     */
+    static auto empty() -> InlineVector<T, InlineCapacity> {
+        return InlineVector<T, InlineCapacity>();
+    }
+    static auto with_allocator(Allocator& allocator) -> InlineVector<T, InlineCapacity> {
+        auto inline_vector        = empty();
+        inline_vector.m_allocator = &allocator;
+        return inline_vector;
+    }
+    static auto from_list(Cxx::InitializerList<T> initializer_list) -> InlineVector<T, InlineCapacity> {
+        return must$(try_from_list(initializer_list));
+    }
+
+    /**
+     * @brief Error safe Factory functions
+     */
+    static auto try_from_list(Cxx::InitializerList<T> initializer_list) -> ErrorOr<InlineVector<T, InlineCapacity>> {
+        auto inline_vector = empty();
+        for ( auto const& e : initializer_list ) { /* even with auto initializer_list exposes only 'T const&' */
+            try$(inline_vector.try_append(Cxx::move(const_cast<T&>(e))));
+        }
+
+        return inline_vector;
+    }
+
+    /**
+     * @brief Move constructor and move assignment.
+     * The inline values are moved one by one, the allocated ones are taken in O(1)
+     */
+    InlineVector(InlineVector<T, InlineCapacity>&& rhs)
+        : m_allocator(rhs.m_allocator) {
+        if ( rhs.is_inline() ) {
+            for ( auto const i : usize::range(0, rhs.m_values_count) ) {
+                new (inline_slot(i)) T(Cxx::move(*rhs.inline_slot(i)));
+            }
+            m_values_count = rhs.m_values_count;
+            rhs.clear();
+        } else {
+            m_heap_storage  = Cxx::exchange(rhs.m_heap_storage, nullptr);
+            m_data_capacity = Cxx::exchange(rhs.m_data_capacity, InlineCapacity);
+            m_values_count  = Cxx::exchange(rhs.m_values_count, 0);
+        }
+    }
+    auto operator=(InlineVector<T, InlineCapacity>&& rhs) -> InlineVector<T, InlineCapacity>& {
+        if ( this != &rhs ) {
+            clear();
+            new (this) InlineVector<T, InlineCapacity>(Cxx::move(rhs));
+        }
+        return *this;
+    }
+
+    ~InlineVector() {
+        clear();
+    }
+
+    /**
+     * @brief Destroys all the stored values, clear() goes back to the inline storage
+     */
+    auto clear() -> void {
+        clear_keep_capacity();
+
+        if ( !is_inline() ) {
+            Details::allocator_dealloc(m_allocator, m_heap_storage, m_data_capacity * sizeof(T));
+            m_heap_storage  = nullptr;
+            m_data_capacity = InlineCapacity;
+        }
+    }
+    auto clear_keep_capacity() -> void {
+        if constexpr ( !TypeTraits<T>::is_trivial() ) {
+            for ( auto const i : usize::range(0, m_values_count) ) {
+                data()[i.unwrap()].~T();
+            }
+        }
+        m_values_count = 0;
+    }
+
+    /**
+     * @brief Pushes the given <value> to the end of the vector
+     */
+    auto append(T value) -> void {
+        must$(try_append(Cxx::move(value)));
+    }
+    auto try_append(T value) -> ErrorOr<void> {
+        try$(try_ensure_capacity(m_values_count + 1));
+        new (data() + m_values_count.unwrap()) T(Cxx::move(value));
+        ++m_values_count;
+        return {};
+    }
+
+    /**
+     * @brief Pushes a new value to the end of the vector constructing it with the given arguments
+     */
+    template<typename... Args>
+    auto emplace_last(Args&&... args) -> void {
+        must$(try_emplace_last(Cxx::forward<Args>(args)...));
+    }
+    template<typename... Args>
+    auto try_emplace_last(Args&&... args) -> ErrorOr<void> {
+        try$(try_ensure_capacity(m_values_count + 1));
+        new (data() + m_values_count.unwrap()) T{ Cxx::forward<Args>(args)... };
+        ++m_values_count;
+        return {};
+    }
+
+    /**
+     * @brief Removes and returns the last element
+     */
+    auto take_last() -> T {
+        verify_greater$(m_values_count, 0);
+
+        auto& last_value = at(m_values_count - 1);
+        auto  value      = Cxx::move(last_value);
+        last_value.~T();
+        --m_values_count;
+        return value;
+    }
+
+    /**
+     * @brief Removes the element at the given index
+     */
+    auto erase_at(usize index) -> ErrorOr<void> {
+        if ( index >= m_values_count ) {
+            return Error::from_code(ErrorCode::Invalid);
+        }
+
+        /* shift all the values one position back */
+        auto const data_ptr = data();
+        if constexpr ( TypeTraits<T>::is_trivial() ) {
+            Cxx::memmove(data_ptr + index.unwrap(), data_ptr + index.unwrap() + 1, (m_values_count - index - 1) * sizeof(T));
+        } else {
+            data_ptr[index.unwrap()].~T();
+            for ( auto const i : usize::range(index + 1, m_values_count) ) {
+                new (data_ptr + i.unwrap() - 1) T(Cxx::move(data_ptr[i.unwrap()]));
+                data_ptr[i.unwrap()].~T();
+            }
+        }
+        --m_values_count;
+        return {};
+    }
+
+    /**
+     * @brief Allocates new capacity for this vector for at least the given capacity
+     */
+    auto ensure_capacity(usize capacity) -> void {
+        must$(try_ensure_capacity(capacity));
+    }
+    auto try_ensure_capacity(usize capacity) -> ErrorOr<void> {
+        if ( m_data_capacity >= capacity ) {
+            return {};
+        }
+
+        /* same growth policy of Vector<T> */
+        auto const new_capacity = usize::max(capacity, m_data_capacity + m_data_capacity / 2);
+        if constexpr ( TypeTraits<T>::is_trivial() ) {
+            if ( !is_inline() ) {
+                auto const new_data_ptr = try$(Details::allocator_realloc(m_allocator, m_heap_storage, m_data_capacity * sizeof(T), new_capacity * sizeof(T)));
+
+                m_heap_storage  = static_cast<T*>(new_data_ptr);
+                m_data_capacity = new_capacity;
+                return {};
+            }
+        }
+
+        /* allocate new memory and move the content into it */
+        auto const new_data_ptr = static_cast<T*>(try$(Details::allocator_alloc(m_allocator, new_capacity * sizeof(T))));
+        auto const old_data_ptr = data();
+        if constexpr ( TypeTraits<T>::is_trivial() ) {
+            Cxx::memcpy(new_data_ptr, old_data_ptr, m_values_count * sizeof(T));
+        } else {
+            for ( auto const i : usize::range(0, m_values_count) ) {
+                new (new_data_ptr + i.unwrap()) T(Cxx::move(old_data_ptr[i.unwrap()]));
+                old_data_ptr[i.unwrap()].~T();
+            }
+        }
+
+        if ( !is_inline() ) {
+            Details::allocator_dealloc(m_allocator, m_heap_storage, m_data_capacity * sizeof(T));
+        }
+
+        m_heap_storage  = new_data_ptr;
+        m_data_capacity = new_capacity;
+        return {};
+    }
+
+    /**
+     * @brief for-each support
+     */
+    auto begin() -> Iterator {
+        return data();
+    }
+    auto end() -> Iterator {
+        return data() + m_values_count.unwrap();
+    }
+
+    auto begin() const -> ConstIterator {
+        return data();
+    }
+    auto end() const -> ConstIterator {
+        return data() + m_values_count.unwrap();
+    }
+
+    /**
+     * @brief Returns a reference to the first element
+     */
+    auto first() -> T& {
+        return at(0);
+    }
+    auto first() const -> T const& {
+        return at(0);
+    }
+
+    /**
+     * @brief Returns a reference to the last element
+     */
+    auto last() -> T& {
+        return at(m_values_count - 1);
+    }
+    auto last() const -> T const& {
+        return at(m_values_count - 1);
+    }
+
+    /**
+     * @brief Vector data access
+     */
+    auto at(usize index) -> T& {
+        verify_less$(index, m_values_count);
+        return data()[index.unwrap()];
+    }
+    auto at(usize index) const -> T const& {
+        verify_less$(index, m_values_count);
+        return data()[index.unwrap()];
+    }
+
+    auto operator[](usize index) -> T& {
+        return at(index);
+    }
+    auto operator[](usize index) const -> T const& {
+        return at(index);
+    }
+
+    auto as_slice() const -> Slice<T> {
+        return Slice<T>::from_raw_parts(const_cast<T*>(data()), m_values_count);
+    }
+
+    /**
+     * @brief Getters
+     */
+    auto count() const -> usize {
+        return m_values_count;
+    }
+    auto capacity() const -> usize {
+        return m_data_capacity;
+    }
+    auto is_empty() const -> bool {
+        return m_values_count == 0;
+    }
+    auto is_inline() const -> bool {
+        return m_heap_storage == nullptr;
+    }
+
+private:
+    explicit constexpr InlineVector() = default;
+
+    auto data() -> T* {
+        if ( is_inline() ) {
+            return inline_slot(0);
+        } else {
+            return m_heap_storage;
+        }
+    }
+    auto data() const -> T const* {
+        return const_cast<InlineVector<T, InlineCapacity>*>(this)->data();
+    }
+
+    auto inline_slot(usize index) -> T* {
+        return Cxx::bit_cast<T*>(&m_inline_storage) + index.unwrap();
+    }
+
+private:
+    alignas(T) u8::NativeInt m_inline_storage[sizeof(T) * InlineCapacity];
+    T*         m_heap_storage  = nullptr;
+    usize      m_data_capacity = InlineCapacity;
+    usize      m_values_count  = 0;
+    Allocator* m_allocator     = nullptr;
+};
@@ -0,0 +1,172 @@
+/**
+ * @brief
+ * This file is part of the MeetiX Operating System.
+ * Copyright (c) 2017-2022, Marco Cicognani (marco.cicognani@meetixos.org)
+ *
+ * @developers
+ * Marco Cicognani (marco.cicognani@meetixos.org)
+ *
+ * @license
+ * GNU General Public License version 3
+ */
+
+#pragma once
+
+#include <CCLang/Forward.hh>
+
+#include <CCLang/Alloc/Allocator.hh>
+#include <CCLang/Alloc/New.hh>
+#include <CCLang/Core/Assertions.hh>
+#include <CCLang/Core/ErrorOr.hh>
+#include <CCLang/Core/TypeTraits.hh>
+#include <CCLang/Lang/Cxx.hh>
+#include <CCLang/Lang/DenyCopy.hh>
+#include <CCLang/Lang/IntTypes.hh>
+#include <CCLang/Lang/Must.hh>
+#include <CCLang/Lang/Range.hh>
+#include <CCLang/Lang/Slice.hh>
+#include <CCLang/Lang/Try.hh>
+
+/**
+ * @brief Fixed grid of lines of the same length kept as a circular buffer.
+ * The visible lines are followed by the history ones, scrolling up moves only the head of the ring and clears the new
+ * last line, so the lines which go out from the top stay readable as history until they are overwritten
+ */
+template<typename T>
+class LineRing final : public DenyCopy {
+public:
+    /**
+     * @brief Non-Error safe factory functions
+     */
+    static auto empty() -> LineRing<T> {
+        return LineRing<T>();
+    }
+    static auto with_size(usize line_len, usize visible_lines, usize history_lines, T const& blank) -> LineRing<T> {
+        return must$(try_with_size(line_len, visible_lines, history_lines, blank));
+    }
+
+    /**
+     * @brief Error safe factory functions
+     */
+    static auto try_with_size(usize line_len, usize visible_lines, usize history_lines, T const& blank) -> ErrorOr<LineRing<T>> {
+        if ( line_len == 0 || visible_lines == 0 ) {
+            return Error::from_code(ErrorCode::Invalid);
+        }
+
+        auto       line_ring   = empty();
+        auto const cells_count = line_len * (visible_lines + history_lines);
+
+        line_ring.m_data_storage = static_cast<T*>(try$(Details::allocator_alloc(nullptr, cells_count * sizeof(T))));
+        for ( auto const i : usize::range(0, cells_count) ) {
+            new (line_ring.m_data_storage + i.unwrap()) T(blank);
+        }
+
+        line_ring.m_line_len      = line_len;
+        line_ring.m_visible_lines = visible_lines;
+        line_ring.m_lines_count   = visible_lines + history_lines;
+        return line_ring;
+    }
+
+    /**
+     * @brief Move constructor and move assignment
+     */
+    LineRing(LineRing<T>&& rhs)
+        : m_data_storage(Cxx::exchange(rhs.m_data_storage, nullptr))
+        , m_line_len(Cxx::exchange(rhs.m_line_len, 0))
+        , m_visible_lines(Cxx::exchange(rhs.m_visible_lines, 0))
+        , m_lines_count(Cxx::exchange(rhs.m_lines_count, 0))
+        , m_top_line(Cxx::exchange(rhs.m_top_line, 0))
+        , m_history_count(Cxx::exchange(rhs.m_history_count, 0)) {
+    }
+    auto operator=(LineRing<T>&& rhs) -> LineRing<T>& {
+        if ( this != &rhs ) {
+            this->~LineRing<T>();
+            new (this) LineRing<T>(Cxx::move(rhs));
+        }
+        return *this;
+    }
+
+    ~LineRing() {
+        auto const cells_count = m_line_len * m_lines_count;
+        if constexpr ( !TypeTraits<T>::is_trivial() ) {
+            for ( auto const i : usize::range(0, cells_count) ) {
+                m_data_storage[i.unwrap()].~T();
+            }
+        }
+        if ( m_data_storage != nullptr ) {
+            Details::allocator_dealloc(nullptr, m_data_storage, cells_count * sizeof(T));
+        }
+    }
+
+    /**
+     * @brief Returns the visible line at the given row, the lines scrolled back by <view_offset> when not zero
+     */
+    auto line(usize row, usize view_offset = 0) -> Slice<T> {
+        verify_less$(row, m_visible_lines);
+        verify_less_equal$(view_offset, m_history_count);
+
+        return Slice<T>::from_raw_parts(line_ptr(m_top_line + m_lines_count - view_offset + row), m_line_len);
+    }
+
+    /**
+     * @brief Moves the visible lines one line up in O(1), the top one goes into the history.
+     * The new last line is filled with <blank>
+     */
+    auto scroll_up(T const& blank) -> void {
+        m_top_line = (m_top_line + 1) % m_lines_count;
+        if ( m_history_count < m_lines_count - m_visible_lines ) {
+            ++m_history_count;
+        }
+
+        auto const last_line_ptr = line_ptr(m_top_line + m_visible_lines - 1);
+        for ( auto x = usize::NativeInt{ 0 }; x < m_line_len.unwrap(); ++x ) {
+            last_line_ptr[x] = blank;
+        }
+    }
+
+    /**
+     * @brief Fills all the lines with <blank> and forgets the history
+     */
+    auto clear(T const& blank) -> void {
+        auto const cells_count = (m_line_len * m_lines_count).unwrap();
+        for ( auto i = usize::NativeInt{ 0 }; i < cells_count; ++i ) {
+            m_data_storage[i] = blank;
+        }
+        m_top_line      = 0;
+        m_history_count = 0;
+    }
+
+    /**
+     * @brief Getters
+     */
+    auto line_len() const -> usize {
+        return m_line_len;
+    }
+    auto visible_lines() const -> usize {
+        return m_visible_lines;
+    }
+    auto history_count() const -> usize {
+        return m_history_count;
+    }
+    auto history_capacity() const -> usize {
+        return m_lines_count - m_visible_lines;
+    }
+    auto is_empty() const -> bool {
+        return m_data_storage == nullptr;
+    }
+
+private:
+    explicit constexpr LineRing() = default;
+
+    auto line_ptr(usize ring_line) const -> T* {
+        return m_data_storage + (ring_line.unwrap() % m_lines_count.unwrap()) * m_line_len.unwrap();
+    }
+
+private:
+    T*    m_data_storage  = nullptr;
+    usize m_line_len      = 0;
+    usize m_visible_lines = 0;
+    usize m_lines_count   = 0;
+    usize m_top_line      = 0;
+    usize m_history_count = 0;
+};
@@ -14,6 +14,7 @@
 
 #include <CCLang/Forward.hh>
 
+#include <CCLang/Alloc/Allocator.hh>
 #include <CCLang/Core/Assertions.hh>
 #include <CCLang/Core/ErrorOr.hh>
 #include <CCLang/Lang/Cxx.hh>
@@ -125,11 +126,6 @@ private:
         , m_current_node(current_node) {
     }
 
-    void delete_node() {
-        delete m_current_node;
-        m_current_node = nullptr;
-    }
-
 private:
     using TNode = typename TList::Node;
 
@@ -169,6 +165,11 @@ public:
     static auto empty() -> List<T> {
         return List<T>();
     }
+    static auto with_allocator(Allocator& allocator) -> List<T> {
+        auto list        = empty();
+        list.m_allocator = &allocator;
+        return list;
+    }
     static auto from_other(List<T> const& rhs) -> List<T> {
         return must$(try_from_other(rhs));
     }
@@ -208,7 +209,8 @@ public:
     List(List<T>&& rhs)
         : m_head_node(Cxx::exchange(rhs.m_head_node, nullptr))
         , m_tail_node(Cxx::exchange(rhs.m_tail_node, nullptr))
-        , m_values_count(Cxx::exchange(rhs.m_values_count, 0)) {
+        , m_values_count(Cxx::exchange(rhs.m_values_count, 0))
+        , m_allocator(Cxx::exchange(rhs.m_allocator, nullptr)) {
     }
     auto operator=(List<T>&& rhs) -> List<T>& {
         List<T> list = Cxx::move(rhs);
@@ -221,7 +223,7 @@ public:
     }
 
     /**
-     * @brief Deep cloning
+     * @brief Deep cloning, the clone always allocates from the global heap
      */
     auto clone() const -> List<T> {
         return must$(try_clone());
@@ -236,7 +238,7 @@ public:
     auto clear() {
         for ( auto node = m_head_node; node != nullptr; ) {
             auto const next_node = node->m_next_node;
-            delete node;
+            delete_node(node);
             node = next_node;
         }
         m_head_node    = nullptr;
@@ -251,6 +253,7 @@ public:
         Cxx::swap(m_head_node, rhs.m_head_node);
         Cxx::swap(m_tail_node, rhs.m_tail_node);
         Cxx::swap(m_values_count, rhs.m_values_count);
+        Cxx::swap(m_allocator, rhs.m_allocator);
     }
 
     /**
@@ -260,10 +263,7 @@ public:
         must$(try_append(Cxx::move(value)));
     }
     auto try_append(T value) -> ErrorOr<void> {
-        auto const new_node = new (nothrow) Node{ Cxx::move(value) };
-        if ( new_node == nullptr ) [[unlikely]] {
-            return Error::from_code(ErrorCode::NoMemory);
-        }
+        auto const new_node = try$(try_new_node(Cxx::move(value)));
 
         if ( m_tail_node != nullptr ) {
             m_tail_node->m_next_node = new_node;
@@ -284,10 +284,7 @@ public:
         must$(try_prepend(Cxx::move(value)));
     }
     auto try_prepend(T value) -> ErrorOr<void> {
-        auto const new_node = new (nothrow) Node{ Cxx::move(value) };
-        if ( new_node == nullptr ) [[unlikely]] {
-            return Error::from_code(ErrorCode::NoMemory);
-        }
+        auto const new_node = try$(try_new_node(Cxx::move(value)));
 
         if ( m_head_node != nullptr ) {
             m_head_node->m_prev_node = new_node;
@@ -438,6 +435,15 @@ public:
 private:
     explicit List() = default;
 
+    auto try_new_node(T value) -> ErrorOr<Node*> {
+        auto const node_ptr = try$(Details::allocator_alloc(m_allocator, sizeof(Node)));
+        return new (node_ptr) Node{ Cxx::move(value) };
+    }
+    auto delete_node(Node* node) -> void {
+        node->~Node();
+        Details::allocator_dealloc(m_allocator, node, sizeof(Node));
+    }
+
     template<typename TIterator>
     auto erase(TIterator& iterator) {
         verify_false$(iterator.is_end());
@@ -456,14 +462,15 @@ private:
             node_to_erase->m_next_node->m_prev_node = node_to_erase->m_prev_node;
         }
 
-        iterator.delete_node();
+        delete_node(Cxx::exchange(iterator.m_current_node, nullptr));
         --m_values_count;
     }
 
 private:
-    Node* m_head_node    = nullptr;
-    Node* m_tail_node    = nullptr;
-    usize m_values_count = 0;
+    Node*      m_head_node    = nullptr;
+    Node*      m_tail_node    = nullptr;
+    usize      m_values_count = 0;
+    Allocator* m_allocator    = nullptr;
 };
 
 namespace Cxx {
@@ -83,6 +83,11 @@ public:
     static auto empty() -> Map<K, T, KTraits, IsOrdered> {
         return Map<K, T, KTraits, IsOrdered>();
     }
+    static auto with_allocator(Allocator& allocator) -> Map<K, T, KTraits, IsOrdered> {
+        auto map       = empty();
+        map.m_hash_set = Set<KeyValue, KeyValueTraits, IsOrdered>::with_allocator(allocator);
+        return map;
+    }
     static auto with_capacity(usize capacity) -> Map<K, T, KTraits, IsOrdered> {
         return must$(try_with_capacity(capacity));
     }
@@ -133,7 +138,7 @@ public:
     ~Map() = default;
 
     /**
-     * @brief Deep cloning
+     * @brief Deep cloning, the clone always allocates from the global heap
      */
     auto clone() const -> Map<K, T, KTraits, IsOrdered> {
         return must$(try_clone());
@@ -180,10 +185,10 @@ public:
      * @brief Returns the pair referenced by the given key if exists
      */
     auto find(K const& key) -> Option<KeyValue&> {
-        return m_hash_set.find(KeyValue{ key, T{} });
+        return m_hash_set.find(KTraits::hash(key), [&key](auto const& pair) -> bool { return KTraits::equals(pair.m_key, key); });
     }
     auto find(K const& key) const -> Option<KeyValue const&> {
-        return m_hash_set.find(KeyValue{ key, T{} });
+        return m_hash_set.find(KTraits::hash(key), [&key](auto const& pair) -> bool { return KTraits::equals(pair.m_key, key); });
     }
 
     /**
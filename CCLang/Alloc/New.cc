@@ -14,10 +14,12 @@
 
 #include <CCLang/Core/Assertions.hh>
 #include <CCLang/Lang/Must.hh>
+#include <CCLang/Lang/Try.hh>
 
 extern "C++" {
 
 auto __rt_heap_plugin_alloc(usize size, bool clean) -> ErrorOr<void*>;
+auto __rt_heap_plugin_realloc(void* ptr, usize size, usize new_size) -> ErrorOr<void*>;
 auto __rt_heap_plugin_dealloc(void* ptr, usize size) -> ErrorOr<void>;
 
 auto __rt_heap_plugin_alloc_aligned(usize size, usize alignment, bool clean) -> ErrorOr<void*>;
@@ -92,6 +94,16 @@ auto Details::internal_heap_alloc(usize size) -> ErrorOr<void*> {
     return __rt_heap_plugin_alloc(size, true);
 }
 
+auto Details::internal_heap_realloc(void* ptr, usize size, usize new_size) -> ErrorOr<void*> {
+    auto const new_ptr = try$(__rt_heap_plugin_realloc(ptr, size, new_size));
+
+    /* the heap keeps the content but not the zero-filled memory contract of the containers */
+    if ( new_size > size ) {
+        Cxx::memset(static_cast<u8::NativeInt*>(new_ptr) + size.unwrap(), 0, new_size - size);
+    }
+    return new_ptr;
+}
+
 auto Details::internal_heap_dealloc(void* ptr, usize size) -> void {
     must$(__rt_heap_plugin_dealloc(ptr, size));
 }
@@ -43,6 +43,7 @@ namespace Details {
 /* Visible on the header only because they are used by the CCLang.Alloc containers */
 
 auto internal_heap_alloc(usize size) -> ErrorOr<void*>;
+auto internal_heap_realloc(void* ptr, usize size, usize new_size) -> ErrorOr<void*>;
 auto internal_heap_dealloc(void* ptr, usize size) -> void;
 
 } /* namespace Details */
@@ -0,0 +1,111 @@
+/**
+ * @brief
+ * This file is part of the MeetiX Operating System.
+ * Copyright (c) 2017-2022, Marco Cicognani (marco.cicognani@meetixos.org)
+ *
+ * @developers
+ * Marco Cicognani (marco.cicognani@meetixos.org)
+ *
+ * @license
+ * GNU General Public License version 3
+ */
+
+#include <CCLang/Alloc/PoolAllocator.hh>
+
+#include <CCLang/Alloc/New.hh>
+#include <CCLang/Core/Assertions.hh>
+#include <CCLang/Lang/Cxx.hh>
+#include <CCLang/Lang/Try.hh>
+
+auto PoolAllocator::with_block_size(usize block_size, usize blocks_per_slab) -> PoolAllocator {
+    verify_greater$(block_size, 0);
+    verify_greater$(blocks_per_slab, 0);
+
+    /* each free block keeps the link to the next one */
+    auto const aligned_block_size = (block_size.unwrap() + C_BLOCK_ALIGNMENT - 1) & ~(C_BLOCK_ALIGNMENT - 1);
+    return PoolAllocator{ aligned_block_size, blocks_per_slab };
+}
+
+PoolAllocator::~PoolAllocator() {
+    auto const slab_size = m_block_size * m_blocks_per_slab + C_SLAB_HEADER_SIZE;
+    while ( m_slabs != nullptr ) {
+        Details::internal_heap_dealloc(Cxx::exchange(m_slabs, m_slabs->m_next_slab), slab_size);
+    }
+}
+
+auto PoolAllocator::try_alloc(usize size) -> ErrorOr<void*> {
+    if ( size > m_block_size ) [[unlikely]] {
+        ++m_fallback_allocations_count;
+        return Details::internal_heap_alloc(size);
+    }
+
+    if ( m_free_blocks == nullptr ) {
+        try$(try_push_slab());
+    }
+
+    /* only the link is dirty into a free block */
+    auto const block = Cxx::exchange(m_free_blocks, m_free_blocks->m_next_block);
+    block->m_next_block = nullptr;
+    ++m_allocations_count;
+    return block;
+}
+
+auto PoolAllocator::try_realloc(void* ptr, usize size, usize new_size) -> ErrorOr<void*> {
+    if ( size > m_block_size || new_size > m_block_size ) {
+        return Allocator::try_realloc(ptr, size, new_size);
+    }
+
+    /* a shrunk block must be clean for a later growth */
+    if ( new_size < size ) {
+        Cxx::memset(static_cast<u8::NativeInt*>(ptr) + new_size.unwrap(), 0, size - new_size);
+    }
+    return ptr;
+}
+
+auto PoolAllocator::dealloc(void* ptr, usize size) -> void {
+    if ( ptr == nullptr ) {
+        return;
+    }
+
+    if ( size > m_block_size ) [[unlikely]] {
+        Details::internal_heap_dealloc(ptr, size);
+    } else {
+        Cxx::memset(ptr, 0, m_block_size);
+        m_free_blocks = new (ptr) FreeBlock{ m_free_blocks };
+    }
+}
+
+auto PoolAllocator::allocations_count() const -> usize {
+    return m_allocations_count;
+}
+
+auto PoolAllocator::slab_allocations_count() const -> usize {
+    return m_slab_allocations_count;
+}
+
+auto PoolAllocator::fallback_allocations_count() const -> usize {
+    return m_fallback_allocations_count;
+}
+
+auto PoolAllocator::block_size() const -> usize {
+    return m_block_size;
+}
+
+PoolAllocator::PoolAllocator(usize block_size, usize blocks_per_slab)
+    : m_block_size(block_size)
+    , m_blocks_per_slab(blocks_per_slab) {
+}
+
+auto PoolAllocator::try_push_slab() -> ErrorOr<void> {
+    auto const slab_ptr = try$(Details::internal_heap_alloc(m_block_size * m_blocks_per_slab + C_SLAB_HEADER_SIZE));
+    m_slabs             = new (slab_ptr) Slab{ m_slabs };
+
+    /* thread the clean blocks into the free-list, in reverse to hand them out in address order */
+    auto const blocks_begin = static_cast<u8::NativeInt*>(slab_ptr) + C_SLAB_HEADER_SIZE;
+    for ( auto i = m_blocks_per_slab; i > 0; --i ) {
+        m_free_blocks = new (blocks_begin + ((i - 1) * m_block_size).unwrap()) FreeBlock{ m_free_blocks };
+    }
+
+    ++m_slab_allocations_count;
+    return {};
+}
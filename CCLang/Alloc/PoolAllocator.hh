@@ -0,0 +1,91 @@
+/**
+ * @brief
+ * This file is part of the MeetiX Operating System.
+ * Copyright (c) 2017-2022, Marco Cicognani (marco.cicognani@meetixos.org)
+ *
+ * @developers
+ * Marco Cicognani (marco.cicognani@meetixos.org)
+ *
+ * @license
+ * GNU General Public License version 3
+ */
+
+#pragma once
+
+#include <CCLang/Forward.hh>
+
+#include <CCLang/Alloc/Allocator.hh>
+#include <CCLang/Core/ErrorOr.hh>
+#include <CCLang/Lang/DenyCopy.hh>
+#include <CCLang/Lang/DenyMove.hh>
+#include <CCLang/Lang/IntTypes.hh>
+
+/**
+ * @brief Fixed-size blocks allocator, i.e. for the List nodes.
+ * Blocks are carved from slabs obtained from the global heap and recycled through a free-list, the requests bigger
+ * than the block size are forwarded to the global heap
+ */
+class PoolAllocator final : public Allocator,
+                            public DenyCopy,
+                            public DenyMove {
+public:
+    static constexpr usize::NativeInt C_DEFAULT_BLOCKS_PER_SLAB = 64;
+
+public:
+    /**
+     * @brief Non-Error safe factory functions
+     */
+    static auto with_block_size(usize block_size, usize blocks_per_slab = C_DEFAULT_BLOCKS_PER_SLAB) -> PoolAllocator;
+
+    template<typename T>
+    static auto for_type(usize blocks_per_slab = C_DEFAULT_BLOCKS_PER_SLAB) -> PoolAllocator {
+        return with_block_size(sizeof(T), blocks_per_slab);
+    }
+
+    ~PoolAllocator() override;
+
+    /**
+     * @brief Allocator implementation.
+     * try_realloc() keeps the same block while the new size fits into it
+     */
+    auto try_alloc(usize size) -> ErrorOr<void*> override;
+    auto try_realloc(void* ptr, usize size, usize new_size) -> ErrorOr<void*> override;
+    auto dealloc(void* ptr, usize size) -> void override;
+
+    /**
+     * @brief Getters
+     */
+    [[nodiscard]]
+    auto allocations_count() const -> usize;
+    [[nodiscard]]
+    auto slab_allocations_count() const -> usize;
+    [[nodiscard]]
+    auto fallback_allocations_count() const -> usize;
+    [[nodiscard]]
+    auto block_size() const -> usize;
+
+private:
+    struct FreeBlock {
+        FreeBlock* m_next_block;
+    };
+    struct Slab {
+        Slab* m_next_slab;
+    };
+
+    static constexpr usize::NativeInt C_BLOCK_ALIGNMENT = sizeof(void*) * 2;
+    static constexpr usize::NativeInt C_SLAB_HEADER_SIZE = (sizeof(Slab) + C_BLOCK_ALIGNMENT - 1) & ~(C_BLOCK_ALIGNMENT - 1);
+
+private:
+    explicit PoolAllocator(usize block_size, usize blocks_per_slab);
+
+    auto try_push_slab() -> ErrorOr<void>;
+
+private:
+    FreeBlock* m_free_blocks                = nullptr;
+    Slab*      m_slabs                      = nullptr;
+    usize      m_block_size                 = 0;
+    usize      m_blocks_per_slab            = 0;
+    usize      m_allocations_count          = 0;
+    usize      m_slab_allocations_count     = 0;
+    usize      m_fallback_allocations_count = 0;
+};
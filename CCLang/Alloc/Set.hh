@@ -14,6 +14,7 @@
 
 #include <CCLang/Forward.hh>
 
+#include <CCLang/Alloc/Allocator.hh>
 #include <CCLang/Alloc/New.hh>
 #include <CCLang/Core/Assertions.hh>
 #include <CCLang/Core/Concept.hh>
@@ -30,22 +31,123 @@
 
 namespace Details {
 
-enum class SetBucketState : u32::NativeInt {
-    Free     = 0x00,
-    Used     = 0x10,
-    Deleted  = 0x01,
-    Rehashed = 0x12,
-    End      = 0xFF,
+/**
+ * @brief Each bucket has one control byte, stored apart from the buckets to be scanned a group at a time.
+ * A zero-filled table is a valid empty table, the used buckets keep into the low 7 bits a fragment of their hash
+ */
+enum class SetControl : u8::NativeInt {
+    Empty   = 0x00,
+    Deleted = 0x01,
+    Used    = 0x80,
 };
 
-constexpr auto set_bucket_state_is_used(SetBucketState state) -> bool {
-    return ((u32::NativeInt)state & 0xf0) == (u32::NativeInt)SetBucketState::Used;
+constexpr auto set_control_is_used(u8::NativeInt control) -> bool {
+    return (control & (u8::NativeInt)SetControl::Used) != 0;
 }
 
-constexpr auto set_bucket_state_is_free(SetBucketState state) -> bool {
-    return ((u32::NativeInt)state & 0xf0) == (u32::NativeInt)SetBucketState::Free;
+/**
+ * @brief Spreads the bits of the user hash, the group index is taken from the high bits and the control fragment
+ * from the low ones, so both must be well distributed
+ */
+constexpr auto set_mix_hash(usize::NativeInt mixed_hash) -> usize::NativeInt {
+    if constexpr ( sizeof(usize::NativeInt) == 8 ) {
+        mixed_hash ^= mixed_hash >> 33;
+        mixed_hash *= static_cast<usize::NativeInt>(0xff51afd7ed558ccdull);
+        mixed_hash ^= mixed_hash >> 33;
+        mixed_hash *= static_cast<usize::NativeInt>(0xc4ceb9fe1a85ec53ull);
+        mixed_hash ^= mixed_hash >> 33;
+    } else {
+        mixed_hash ^= mixed_hash >> 16;
+        mixed_hash *= 0x85ebca6b;
+        mixed_hash ^= mixed_hash >> 13;
+        mixed_hash *= 0xc2b2ae35;
+        mixed_hash ^= mixed_hash >> 16;
+    }
+    return mixed_hash;
 }
 
+/**
+ * @brief Group of control bytes matched together, vectorized with SSE2 when the target has it and word-at-a-time
+ * otherwise. The matches are returned as a bitmask with a bit for each control byte
+ */
+class SetControlGroup final {
+public:
+    static constexpr usize::NativeInt C_WIDTH = 16;
+
+public:
+    static auto load(u8::NativeInt const* control_bytes) -> SetControlGroup {
+        SetControlGroup group;
+        __builtin_memcpy(&group.m_control_bytes, control_bytes, C_WIDTH);
+        return group;
+    }
+
+#ifdef __SSE2__
+    auto match(u8::NativeInt control) const -> u32::NativeInt {
+        return __builtin_ia32_pmovmskb128(m_control_bytes == Vector16{} + static_cast<char>(control));
+    }
+    auto match_empty() const -> u32::NativeInt {
+        return match((u8::NativeInt)SetControl::Empty);
+    }
+    auto match_used() const -> u32::NativeInt {
+        return __builtin_ia32_pmovmskb128(m_control_bytes);
+    }
+#else
+    auto match(u8::NativeInt control) const -> u32::NativeInt {
+        return collect_mask([control](u32::NativeInt word) { return zero_bytes(word ^ (C_LOW_BITS * control)); });
+    }
+    auto match_empty() const -> u32::NativeInt {
+        return collect_mask([](u32::NativeInt word) { return zero_bytes(word); });
+    }
+    auto match_used() const -> u32::NativeInt {
+        return collect_mask([](u32::NativeInt word) { return word & C_HIGH_BITS; });
+    }
+#endif
+
+    /**
+     * @brief Matches the Empty and the Deleted buckets, which can be both written
+     */
+    auto match_free() const -> u32::NativeInt {
+        return ~match_used() & ((1u << C_WIDTH) - 1);
+    }
+
+private:
+    SetControlGroup() = default;
+
+#ifdef __SSE2__
+    /* the vector extensions keep the intrinsics headers, which need the hosted libc, out */
+    using Vector16 = char __attribute__((vector_size(16)));
+#else
+    static constexpr u32::NativeInt C_LOW_BITS   = 0x01010101;
+    static constexpr u32::NativeInt C_LOW7_BITS  = 0x7f7f7f7f;
+    static constexpr u32::NativeInt C_HIGH_BITS  = 0x80808080;
+    static constexpr usize::NativeInt C_WORDS    = C_WIDTH / sizeof(u32::NativeInt);
+
+    /**
+     * @brief Sets the high bit of each zero byte, without the false positives of the borrow-based variant
+     */
+    static auto zero_bytes(u32::NativeInt word) -> u32::NativeInt {
+        return ~(((word & C_LOW7_BITS) + C_LOW7_BITS) | word | C_LOW7_BITS);
+    }
+
+    auto collect_mask(auto word_high_bits) const -> u32::NativeInt {
+        u32::NativeInt mask = 0;
+        for ( usize::NativeInt i = 0; i < C_WORDS; ++i ) {
+            /* gathers the high bit of each byte into the top nibble, the lowest byte first */
+            auto const high_bits = word_high_bits(m_control_bytes[i]) >> 7;
+            mask |= ((high_bits * 0x10204080) >> 28) << (i * sizeof(u32::NativeInt));
+        }
+        return mask;
+    }
+#endif
+
+private:
+#ifdef __SSE2__
+    Vector16 m_control_bytes;
+#else
+    u32::NativeInt m_control_bytes[C_WORDS];
+#endif
+};
+
 template<typename T, typename TBucket>
 class SetIterator final {
 public:
@@ -53,10 +155,10 @@ public:
      * @brief Error safe factory functions
      */
     static auto empty() -> SetIterator<T, TBucket> {
-        return SetIterator<T, TBucket>(nullptr);
+        return SetIterator<T, TBucket>(nullptr, nullptr, 0);
     }
-    static auto from_bucket(TBucket* bucket) -> SetIterator<T, TBucket> {
-        return SetIterator<T, TBucket>(bucket);
+    static auto from_bucket(u8::NativeInt const* control_byte, TBucket* bucket, usize remaining_count) -> SetIterator<T, TBucket> {
+        return SetIterator<T, TBucket>(control_byte, bucket, remaining_count);
     }
 
     SetIterator(SetIterator const&) = default;
@@ -71,17 +173,16 @@ public:
             return *this;
         }
 
-        do {
-            ++m_current_bucket;
-            if ( m_current_bucket->m_bucket_state == SetBucketState::Used ) {
-                return *this;
-            }
-        } while ( m_current_bucket->m_bucket_state != SetBucketState::End );
-
-        if ( m_current_bucket->m_bucket_state == SetBucketState::End ) {
+        /* the remaining count avoids to scan the free buckets after the last used one */
+        if ( --m_remaining_count == 0 ) {
             m_current_bucket = nullptr;
+            return *this;
         }
 
+        do {
+            ++m_control_byte;
+            ++m_current_bucket;
+        } while ( !set_control_is_used(*m_control_byte) );
         return *this;
     }
     auto operator++(int) -> SetIterator {
@@ -122,15 +223,21 @@ public:
     auto operator!=(SetIterator const& rhs) const -> bool {
         return m_current_bucket != rhs.m_current_bucket;
     }
-    auto operator<=>(SetIterator const& rhs) const -> bool = default;
 
 private:
-    explicit constexpr SetIterator(TBucket* bucket)
-        : m_current_bucket(bucket) {
+    explicit constexpr SetIterator(u8::NativeInt const* control_byte, TBucket* bucket, usize remaining_count)
+        : m_control_byte(control_byte)
+        , m_current_bucket(bucket)
+        , m_remaining_count(remaining_count) {
     }
 
+    template<typename, typename, bool>
+    friend class ::Set;
+
 private:
-    TBucket* m_current_bucket;
+    u8::NativeInt const* m_control_byte;
+    TBucket*             m_current_bucket;
+    usize                m_remaining_count;
 };
 
 template<typename T, typename TBucket, bool IsReverse>
@@ -209,6 +316,9 @@ private:
         : m_current_bucket(bucket) {
     }
 
+    template<typename, typename, bool>
+    friend class ::Set;
+
 private:
     TBucket* m_current_bucket;
 };
@@ -222,7 +332,6 @@ struct SetBucket final {
         return Cxx::bit_cast<T const*>(&m_storage);
     }
 
-    SetBucketState m_bucket_state;
     alignas(T) u8 m_storage[sizeof(T)];
 };
 
@@ -237,7 +346,6 @@ struct OrderedSetBucket final {
 
     OrderedSetBucket* m_prev_bucket;
     OrderedSetBucket* m_next_bucket;
-    SetBucketState    m_bucket_state;
     alignas(T) u8 m_storage[sizeof(T)];
 };
 
@@ -270,12 +378,11 @@ using SetInsertResult    = Details::InsertResult;
 template<typename T, typename TTraits, bool IsOrdered>
 class Set final : public DenyCopy {
 private:
-    enum : unsigned int {
-        LoadFactorPercent = 60
-    };
-
     using Bucket         = Conditional<IsOrdered, Details::OrderedSetBucket<T>, Details::SetBucket<T>>;
     using DataCollection = Conditional<IsOrdered, Details::OrderedCollectionData<Bucket>, Details::CollectionData>;
+    using ControlGroup   = Details::SetControlGroup;
+
+    static constexpr usize::NativeInt C_MIN_CAPACITY = ControlGroup::C_WIDTH;
 
 public:
     using Iterator             = Conditional<IsOrdered, Details::OrderedSetIterator<T, Bucket, false>, Details::SetIterator<T, Bucket>>;
@@ -292,6 +399,11 @@ public:
     static constexpr auto empty() -> Set<T, TTraits, IsOrdered> {
         return Set<T, TTraits, IsOrdered>();
     }
+    static auto with_allocator(Allocator& allocator) -> Set<T, TTraits, IsOrdered> {
+        auto set        = empty();
+        set.m_allocator = &allocator;
+        return set;
+    }
     static auto with_capacity(usize capacity) -> Set<T, TTraits, IsOrdered> {
         return must$(try_with_capacity(capacity));
     }
@@ -307,7 +419,7 @@ public:
      */
     static auto try_with_capacity(usize capacity) -> ErrorOr<Set<T, TTraits, IsOrdered>> {
         auto set = Set<T, TTraits, IsOrdered>::empty();
-        try$(set.try_rehash(capacity));
+        try$(set.try_rehash(buckets_count_for(capacity)));
         return set;
     }
     static auto try_from_other(Set<T, TTraits, IsOrdered> const& rhs) -> ErrorOr<Set<T, TTraits, IsOrdered>> {
@@ -337,11 +449,13 @@ public:
      * @brief Move constructor and move assignment
      */
     Set(Set<T, TTraits, IsOrdered>&& rhs)
-        : m_buckets_storage(Cxx::exchange(rhs.m_buckets_storage, nullptr))
+        : m_control_bytes(Cxx::exchange(rhs.m_control_bytes, nullptr))
+        , m_buckets_storage(Cxx::exchange(rhs.m_buckets_storage, nullptr))
         , m_collection_data(Cxx::exchange(rhs.m_collection_data, DataCollection()))
         , m_data_capacity(Cxx::exchange(rhs.m_data_capacity, 0))
         , m_values_count(Cxx::exchange(rhs.m_values_count, 0))
-        , m_deleted_count(Cxx::exchange(rhs.m_deleted_count, 0)) {
+        , m_deleted_count(Cxx::exchange(rhs.m_deleted_count, 0))
+        , m_allocator(Cxx::exchange(rhs.m_allocator, nullptr)) {
     }
     auto operator=(Set<T, TTraits, IsOrdered>&& rhs) -> Set<T, TTraits, IsOrdered>& {
         auto set = Cxx::move(rhs);
@@ -354,7 +468,7 @@ public:
     }
 
     /**
-     * @brief Deep cloning
+     * @brief Deep cloning, the clone always allocates from the global heap
      */
     auto clone() const -> Set<T, TTraits, IsOrdered> {
         return must$(try_clone());
@@ -370,25 +484,29 @@ public:
         clear_keep_capacity();
 
         if ( m_data_capacity > 0 ) {
-            Details::internal_heap_dealloc(m_buckets_storage, size_in_bytes(capacity()));
+            Details::allocator_dealloc(m_allocator, m_control_bytes, size_in_bytes(m_data_capacity.unwrap()));
+            m_control_bytes   = nullptr;
             m_buckets_storage = nullptr;
             m_data_capacity   = 0;
         }
     }
     auto clear_keep_capacity() -> void {
+        if ( m_control_bytes == nullptr ) {
+            return;
+        }
+
         if constexpr ( !TTraits::is_trivial() ) {
             for ( auto const i : usize::range(0, m_data_capacity) ) {
-                if ( Details::set_bucket_state_is_used(m_buckets_storage[i.unwrap()].m_bucket_state) ) {
+                if ( Details::set_control_is_used(m_control_bytes[i.unwrap()]) ) {
                     m_buckets_storage[i.unwrap()].slot()->~T();
                 }
             }
         }
 
-        Cxx::memset(m_buckets_storage, 0, size_in_bytes(capacity()));
+        /* both the control bytes and the buckets go back to the zero-filled state */
+        Cxx::memset(m_control_bytes, 0, size_in_bytes(m_data_capacity.unwrap()));
         if constexpr ( IsOrdered ) {
             m_collection_data = Details::OrderedCollectionData<Bucket>{ nullptr, nullptr };
-        } else {
-            m_buckets_storage[m_data_capacity.unwrap()].m_bucket_state = Details::SetBucketState::End;
         }
 
         m_values_count  = 0;
@@ -399,10 +517,12 @@ public:
      * @brief Swaps in O(1) the content of this Set with another
      */
     auto swap(Set<T, TTraits, IsOrdered>& rhs) {
+        Cxx::swap(m_control_bytes, rhs.m_control_bytes);
         Cxx::swap(m_buckets_storage, rhs.m_buckets_storage);
         Cxx::swap(m_data_capacity, rhs.m_data_capacity);
         Cxx::swap(m_values_count, rhs.m_values_count);
         Cxx::swap(m_deleted_count, rhs.m_deleted_count);
+        Cxx::swap(m_allocator, rhs.m_allocator);
 
         if constexpr ( IsOrdered ) {
             Cxx::swap(m_collection_data, rhs.m_collection_data);
@@ -417,41 +537,27 @@ public:
         return must$(try_insert(Cxx::move(value), replace_existing));
     }
     auto try_insert(T value, SetReplaceExisting replace_existing = SetReplaceExisting::Yes) -> ErrorOr<SetInsertResult> {
-        /* find a found_bucket which is suitable for writing the value */
-        auto found_bucket = try$(try_lookup_for_writing(value));
-        if ( Details::set_bucket_state_is_used(found_bucket->m_bucket_state) ) {
+        auto const hash = TTraits::hash(value);
+
+        /* look for an existing value first, the lookup stops to the first group with an empty bucket */
+        auto existing_bucket = lookup_with_hash(hash, [&value](T const& current) -> bool { return TTraits::equals(current, value); });
+        if ( existing_bucket != nullptr ) {
             /* keep the existing value and return */
             if ( replace_existing == SetReplaceExisting::No ) {
                 return SetInsertResult::Kept;
             }
 
             /* replace the value with the given one */
-            (*found_bucket->slot()) = Cxx::move(value); /* use move assignment to let the existing value to be correctly replaced */
+            (*existing_bucket->slot()) = Cxx::move(value); /* use move assignment to let the existing value to be correctly replaced */
             return SetInsertResult::Replaced;
         }
 
-        /* write the value into the new bucket.
-         * NOTE even if the bucket is in the Deleted state, we can overwrite using move constructor
-         * because destructor of previous value was already called by remove */
-        new (found_bucket->slot()) T(Cxx::move(value));
-        if ( found_bucket->m_bucket_state == Details::SetBucketState::Deleted ) {
-            --m_deleted_count;
-        }
-
-        found_bucket->m_bucket_state = Details::SetBucketState::Used;
-
-        /* update linked list of ordered values if is ordered */
-        if constexpr ( IsOrdered ) {
-            if ( m_collection_data.m_head == nullptr ) [[unlikely]] {
-                m_collection_data.m_head = found_bucket;
-            } else {
-                found_bucket->m_prev_bucket             = m_collection_data.m_tail;
-                m_collection_data.m_tail->m_next_bucket = found_bucket;
-            }
-            m_collection_data.m_tail = found_bucket;
+        /* the deleted buckets are counted too, because they keep the probing going as the used ones */
+        if ( used_bucket_count() >= growth_limit(m_data_capacity.unwrap()) ) {
+            try$(try_grow());
         }
 
-        ++m_values_count;
+        insert_new(Details::set_mix_hash(hash.unwrap()), Cxx::move(value));
         return SetInsertResult::New;
     }
 
@@ -461,7 +567,8 @@ public:
     auto remove(T const& value) -> bool {
         auto bucket = lookup_with_hash(TTraits::hash(value), [&value](T const& current) -> bool { return TTraits::equals(value, current); });
         if ( bucket != nullptr ) {
-            return remove(*bucket);
+            remove_bucket(*bucket);
+            return true;
         } else {
             return false;
         }
@@ -472,7 +579,8 @@ public:
      */
     auto remove(Iterator iterator) -> bool {
         if ( iterator != end() ) {
-            return remove(*iterator.m_bucket);
+            remove_bucket(*iterator.m_current_bucket);
+            return true;
         } else {
             return false;
         }
@@ -486,20 +594,11 @@ public:
         usize removed_count = 0;
         for ( auto const i : usize::range(0, m_data_capacity) ) {
             auto& bucket = m_buckets_storage[i.unwrap()];
-            if ( Details::set_bucket_state_is_used(bucket.m_bucket_state) && predicate(*bucket.slot()) ) {
-                delete_bucket(bucket);
+            if ( Details::set_control_is_used(m_control_bytes[i.unwrap()]) && predicate(*bucket.slot()) ) {
+                remove_bucket(bucket);
                 ++removed_count;
             }
         }
-
-        /* update the statistics */
-        if ( removed_count > 0 ) {
-            m_deleted_count += removed_count;
-            m_values_count -= removed_count;
-        }
-
-        /* rehash if needed and return the removed amount */
-        rehash_in_place_if_needed();
         return removed_count;
     }
 
@@ -507,12 +606,16 @@ public:
      * @brief Allocates new capacity for this set for at least the given capacity
      */
     auto ensure_capacity(usize capacity) {
-        verify_greater_equal$(capacity, count());
-        rehash(capacity * 2);
+        must$(try_ensure_capacity(capacity));
     }
     auto try_ensure_capacity(usize capacity) -> ErrorOr<void> {
         verify_greater_equal$(capacity, count());
-        return try_rehash(capacity * 2);
+
+        auto const buckets_count = buckets_count_for(capacity);
+        if ( m_data_capacity < buckets_count ) {
+            try$(try_rehash(buckets_count));
+        }
+        return {};
     }
 
     /**
@@ -522,13 +625,12 @@ public:
         if constexpr ( IsOrdered ) {
             return Iterator::from_bucket(m_collection_data.m_head);
         } else {
-            /* find the first used bucket */
-            for ( auto const i : usize::range(0, m_data_capacity) ) {
-                if ( Details::set_bucket_state_is_used(m_buckets_storage[i.unwrap()].m_bucket_state) ) {
-                    return Iterator::from_bucket(&m_buckets_storage[i.unwrap()]);
-                }
+            if ( is_empty() ) {
+                return end();
             }
-            return end();
+
+            auto const index = first_used_index();
+            return Iterator::from_bucket(m_control_bytes + index, m_buckets_storage + index, m_values_count);
         }
     }
     auto end() -> Iterator {
@@ -539,13 +641,12 @@ public:
         if constexpr ( IsOrdered ) {
             return ConstIterator::from_bucket(m_collection_data.m_head);
         } else {
-            /* find the first used bucket */
-            for ( auto const i : usize::range(0, m_data_capacity) ) {
-                if ( Details::set_bucket_state_is_used(m_buckets_storage[i.unwrap()].m_bucket_state) ) {
-                    return ConstIterator::from_bucket(&m_buckets_storage[i.unwrap()]);
-                }
+            if ( is_empty() ) {
+                return end();
             }
-            return end();
+
+            auto const index = first_used_index();
+            return ConstIterator::from_bucket(m_control_bytes + index, m_buckets_storage + index, m_values_count);
         }
     }
     auto end() const -> ConstIterator {
@@ -631,297 +732,188 @@ public:
 private:
     explicit constexpr Set() = default;
 
-    auto insert_during_rehash(T&& value) {
-        auto& bucket = lookup_for_writing(value);
-
-        /* fill the selected bucket */
-        bucket.m_bucket_state = Details::SetBucketState::Used;
-        new (bucket.slot()) T(Cxx::move(value));
-
-        /* link to the linked list if the set is ordered */
-        if constexpr ( IsOrdered ) {
-            if ( !m_collection_data.m_head ) [[unlikely]] {
-                m_collection_data.m_head = &bucket;
-            } else {
-                bucket.m_prev_bucket                    = m_collection_data.m_tail;
-                m_collection_data.m_tail->m_next_bucket = &bucket;
-            }
-            m_collection_data.m_tail = &bucket;
-        }
+    /**
+     * @brief The groups are visited with triangular steps, which cover all of them when their count is a power of two
+     */
+    auto groups_mask() const -> usize::NativeInt {
+        return m_data_capacity.unwrap() / ControlGroup::C_WIDTH - 1;
     }
 
-    auto rehash(usize new_capacity) -> void {
-        must$(try_rehash(new_capacity));
+    static constexpr auto control_fragment(usize::NativeInt mixed_hash) -> u8::NativeInt {
+        return (u8::NativeInt)Details::SetControl::Used | (mixed_hash & 0x7f);
     }
-    auto try_rehash(usize new_capacity) -> ErrorOr<void> {
-        if ( new_capacity == m_data_capacity && new_capacity >= 4 ) {
-            rehash_in_place();
-            return {};
-        }
-
-        /* roundup the given new capacity */
-        new_capacity = usize::max(new_capacity, 4);
-        new_capacity = new_capacity * sizeof(Bucket) / sizeof(Bucket);
-
-        /* keep old references */
-        auto const old_buckets  = m_buckets_storage;
-        auto const old_capacity = m_data_capacity;
-        auto       old_iter     = begin();
-
-        /* allocate the new memory */
-        m_buckets_storage = try$(Details::internal_heap_alloc(size_in_bytes(new_capacity)).map<Bucket*>([](void* void_ptr) -> Bucket* {
-            return Cxx::bit_cast<Bucket*>(void_ptr);
-        }));
-        m_data_capacity   = new_capacity;
-        m_deleted_count   = 0;
-
-        /* update the collection */
-        if constexpr ( IsOrdered ) {
-            m_collection_data = Details::OrderedCollectionData<Bucket>{ nullptr, nullptr };
-        } else {
-            m_buckets_storage[m_data_capacity.unwrap()].m_bucket_state = Details::SetBucketState::End;
-        }
-
-        /* return if this set was emtpy */
-        if ( old_buckets == nullptr ) {
-            return {};
-        }
 
-        /* move the values to the new memory */
-        for ( auto it = Cxx::move(old_iter); it != end(); ++it ) {
-            insert_during_rehash(Cxx::move(*it));
-            it->~T();
+    auto lookup_with_hash(usize hash, auto predicate) const -> Bucket* {
+        if ( is_empty() ) {
+            return nullptr;
         }
 
-        /* free the old memory */
-        Details::internal_heap_dealloc(m_buckets_storage, size_in_bytes(old_capacity));
-        return {};
-    }
-
-    void rehash_in_place_if_needed() {
-        if ( m_deleted_count >= m_values_count && should_grow() ) {
-            rehash_in_place();
-        }
-    }
+        auto const mixed_hash = Details::set_mix_hash(hash.unwrap());
+        auto const control    = control_fragment(mixed_hash);
 
-    void rehash_in_place() {
-        for ( auto const i : usize::range(0, m_data_capacity) ) {
-            auto& bucket = m_buckets_storage[i.unwrap()];
+        auto group_index = (mixed_hash >> 7) & groups_mask();
+        for ( usize::NativeInt probe_step = 0;; ) {
+            auto const group_begin = group_index * ControlGroup::C_WIDTH;
+            auto const group       = ControlGroup::load(m_control_bytes + group_begin);
 
-            if ( bucket.m_bucket_state == Details::SetBucketState::Rehashed || bucket.m_bucket_state == Details::SetBucketState::End
-                 || bucket.m_bucket_state == Details::SetBucketState::Free ) {
-                continue;
-            }
-            if ( bucket.m_bucket_state == Details::SetBucketState::Deleted ) {
-                bucket.m_bucket_state = Details::SetBucketState::Free;
-                continue;
+            /* give to the predicate only the buckets with the same hash fragment */
+            for ( auto mask = group.match(control); mask != 0; mask &= mask - 1 ) {
+                auto& bucket = m_buckets_storage[group_begin + __builtin_ctz(mask)];
+                if ( predicate(*bucket.slot()) ) {
+                    return &bucket;
+                }
             }
 
-            auto const new_hash = TTraits::hash(*bucket.slot());
-            if ( new_hash % m_data_capacity == i ) {
-                bucket.m_bucket_state = Details::SetBucketState::Rehashed;
-                continue;
+            /* an empty bucket means that the value would have been placed into this group */
+            if ( group.match_empty() != 0 ) {
+                return nullptr;
             }
 
-            auto const to_move_hash   = i;
-            auto       target_hash    = new_hash;
-            auto       target_bucket  = &m_buckets_storage[(target_hash % m_data_capacity).unwrap()];
-            auto       bucket_to_move = &m_buckets_storage[i.unwrap()];
-
-            /* Try to move the bucket to move into its correct spot.
-             * During the procedure, we might re-hash or actually change the bucket to move
-             */
-            while ( !Details::set_bucket_state_is_free(bucket_to_move->m_bucket_state) ) {
-                /* if we're targeting ourselves, there's nothing to do */
-                if ( to_move_hash == target_hash % m_data_capacity ) {
-                    bucket_to_move->m_bucket_state = Details::SetBucketState::Rehashed;
-                    break;
-                }
+            group_index = (group_index + ++probe_step) & groups_mask();
+        }
+    }
 
-                if ( Details::set_bucket_state_is_free(target_bucket->m_bucket_state) ) {
-                    /* we can just overwrite the target bucket and bail out */
-                    new (target_bucket->slot()) T( Cxx::move(*bucket_to_move->slot()) );
-                    target_bucket->m_bucket_state  = Details::SetBucketState::Rehashed;
-                    bucket_to_move->m_bucket_state = Details::SetBucketState::Free;
-
-                    if constexpr ( IsOrdered ) {
-                        Cxx::swap(bucket_to_move->m_prev_bucket, target_bucket->m_prev_bucket);
-                        Cxx::swap(bucket_to_move->m_next_bucket, target_bucket->m_next_bucket);
-
-                        if ( target_bucket->m_prev_bucket ) {
-                            target_bucket->m_prev_bucket->m_next_bucket = target_bucket;
-                        } else {
-                            m_collection_data.m_head = target_bucket;
-                        }
-                        if ( target_bucket->m_next_bucket ) {
-                            target_bucket->m_next_bucket->m_prev_bucket = target_bucket;
-                        } else {
-                            m_collection_data.m_tail = target_bucket;
-                        }
-                    }
-                } else if ( target_bucket->m_bucket_state == Details::SetBucketState::Rehashed ) {
-                    /* if the target bucket is already re-hashed, we do normal probing */
-                    target_hash   = hash_again(target_hash);
-                    target_bucket = &m_buckets_storage[(target_hash % m_data_capacity).unwrap()];
-                } else {
-                    verify$(target_bucket->m_bucket_state != Details::SetBucketState::End);
-
-                    /* the target bucket is a used bucket that hasn't been re-hashed.
-                     * Swap the data into the target; now the target's data resides in the bucket to move again.
-                     * (That's of course what we want, how neat!)
-                     */
-                    Cxx::swap(*bucket_to_move->slot(), *target_bucket->slot());
-                    bucket_to_move->m_bucket_state = target_bucket->m_bucket_state;
-                    target_bucket->m_bucket_state  = Details::SetBucketState::Rehashed;
-
-                    if constexpr ( IsOrdered ) {
-                        /* update state for the target bucket, we'll do the bucket to move later */
-                        Cxx::swap(bucket_to_move->m_prev_bucket, target_bucket->m_prev_bucket);
-                        Cxx::swap(bucket_to_move->m_next_bucket, target_bucket->m_next_bucket);
-
-                        if ( target_bucket->m_prev_bucket ) {
-                            target_bucket->m_prev_bucket->m_next_bucket = target_bucket;
-                        } else {
-                            m_collection_data.m_head = target_bucket;
-                        }
-                        if ( target_bucket->m_next_bucket ) {
-                            target_bucket->m_next_bucket->m_prev_bucket = target_bucket;
-                        } else {
-                            m_collection_data.m_tail = target_bucket;
-                        }
-                    }
-
-                    target_hash   = TTraits::hash(*bucket_to_move->slot());
-                    target_bucket = &m_buckets_storage[(target_hash % m_data_capacity).unwrap()];
-
-                    /* the data is already in the correct location: Adjust the pointers */
-                    if ( target_hash % m_data_capacity == to_move_hash ) {
-                        bucket_to_move->m_bucket_state = Details::SetBucketState::Rehashed;
-                        if constexpr ( IsOrdered ) {
-                            /* update state for the bucket to move as it's not actually moved anymore */
-                            if ( bucket_to_move->m_prev_bucket ) {
-                                bucket_to_move->m_prev_bucket->m_next_bucket = bucket_to_move;
-                            } else {
-                                m_collection_data.m_head = bucket_to_move;
-                            }
-                            if ( bucket_to_move->m_next_bucket ) {
-                                bucket_to_move->m_next_bucket->m_prev_bucket = bucket_to_move;
-                            } else {
-                                m_collection_data.m_tail = bucket_to_move;
-                            }
-                        }
-                        break;
-                    }
-                }
+    auto find_free_index(usize::NativeInt mixed_hash) const -> usize::NativeInt {
+        auto group_index = (mixed_hash >> 7) & groups_mask();
+        for ( usize::NativeInt probe_step = 0;; ) {
+            auto const group_begin = group_index * ControlGroup::C_WIDTH;
+            auto const mask        = ControlGroup::load(m_control_bytes + group_begin).match_free();
+            if ( mask != 0 ) {
+                return group_begin + __builtin_ctz(mask);
             }
 
-            /* after this, the bucket_to_move either contains data that rehashes to itself,
-             * or it contains nothing as we were able to move the last thing
-             */
-            if ( bucket_to_move->m_bucket_state == Details::SetBucketState::Deleted ) {
-                bucket_to_move->m_bucket_state = Details::SetBucketState::Free;
-            }
+            group_index = (group_index + ++probe_step) & groups_mask();
         }
+    }
 
-        m_deleted_count = 0;
-        for ( auto const i : usize::range(0, m_data_capacity) ) {
-            if ( m_buckets_storage[i.unwrap()].m_bucket_state == Details::SetBucketState::Rehashed ) {
-                m_buckets_storage[i.unwrap()].m_bucket_state = Details::SetBucketState::Used;
+    auto first_used_index() const -> usize::NativeInt {
+        for ( usize::NativeInt group_begin = 0;; group_begin += ControlGroup::C_WIDTH ) {
+            auto const mask = ControlGroup::load(m_control_bytes + group_begin).match_used();
+            if ( mask != 0 ) {
+                return group_begin + __builtin_ctz(mask);
             }
         }
     }
 
-    auto lookup_with_hash(usize hash, auto predicate) const -> Bucket* {
-        if ( is_empty() ) {
-            return nullptr;
+    auto insert_new(usize::NativeInt mixed_hash, T&& value) -> void {
+        auto const index  = find_free_index(mixed_hash);
+        auto&      bucket = m_buckets_storage[index];
+
+        /* a deleted bucket is reused, the destructor of its previous value was already called by remove */
+        if ( m_control_bytes[index] == (u8::NativeInt)Details::SetControl::Deleted ) {
+            --m_deleted_count;
         }
 
-        /* iterate each bucket */
-        for ( ;; ) {
-            auto& bucket = m_buckets_storage[(hash % m_data_capacity).unwrap()];
+        m_control_bytes[index] = control_fragment(mixed_hash);
+        new (bucket.slot()) T(Cxx::move(value));
 
-            /* give to the predicate if it is used */
-            if ( Details::set_bucket_state_is_used(bucket.m_bucket_state) && predicate(*bucket.slot()) ) {
-                return &bucket;
+        /* update linked list of ordered values if is ordered */
+        if constexpr ( IsOrdered ) {
+            bucket.m_prev_bucket = m_collection_data.m_tail;
+            bucket.m_next_bucket = nullptr;
+            if ( m_collection_data.m_head == nullptr ) [[unlikely]] {
+                m_collection_data.m_head = &bucket;
+            } else {
+                m_collection_data.m_tail->m_next_bucket = &bucket;
             }
+            m_collection_data.m_tail = &bucket;
+        }
 
-            /* stop on end bucket */
-            if ( bucket.m_bucket_state != Details::SetBucketState::Used && bucket.m_bucket_state != Details::SetBucketState::Deleted ) {
-                return nullptr;
-            }
+        ++m_values_count;
+    }
 
-            /* double the hash and try again */
-            hash = hash_again(hash);
+    auto try_grow() -> ErrorOr<void> {
+        if ( m_data_capacity == 0 ) {
+            return try_rehash(C_MIN_CAPACITY);
         }
-    }
 
-    auto try_lookup_for_writing(T const& value) -> ErrorOr<Bucket*> {
-        if ( should_grow() ) {
-            try$(try_rehash(capacity() * 2));
+        /* when most of the used buckets are tombstones, cleaning them is enough */
+        if ( m_deleted_count >= m_values_count ) {
+            return try_rehash(m_data_capacity.unwrap());
+        } else {
+            return try_rehash(m_data_capacity.unwrap() * 2);
         }
+    }
 
-        /* pre-calculate the hash value */
-        auto hash = TTraits::hash(value);
+    auto try_rehash(usize::NativeInt new_capacity) -> ErrorOr<void> {
+        /* keep old references */
+        auto const old_control_bytes = m_control_bytes;
+        auto const old_buckets       = m_buckets_storage;
+        auto const old_capacity      = m_data_capacity.unwrap();
+        auto const old_values_count  = m_values_count;
+
+        /* allocate the new memory, the zero-filled control bytes are all empty */
+        auto const storage_ptr = try$(Details::allocator_alloc(m_allocator, size_in_bytes(new_capacity)));
+        m_control_bytes        = static_cast<u8::NativeInt*>(storage_ptr);
+        m_buckets_storage      = Cxx::bit_cast<Bucket*>(m_control_bytes + buckets_offset(new_capacity));
+        m_data_capacity        = new_capacity;
+        m_values_count         = 0;
+        m_deleted_count        = 0;
 
-        /* iterate each bucket to find the first usable */
-        Bucket* first_empty_bucket = nullptr;
-        for ( ;; ) {
-            auto& bucket = m_buckets_storage[(hash % m_data_capacity).unwrap()];
+        /* return if this set was emtpy */
+        if ( old_control_bytes == nullptr ) {
+            return {};
+        }
 
-            /* use the already used bucket if the value matches */
-            if ( Details::set_bucket_state_is_used(bucket.m_bucket_state) && TTraits::equals(*bucket.slot(), value) ) {
-                return &bucket;
+        /* move the values to the new memory, the ordered sets follow their list to keep the insertion order */
+        auto const move_to_new_buckets = [this](Bucket& bucket) {
+            insert_new(Details::set_mix_hash(TTraits::hash(*bucket.slot()).unwrap()), Cxx::move(*bucket.slot()));
+            bucket.slot()->~T();
+        };
+        if constexpr ( IsOrdered ) {
+            auto bucket       = m_collection_data.m_head;
+            m_collection_data = Details::OrderedCollectionData<Bucket>{ nullptr, nullptr };
+            for ( ; bucket != nullptr; bucket = bucket->m_next_bucket ) {
+                move_to_new_buckets(*bucket);
             }
-
-            /* use a new and empty bucket */
-            if ( !Details::set_bucket_state_is_used(bucket.m_bucket_state) ) {
-                if ( first_empty_bucket == nullptr ) {
-                    first_empty_bucket = &bucket;
-                }
-
-                if ( bucket.m_bucket_state != Details::SetBucketState::Deleted ) {
-                    return first_empty_bucket;
+        } else {
+            for ( usize::NativeInt i = 0; i < old_capacity; ++i ) {
+                if ( Details::set_control_is_used(old_control_bytes[i]) ) {
+                    move_to_new_buckets(old_buckets[i]);
                 }
             }
-
-            /* double the hash and try again */
-            hash = hash_again(hash);
         }
-    }
-    auto lookup_for_writing(T const& value) -> Bucket& {
-        return *must$(try_lookup_for_writing(value));
+        verify_equal$(m_values_count, old_values_count);
+
+        /* free the old memory */
+        Details::allocator_dealloc(m_allocator, old_control_bytes, size_in_bytes(old_capacity));
+        return {};
     }
 
     auto used_bucket_count() const -> usize {
         return m_values_count + m_deleted_count;
     }
 
-    auto should_grow() const -> bool {
-        return ((used_bucket_count() + 1) * 100) >= (m_data_capacity * LoadFactorPercent);
+    /**
+     * @brief Up to 7/8 of the buckets are used, so each probing meets an empty bucket soon
+     */
+    static constexpr auto growth_limit(usize::NativeInt capacity) -> usize::NativeInt {
+        return capacity - capacity / 8;
     }
 
-    static constexpr auto size_in_bytes(usize capacity) -> usize {
-        if constexpr ( IsOrdered ) {
-            return capacity * sizeof(Bucket);
-        } else {
-            return (capacity + 1) * sizeof(Bucket);
+    static constexpr auto buckets_count_for(usize values_count) -> usize::NativeInt {
+        auto buckets_count = C_MIN_CAPACITY;
+        while ( growth_limit(buckets_count) < values_count.unwrap() ) {
+            buckets_count *= 2;
         }
+        return buckets_count;
     }
 
-    auto remove(Bucket& bucket) -> bool {
-        verify$(Details::set_bucket_state_is_used(bucket.m_bucket_state));
-
-        delete_bucket(bucket);
-        --m_values_count;
-        ++m_deleted_count;
-        rehash_in_place_if_needed();
-        return true;
+    /**
+     * @brief The control bytes and the buckets share the same allocation, the control bytes come first
+     */
+    static constexpr auto buckets_offset(usize::NativeInt capacity) -> usize::NativeInt {
+        return (capacity + alignof(Bucket) - 1) & ~(alignof(Bucket) - 1);
+    }
+    static constexpr auto size_in_bytes(usize::NativeInt capacity) -> usize::NativeInt {
+        return buckets_offset(capacity) + capacity * sizeof(Bucket);
     }
 
-    auto delete_bucket(Bucket& bucket) {
-        bucket.slot()->~T();
-        bucket.m_bucket_state = Details::SetBucketState::Deleted;
+    auto remove_bucket(Bucket& bucket) -> void {
+        auto const index = static_cast<usize::NativeInt>(&bucket - m_buckets_storage);
+        verify$(Details::set_control_is_used(m_control_bytes[index]));
 
+        bucket.slot()->~T();
         if constexpr ( IsOrdered ) {
             if ( bucket.m_prev_bucket != nullptr ) {
                 bucket.m_prev_bucket->m_next_bucket = bucket.m_next_bucket;
@@ -935,29 +927,26 @@ private:
                 m_collection_data.m_tail = bucket.m_prev_bucket;
             }
         }
-    }
 
-    auto hash_again(usize key) const -> usize {
-        usize magic = 0xba5edb01;
-        if ( key == magic ) {
-            return 0;
-        }
-        if ( key == 0 ) {
-            key = magic;
+        /* a group which still has an empty bucket never let the probing continue, so no tombstone is needed */
+        auto const group_begin = index & ~(ControlGroup::C_WIDTH - 1);
+        if ( ControlGroup::load(m_control_bytes + group_begin).match_empty() != 0 ) {
+            m_control_bytes[index] = (u8::NativeInt)Details::SetControl::Empty;
+        } else {
+            m_control_bytes[index] = (u8::NativeInt)Details::SetControl::Deleted;
+            ++m_deleted_count;
         }
-
-        key ^= key << 13;
-        key ^= key >> 17;
-        key ^= key << 5;
-        return key;
+        --m_values_count;
     }
 
 private:
+    u8::NativeInt* m_control_bytes   = nullptr;
     Bucket*        m_buckets_storage = nullptr;
     DataCollection m_collection_data = {};
     usize          m_data_capacity   = 0;
     usize          m_values_count    = 0;
     usize          m_deleted_count   = 0;
+    Allocator*     m_allocator       = nullptr;
 };
 
 namespace Cxx {
@@ -31,8 +31,12 @@ auto String::from_view(StringView string_view) -> String {
     return must$(try_from_view(string_view));
 }
 
+auto String::from_view(StringView string_view, Allocator& allocator) -> String {
+    return must$(try_from_view(string_view, allocator));
+}
+
 auto String::try_empty() -> ErrorOr<String> {
-    return try_from_view(""sv);
+    return String{};
 }
 
 auto String::try_from_other(String const& rhs) -> ErrorOr<String> {
@@ -40,15 +44,37 @@ auto String::try_from_other(String const& rhs) -> ErrorOr<String> {
 }
 
 auto String::try_from_view(StringView string_view) -> ErrorOr<String> {
-    return String{ try$(StringStorage::try_from_view(string_view)) };
+    return try_from_view_with(string_view, nullptr);
+}
+
+auto String::try_from_view(StringView string_view, Allocator& allocator) -> ErrorOr<String> {
+    return try_from_view_with(string_view, &allocator);
+}
+
+auto String::try_from_view_with(StringView string_view, Allocator* allocator) -> ErrorOr<String> {
+    if ( string_view.is_null() )
+        return Error::from_code(ErrorCode::EmptyData);
+    if ( string_view.len() > C_INLINE_CAPACITY )
+        return String{ try$(StringStorage::try_from_view(string_view, allocator)) };
+
+    /* short strings are copied into the object, the constructor already terminated them */
+    auto string                          = String{};
+    string.m_representation.m_inline_len = static_cast<u8::NativeInt>(string_view.len().unwrap());
+    Cxx::memcpy(string.m_representation.m_inline_chars, string_view.as_cstr(), string_view.len() * sizeof(char));
+    return string;
 }
 
 auto String::clone() const -> String {
-    return String{ m_string_storage_ref.clone() };
+    if ( !is_inline() )
+        m_representation.m_string_storage_ptr->add_strong_ref();
+
+    auto string             = String{};
+    string.m_representation = m_representation;
+    return string;
 }
 
 String::String(String&& rhs)
-    : m_string_storage_ref(Cxx::move(rhs.m_string_storage_ref)) {
+    : m_representation(Cxx::exchange(rhs.m_representation, Representation{})) {
 }
 
 auto String::operator=(String&& rhs) -> String& {
@@ -57,8 +83,13 @@ auto String::operator=(String&& rhs) -> String& {
     return *this;
 }
 
+String::~String() {
+    if ( !is_inline() )
+        m_representation.m_string_storage_ptr->remove_strong_ref();
+}
+
 auto String::swap(String& rhs) -> void {
-    Cxx::swap(m_string_storage_ref, rhs.m_string_storage_ref);
+    Cxx::swap(m_representation, rhs.m_representation);
 }
 
 auto String::at(usize index) const -> char const& {
@@ -193,7 +224,7 @@ auto String::try_to_lowercase() const -> ErrorOr<String> {
         else
             try$(string_builder.try_append(c));
     }
-    return string_builder.try_to_string();
+    return string_builder.try_into_string();
 }
 
 auto String::to_uppercase() const -> String {
@@ -208,7 +239,7 @@ auto String::try_to_uppercase() const -> ErrorOr<String> {
         else
             try$(string_builder.try_append(c));
     }
-    return string_builder.try_to_string();
+    return string_builder.try_into_string();
 }
 
 auto String::to_reverse() const -> String {
@@ -220,7 +251,7 @@ auto String::try_to_reverse() const -> ErrorOr<String> {
     for ( auto const c : reverse_iter() )
         try$(string_builder.try_append(c));
 
-    return string_builder.try_to_string();
+    return string_builder.try_into_string();
 }
 
 auto String::operator==(const String& rhs) const -> bool {
@@ -300,29 +331,48 @@ auto String::reverse_iter() const -> ConstReverseIteratorWrapper {
 }
 
 auto String::hash_code() const -> usize {
-    return as_string_view().hash_code();
+    if ( is_inline() )
+        return as_string_view().hash_code();
+    else
+        return m_representation.m_string_storage_ptr->hash_code();
 }
 
 auto String::as_cstr() const -> char const* {
-    return m_string_storage_ref->storage_ptr();
+    if ( is_inline() )
+        return m_representation.m_inline_chars;
+    else
+        return m_representation.m_string_storage_ptr->storage_ptr();
 }
 
 auto String::len() const -> usize {
-    return m_string_storage_ref->len();
+    if ( is_inline() )
+        return m_representation.m_inline_len;
+    else
+        return m_representation.m_string_storage_ptr->len();
 }
 
 auto String::count() const -> usize {
-    return m_string_storage_ref->len();
+    return len();
 }
 
 auto String::is_empty() const -> bool {
-    return m_string_storage_ref->is_empty();
+    return len() == 0;
 }
 
 auto String::as_string_view() const -> StringView {
     return StringView::from_raw_parts(as_cstr(), len());
 }
 
-String::String(NonNullRef<StringStorage> string_storage)
-    : m_string_storage_ref(Cxx::move(string_storage)) {
+auto String::is_inline() const -> bool {
+    return m_representation.m_inline_len != C_STORAGE_TAG;
+}
+
+String::String()
+    : m_representation{} {
+}
+
+String::String(StringStorage* string_storage)
+    : m_representation{} {
+    m_representation.m_string_storage_ptr = string_storage;
+    m_representation.m_inline_len         = C_STORAGE_TAG;
 }
@@ -14,7 +14,6 @@
 
 #include <CCLang/Forward.hh>
 
-#include <CCLang/Alloc/NonNullRef.hh>
 #include <CCLang/Alloc/StringStorage.hh>
 #include <CCLang/Core/ErrorOr.hh>
 #include <CCLang/Core/TypeTraits.hh>
@@ -43,6 +42,7 @@ public:
     static auto empty() -> String;
     static auto from_other(String const& rhs) -> String;
     static auto from_view(StringView string_view) -> String;
+    static auto from_view(StringView string_view, Allocator& allocator) -> String;
 
     /**
      * @brief Error safe Factory functions
@@ -50,6 +50,7 @@ public:
     static auto try_empty() -> ErrorOr<String>;
     static auto try_from_other(String const& rhs) -> ErrorOr<String>;
     static auto try_from_view(StringView string_view) -> ErrorOr<String>;
+    static auto try_from_view(StringView string_view, Allocator& allocator) -> ErrorOr<String>;
 
     /**
      * @brief Move constructor and move assignment
@@ -57,10 +58,10 @@ public:
     String(String&& rhs);
     auto operator=(String&& rhs) -> String&;
 
-    ~String() = default;
+    ~String();
 
     /**
-     * @brief Cloning only increments strong references to the memory
+     * @brief Cloning only increments strong references to the memory, inline strings are copied
      */
     auto clone() const -> String;
 
@@ -194,7 +195,7 @@ public:
     auto reverse_iter() const -> ConstReverseIteratorWrapper;
 
     /**
-     * @brief Hashing support
+     * @brief Hashing support, cached for the strings which are not inline
      */
     auto hash_code() const -> usize;
 
@@ -209,11 +210,37 @@ public:
 
     auto as_string_view() const -> StringView;
 
+    /**
+     * @brief Returns whether the chars are stored into this object instead of the heap
+     */
+    auto is_inline() const -> bool;
+
 private:
-    explicit String(NonNullRef<StringStorage>);
+    friend class StringBuilder;
+
+    /**
+     * @brief Strings up to this length are stored without allocations, a String stays 16 bytes long
+     */
+    static constexpr usize::NativeInt C_INLINE_CAPACITY = 14;
+    static constexpr u8::NativeInt    C_STORAGE_TAG     = 0xff;
+
+    struct Representation {
+        union {
+            StringStorage* m_string_storage_ptr;
+            char           m_inline_chars[C_INLINE_CAPACITY + 1];
+        };
+
+        /* the count of the inline chars, or C_STORAGE_TAG when they are into m_string_storage_ptr */
+        u8::NativeInt m_inline_len;
+    };
+
+    String();
+    explicit String(StringStorage*);
+
+    static auto try_from_view_with(StringView string_view, Allocator* allocator) -> ErrorOr<String>;
 
 private:
-    NonNullRef<StringStorage> m_string_storage_ref;
+    Representation m_representation;
 };
 
 template<>
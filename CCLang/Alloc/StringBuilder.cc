@@ -12,6 +12,10 @@
 
 #include <CCLang/Alloc/StringBuilder.hh>
 
+#include <CCLang/Alloc/Allocator.hh>
+#include <CCLang/Alloc/StringStorage.hh>
+#include <CCLang/Core/Assertions.hh>
+#include <CCLang/Lang/Cxx.hh>
 #include <CCLang/Lang/Must.hh>
 #include <CCLang/Lang/Try.hh>
 
@@ -19,10 +23,25 @@ auto StringBuilder::empty() -> StringBuilder {
     return StringBuilder{};
 }
 
+auto StringBuilder::with_allocator(Allocator& allocator) -> StringBuilder {
+    auto string_builder          = StringBuilder{};
+    string_builder.m_allocator   = &allocator;
+    string_builder.m_full_chunks = Vector<Chunk>::with_allocator(allocator);
+    return string_builder;
+}
+
 auto StringBuilder::with_capacity(usize capacity) -> StringBuilder {
     return must$(try_with_capacity(capacity));
 }
 
+auto StringBuilder::chunked(usize chunk_size) -> StringBuilder {
+    verify_greater$(chunk_size, 0);
+
+    auto string_builder         = StringBuilder{};
+    string_builder.m_chunk_size = chunk_size;
+    return string_builder;
+}
+
 auto StringBuilder::from_other(StringBuilder const& rhs) -> StringBuilder {
     return must$(try_from_other(rhs));
 }
@@ -35,14 +54,18 @@ auto StringBuilder::try_with_capacity(usize capacity) -> ErrorOr<StringBuilder>
 
 auto StringBuilder::try_from_other(StringBuilder const& rhs) -> ErrorOr<StringBuilder> {
     auto string_builder = try$(try_with_capacity(rhs.len()));
-    for ( auto const& c : rhs.as_string_view() )
-        try$(string_builder.try_append(c));
-
+    try$(string_builder.try_append_content_of(rhs));
     return string_builder;
 }
 
 StringBuilder::StringBuilder(StringBuilder&& rhs)
-    : m_char_vector{ Cxx::move(rhs.m_char_vector) } {
+    : m_storage_ptr{ Cxx::exchange(rhs.m_storage_ptr, nullptr) }
+    , m_capacity{ Cxx::exchange(rhs.m_capacity, 0) }
+    , m_tail_len{ Cxx::exchange(rhs.m_tail_len, 0) }
+    , m_len{ Cxx::exchange(rhs.m_len, 0) }
+    , m_chunk_size{ Cxx::exchange(rhs.m_chunk_size, 0) }
+    , m_full_chunks{ Cxx::move(rhs.m_full_chunks) }
+    , m_allocator{ Cxx::exchange(rhs.m_allocator, nullptr) } {
 }
 
 auto StringBuilder::operator=(StringBuilder&& rhs) -> StringBuilder& {
@@ -51,8 +74,18 @@ auto StringBuilder::operator=(StringBuilder&& rhs) -> StringBuilder& {
     return *this;
 }
 
+StringBuilder::~StringBuilder() {
+    clear();
+}
+
 auto StringBuilder::swap(StringBuilder& rhs) -> void {
-    m_char_vector.swap(rhs.m_char_vector);
+    Cxx::swap(m_storage_ptr, rhs.m_storage_ptr);
+    Cxx::swap(m_capacity, rhs.m_capacity);
+    Cxx::swap(m_tail_len, rhs.m_tail_len);
+    Cxx::swap(m_len, rhs.m_len);
+    Cxx::swap(m_chunk_size, rhs.m_chunk_size);
+    m_full_chunks.swap(rhs.m_full_chunks);
+    Cxx::swap(m_allocator, rhs.m_allocator);
 }
 
 auto StringBuilder::clone() const -> StringBuilder {
@@ -64,11 +97,19 @@ auto StringBuilder::try_clone() const -> ErrorOr<StringBuilder> {
 }
 
 auto StringBuilder::clear() -> void {
-    m_char_vector.clear();
+    clear_keep_capacity();
+
+    release_storage(Cxx::exchange(m_storage_ptr, nullptr), m_capacity);
+    m_capacity = 0;
 }
 
 auto StringBuilder::clear_keep_capacity() -> void {
-    m_char_vector.clear_keep_capacity();
+    for ( auto const& chunk : m_full_chunks )
+        release_storage(chunk.m_storage_ptr, chunk.m_capacity);
+    m_full_chunks.clear_keep_capacity();
+
+    m_tail_len = 0;
+    m_len      = 0;
 }
 
 auto StringBuilder::append(char c) -> void {
@@ -76,7 +117,13 @@ auto StringBuilder::append(char c) -> void {
 }
 
 auto StringBuilder::try_append(char c) -> ErrorOr<void> {
-    return m_char_vector.try_append(c);
+    if ( m_tail_len == m_capacity ) [[unlikely]]
+        try$(try_ensure_tail_space(1));
+
+    tail_chars()[m_tail_len.unwrap()] = c;
+    ++m_tail_len;
+    ++m_len;
+    return {};
 }
 
 auto StringBuilder::append(StringView string_view) -> void {
@@ -87,10 +134,25 @@ auto StringBuilder::try_append(StringView string_view) -> ErrorOr<void> {
     if ( string_view.is_null_or_empty() )
         return {};
 
-    /* first ensure the right capacity then append unchecked for speed */
-    try$(try_ensure_capacity(len() + string_view.len()));
-    for ( auto const c : string_view )
-        m_char_vector.append_unchecked(c);
+    /* the chunked builders fill up the tail before moving to the next chunk */
+    auto chars_ptr   = string_view.as_cstr();
+    auto chars_count = string_view.len();
+    while ( chars_count > 0 ) {
+        if ( is_chunked() ) {
+            if ( m_tail_len == m_capacity )
+                try$(try_ensure_tail_space(chars_count));
+        } else {
+            try$(try_ensure_tail_space(chars_count));
+        }
+
+        auto const copy_count = usize::min(chars_count, m_capacity - m_tail_len);
+        Cxx::memcpy(tail_chars() + m_tail_len.unwrap(), chars_ptr, copy_count * sizeof(char));
+
+        m_tail_len += copy_count;
+        m_len += copy_count;
+        chars_ptr += copy_count.unwrap();
+        chars_count -= copy_count;
+    }
     return {};
 }
 
@@ -101,12 +163,15 @@ auto StringBuilder::try_append(u32) -> ErrorOr<void> {
     return Error::from_code(ErrorCode::Unimplemented);
 }
 
-auto StringBuilder::ensure_capacity(usize capacity) {
+auto StringBuilder::ensure_capacity(usize capacity) -> void {
     must$(try_ensure_capacity(capacity));
 }
 
 auto StringBuilder::try_ensure_capacity(usize capacity) -> ErrorOr<void> {
-    return m_char_vector.try_ensure_capacity(capacity);
+    if ( capacity <= m_len )
+        return {};
+
+    return try_ensure_tail_space(capacity - m_len);
 }
 
 auto StringBuilder::to_string() const -> String {
@@ -114,17 +179,145 @@ auto StringBuilder::to_string() const -> String {
 }
 
 auto StringBuilder::try_to_string() const -> ErrorOr<String> {
+    if ( !m_full_chunks.is_empty() ) {
+        auto string_builder = try$(try_from_other(*this));
+        return string_builder.try_into_string();
+    }
     return String::try_from_view(as_string_view());
 }
 
+auto StringBuilder::into_string() -> String {
+    return must$(try_into_string());
+}
+
+auto StringBuilder::try_into_string() -> ErrorOr<String> {
+    /* the short strings are kept inline by String, so there is nothing to adopt */
+    if ( m_len <= String::C_INLINE_CAPACITY ) {
+        auto string = try$(try_to_string());
+        clear();
+        return string;
+    }
+
+    try$(try_join_chunks());
+
+    /* terminate the chars and give back the unused capacity, then build the header into the room left for it */
+    tail_chars()[m_len.unwrap()] = '\0';
+    if ( m_capacity != m_len ) {
+        auto const storage_ptr = try$(Details::allocator_realloc(m_allocator,
+                                                                 m_storage_ptr,
+                                                                 StringStorage::alloc_size(m_capacity),
+                                                                 StringStorage::alloc_size(m_len)));
+        m_storage_ptr          = static_cast<u8::NativeInt*>(storage_ptr);
+        m_capacity             = m_len;
+    }
+
+    auto const string_storage = StringStorage::from_adopted(Cxx::exchange(m_storage_ptr, nullptr), m_len, m_allocator);
+    m_capacity                = 0;
+    m_tail_len                = 0;
+    m_len                     = 0;
+    return String{ string_storage };
+}
+
 auto StringBuilder::len() const -> usize {
-    return m_char_vector.count();
+    return m_len;
 }
 
 auto StringBuilder::is_empty() const -> bool {
     return len() == 0;
 }
 
+auto StringBuilder::is_chunked() const -> bool {
+    return m_chunk_size > 0;
+}
+
+auto StringBuilder::as_string_view() -> StringView {
+    must$(try_join_chunks());
+    return const_cast<StringBuilder const*>(this)->as_string_view();
+}
+
 auto StringBuilder::as_string_view() const -> StringView {
-    return StringView::from_raw_parts(m_char_vector.raw_data(), len());
+    verify_with_msg$(m_full_chunks.is_empty(), "StringBuilder - Tried to view the chunks of a const chunked builder");
+
+    if ( m_storage_ptr == nullptr )
+        return ""sv;
+    return StringView::from_raw_parts(tail_chars(), m_len);
+}
+
+auto StringBuilder::try_ensure_tail_space(usize count) -> ErrorOr<void> {
+    if ( m_capacity - m_tail_len >= count )
+        return {};
+
+    if ( !is_chunked() ) {
+        /* grow geometrically, the buffer is resized in place when the allocator is able to */
+        auto const new_capacity = usize::max(m_tail_len + count, usize::max(m_capacity + m_capacity / 2, C_MIN_CAPACITY));
+        return try_resize_tail(new_capacity);
+    }
+
+    /* the filled tail becomes a chunk, the chars already written are never moved */
+    if ( m_tail_len > 0 ) {
+        try$(m_full_chunks.try_append(Chunk{ m_storage_ptr, m_tail_len, m_capacity }));
+    } else {
+        release_storage(m_storage_ptr, m_capacity);
+    }
+
+    m_storage_ptr = nullptr;
+    m_capacity    = 0;
+    m_tail_len    = 0;
+    return try_resize_tail(usize::max(count, m_chunk_size));
+}
+
+auto StringBuilder::try_resize_tail(usize capacity) -> ErrorOr<void> {
+    void* storage_ptr;
+    if ( m_storage_ptr == nullptr ) {
+        storage_ptr = try$(Details::allocator_alloc(m_allocator, StringStorage::alloc_size(capacity)));
+    } else {
+        storage_ptr = try$(Details::allocator_realloc(m_allocator,
+                                                      m_storage_ptr,
+                                                      StringStorage::alloc_size(m_capacity),
+                                                      StringStorage::alloc_size(capacity)));
+    }
+
+    m_storage_ptr = static_cast<u8::NativeInt*>(storage_ptr);
+    m_capacity    = capacity;
+    return {};
+}
+
+auto StringBuilder::try_join_chunks() -> ErrorOr<void> {
+    if ( m_full_chunks.is_empty() )
+        return {};
+
+    /* each char is copied once into a buffer which fits exactly all of them */
+    auto const storage_ptr = static_cast<u8::NativeInt*>(try$(Details::allocator_alloc(m_allocator, StringStorage::alloc_size(m_len))));
+    auto       chars_ptr   = reinterpret_cast<char*>(storage_ptr + sizeof(StringStorage));
+    for ( auto const& chunk : m_full_chunks ) {
+        Cxx::memcpy(chars_ptr, chunk.m_storage_ptr + sizeof(StringStorage), chunk.m_len * sizeof(char));
+        chars_ptr += chunk.m_len.unwrap();
+        release_storage(chunk.m_storage_ptr, chunk.m_capacity);
+    }
+    Cxx::memcpy(chars_ptr, tail_chars(), m_tail_len * sizeof(char));
+    release_storage(m_storage_ptr, m_capacity);
+    m_full_chunks.clear_keep_capacity();
+
+    m_storage_ptr = storage_ptr;
+    m_capacity    = m_len;
+    m_tail_len    = m_len;
+    return {};
+}
+
+auto StringBuilder::try_append_content_of(StringBuilder const& rhs) -> ErrorOr<void> {
+    for ( auto const& chunk : rhs.m_full_chunks )
+        try$(try_append(StringView::from_raw_parts(reinterpret_cast<char const*>(chunk.m_storage_ptr + sizeof(StringStorage)), chunk.m_len)));
+
+    if ( rhs.m_storage_ptr != nullptr )
+        try$(try_append(StringView::from_raw_parts(rhs.tail_chars(), rhs.m_tail_len)));
+    return {};
+}
+
+auto StringBuilder::release_storage(u8::NativeInt* storage_ptr, usize capacity) -> void {
+    if ( storage_ptr != nullptr )
+        Details::allocator_dealloc(m_allocator, storage_ptr, StringStorage::alloc_size(capacity));
+}
+
+auto StringBuilder::tail_chars() const -> char* {
+    return reinterpret_cast<char*>(m_storage_ptr + sizeof(StringStorage));
 }
@@ -23,13 +23,27 @@
 #include <CCLang/Lang/IntTypes.hh>
 #include <CCLang/Lang/StringView.hh>
 
+/**
+ * @brief Mutable buffer of chars which builds Strings.
+ * By default the chars are kept into a single allocation grown in place, which into_string() adopts as String storage
+ * without copying them. The chunked() builders instead keep the chars into fixed size chunks, for the very large
+ * outputs which would pay the growth of a single buffer, and join them with a single copy only when needed
+ */
 class StringBuilder final : public DenyCopy {
+public:
+    /**
+     * @brief Size of the chunks of the chunked() builders when not specified
+     */
+    static constexpr usize::NativeInt C_DEFAULT_CHUNK_SIZE = 64 * 1024;
+
 public:
     /**
      * @brief Non-Error safe factory functions
      */
     static auto empty() -> StringBuilder;
+    static auto with_allocator(Allocator& allocator) -> StringBuilder;
     static auto with_capacity(usize capacity) -> StringBuilder;
+    static auto chunked(usize chunk_size = C_DEFAULT_CHUNK_SIZE) -> StringBuilder;
     static auto from_other(StringBuilder const& rhs) -> StringBuilder;
 
     /**
@@ -44,7 +58,7 @@ public:
     StringBuilder(StringBuilder&& rhs);
     auto operator=(StringBuilder&& rhs) -> StringBuilder&;
 
-    ~StringBuilder() = default;
+    ~StringBuilder();
 
     /**
      * @brief Swaps in O(1) the content of this StringBuilder with another
@@ -52,7 +66,7 @@ public:
     auto swap(StringBuilder& rhs) -> void;
 
     /**
-     * @brief Deep cloning
+     * @brief Deep cloning, the clone always allocates from the global heap
      */
     auto clone() const -> StringBuilder;
     auto try_clone() const -> ErrorOr<StringBuilder>;
@@ -82,9 +96,9 @@ public:
     auto try_append(u32 rune) -> ErrorOr<void>;
 
     /**
-     * @brief Ensures that this StringBuilder could store at least <capacity>
+     * @brief Ensures that this StringBuilder could store at least <capacity> without allocating
      */
-    auto ensure_capacity(usize capacity);
+    auto ensure_capacity(usize capacity) -> void;
     auto try_ensure_capacity(usize capacity) -> ErrorOr<void>;
 
     /**
@@ -93,19 +107,57 @@ public:
     auto to_string() const -> String;
     auto try_to_string() const -> ErrorOr<String>;
 
+    /**
+     * @brief Moves the content of this StringBuilder into a String, which adopts the buffer without copying the
+     * chars. This StringBuilder is left empty
+     */
+    auto into_string() -> String;
+    auto try_into_string() -> ErrorOr<String>;
+
     /**
      * @brief Getters
      */
     auto len() const -> usize;
     auto is_empty() const -> bool;
+    auto is_chunked() const -> bool;
 
+    /**
+     * @brief Returns a view of the content, the chunks of a chunked() builder are joined by the mutable version
+     */
+    auto as_string_view() -> StringView;
     auto as_string_view() const -> StringView;
 
 private:
+    /**
+     * @brief Filled chunk of a chunked() builder, laid out like the tail buffer
+     */
+    struct Chunk {
+        u8::NativeInt* m_storage_ptr;
+        usize          m_len;
+        usize          m_capacity;
+    };
+
+    static constexpr usize::NativeInt C_MIN_CAPACITY = 16;
+
     explicit constexpr StringBuilder() = default;
 
+    auto try_ensure_tail_space(usize count) -> ErrorOr<void>;
+    auto try_resize_tail(usize capacity) -> ErrorOr<void>;
+    auto try_join_chunks() -> ErrorOr<void>;
+    auto try_append_content_of(StringBuilder const& rhs) -> ErrorOr<void>;
+    auto release_storage(u8::NativeInt* storage_ptr, usize capacity) -> void;
+
+    auto tail_chars() const -> char*;
+
 private:
-    Vector<char> m_char_vector = Vector<char>::empty();
+    /* the tail buffer keeps the room for the StringStorage header before the chars */
+    u8::NativeInt* m_storage_ptr = nullptr;
+    usize          m_capacity    = 0;
+    usize          m_tail_len    = 0;
+    usize          m_len         = 0;
+    usize          m_chunk_size  = 0;
+    Vector<Chunk>  m_full_chunks = Vector<Chunk>::empty();
+    Allocator*     m_allocator   = nullptr;
 };
 
 
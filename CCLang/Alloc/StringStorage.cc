@@ -12,22 +12,55 @@
 
 #include <CCLang/Alloc/StringStorage.hh>
 
-#include <CCLang/Alloc/New.hh>
-#include <CCLang/Alloc/NonNullRef.hh>
+#include <CCLang/Alloc/Allocator.hh>
+#include <CCLang/Core/Assertions.hh>
 #include <CCLang/Lang/Cxx.hh>
 #include <CCLang/Lang/StringView.hh>
 #include <CCLang/Lang/Try.hh>
 
-auto StringStorage::try_from_view(StringView string_view) -> ErrorOr<NonNullRef<StringStorage>> {
+auto StringStorage::try_from_view(StringView string_view, Allocator* allocator) -> ErrorOr<StringStorage*> {
     if ( string_view.is_null() )
         return Error::from_code(ErrorCode::EmptyData);
 
-    auto storage_box = try$(Box<char[]>::try_from_len(string_view.len()));
-    return NonNullRef<StringStorage>::try_from_adopt(new (nothrow) StringStorage(Cxx::move(storage_box), string_view));
+    auto const storage_ptr = try$(Details::allocator_alloc(allocator, alloc_size(string_view.len())));
+    return new (storage_ptr) StringStorage(string_view, allocator);
+}
+
+auto StringStorage::from_adopted(void* storage_ptr, usize char_count, Allocator* allocator) -> StringStorage* {
+    verify_not_null$(storage_ptr);
+    return new (storage_ptr) StringStorage(char_count, allocator);
+}
+
+auto StringStorage::add_strong_ref() const -> void {
+    auto const old_strong_count = m_strong_ref_count.atomic_fetch_add(1, MemOrder::Relaxed);
+    verify_greater_equal_with_msg$(old_strong_count, 1, "StringStorage - Tried to add_strong_ref() to a dead reference");
+}
+
+auto StringStorage::remove_strong_ref() const -> void {
+    auto const old_strong_count = m_strong_ref_count.atomic_fetch_sub(1, MemOrder::Total);
+    verify_greater_equal_with_msg$(old_strong_count, 1, "StringStorage - Tried to remove_strong_ref() from a dead reference");
+
+    /* the chars follow the header, so the allocation is released with its real size */
+    if ( old_strong_count - 1 == 0 ) {
+        auto const size      = alloc_size(m_char_count);
+        auto const allocator = m_allocator;
+        this->~StringStorage();
+        Details::allocator_dealloc(allocator, const_cast<StringStorage*>(this), size);
+    }
+}
+
+auto StringStorage::hash_code() const -> usize {
+    /* racing threads compute the same value, so the relaxed order is enough */
+    auto hash_code = m_hash_code.atomic_load(MemOrder::Relaxed);
+    if ( hash_code == 0 ) {
+        hash_code = StringView::from_raw_parts(storage_ptr(), m_char_count).hash_code();
+        m_hash_code.atomic_store(hash_code, MemOrder::Relaxed);
+    }
+    return hash_code;
 }
 
 auto StringStorage::storage_ptr() const -> char const* {
-    return m_storage_box.as_ptr();
+    return reinterpret_cast<char const*>(this + 1);
 }
 
 auto StringStorage::len() const -> usize {
@@ -38,8 +71,23 @@ auto StringStorage::is_empty() const -> bool {
     return m_char_count == 0;
 }
 
-StringStorage::StringStorage(Box<char[]> storage_box, StringView string_view)
-    : m_storage_box(Cxx::move(storage_box))
-    , m_char_count(string_view.len()) {
-    Cxx::memcpy(m_storage_box.as_ptr(), string_view.as_cstr(), string_view.len() * sizeof(char));
+auto StringStorage::strong_ref_count() const -> usize {
+    return m_strong_ref_count.atomic_load(MemOrder::Total);
+}
+
+StringStorage::StringStorage(StringView string_view, Allocator* allocator)
+    : m_char_count(string_view.len())
+    , m_allocator(allocator) {
+    /* the allocation is clean, so the chars are already null-terminated */
+    Cxx::memcpy(const_cast<char*>(storage_ptr()), string_view.as_cstr(), string_view.len() * sizeof(char));
+}
+
+StringStorage::StringStorage(usize char_count, Allocator* allocator)
+    : m_char_count(char_count)
+    , m_allocator(allocator) {
+    verify_equal_with_msg$(storage_ptr()[char_count.unwrap()], '\0', "StringStorage - Adopted chars are not null-terminated");
+}
+
+auto StringStorage::alloc_size(usize char_count) -> usize {
+    return char_count + sizeof(StringStorage) + 1;
 }
@@ -14,20 +14,44 @@
 
 #include <CCLang/Forward.hh>
 
-#include <CCLang/Alloc/Box.hh>
-#include <CCLang/Alloc/NonNullRef.hh>
-#include <CCLang/Alloc/RefCounted.hh>
 #include <CCLang/Core/ErrorOr.hh>
+#include <CCLang/Lang/DenyCopy.hh>
+#include <CCLang/Lang/DenyMove.hh>
 #include <CCLang/Lang/IntTypes.hh>
 
-class StringStorage final : public RefCounted {
+/**
+ * @brief Heap storage of the Strings too long to be kept inline.
+ * The header and the null-terminated chars live into a single allocation, obtained from the given Allocator or from
+ * the global heap when it is nullptr
+ */
+class StringStorage final : public DenyCopy, public DenyMove {
 public:
     /**
      * @brief Error safe Factory functions
      */
-    static auto try_from_view(StringView) -> ErrorOr<NonNullRef<StringStorage>>;
+    static auto try_from_view(StringView, Allocator*) -> ErrorOr<StringStorage*>;
 
-    ~StringStorage() = default;
+    /**
+     * @brief Builds the header in place at the start of an allocation of alloc_size(char_count) bytes which already
+     * contains the null-terminated chars after sizeof(StringStorage) bytes, taking the ownership of it
+     */
+    static auto from_adopted(void* storage_ptr, usize char_count, Allocator*) -> StringStorage*;
+
+    /**
+     * @brief Returns the size of the allocation which keeps the header and <char_count> null-terminated chars
+     */
+    static auto alloc_size(usize char_count) -> usize;
+
+    /**
+     * @brief Reference counting, the storage is released with the last reference
+     */
+    auto add_strong_ref() const -> void;
+    auto remove_strong_ref() const -> void;
+
+    /**
+     * @brief Hashing support, computed on the first request
+     */
+    auto hash_code() const -> usize;
 
     /**
      * @brief Getters
@@ -37,10 +61,17 @@ public:
 
     auto is_empty() const -> bool;
 
+    [[nodiscard]]
+    auto strong_ref_count() const -> usize;
+
 private:
-    explicit StringStorage(Box<char[]>, StringView);
+    explicit StringStorage(StringView, Allocator*);
+    explicit StringStorage(usize char_count, Allocator*);
+    ~StringStorage() = default;
 
 private:
-    Box<char[]> m_storage_box;
-    usize       m_char_count = 0;
+    mutable usize m_strong_ref_count = 1;
+    mutable usize m_hash_code        = 0;
+    usize         m_char_count       = 0;
+    Allocator*    m_allocator        = nullptr;
 };
@@ -17,6 +17,7 @@
 #include <CCLang/Alloc/StringBuilder.hh>
 #include <CCLang/Alloc/Text/FormatLexer.hh>
 #include <CCLang/Alloc/Text/FormatParser.hh>
+#include <CCLang/Alloc/Text/FormatString.hh>
 #include <CCLang/Alloc/Text/Formatter.hh>
 #include <CCLang/Core/ErrorOr.hh>
 #include <CCLang/Lang/Cxx.hh>
@@ -64,3 +65,54 @@ auto format(StringBuilder& string_builder, FormatLexer& format_lexer, T const& f
 }
 
 auto format(StringBuilder& string_builder, FormatLexer& format_lexer) -> ErrorOr<void>;
+
+namespace Details {
+
+/**
+ * @brief Writes the literal run at index into StringBuilder, unescaping the doubled braces only when needed
+ */
+template<typename... FormatArgs>
+auto format_literal(StringBuilder& string_builder, FormatString<FormatArgs...> const& format_string, usize::NativeInt index) -> ErrorOr<void> {
+    if ( format_string.literal(index).m_len == 0 )
+        return {};
+
+    if ( format_string.literal(index).m_has_escapes )
+        try$(format(string_builder, format_string.literal_view(index)));
+    else
+        try$(string_builder.try_append(format_string.literal_view(index)));
+    return {};
+}
+
+template<usize::NativeInt Index, typename... FormatArgs>
+auto format_placeholders(StringBuilder& string_builder, FormatString<FormatArgs...> const& format_string) -> ErrorOr<void> {
+    try$(format_literal(string_builder, format_string, Index));
+    return {};
+}
+
+/**
+ * @brief Writes the literal preceding the placeholder at Index, formats first_arg with the pre-parsed specification and recurse
+ */
+template<usize::NativeInt Index, typename... FormatArgs, typename T, typename... Args>
+auto format_placeholders(StringBuilder&                     string_builder,
+                         FormatString<FormatArgs...> const& format_string,
+                         T const&                           first_arg,
+                         Args const&... variadic_args) -> ErrorOr<void> {
+    try$(format_literal(string_builder, format_string, Index));
+
+    auto formatter = Formatter<T>::from_parser_result(string_builder, format_string.placeholder(Index).as_parser_result());
+    try$(formatter.format(first_arg));
+
+    try$(format_placeholders<Index + 1>(string_builder, format_string, variadic_args...));
+    return {};
+}
+
+} /* namespace Details */
+
+/**
+ * @brief Formats the given string literal, parsed and validated at compile time, into the given StringBuilder
+ */
+template<typename... Args>
+auto format(StringBuilder& string_builder, FormatString<TypeIdentity<Args>...> format_string, Args const&... variadic_args) -> ErrorOr<void> {
+    try$(Details::format_placeholders<0>(string_builder, format_string, variadic_args...));
+    return {};
+}
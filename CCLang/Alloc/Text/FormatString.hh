@@ -0,0 +1,303 @@
+/**
+ * @brief
+ * This file is part of the MeetiX Operating System.
+ * Copyright (c) 2017-2022, Marco Cicognani (marco.cicognani@meetixos.org)
+ *
+ * @developers
+ * Marco Cicognani (marco.cicognani@meetixos.org)
+ *
+ * @license
+ * GNU General Public License version 3
+ */
+
+#pragma once
+
+#include <CCLang/Forward.hh>
+
+#include <CCLang/Alloc/Text/FormatParser.hh>
+#include <CCLang/Alloc/Text/Formatter.hh>
+#include <CCLang/Core/Meta.hh>
+#include <CCLang/Lang/IntTypes.hh>
+#include <CCLang/Lang/StringView.hh>
+
+namespace Details {
+
+/**
+ * @brief Diagnostics of the compile-time format string validation.
+ * They are intentionally not constexpr (and never defined), so reaching one of them while the
+ * consteval FormatString constructor runs turns into a compiler error naming the problem
+ */
+auto format_string_has_less_placeholders_than_arguments() -> void;
+auto format_string_has_more_placeholders_than_arguments() -> void;
+auto format_string_has_malformed_placeholder() -> void;
+auto format_string_has_unescaped_closing_brace() -> void;
+auto format_string_display_as_is_not_supported_by_argument() -> void;
+auto format_string_argument_has_no_formatter() -> void;
+
+} /* namespace Details */
+
+/**
+ * @brief Format string parsed and validated at compile time against the types of the arguments.
+ * Literal runs are kept as offsets into the string literal and the placeholders are already
+ * converted into FormatParser specifications, so the formatting doesn't need any lexing at runtime
+ */
+template<typename... Args>
+class FormatString final {
+public:
+    static constexpr usize::NativeInt C_PLACEHOLDER_COUNT = sizeof...(Args);
+
+    struct Literal {
+        usize::NativeInt m_offset{ 0 };
+        usize::NativeInt m_len{ 0 };
+        bool             m_has_escapes{ false };
+    };
+
+    struct Placeholder {
+        char                          m_alignment_fill{ ' ' };
+        FormatParser::Alignment       m_alignment{ FormatParser::Alignment::Default };
+        FormatParser::ShowIntegerSign m_show_integer_sign{ FormatParser::ShowIntegerSign::IfNegative };
+        FormatParser::ShowBase        m_show_base{ FormatParser::ShowBase::No };
+        FormatParser::ZeroPad         m_zero_pad{ FormatParser::ZeroPad::No };
+        bool                          m_has_width{ false };
+        usize::NativeInt              m_width{ 0 };
+        bool                          m_has_precision{ false };
+        usize::NativeInt              m_precision{ 0 };
+        FormatParser::DisplayAs       m_display_as{ FormatParser::DisplayAs::Default };
+
+        /**
+         * @brief Converts this placeholder into the runtime representation used by the Formatters
+         */
+        [[nodiscard]]
+        auto as_parser_result() const -> FormatParser::Result {
+            FormatParser::Result result;
+            result.m_alignment_fill    = m_alignment_fill;
+            result.m_alignment         = m_alignment;
+            result.m_show_integer_sign = m_show_integer_sign;
+            result.m_show_base         = m_show_base;
+            result.m_zero_pad          = m_zero_pad;
+            result.m_display_as        = m_display_as;
+            if ( m_has_width )
+                result.m_width = usize(m_width);
+            if ( m_has_precision )
+                result.m_precision = usize(m_precision);
+            return result;
+        }
+    };
+
+public:
+    /**
+     * @brief Parses and validates the given string literal.
+     * Implicit to allow format(string_builder, "...{}...", args...)
+     */
+    template<usize::NativeInt N>
+    consteval explicit(false) FormatString(char const (&format_literal)[N])
+        : m_format_chars{ format_literal } {
+        usize::NativeInt const format_len  = N - 1;
+        usize::NativeInt       index       = 0;
+        usize::NativeInt       placeholder = 0;
+        while ( true ) {
+            auto& literal    = m_literals[placeholder];
+            literal.m_offset = index;
+            index            = consume_literal(format_literal, format_len, index, literal);
+            literal.m_len    = index - literal.m_offset;
+            if ( index == format_len )
+                break;
+
+            /* consume_literal() stops only at the end or at an opening brace */
+            if ( placeholder == C_PLACEHOLDER_COUNT )
+                Details::format_string_has_more_placeholders_than_arguments();
+
+            index = consume_placeholder(format_literal, format_len, index, m_placeholders[placeholder]);
+            ++placeholder;
+        }
+
+        if ( placeholder != C_PLACEHOLDER_COUNT )
+            Details::format_string_has_less_placeholders_than_arguments();
+
+        /* validate each placeholder against the type of its argument */
+        usize::NativeInt arg_index = 0;
+        (validate_argument<RemoveConstVolatile<Args>>(m_placeholders[arg_index++]), ...);
+    }
+
+    /**
+     * @brief Getters
+     */
+    [[nodiscard]]
+    auto literal(usize::NativeInt index) const -> Literal const& {
+        return m_literals[index];
+    }
+    [[nodiscard]]
+    auto literal_view(usize::NativeInt index) const -> StringView {
+        return StringView::from_raw_parts(m_format_chars + m_literals[index].m_offset, m_literals[index].m_len);
+    }
+    [[nodiscard]]
+    auto placeholder(usize::NativeInt index) const -> Placeholder const& {
+        return m_placeholders[index];
+    }
+
+private:
+    static consteval auto consume_literal(char const*      format_chars,
+                                          usize::NativeInt format_len,
+                                          usize::NativeInt index,
+                                          Literal&         literal) -> usize::NativeInt {
+        while ( index < format_len ) {
+            auto const c      = format_chars[index];
+            auto const next_c = index + 1 < format_len ? format_chars[index + 1] : '\0';
+            if ( (c == '{' && next_c == '{') || (c == '}' && next_c == '}') ) {
+                literal.m_has_escapes = true;
+                index += 2;
+            } else if ( c == '{' ) {
+                return index;
+            } else if ( c == '}' ) {
+                Details::format_string_has_unescaped_closing_brace();
+            } else {
+                ++index;
+            }
+        }
+        return index;
+    }
+
+    static consteval auto consume_number(char const*       format_chars,
+                                         usize::NativeInt  format_len,
+                                         usize::NativeInt& index,
+                                         usize::NativeInt& value) -> bool {
+        value = 0;
+
+        bool consumed_at_least_one = false;
+        while ( index < format_len && format_chars[index] >= '0' && format_chars[index] <= '9' ) {
+            value = value * 10 + static_cast<usize::NativeInt>(format_chars[index++] - '0');
+            consumed_at_least_one = true;
+        }
+        return consumed_at_least_one;
+    }
+
+    /**
+     * @brief Mirrors FormatParser::try_parse() on the literal characters
+     */
+    static consteval auto consume_placeholder(char const*      format_chars,
+                                              usize::NativeInt format_len,
+                                              usize::NativeInt index,
+                                              Placeholder&     placeholder) -> usize::NativeInt {
+        auto const peek = [&](usize::NativeInt offset) -> char {
+            return index + offset < format_len ? format_chars[index + offset] : '\0';
+        };
+        auto const consume_specific = [&](char c) -> bool {
+            if ( peek(0) != c )
+                return false;
+
+            ++index;
+            return true;
+        };
+
+        if ( !consume_specific('{') )
+            Details::format_string_has_malformed_placeholder();
+
+        if ( consume_specific(':') ) {
+            /* alignment fill and alignment */
+            if ( peek(1) == '<' || peek(1) == '^' || peek(1) == '>' )
+                placeholder.m_alignment_fill = format_chars[index++];
+            if ( consume_specific('<') )
+                placeholder.m_alignment = FormatParser::Alignment::Left;
+            else if ( consume_specific('^') )
+                placeholder.m_alignment = FormatParser::Alignment::Center;
+            else if ( consume_specific('>') )
+                placeholder.m_alignment = FormatParser::Alignment::Right;
+
+            /* integer sign, base and zero pad */
+            if ( consume_specific('-') )
+                placeholder.m_show_integer_sign = FormatParser::ShowIntegerSign::IfNegative;
+            else if ( consume_specific('+') )
+                placeholder.m_show_integer_sign = FormatParser::ShowIntegerSign::Yes;
+            else if ( consume_specific(' ') )
+                placeholder.m_show_integer_sign = FormatParser::ShowIntegerSign::KeepSpace;
+            if ( consume_specific('#') )
+                placeholder.m_show_base = FormatParser::ShowBase::Yes;
+            if ( consume_specific('0') )
+                placeholder.m_zero_pad = FormatParser::ZeroPad::Yes;
+
+            /* width and precision */
+            placeholder.m_has_width = consume_number(format_chars, format_len, index, placeholder.m_width);
+            if ( consume_specific('.') ) {
+                placeholder.m_has_precision = consume_number(format_chars, format_len, index, placeholder.m_precision);
+                if ( !placeholder.m_has_precision )
+                    Details::format_string_has_malformed_placeholder();
+            }
+
+            /* display as */
+            if ( auto const display_as = display_as_from_specifier(peek(0)); display_as != FormatParser::DisplayAs::Default ) {
+                placeholder.m_display_as = display_as;
+                ++index;
+            }
+        }
+
+        if ( !consume_specific('}') )
+            Details::format_string_has_malformed_placeholder();
+        return index;
+    }
+
+    static consteval auto display_as_from_specifier(char specifier) -> FormatParser::DisplayAs {
+        switch ( specifier ) {
+            case 'b':
+                return FormatParser::DisplayAs::Binary;
+            case 'B':
+                return FormatParser::DisplayAs::BinaryUpperCase;
+            case 'o':
+                return FormatParser::DisplayAs::Octal;
+            case 'd':
+                return FormatParser::DisplayAs::Decimal;
+            case 'x':
+                return FormatParser::DisplayAs::Hex;
+            case 'X':
+                return FormatParser::DisplayAs::HexUpperCase;
+            case 'p':
+                return FormatParser::DisplayAs::Pointer;
+            case 'c':
+                return FormatParser::DisplayAs::Char;
+            case 's':
+                return FormatParser::DisplayAs::String;
+            case 'f':
+                return FormatParser::DisplayAs::Float;
+            case 'a':
+                return FormatParser::DisplayAs::HexFloat;
+            case 'A':
+                return FormatParser::DisplayAs::HexFloatUpperCase;
+            default:
+                return FormatParser::DisplayAs::Default;
+        }
+    }
+
+    template<typename T>
+    static consteval auto validate_argument(Placeholder const& placeholder) -> void {
+        if constexpr ( requires { typename Formatter<T>::NoFormatterAvailable; } )
+            Details::format_string_argument_has_no_formatter();
+
+        using DisplayAs = FormatParser::DisplayAs;
+
+        auto const display_as = placeholder.m_display_as;
+        auto const is_numeric = display_as == DisplayAs::Binary || display_as == DisplayAs::BinaryUpperCase
+                             || display_as == DisplayAs::Octal || display_as == DisplayAs::Decimal
+                             || display_as == DisplayAs::Hex || display_as == DisplayAs::HexUpperCase;
+        auto const is_float = display_as == DisplayAs::Float || display_as == DisplayAs::HexFloat
+                           || display_as == DisplayAs::HexFloatUpperCase;
+
+        bool is_supported = true;
+        if constexpr ( is_same<T, char> || is_same<T, bool> )
+            is_supported = display_as != DisplayAs::Pointer && !is_float;
+        else if constexpr ( is_integral<T> )
+            is_supported = display_as != DisplayAs::String && !is_float && !placeholder.m_has_precision;
+        else if constexpr ( (is_pointer<T> && !is_same<T, char const*>) || is_nullptr<T> )
+            is_supported = display_as == DisplayAs::Default || display_as == DisplayAs::Pointer || is_numeric;
+        else if constexpr ( is_floating_point<T> )
+            is_supported = display_as == DisplayAs::Default || is_float;
+        else if constexpr ( is_same<T, StringView> || is_same<T, String> || is_same<T, StringBuilder> || is_same<T, char const*> )
+            is_supported = display_as == DisplayAs::Default || display_as == DisplayAs::String || display_as == DisplayAs::Char;
+
+        if ( !is_supported )
+            Details::format_string_display_as_is_not_supported_by_argument();
+    }
+
+private:
+    char const* m_format_chars{ nullptr };
+    Literal     m_literals[C_PLACEHOLDER_COUNT + 1]{};
+    Placeholder m_placeholders[C_PLACEHOLDER_COUNT + 1]{};
+};
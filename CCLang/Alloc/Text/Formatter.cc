@@ -13,6 +13,7 @@
 #include <CCLang/Alloc/Text/Format.hh>
 #include <CCLang/Alloc/Text/Formatter.hh>
 #include <CCLang/Core/Assertions.hh>
+#include <CCLang/Core/ToChars.hh>
 #include <CCLang/Lang/Cxx.hh>
 #include <CCLang/Lang/Range.hh>
 #include <CCLang/Lang/Try.hh>
@@ -128,9 +129,9 @@ auto FormatApplier::try_put_u64(u64                           value,
     }
 
     /* convert the integer value to a string */
-    char to_char_buffer[128];
-    auto to_char_slice = Slice<char>::from_raw_parts(to_char_buffer, 128);
-    auto digits_width  = convert_unsigned_to_chars(value, to_char_slice, base, upper_case);
+    char to_char_buffer[C_UNSIGNED_TO_CHARS_MAX_LEN];
+    auto to_char_slice = Slice<char>::from_raw_parts(to_char_buffer, C_UNSIGNED_TO_CHARS_MAX_LEN);
+    auto digits_width  = unsigned_to_chars(value, to_char_slice, base, upper_case);
 
     /* calculate the width */
     usize prefix_width;
@@ -148,7 +149,7 @@ auto FormatApplier::try_put_u64(u64                           value,
         if ( show_base_prefix == FormatParser::ShowBase::Yes ) {
             if ( base == 2 || base == 16 ) {
                 prefix_width += 2;
-            } else if ( base == 16 ) {
+            } else if ( base == 8 ) {
                 prefix_width += 1;
             } else {
                 verify_not_reached$();
@@ -191,9 +192,7 @@ auto FormatApplier::try_put_u64(u64                           value,
      * @brief Puts into the buffer the remaining digits for the number to print
      */
     auto try_put_digits = [&]() -> ErrorOr<void> {
-        for ( auto const i : usize::range(0, digits_width) ) {
-            try$(m_string_builder.try_append(to_char_slice[i]));
-        }
+        try$(m_string_builder.try_append(StringView::from_raw_parts(to_char_buffer, digits_width)));
         return {};
     };
 
@@ -248,35 +247,53 @@ auto FormatApplier::try_put_i64(i64                           value,
 }
 
 #ifndef IN_KERNEL
-auto FormatApplier::try_put_f64(f64                           value,
+auto FormatApplier::try_put_f32(f32                           value,
                                 u8                            base,
                                 bool                          upper_case,
                                 FormatParser::ZeroPad         zero_pad,
                                 FormatParser::Alignment       alignment,
                                 usize                         min_width,
-                                usize                         precision,
+                                Option<usize>                 precision,
                                 char                          alignment_fill,
                                 FormatParser::ShowIntegerSign integer_sign) -> ErrorOr<void> {
-    auto string_builder = StringBuilder::empty();
-    auto format_applier = FormatApplier::from_string_builder(string_builder);
+    /* only the decimal digits are generated with the binary32 precision */
+    if ( base != 10 || isnan(value) || isinf(value) ) {
+        try$(try_put_f64(value, base, upper_case, zero_pad, alignment, min_width, Cxx::move(precision), alignment_fill, integer_sign));
+        return {};
+    }
 
-    /* write-out the NotANumber and Infinite values */
-    if ( isnan(value) || isinf(value) ) [[unlikely]] {
-        if ( value < 0.0 ) {
-            try$(string_builder.try_append('-'));
-        } else if ( integer_sign == FormatParser::ShowIntegerSign::Yes ) {
-            try$(string_builder.try_append('+'));
-        } else if ( integer_sign == FormatParser::ShowIntegerSign::KeepSpace ) {
-            try$(string_builder.try_append(' '));
-        }
+    /* check for negative value and take the module */
+    auto const is_negative = value < 0.0f;
+    if ( is_negative ) {
+        value = -value;
+    }
 
-        if ( isnan(value) ) {
-            try$(string_builder.try_append(upper_case ? "NAN"sv : "nan"sv));
-        } else {
-            try$(string_builder.try_append(upper_case ? "INF"sv : "inf"sv));
-        }
+    /* obtain the shortest digits which round-trip to the f32 value */
+    char  digits[C_SHORTEST_DIGITS_MAX_LEN];
+    auto  digits_slice   = Slice<char>::from_raw_parts(digits, C_SHORTEST_DIGITS_MAX_LEN);
+    i32   exponent       = 0;
+    usize digits_count   = 0;
+    if ( value != 0.0f ) {
+        digits_count = shortest_decimal_digits(value, digits_slice, exponent);
+    }
+
+    auto const point_position = isize(static_cast<isize::NativeInt>(digits_count.unwrap()) + exponent.unwrap());
+    try$(try_put_decimal_digits(digits_slice, digits_count, point_position, is_negative, zero_pad, alignment, min_width, Cxx::move(precision), alignment_fill, integer_sign));
+    return {};
+}
 
-        try$(try_put_string(string_builder.as_string_view(), min_width, 0xfffffff, alignment, alignment_fill));
+auto FormatApplier::try_put_f64(f64                           value,
+                                u8                            base,
+                                bool                          upper_case,
+                                FormatParser::ZeroPad         zero_pad,
+                                FormatParser::Alignment       alignment,
+                                usize                         min_width,
+                                Option<usize>                 precision,
+                                char                          alignment_fill,
+                                FormatParser::ShowIntegerSign integer_sign) -> ErrorOr<void> {
+    /* write-out the NotANumber and Infinite values */
+    if ( isnan(value) || isinf(value) ) [[unlikely]] {
+        try$(try_put_not_finite(value, upper_case, alignment, min_width, alignment_fill, integer_sign));
         return {};
     }
 
@@ -286,6 +303,24 @@ auto FormatApplier::try_put_f64(f64                           value,
         value = -value;
     }
 
+    if ( base == 10 ) {
+        /* obtain the shortest digits which round-trip to the value */
+        char  digits[C_SHORTEST_DIGITS_MAX_LEN];
+        auto  digits_slice = Slice<char>::from_raw_parts(digits, C_SHORTEST_DIGITS_MAX_LEN);
+        i32   exponent     = 0;
+        usize digits_count = 0;
+        if ( value != 0.0 ) {
+            digits_count = shortest_decimal_digits(value, digits_slice, exponent);
+        }
+
+        auto const point_position = isize(static_cast<isize::NativeInt>(digits_count.unwrap()) + exponent.unwrap());
+        try$(try_put_decimal_digits(digits_slice, digits_count, point_position, is_negative, zero_pad, alignment, min_width, Cxx::move(precision), alignment_fill, integer_sign));
+        return {};
+    }
+
+    auto string_builder = StringBuilder::empty();
+    auto format_applier = FormatApplier::from_string_builder(string_builder);
+
     /* put out the integer part */
     try$(format_applier.try_put_u64(u64(value),
                                     base,
@@ -298,19 +333,20 @@ auto FormatApplier::try_put_f64(f64                           value,
                                     integer_sign,
                                     is_negative));
 
-    /* approximate the decimal part */
-    if ( precision > 0 ) {
+    /* approximate the fractional digits in the non-decimal bases */
+    auto const fraction_digits = precision.unwrap_or(6);
+    if ( fraction_digits > 0 ) {
         value -= (f64)((i64::NativeInt)value);
 
         /* make the epsilon precision value */
         double epsilon = 0.5;
-        for ( auto const i : usize::range(0, precision) ) {
+        for ( auto const i : usize::range(0, fraction_digits) ) {
             epsilon /= 10.0;
         }
 
         /* calculate the visible precision chars */
         usize visible_precision = 0;
-        for ( ; visible_precision < precision; ++visible_precision ) {
+        for ( ; visible_precision < fraction_digits; ++visible_precision ) {
             if ( value - (f64)((i64::NativeInt)value) < epsilon ) {
                 break;
             }
@@ -325,8 +361,8 @@ auto FormatApplier::try_put_f64(f64                           value,
         if ( visible_precision > 0 ) {
             try$(format_applier.try_put_u64(u64(value), base, FormatParser::ShowBase::No, upper_case, FormatParser::ZeroPad::Yes, visible_precision));
         }
-        if ( zero_pad == FormatParser::ZeroPad::Yes && (precision - visible_precision) > 0 ) {
-            try$(format_applier.try_put_u64(0, base, FormatParser::ShowBase::No, false, FormatParser::ZeroPad::Yes, precision - visible_precision));
+        if ( zero_pad == FormatParser::ZeroPad::Yes && (fraction_digits - visible_precision) > 0 ) {
+            try$(format_applier.try_put_u64(0, base, FormatParser::ShowBase::No, false, FormatParser::ZeroPad::Yes, fraction_digits - visible_precision));
         }
     }
 
@@ -348,21 +384,7 @@ auto FormatApplier::try_put_f80(f80                           value,
 
     /* write-out the NotANumber and Infinite values */
     if ( isnan(value) || isinf(value) ) [[unlikely]] {
-        if ( value < 0.0L ) {
-            try$(string_builder.try_append('-'));
-        } else if ( integer_sign == FormatParser::ShowIntegerSign::Yes ) {
-            try$(string_builder.try_append('+'));
-        } else if ( integer_sign == FormatParser::ShowIntegerSign::KeepSpace ) {
-            try$(string_builder.try_append(' '));
-        }
-
-        if ( isnan(value) ) {
-            try$(string_builder.try_append(upper_case ? "NAN"sv : "nan"sv));
-        } else {
-            try$(string_builder.try_append(upper_case ? "INF"sv : "inf"sv));
-        }
-
-        try$(try_put_string(string_builder.as_string_view(), min_width, 0xfffffff, alignment, alignment_fill));
+        try$(try_put_not_finite(static_cast<f64>(value), upper_case, alignment, min_width, alignment_fill, integer_sign));
         return {};
     }
 
@@ -415,6 +437,150 @@ auto FormatApplier::try_put_f80(f80                           value,
     try$(try_put_string(string_builder.as_string_view(), min_width, 0xffffff, alignment, alignment_fill));
     return {};
 }
+
+auto FormatApplier::try_put_not_finite(f64                           value,
+                                       bool                          upper_case,
+                                       FormatParser::Alignment       alignment,
+                                       usize                         min_width,
+                                       char                          alignment_fill,
+                                       FormatParser::ShowIntegerSign integer_sign) -> ErrorOr<void> {
+    auto string_builder = StringBuilder::empty();
+    if ( value < 0.0 ) {
+        try$(string_builder.try_append('-'));
+    } else if ( integer_sign == FormatParser::ShowIntegerSign::Yes ) {
+        try$(string_builder.try_append('+'));
+    } else if ( integer_sign == FormatParser::ShowIntegerSign::KeepSpace ) {
+        try$(string_builder.try_append(' '));
+    }
+
+    if ( isnan(value) ) {
+        try$(string_builder.try_append(upper_case ? "NAN"sv : "nan"sv));
+    } else {
+        try$(string_builder.try_append(upper_case ? "INF"sv : "inf"sv));
+    }
+
+    try$(try_put_string(string_builder.as_string_view(), min_width, 0xfffffff, alignment, alignment_fill));
+    return {};
+}
+
+auto FormatApplier::try_put_decimal_digits(Slice<char>                   digits_slice,
+                                           usize                         digits_count,
+                                           isize                         point_position,
+                                           bool                          is_negative,
+                                           FormatParser::ZeroPad         zero_pad,
+                                           FormatParser::Alignment       alignment,
+                                           usize                         min_width,
+                                           Option<usize>                 precision,
+                                           char                          alignment_fill,
+                                           FormatParser::ShowIntegerSign integer_sign) -> ErrorOr<void> {
+    using SSize = isize::NativeInt;
+
+    /* the value is 0.<digits> * 10^point, the index arithmetic is done on the native integers */
+    auto const digits        = digits_slice.data();
+    auto const has_precision = precision.is_present();
+    auto const max_fraction  = has_precision ? static_cast<SSize>(precision.unwrap().unwrap()) : 0;
+    auto       count         = static_cast<SSize>(digits_count.unwrap());
+    auto       point         = point_position.unwrap();
+
+    /* round half-up the digits beyond the requested precision */
+    if ( has_precision && point + max_fraction < count ) {
+        auto const kept_count = point + max_fraction;
+        if ( kept_count < 0 ) {
+            count = 0;
+        } else {
+            auto const round_up = digits[kept_count] >= '5';
+
+            count = kept_count;
+            if ( round_up ) {
+                auto i = count - 1;
+                while ( i >= 0 && digits[i] == '9' ) {
+                    --i;
+                }
+
+                if ( i < 0 ) {
+                    digits[0] = '1';
+                    count     = 1;
+                    ++point;
+                } else {
+                    ++digits[i];
+                    count = i + 1;
+                }
+            }
+        }
+    }
+
+    /* the trailing zeros are given back by the point position or by the zero padding */
+    while ( count > 0 && digits[count - 1] == '0' ) {
+        --count;
+    }
+
+    /* calculate the width of each part */
+    auto const sign_width      = is_negative || integer_sign != FormatParser::ShowIntegerSign::IfNegative ? 1 : 0;
+    auto const integral_width  = point > 0 ? point : 1;
+    auto const fraction_width  = count > point ? count - (point > 0 ? point : 0) : 0;
+    auto const trailing_zeros  = zero_pad == FormatParser::ZeroPad::Yes && max_fraction > fraction_width ? max_fraction - fraction_width : 0;
+    auto const has_point       = fraction_width + trailing_zeros > 0;
+    auto const field_width     = sign_width + integral_width + (has_point ? 1 : 0) + fraction_width + trailing_zeros;
+    auto const padding_width   = usize::max(usize(static_cast<usize::NativeInt>(field_width)), min_width) - usize(static_cast<usize::NativeInt>(field_width));
+
+    /**
+     * @brief Puts into the buffer the sign and the digits around the decimal point, a run at time
+     */
+    auto try_put_number = [&]() -> ErrorOr<void> {
+        if ( is_negative ) {
+            try$(m_string_builder.try_append('-'));
+        } else if ( integer_sign == FormatParser::ShowIntegerSign::Yes ) {
+            try$(m_string_builder.try_append('+'));
+        } else if ( integer_sign == FormatParser::ShowIntegerSign::KeepSpace ) {
+            try$(m_string_builder.try_append(' '));
+        }
+
+        if ( point > 0 ) {
+            auto const integral_digits = count < point ? count : point;
+            try$(m_string_builder.try_append(StringView::from_raw_parts(digits, static_cast<usize::NativeInt>(integral_digits))));
+            try$(try_put_padding('0', static_cast<usize::NativeInt>(point - integral_digits)));
+        } else {
+            try$(m_string_builder.try_append('0'));
+        }
+
+        if ( has_point ) {
+            auto const first_fraction_digit = point > 0 ? point : 0;
+
+            try$(m_string_builder.try_append('.'));
+            try$(try_put_padding('0', static_cast<usize::NativeInt>(point < 0 ? -point : 0)));
+            if ( count > first_fraction_digit ) {
+                try$(m_string_builder.try_append(StringView::from_raw_parts(digits + first_fraction_digit, static_cast<usize::NativeInt>(count - first_fraction_digit))));
+            }
+            try$(try_put_padding('0', static_cast<usize::NativeInt>(trailing_zeros)));
+        }
+        return {};
+    };
+
+    /* floating values are aligned like strings */
+    switch ( alignment ) {
+        case FormatParser::Alignment::Default:
+        case FormatParser::Alignment::Left:
+            try$(try_put_number());
+            try$(try_put_padding(alignment_fill, padding_width));
+            break;
+        case FormatParser::Alignment::Center: {
+            auto left_padding_width  = padding_width / 2;
+            auto right_padding_width = usize::ceil_div(padding_width, 2);
+
+            try$(try_put_padding(alignment_fill, left_padding_width));
+            try$(try_put_number());
+            try$(try_put_padding(alignment_fill, right_padding_width));
+            break;
+        }
+        case FormatParser::Alignment::Right:
+            try$(try_put_padding(alignment_fill, padding_width));
+            try$(try_put_number());
+            break;
+        default:
+            verify_not_reached$();
+    }
+    return {};
+}
 #endif
 
 auto FormatApplier::string_builder() -> StringBuilder& {
@@ -494,38 +660,6 @@ FormatApplier::FormatApplier(StringBuilder& string_builder, FormatParser::Result
     , m_parser_result(Cxx::move(result)) {
 }
 
-auto FormatApplier::convert_unsigned_to_chars(u64 int_value, Slice<char> to_chars_buffer, u8 base, bool upper_case) -> usize {
-    verify_greater_equal$(base, 2);
-    verify_less_equal$(base, 16);
-
-    /* short way for 0 int_value */
-    if ( int_value == 0 ) {
-        to_chars_buffer[0] = '0';
-        return 1;
-    }
-
-    Slice<char const> digits_slice = ({
-        upper_case ? Slice<char const>::from_raw_parts("0123456789ABCDEF", sizeof("0123456789ABCDEF") - 1)
-                   : Slice<char const>::from_raw_parts("0123456789abcdef", sizeof("0123456789abcdef") - 1);
-    });
-
-    /* convert the digits */
-    usize used_chars = 0;
-    while ( int_value > 0 ) {
-        auto const i                = int_value % base.as<u64>();
-        to_chars_buffer[used_chars] = digits_slice[i.as<usize>()];
-
-        int_value /= base.as<u64>();
-        used_chars += 1;
-    }
-
-    /* flip the buffer */
-    for ( auto const i : usize::range(0, used_chars / 2) ) {
-        Cxx::swap(to_chars_buffer[i], to_chars_buffer[used_chars - i - 1]);
-    }
-    return used_chars;
-}
-
 auto Formatter<nullptr_t>::from_format_applier(FormatApplier format_applier) -> Formatter<nullptr_t> {
     return Formatter<nullptr_t>(Cxx::move(format_applier));
 }
@@ -866,10 +1000,36 @@ auto Formatter<f32>::from_parser_result(StringBuilder& string_builder, FormatPar
     return from_format_applier(FormatApplier::from_parser_result(string_builder, Cxx::move(result)));
 }
 
-auto Formatter<f32>::format(f32 value) const -> ErrorOr<void> {
-    auto double_formatter = Formatter<f64>::from_format_applier(clone_base_format_applier());
-    try$(double_formatter.format(static_cast<f64>(value)));
+auto Formatter<f32>::format(f32 value) -> ErrorOr<void> {
+    /* prepare the base and the case */
+    u8   base       = 0;
+    bool upper_case = false;
+    switch ( display_as() ) {
+        case FormatParser::DisplayAs::Default:
+        case FormatParser::DisplayAs::Float:
+            base = 10;
+            break;
+        case FormatParser::DisplayAs::HexFloat:
+            base = 16;
+            break;
+        case FormatParser::DisplayAs::HexFloatUpperCase:
+            base       = 16;
+            upper_case = true;
+            break;
+        default:
+            verify_not_reached$();
+    }
 
+    /* put the float value into the string-builder */
+    try$(try_put_f32(value,
+                     base,
+                     upper_case,
+                     zero_pad(),
+                     alignment(),
+                     width().unwrap_or(usize::min()),
+                     precision(),
+                     alignment_fill(),
+                     show_integer_sign()));
     return {};
 }
 
@@ -912,7 +1072,7 @@ auto Formatter<f64>::format(f64 value) -> ErrorOr<void> {
                      zero_pad(),
                      alignment(),
                      width().unwrap_or(usize::min()),
-                     precision().unwrap_or(6),
+                     precision(),
                      alignment_fill(),
                      show_integer_sign()));
     return {};
@@ -1001,7 +1161,7 @@ auto Formatter<SourceLocation>::format(SourceLocation const& source_location) co
     }
 
     auto string_builder = StringBuilder::empty();
-    try$(::format(string_builder, "{} {}() {}"sv, file_path_sv, source_location.function(), source_location.line()));
+    try$(::format(string_builder, "{} {}() {}", file_path_sv, source_location.function(), source_location.line()));
 
     auto formatter = Formatter<StringView>::from_format_applier(clone_base_format_applier());
     try$(formatter.format(string_builder.as_string_view()));
@@ -1050,17 +1210,17 @@ auto Formatter<Error>::from_parser_result(StringBuilder& string_builder, FormatP
 auto Formatter<Error>::format(Error const& error) const -> ErrorOr<void> {
     auto string_builder = StringBuilder::empty();
 
-    try$(::format(string_builder, "{}\n"sv, error.source_location()));
+    try$(::format(string_builder, "{}\n", error.source_location()));
     if ( error.is_from_syscall() == Error::FromSyscall::Yes ) {
-        try$(::format(string_builder, "> System "sv));
+        try$(::format(string_builder, "> System "));
     } else {
-        try$(::format(string_builder, "> User "sv));
+        try$(::format(string_builder, "> User "));
     }
 
     if ( !error.string_literal().is_null_or_empty() ) {
-        try$(::format(string_builder, "{} - {}"sv, error.code(), error.string_literal()));
+        try$(::format(string_builder, "{} - {}", error.code(), error.string_literal()));
     } else {
-        try$(::format(string_builder, "{}"sv, error.code()));
+        try$(::format(string_builder, "{}", error.code()));
     }
 
     auto formatter = Formatter<StringView>::from_format_applier(clone_base_format_applier());
@@ -92,13 +92,22 @@ protected:
                      char                          alignment_fill   = ' ',
                      FormatParser::ShowIntegerSign integer_sign     = FormatParser::ShowIntegerSign::IfNegative) -> ErrorOr<void>;
 #ifndef IN_KERNEL
+    auto try_put_f32(f32                           value,
+                     u8                            base           = 10,
+                     bool                          upper_case     = false,
+                     FormatParser::ZeroPad         zero_pad       = FormatParser::ZeroPad::No,
+                     FormatParser::Alignment       alignment      = FormatParser::Alignment::Right,
+                     usize                         min_width      = 0,
+                     Option<usize>                 precision      = {},
+                     char                          alignment_fill = ' ',
+                     FormatParser::ShowIntegerSign integer_sign   = FormatParser::ShowIntegerSign::IfNegative) -> ErrorOr<void>;
     auto try_put_f64(f64                           value,
                      u8                            base           = 10,
                      bool                          upper_case     = false,
                      FormatParser::ZeroPad         zero_pad       = FormatParser::ZeroPad::No,
                      FormatParser::Alignment       alignment      = FormatParser::Alignment::Right,
                      usize                         min_width      = 0,
-                     usize                         precision      = 6,
+                     Option<usize>                 precision      = {},
                      char                          alignment_fill = ' ',
                      FormatParser::ShowIntegerSign integer_sign   = FormatParser::ShowIntegerSign::IfNegative) -> ErrorOr<void>;
     auto try_put_f80(f80                           value,
@@ -151,7 +160,24 @@ private:
     explicit FormatApplier(StringBuilder&, FormatParser::Result);
 
 private:
-    static auto convert_unsigned_to_chars(u64 int_value, Slice<char> to_chars_buffer, u8 base, bool upper_case) -> usize;
+#ifndef IN_KERNEL
+    auto try_put_not_finite(f64                           value,
+                            bool                          upper_case,
+                            FormatParser::Alignment       alignment,
+                            usize                         min_width,
+                            char                          alignment_fill,
+                            FormatParser::ShowIntegerSign integer_sign) -> ErrorOr<void>;
+    auto try_put_decimal_digits(Slice<char>                   digits,
+                                usize                         digits_count,
+                                isize                         point_position,
+                                bool                          is_negative,
+                                FormatParser::ZeroPad         zero_pad,
+                                FormatParser::Alignment       alignment,
+                                usize                         min_width,
+                                Option<usize>                 precision,
+                                char                          alignment_fill,
+                                FormatParser::ShowIntegerSign integer_sign) -> ErrorOr<void>;
+#endif
 
 private:
     StringBuilder&       m_string_builder;
@@ -313,7 +339,7 @@ public:
     /**
      * @brief Performs the format on the given string-builder
      */
-    auto format(f32) const -> ErrorOr<void>;
+    auto format(f32) -> ErrorOr<void>;
 
 private:
     explicit Formatter(FormatApplier);
@@ -375,7 +401,7 @@ public:
         return Formatter<T>(Cxx::move(format_applier));
     }
     [[nodiscard]]
-    static auto from_parser_result(StringBuilder& string_builder, FormatParser::Result result) -> Formatter<T*> {
+    static auto from_parser_result(StringBuilder& string_builder, FormatParser::Result result) -> Formatter<T> {
         return from_format_applier(FormatApplier::from_parser_result(string_builder, Cxx::move(result)));
     }
 
@@ -384,7 +410,7 @@ public:
     /**
      * @brief Performs the format on the given string-builder
      */
-    auto format(T* value) -> ErrorOr<void> {
+    auto format(T value) -> ErrorOr<void> {
         /* show as pointer a pointer */
         if ( display_as() == FormatParser::DisplayAs::Default ) {
             set_display_as(FormatParser::DisplayAs::Pointer);
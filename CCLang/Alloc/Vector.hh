@@ -14,6 +14,7 @@
 
 #include <CCLang/Forward.hh>
 
+#include <CCLang/Alloc/Allocator.hh>
 #include <CCLang/Alloc/New.hh>
 #include <CCLang/Core/Assertions.hh>
 #include <CCLang/Core/ErrorOr.hh>
@@ -25,17 +26,21 @@
 #include <CCLang/Lang/IntTypes.hh>
 #include <CCLang/Lang/Must.hh>
 #include <CCLang/Lang/Range.hh>
+#include <CCLang/Lang/ReverseIteratorSupport.hh>
 #include <CCLang/Lang/Try.hh>
 
 template<typename T>
 class Vector final : public DenyCopy {
+public:
+    static constexpr usize::NativeInt C_MIN_CAPACITY = 4;
+
 public:
     using Iterator                    = Slice<T>::Iterator;
     using ConstIterator               = Slice<T>::ConstIterator;
     using ReverseIterator             = Slice<T>::ReverseIterator;
     using ConstReverseIterator        = Slice<T>::ConstReverseIterator;
-    using ReverseIteratorWrapper      = Slice<T>::ReverseIteratorWrapper;
-    using ConstReverseIteratorWrapper = Slice<T>::ConstReverseIteratorWrapper;
+    using ReverseIteratorWrapper      = ReverseIteratorSupport::Wrapper<Vector<T>>;
+    using ConstReverseIteratorWrapper = ReverseIteratorSupport::Wrapper<Vector<T> const>;
 
 public:
     /**
@@ -44,6 +49,11 @@ public:
     static auto empty() -> Vector<T> {
         return Vector<T>();
     }
+    static auto with_allocator(Allocator& allocator) -> Vector<T> {
+        auto vector        = empty();
+        vector.m_allocator = &allocator;
+        return vector;
+    }
     static auto with_capacity(usize capacity) -> Vector<T> {
         return must$(try_with_capacity(capacity));
     }
@@ -91,7 +101,8 @@ public:
     Vector(Vector<T>&& rhs)
         : m_data_storage(Cxx::exchange(rhs.m_data_storage, Slice<T>::empty()))
         , m_data_capacity(Cxx::exchange(rhs.m_data_capacity, 0))
-        , m_values_count(Cxx::exchange(rhs.m_values_count, 0)) {
+        , m_values_count(Cxx::exchange(rhs.m_values_count, 0))
+        , m_allocator(Cxx::exchange(rhs.m_allocator, nullptr)) {
     }
     auto operator=(Vector<T>&& rhs) -> Vector<T>& {
         Vector<T> vector = Cxx::move(rhs);
@@ -104,7 +115,7 @@ public:
     }
 
     /**
-     * @brief Deep cloning
+     * @brief Deep cloning, the clone always allocates from the global heap
      */
     auto clone() const -> Vector<T> {
         return must$(try_clone());
@@ -120,7 +131,7 @@ public:
         clear_keep_capacity();
 
         if ( !m_data_storage.is_null() ) {
-            Details::internal_heap_dealloc(m_data_storage.data(), m_data_capacity * sizeof(T));
+            Details::allocator_dealloc(m_allocator, m_data_storage.data(), m_data_capacity * sizeof(T));
             m_data_storage  = Slice<T>::empty();
             m_data_capacity = 0;
         }
@@ -141,6 +152,7 @@ public:
         Cxx::swap(m_data_storage, rhs.m_data_storage);
         Cxx::swap(m_data_capacity, rhs.m_data_capacity);
         Cxx::swap(m_values_count, rhs.m_values_count);
+        Cxx::swap(m_allocator, rhs.m_allocator);
     }
 
     /**
@@ -326,11 +338,23 @@ public:
             return {};
         }
 
-        /* for first time use the given capacity, otherwise increase the capacity logarithmically */
-        usize new_capacity = ({ m_data_capacity == 0 && capacity == 0 ? 16 : capacity * 2 / 4; });
+        /* grow by a 1.5 factor unless a bigger capacity is requested: the appends stay amortized O(1) and the heap
+         * can reuse the blocks given back by the previous growths */
+        auto const new_capacity = usize::max(capacity, usize::max(m_data_capacity + m_data_capacity / 2, C_MIN_CAPACITY));
+
+        /* the trivial values are relocated by the allocator, which may resize the memory in place */
+        if constexpr ( TypeTraits<T>::is_trivial() ) {
+            if ( !m_data_storage.is_null() ) {
+                auto const new_data_ptr = try$(Details::allocator_realloc(m_allocator, m_data_storage.data(), m_data_capacity * sizeof(T), new_capacity * sizeof(T)));
+
+                m_data_storage  = Slice<T>::from_raw_parts(static_cast<T*>(new_data_ptr), new_capacity);
+                m_data_capacity = new_capacity;
+                return {};
+            }
+        }
 
         /* allocate new memory and move the content into it */
-        auto new_data_storage = try$(Details::internal_heap_alloc(new_capacity * sizeof(T)).map<Slice<T>>([new_capacity](void* void_ptr) -> Slice<T> {
+        auto new_data_storage = try$(Details::allocator_alloc(m_allocator, new_capacity * sizeof(T)).map<Slice<T>>([new_capacity](void* void_ptr) -> Slice<T> {
             return Slice<T>::from_raw_parts((T*)void_ptr, new_capacity);
         }));
         if constexpr ( TypeTraits<T>::is_trivial() ) {
@@ -344,7 +368,7 @@ public:
 
         /* destroy the previous buffer if exists and update the other fields */
         if ( !m_data_storage.is_null() ) {
-            Details::internal_heap_dealloc(m_data_storage.data(), m_data_capacity * sizeof(T));
+            Details::allocator_dealloc(m_allocator, m_data_storage.data(), m_data_capacity * sizeof(T));
         }
 
         m_data_storage  = new_data_storage;
@@ -359,7 +383,7 @@ public:
         return as_slice().begin();
     }
     auto end() -> Iterator {
-        return as_slice().begin();
+        return as_slice().end();
     }
 
     auto begin() const -> ConstIterator {
@@ -391,10 +415,10 @@ public:
     }
 
     auto reverse_iter() -> ReverseIteratorWrapper {
-        return as_slice().reverse_iter();
+        return ReverseIteratorSupport::in_reverse(*this);
     }
     auto reverse_iter() const -> ConstReverseIteratorWrapper {
-        return as_slice().reverse_iter();
+        return ReverseIteratorSupport::in_reverse(*this);
     }
 
     /**
@@ -501,9 +525,10 @@ private:
     }
 
 private:
-    Slice<T> m_data_storage  = Slice<T>::empty();
-    usize    m_data_capacity = 0;
-    usize    m_values_count  = 0;
+    Slice<T>   m_data_storage  = Slice<T>::empty();
+    usize      m_data_capacity = 0;
+    usize      m_values_count  = 0;
+    Allocator* m_allocator     = nullptr;
 };
 
 namespace Cxx {
@@ -12,87 +12,186 @@
 
 #include <CCLang/Core/Find.hh>
 
-#include <CCLang/Alloc/Vector.hh>
-#include <CCLang/Lang/Option.hh>
-#include <CCLang/Lang/Range.hh>
-#include <CCLang/Lang/Try.hh>
-
 namespace Details {
 
-auto bitwise_find_in_memory(Slice<u8 const> haystack, Slice<u8 const> needle) -> Option<usize> {
-    usize needle_mask[256];
-    auto needle_mask_slice = Slice<usize>::from_raw_parts(needle_mask, 256);
-    needle_mask_slice.fill(0xffffffff);
+/* The kernels work on the native integers, the bounds are checked once by the callers */
+using Byte = u8::NativeInt;
+using Size = usize::NativeInt;
 
-    for ( auto const i : usize::range(0, needle.len()) ) {
-        needle_mask_slice[needle[i].as<usize>()] &= ~(0x00000001 << i);
-    }
+#ifdef __SSE2__
+/* the vector extensions keep the intrinsics headers, which need the hosted libc, out */
+using Vector16 = char __attribute__((vector_size(16)));
 
-    usize lookup = 0xfffffffe;
-    for ( auto const i : usize::range(0, haystack.len()) ) {
-        lookup |= needle_mask_slice[haystack[i].as<usize>()];
-        lookup <<= 1;
+static auto load_vector(Byte const* ptr) -> Vector16 {
+    Vector16 vector;
+    __builtin_memcpy(&vector, ptr, sizeof(Vector16));
+    return vector;
+}
+
+static auto equal_bytes_mask(Vector16 chunk, Vector16 needle_vector) -> int {
+    return __builtin_ia32_pmovmskb128(chunk == needle_vector);
+}
+#else
+static constexpr Size C_LOW_BITS  = ~Size{ 0 } / 0xff;
+static constexpr Size C_HIGH_BITS = C_LOW_BITS * 0x80;
 
-        if ( (lookup & (0x00000001 << needle.len())) == 0 ) {
-            return i - needle.len() + 1;
+static auto word_has_zero_byte(Size word) -> bool {
+    return ((word - C_LOW_BITS) & ~word & C_HIGH_BITS) != 0;
+}
+
+static auto load_word(Byte const* ptr) -> Size {
+    Size word;
+    __builtin_memcpy(&word, ptr, sizeof(Size));
+    return word;
+}
+#endif
+
+auto find_byte_in_memory(Slice<u8 const> haystack, u8 needle) -> Option<usize> {
+    auto const begin = reinterpret_cast<Byte const*>(haystack.data());
+    auto const end   = begin + haystack.len().unwrap();
+    auto const value = needle.unwrap();
+
+    auto ptr = begin;
+#ifdef __SSE2__
+    auto const needle_vector = Vector16{} + static_cast<char>(value);
+    while ( end - ptr >= 16 ) {
+        auto const mask = equal_bytes_mask(load_vector(ptr), needle_vector);
+        if ( mask != 0 ) {
+            return usize(Size(ptr - begin) + __builtin_ctz(mask));
+        }
+        ptr += 16;
+    }
+#else
+    /* skip the words without the needle, the scalar loop below finds the exact byte */
+    auto const needle_word = C_LOW_BITS * value;
+    while ( Size(end - ptr) >= sizeof(Size) && !word_has_zero_byte(load_word(ptr) ^ needle_word) ) {
+        ptr += sizeof(Size);
+    }
+#endif
+
+    for ( ; ptr < end; ++ptr ) {
+        if ( *ptr == value ) {
+            return usize(Size(ptr - begin));
         }
     }
     return {};
 }
 
-auto kmp_find_in_memory(Slice<u8 const> haystack, Slice<u8 const> needle) -> Option<usize> {
-    auto prepare_kmp_partial_table = [&]() -> ErrorOr<Vector<i32>> {
-        auto kmp_partial_table = try$(Vector<i32>::try_with_capacity(needle.len()));
+auto find_last_byte_in_memory(Slice<u8 const> haystack, u8 needle) -> Option<usize> {
+    auto const begin = reinterpret_cast<Byte const*>(haystack.data());
+    auto const value = needle.unwrap();
+
+    auto ptr = begin + haystack.len().unwrap();
+#ifdef __SSE2__
+    auto const needle_vector = Vector16{} + static_cast<char>(value);
+    while ( ptr - begin >= 16 ) {
+        auto const mask = equal_bytes_mask(load_vector(ptr - 16), needle_vector);
+        if ( mask != 0 ) {
+            return usize(Size(ptr - 16 - begin) + 31 - __builtin_clz(mask));
+        }
+        ptr -= 16;
+    }
+#else
+    auto const needle_word = C_LOW_BITS * value;
+    while ( Size(ptr - begin) >= sizeof(Size) && !word_has_zero_byte(load_word(ptr - sizeof(Size)) ^ needle_word) ) {
+        ptr -= sizeof(Size);
+    }
+#endif
 
-        usize position       = 1;
-        i32   candidate      = 0;
-        kmp_partial_table[0] = -1;
-        while ( position < needle.len() ) {
-            if ( needle[position] == needle[candidate.as<usize>()] ) {
-                kmp_partial_table[position] = kmp_partial_table[candidate.as<usize>()];
+    while ( ptr > begin ) {
+        if ( *--ptr == value ) {
+            return usize(Size(ptr - begin));
+        }
+    }
+    return {};
+}
+
+/**
+ * @brief Computes the maximal suffix of the needle for the given order, returns its start minus one
+ */
+static auto maximal_suffix(Byte const* needle, Size needle_len, bool reverse_order, Size* out_period) -> Size {
+    Size suffix = static_cast<Size>(-1);
+    Size index  = 0;
+    Size offset = 1;
+    Size period = 1;
+    while ( index + offset < needle_len ) {
+        auto const a = needle[suffix + offset];
+        auto const b = needle[index + offset];
+        if ( a == b ) {
+            if ( offset == period ) {
+                index += period;
+                offset = 1;
             } else {
-                kmp_partial_table[position] = candidate;
-                do {
-                    candidate = kmp_partial_table[candidate.as<usize>()];
-                } while ( candidate >= 0 && needle[candidate.as<usize>()] != needle[position] );
+                ++offset;
             }
-
-            ++position;
-            ++candidate;
+        } else if ( reverse_order ? a < b : a > b ) {
+            index += offset;
+            offset = 1;
+            period = index - suffix;
+        } else {
+            suffix = index++;
+            offset = period = 1;
         }
-        return kmp_partial_table;
-    };
+    }
+
+    *out_period = period;
+    return suffix;
+}
 
-    /* prepare the KMP partial table */
-    auto error_or_partial_table = prepare_kmp_partial_table();
-    if ( error_or_partial_table.is_error() ) {
-        return OptionNone;
+auto two_way_find_in_memory(Slice<u8 const> haystack, Slice<u8 const> needle) -> Option<usize> {
+    auto const h_begin    = reinterpret_cast<Byte const*>(haystack.data());
+    auto const h_len      = haystack.len().unwrap();
+    auto const n          = reinterpret_cast<Byte const*>(needle.data());
+    auto const needle_len = needle.len().unwrap();
+
+    /* the critical factorization is the longer of the two maximal suffixes */
+    Size period;
+    Size reverse_period;
+    auto suffix               = maximal_suffix(n, needle_len, false, &period);
+    auto const reverse_suffix = maximal_suffix(n, needle_len, true, &reverse_period);
+    if ( reverse_suffix + 1 > suffix + 1 ) {
+        suffix = reverse_suffix;
+        period = reverse_period;
     }
 
-    auto const kmp_partial_table = error_or_partial_table.unwrap();
+    /* a periodic needle remembers the part of the prefix already matched after each shift */
+    Size memory_after_shift;
+    if ( __builtin_memcmp(n, n + period, suffix + 1) == 0 ) {
+        memory_after_shift = needle_len - period;
+    } else {
+        memory_after_shift = 0;
+        period             = (suffix > needle_len - suffix - 1 ? suffix : needle_len - suffix - 1) + 1;
+    }
 
-    usize current_haystack_index = 0;
-    i32   needle_index           = 0;
+    Size position = 0;
+    Size memory   = 0;
+    while ( h_len - position >= needle_len ) {
+        auto const h = h_begin + position;
 
-    while ( current_haystack_index < haystack.len() ) {
-        if ( needle[needle_index.as<usize>()] == haystack[current_haystack_index] ) {
-            ++needle_index;
-            ++current_haystack_index;
-            if ( needle_index.as<usize>() == needle.len() ) {
-                return current_haystack_index - needle_index.as<usize>();
-            } else {
-                continue;
-            }
+        /* match the right half */
+        auto i = suffix + 1 > memory ? suffix + 1 : memory;
+        while ( i < needle_len && n[i] == h[i] ) {
+            ++i;
+        }
+        if ( i < needle_len ) {
+            position += i - suffix;
+            memory = 0;
+            continue;
         }
 
-        needle_index = kmp_partial_table[needle_index.as<usize>()];
-        if ( needle_index < 0 ) {
-            ++needle_index;
-            ++current_haystack_index;
+        /* match the left half */
+        i = suffix + 1;
+        while ( i > memory && n[i - 1] == h[i - 1] ) {
+            --i;
+        }
+        if ( i <= memory ) {
+            return usize(position);
         }
-    }
 
+        position += period;
+        memory = memory_after_shift;
+    }
     return {};
 }
 
-} /* namespace Details */
\ No newline at end of file
+} /* namespace Details */
@@ -17,33 +17,53 @@
 #include <CCLang/Lang/Cxx.hh>
 #include <CCLang/Lang/IntTypes.hh>
 #include <CCLang/Lang/Option.hh>
+#include <CCLang/Lang/Slice.hh>
 
 namespace Details {
 
-auto bitwise_find_in_memory(Slice<u8 const> haystack, Slice<u8 const> needle) -> Option<usize>;
-auto kmp_find_in_memory(Slice<u8 const> haystack, Slice<u8 const> needle) -> Option<usize>;
+/**
+ * @brief Search kernels, vectorized with SSE2 when the target has it and word-at-a-time otherwise.
+ * None of them allocates
+ */
+auto find_byte_in_memory(Slice<u8 const> haystack, u8 needle) -> Option<usize>;
+auto find_last_byte_in_memory(Slice<u8 const> haystack, u8 needle) -> Option<usize>;
+auto two_way_find_in_memory(Slice<u8 const> haystack, Slice<u8 const> needle) -> Option<usize>;
 
 } /* namespace Details */
 
+/**
+ * @brief Returns the index of the first needle into the haystack of bytes
+ */
+template<typename T>
+auto find_in_memory(Slice<T const> haystack, T needle) -> Option<usize> {
+    static_assert(sizeof(T) == 1);
+    return Details::find_byte_in_memory(haystack.template as_slice_of<u8 const>(), Cxx::bit_cast<u8>(needle));
+}
+
+/**
+ * @brief Returns the index of the last needle into the haystack of bytes
+ */
+template<typename T>
+auto find_last_in_memory(Slice<T const> haystack, T needle) -> Option<usize> {
+    static_assert(sizeof(T) == 1);
+    return Details::find_last_byte_in_memory(haystack.template as_slice_of<u8 const>(), Cxx::bit_cast<u8>(needle));
+}
+
+/**
+ * @brief Returns the index of the first occurrence of needle into the haystack of bytes
+ */
 template<typename T>
 auto find_in_memory(Slice<T const> haystack, Slice<T const> needle) -> Option<usize> {
+    static_assert(sizeof(T) == 1);
     if ( needle.len() == 0 ) {
         return usize(0);
     }
     if ( haystack.len() < needle.len() ) {
         return {};
     }
-    if ( haystack.len() == needle.len() ) {
-        if ( Cxx::memcmp(haystack.data(), needle.data(), haystack.len()) == Order::Equal ) {
-            return usize(0);
-        } else {
-            return {};
-        }
+    if ( needle.len() == 1 ) {
+        return find_in_memory(haystack, needle[0]);
     }
 
-    if ( needle.len() < 32 ) {
-        return Details::bitwise_find_in_memory(haystack.template as_slice_of<u8 const>(), needle.template as_slice_of<u8 const>());
-    } else {
-        return Details::kmp_find_in_memory(haystack.template as_slice_of<u8 const>(), needle.template as_slice_of<u8 const>());
-    }
+    return Details::two_way_find_in_memory(haystack.template as_slice_of<u8 const>(), needle.template as_slice_of<u8 const>());
 }
@@ -83,6 +83,11 @@ struct RemoveVolatile<T volatile> {
     using Type = T;
 };
 
+template<typename T>
+struct TypeIdentity {
+    using Type = T;
+};
+
 template<bool Condition, typename TTrue, typename TFalse>
 struct Conditional {
     using Type = TTrue;
@@ -324,6 +329,8 @@ struct MakeUnsigned<usize> {
 template<bool Condition, typename TTrue, typename TFalse>
 using Conditional = typename Details::Conditional<Condition, TTrue, TFalse>::Type;
 
+template<typename T> using TypeIdentity = typename Details::TypeIdentity<T>::Type;
+
 template<typename T> using AddConst            = Details::AddConst<T>;
 template<typename T> using AddVolatile         = Details::AddVolatile<T>;
 template<typename T> using AddLValueReference  = typename Details::AddReference<T>::TLValue;
@@ -0,0 +1,376 @@
+/**
+ * @brief
+ * This file is part of the MeetiX Operating System.
+ * Copyright (c) 2017-2022, Marco Cicognani (marco.cicognani@meetixos.org)
+ *
+ * @developers
+ * Marco Cicognani (marco.cicognani@meetixos.org)
+ *
+ * @license
+ * GNU General Public License version 3
+ */
+
+#include <CCLang/Core/Assertions.hh>
+#include <CCLang/Core/ToChars.hh>
+
+namespace Details {
+
+/* The conversions work on the native integers, the buffer bounds are checked once at the entry */
+using U32 = u32::NativeInt;
+using U64 = u64::NativeInt;
+using I32 = i32::NativeInt;
+
+static constexpr char C_DIGIT_PAIRS[] = "00010203040506070809"
+                                        "10111213141516171819"
+                                        "20212223242526272829"
+                                        "30313233343536373839"
+                                        "40414243444546474849"
+                                        "50515253545556575859"
+                                        "60616263646566676869"
+                                        "70717273747576777879"
+                                        "80818283848586878889"
+                                        "90919293949596979899";
+
+static constexpr U64 C_POWERS_OF_10[] = {
+    1ull,
+    10ull,
+    100ull,
+    1000ull,
+    10000ull,
+    100000ull,
+    1000000ull,
+    10000000ull,
+    100000000ull,
+    1000000000ull,
+    10000000000ull,
+    100000000000ull,
+    1000000000000ull,
+    10000000000000ull,
+    100000000000000ull,
+    1000000000000000ull,
+    10000000000000000ull,
+    100000000000000000ull,
+    1000000000000000000ull,
+    10000000000000000000ull,
+};
+
+static auto decimal_digits_count(U64 value) -> U32 {
+    U32 count = 1;
+    while ( count < 20 && value >= C_POWERS_OF_10[count] ) {
+        ++count;
+    }
+    return count;
+}
+
+static auto put_digit_pair(char* chars, U32 pair) -> void {
+    chars[0] = C_DIGIT_PAIRS[pair * 2];
+    chars[1] = C_DIGIT_PAIRS[pair * 2 + 1];
+}
+
+/**
+ * @brief Fills chars[0..count) backwards, two digits per division
+ */
+static auto decimal_to_chars(U64 value, char* chars, U32 count) -> void {
+    auto end = chars + count;
+
+    /* 64-bit divisions are emulated on 32-bit targets, leave them as soon as possible */
+    while ( value > 0xffffffffull ) {
+        auto const pair = static_cast<U32>(value % 100);
+        value /= 100;
+        end -= 2;
+        put_digit_pair(end, pair);
+    }
+
+    auto narrow_value = static_cast<U32>(value);
+    while ( narrow_value >= 100 ) {
+        auto const pair = narrow_value % 100;
+        narrow_value /= 100;
+        end -= 2;
+        put_digit_pair(end, pair);
+    }
+    if ( narrow_value >= 10 ) {
+        put_digit_pair(end - 2, narrow_value);
+    } else {
+        end[-1] = static_cast<char>('0' + narrow_value);
+    }
+}
+
+auto unsigned_to_chars(U64 value, char* chars, U32 base, bool upper_case) -> U32 {
+    auto const digits = upper_case ? "0123456789ABCDEF" : "0123456789abcdef";
+
+    if ( base == 10 ) {
+        auto const count = decimal_digits_count(value);
+        decimal_to_chars(value, chars, count);
+        return count;
+    }
+
+    if ( value == 0 ) {
+        chars[0] = '0';
+        return 1;
+    }
+
+    /* power of two bases are just a matter of shifting out the bits of each digit */
+    if ( (base & (base - 1)) == 0 ) {
+        auto const bits_per_digit = static_cast<U32>(__builtin_ctz(base));
+        auto const digit_mask     = base - 1;
+        auto const value_bits     = 64 - static_cast<U32>(__builtin_clzll(value));
+        auto const count          = (value_bits + bits_per_digit - 1) / bits_per_digit;
+        for ( auto i = count; i > 0; --i ) {
+            chars[i - 1] = digits[value & digit_mask];
+            value >>= bits_per_digit;
+        }
+        return count;
+    }
+
+    /* any other base, written backwards and flipped */
+    U32 count = 0;
+    while ( value > 0 ) {
+        chars[count++] = digits[value % base];
+        value /= base;
+    }
+    for ( U32 i = 0; i < count / 2; ++i ) {
+        auto const c         = chars[i];
+        chars[i]             = chars[count - i - 1];
+        chars[count - i - 1] = c;
+    }
+    return count;
+}
+
+#ifndef IN_KERNEL
+/**
+ * @brief Floating point number with 64-bit significand and binary exponent, used by Grisu2.
+ * See "Printing Floating-Point Numbers Quickly and Accurately with Integers" (Florian Loitsch, 2010)
+ */
+struct DiyFp {
+    U64 m_significand;
+    I32 m_exponent;
+
+    auto operator-(DiyFp const& rhs) const -> DiyFp {
+        return DiyFp{ m_significand - rhs.m_significand, m_exponent };
+    }
+
+    /**
+     * @brief Rounded upper half of the 128-bit product, built from 32-bit halves to be cheap on 32-bit targets
+     */
+    auto operator*(DiyFp const& rhs) const -> DiyFp {
+        constexpr U64 C_LOW_MASK = 0xffffffffull;
+
+        auto const a = m_significand >> 32;
+        auto const b = m_significand & C_LOW_MASK;
+        auto const c = rhs.m_significand >> 32;
+        auto const d = rhs.m_significand & C_LOW_MASK;
+
+        auto const ac = a * c;
+        auto const bc = b * c;
+        auto const ad = a * d;
+        auto const bd = b * d;
+
+        auto const middle = (bd >> 32) + (ad & C_LOW_MASK) + (bc & C_LOW_MASK) + (1ull << 31);
+        return DiyFp{ ac + (ad >> 32) + (bc >> 32) + (middle >> 32), m_exponent + rhs.m_exponent + 64 };
+    }
+
+    [[nodiscard]]
+    auto normalized() const -> DiyFp {
+        auto const shift = __builtin_clzll(m_significand);
+        return DiyFp{ m_significand << shift, m_exponent - shift };
+    }
+};
+
+/**
+ * @brief Normalized 10^k for k in [-348, 340] with step 8, which cover every exponent of the binary64 format
+ */
+static constexpr U64 C_CACHED_POWERS_SIGNIFICAND[] = {
+    0xfa8fd5a0081c0288, 0xbaaee17fa23ebf76, 0x8b16fb203055ac76, 0xcf42894a5dce35ea,
+    0x9a6bb0aa55653b2d, 0xe61acf033d1a45df, 0xab70fe17c79ac6ca, 0xff77b1fcbebcdc4f,
+    0xbe5691ef416bd60c, 0x8dd01fad907ffc3c, 0xd3515c2831559a83, 0x9d71ac8fada6c9b5,
+    0xea9c227723ee8bcb, 0xaecc49914078536d, 0x823c12795db6ce57, 0xc21094364dfb5637,
+    0x9096ea6f3848984f, 0xd77485cb25823ac7, 0xa086cfcd97bf97f4, 0xef340a98172aace5,
+    0xb23867fb2a35b28e, 0x84c8d4dfd2c63f3b, 0xc5dd44271ad3cdba, 0x936b9fcebb25c996,
+    0xdbac6c247d62a584, 0xa3ab66580d5fdaf6, 0xf3e2f893dec3f126, 0xb5b5ada8aaff80b8,
+    0x87625f056c7c4a8b, 0xc9bcff6034c13053, 0x964e858c91ba2655, 0xdff9772470297ebd,
+    0xa6dfbd9fb8e5b88f, 0xf8a95fcf88747d94, 0xb94470938fa89bcf, 0x8a08f0f8bf0f156b,
+    0xcdb02555653131b6, 0x993fe2c6d07b7fac, 0xe45c10c42a2b3b06, 0xaa242499697392d3,
+    0xfd87b5f28300ca0e, 0xbce5086492111aeb, 0x8cbccc096f5088cc, 0xd1b71758e219652c,
+    0x9c40000000000000, 0xe8d4a51000000000, 0xad78ebc5ac620000, 0x813f3978f8940984,
+    0xc097ce7bc90715b3, 0x8f7e32ce7bea5c70, 0xd5d238a4abe98068, 0x9f4f2726179a2245,
+    0xed63a231d4c4fb27, 0xb0de65388cc8ada8, 0x83c7088e1aab65db, 0xc45d1df942711d9a,
+    0x924d692ca61be758, 0xda01ee641a708dea, 0xa26da3999aef774a, 0xf209787bb47d6b85,
+    0xb454e4a179dd1877, 0x865b86925b9bc5c2, 0xc83553c5c8965d3d, 0x952ab45cfa97a0b3,
+    0xde469fbd99a05fe3, 0xa59bc234db398c25, 0xf6c69a72a3989f5c, 0xb7dcbf5354e9bece,
+    0x88fcf317f22241e2, 0xcc20ce9bd35c78a5, 0x98165af37b2153df, 0xe2a0b5dc971f303a,
+    0xa8d9d1535ce3b396, 0xfb9b7cd9a4a7443c, 0xbb764c4ca7a44410, 0x8bab8eefb6409c1a,
+    0xd01fef10a657842c, 0x9b10a4e5e9913129, 0xe7109bfba19c0c9d, 0xac2820d9623bf429,
+    0x80444b5e7aa7cf85, 0xbf21e44003acdd2d, 0x8e679c2f5e44ff8f, 0xd433179d9c8cb841,
+    0x9e19db92b4e31ba9, 0xeb96bf6ebadf77d9, 0xaf87023b9bf0ee6b,
+};
+static constexpr I32 C_CACHED_POWERS_EXPONENT[] = {
+    -1220, -1193, -1166, -1140, -1113, -1087, -1060, -1034, -1007, -980,
+    -954, -927, -901, -874, -847, -821, -794, -768, -741, -715,
+    -688, -661, -635, -608, -582, -555, -529, -502, -475, -449,
+    -422, -396, -369, -343, -316, -289, -263, -236, -210, -183,
+    -157, -130, -103, -77, -50, -24, 3, 30, 56, 83,
+    109, 136, 162, 189, 216, 242, 269, 295, 322, 348,
+    375, 402, 428, 455, 481, 508, 534, 561, 588, 614,
+    641, 667, 694, 720, 747, 774, 800, 827, 853, 880,
+    907, 933, 960, 986, 1013, 1039, 1066,
+};
+
+/**
+ * @brief Returns the cached power c = 10^-k which brings the binary exponent of c * 2^exponent into [-60, -32]
+ */
+static auto cached_power_for_binary_exponent(I32 exponent, I32& decimal_exponent) -> DiyFp {
+    /* k = ceil((-61 - exponent) * log10(2)) + 347, 78913 / 2^18 approximates log10(2) from below */
+    auto const scaled = (-61 - exponent) * 78913;
+    auto       k      = (scaled >> 18) + 347;
+    if ( (scaled & ((1 << 18) - 1)) != 0 ) {
+        ++k;
+    }
+
+    auto const index = static_cast<U32>((k >> 3) + 1);
+    decimal_exponent = -(-348 + static_cast<I32>(index) * 8);
+    return DiyFp{ C_CACHED_POWERS_SIGNIFICAND[index], C_CACHED_POWERS_EXPONENT[index] };
+}
+
+/**
+ * @brief Moves the last digit towards w while the result stays inside the rounding interval
+ */
+static auto grisu_round(char* digits, U32 digits_count, U64 delta, U64 rest, U64 ten_kappa, U64 distance_to_w) -> void {
+    while ( rest < distance_to_w && delta - rest >= ten_kappa
+            && (rest + ten_kappa < distance_to_w || distance_to_w - rest > rest + ten_kappa - distance_to_w) ) {
+        --digits[digits_count - 1];
+        rest += ten_kappa;
+    }
+}
+
+/**
+ * @brief Generates the digits of upper_boundary until they identify a number inside the rounding interval
+ */
+static auto grisu_digit_gen(DiyFp w, DiyFp upper_boundary, U64 delta, char* digits, I32& decimal_exponent) -> U32 {
+    auto const one           = DiyFp{ 1ull << -upper_boundary.m_exponent, upper_boundary.m_exponent };
+    auto const distance_to_w = upper_boundary - w;
+    auto const one_shift     = static_cast<U32>(-one.m_exponent);
+
+    auto integral   = static_cast<U32>(upper_boundary.m_significand >> one_shift);
+    auto fractional = upper_boundary.m_significand & (one.m_significand - 1);
+    auto kappa      = decimal_digits_count(integral);
+
+    U32 digits_count = 0;
+    while ( kappa > 0 ) {
+        auto const power = static_cast<U32>(C_POWERS_OF_10[kappa - 1]);
+        auto const digit = integral / power;
+        integral %= power;
+        if ( digit != 0 || digits_count != 0 ) {
+            digits[digits_count++] = static_cast<char>('0' + digit);
+        }
+        --kappa;
+
+        auto const rest = (static_cast<U64>(integral) << one_shift) + fractional;
+        if ( rest <= delta ) {
+            decimal_exponent += static_cast<I32>(kappa);
+            grisu_round(digits, digits_count, delta, rest, C_POWERS_OF_10[kappa] << one_shift, distance_to_w.m_significand);
+            return digits_count;
+        }
+    }
+
+    /* kappa is zero, continue with the fractional part */
+    I32 negative_kappa = 0;
+    while ( true ) {
+        fractional *= 10;
+        delta *= 10;
+
+        auto const digit = static_cast<char>(fractional >> one_shift);
+        if ( digit != 0 || digits_count != 0 ) {
+            digits[digits_count++] = static_cast<char>('0' + digit);
+        }
+        fractional &= one.m_significand - 1;
+        ++negative_kappa;
+
+        if ( fractional < delta ) {
+            decimal_exponent -= negative_kappa;
+            auto const scale = negative_kappa < 20 ? C_POWERS_OF_10[negative_kappa] : 0;
+            grisu_round(digits, digits_count, delta, fractional, one.m_significand, distance_to_w.m_significand * scale);
+            return digits_count;
+        }
+    }
+}
+
+/**
+ * @brief Grisu2 over a value given as significand * 2^exponent, hidden_bit tells when the lower boundary is closer
+ */
+static auto grisu2(U64 significand, I32 exponent, U64 hidden_bit, char* digits, I32& decimal_exponent) -> U32 {
+    auto const value = DiyFp{ significand, exponent };
+
+    /* the boundaries are the midpoints with the neighbour floating point values */
+    auto const upper = DiyFp{ (significand << 1) + 1, exponent - 1 }.normalized();
+    auto       lower = significand == hidden_bit ? DiyFp{ (significand << 2) - 1, exponent - 2 } : DiyFp{ (significand << 1) - 1, exponent - 1 };
+    lower.m_significand <<= lower.m_exponent - upper.m_exponent;
+    lower.m_exponent = upper.m_exponent;
+
+    I32        cached_exponent;
+    auto const cached_power = cached_power_for_binary_exponent(upper.m_exponent, cached_exponent);
+
+    auto const w        = value.normalized() * cached_power;
+    auto       w_upper  = upper * cached_power;
+    auto       w_lower  = lower * cached_power;
+    ++w_lower.m_significand;
+    --w_upper.m_significand;
+
+    decimal_exponent = cached_exponent;
+    return grisu_digit_gen(w, w_upper, w_upper.m_significand - w_lower.m_significand, digits, decimal_exponent);
+}
+#endif
+
+} /* namespace Details */
+
+auto unsigned_to_chars(u64 value, Slice<char> to_chars_buffer, u8 base, bool upper_case) -> usize {
+    verify_greater_equal$(base, 2);
+    verify_less_equal$(base, 16);
+    verify_greater_equal$(to_chars_buffer.len(), C_UNSIGNED_TO_CHARS_MAX_LEN);
+
+    return Details::unsigned_to_chars(value.unwrap(), to_chars_buffer.data(), base.unwrap(), upper_case);
+}
+
+#ifndef IN_KERNEL
+auto shortest_decimal_digits(f64 value, Slice<char> digits_buffer, i32& decimal_exponent) -> usize {
+    verify_greater$(value, 0.0);
+    verify_greater_equal$(digits_buffer.len(), C_SHORTEST_DIGITS_MAX_LEN);
+
+    constexpr u64::NativeInt C_HIDDEN_BIT       = 1ull << 52;
+    constexpr u64::NativeInt C_SIGNIFICAND_MASK = C_HIDDEN_BIT - 1;
+
+    auto const bits            = __builtin_bit_cast(u64::NativeInt, value);
+    auto const biased_exponent = static_cast<i32::NativeInt>(bits >> 52) & 0x7ff;
+    auto const significand     = bits & C_SIGNIFICAND_MASK;
+
+    i32::NativeInt exponent;
+    auto const     digits_count = ({
+        biased_exponent != 0 ? Details::grisu2(significand | C_HIDDEN_BIT, biased_exponent - 1075, C_HIDDEN_BIT, digits_buffer.data(), exponent)
+                             : Details::grisu2(significand, -1074, C_HIDDEN_BIT, digits_buffer.data(), exponent);
+    });
+
+    decimal_exponent = exponent;
+    return digits_count;
+}
+
+auto shortest_decimal_digits(f32 value, Slice<char> digits_buffer, i32& decimal_exponent) -> usize {
+    verify_greater$(value, 0.0f);
+    verify_greater_equal$(digits_buffer.len(), C_SHORTEST_DIGITS_MAX_LEN);
+
+    constexpr u32::NativeInt C_HIDDEN_BIT       = 1u << 23;
+    constexpr u32::NativeInt C_SIGNIFICAND_MASK = C_HIDDEN_BIT - 1;
+
+    auto const bits            = __builtin_bit_cast(u32::NativeInt, value);
+    auto const biased_exponent = static_cast<i32::NativeInt>(bits >> 23) & 0xff;
+    auto const significand     = bits & C_SIGNIFICAND_MASK;
+
+    /* the boundaries are computed with the binary32 precision, so the digits are the shortest for the f32 */
+    i32::NativeInt exponent;
+    auto const     digits_count = ({
+        biased_exponent != 0 ? Details::grisu2(significand | C_HIDDEN_BIT, biased_exponent - 150, C_HIDDEN_BIT, digits_buffer.data(), exponent)
+                             : Details::grisu2(significand, -149, C_HIDDEN_BIT, digits_buffer.data(), exponent);
+    });
+
+    decimal_exponent = exponent;
+    return digits_count;
+}
+#endif
@@ -0,0 +1,40 @@
+/**
+ * @brief
+ * This file is part of the MeetiX Operating System.
+ * Copyright (c) 2017-2022, Marco Cicognani (marco.cicognani@meetixos.org)
+ *
+ * @developers
+ * Marco Cicognani (marco.cicognani@meetixos.org)
+ *
+ * @license
+ * GNU General Public License version 3
+ */
+
+#pragma once
+
+#include <CCLang/Forward.hh>
+
+#include <CCLang/Lang/IntTypes.hh>
+#include <CCLang/Lang/Slice.hh>
+
+/**
+ * @brief Buffer sizes which are always enough for the conversions below
+ */
+static constexpr usize::NativeInt C_UNSIGNED_TO_CHARS_MAX_LEN = 64;
+static constexpr usize::NativeInt C_SHORTEST_DIGITS_MAX_LEN   = 18;
+
+/**
+ * @brief Writes the digits of value in the given base (from 2 to 16) at the begin of to_chars_buffer
+ * and returns how many have been written. Decimals are converted two digits per step, power-of-two
+ * bases with shifts, and 64-bit divisions are used only while the value doesn't fit 32 bits
+ */
+auto unsigned_to_chars(u64 value, Slice<char> to_chars_buffer, u8 base, bool upper_case) -> usize;
+
+#ifndef IN_KERNEL
+/**
+ * @brief Writes the shortest decimal digits which round-trip to value (Grisu2 over 64-bit DiyFp).
+ * The value must be finite and greater than zero, the result is digits * 10^decimal_exponent
+ */
+auto shortest_decimal_digits(f64 value, Slice<char> digits_buffer, i32& decimal_exponent) -> usize;
+auto shortest_decimal_digits(f32 value, Slice<char> digits_buffer, i32& decimal_exponent) -> usize;
+#endif
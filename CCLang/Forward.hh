@@ -35,6 +35,9 @@ class isize;
 template<typename>
 class Function;
 
+template<typename T, __SIZE_TYPE__ Capacity>
+class MpscQueue;
+
 template<typename T>
 class Option;
 
@@ -52,6 +55,12 @@ class StringView;
 template<typename T>
 class Slice;
 
+template<typename T, __SIZE_TYPE__ Capacity>
+class SpscQueue;
+
+template<typename T, __SIZE_TYPE__ Capacity>
+class WorkStealingDeque;
+
 /* CCLang.Core */
 
 class Error;
@@ -66,9 +75,19 @@ using ErrorOr = Result<T, Error>;
 
 /* CCLang.Alloc */
 
+class Allocator;
+
+class ArenaAllocator;
+
 template<typename T>
 class Box;
 
+template<typename T, __SIZE_TYPE__ InlineCapacity>
+class InlineVector;
+
+template<typename T>
+class LineRing;
+
 template<typename T>
 class List;
 
@@ -78,6 +97,8 @@ class Map;
 template<typename K, typename T, typename KTraits = TypeTraits<K>>
 using OrderedMap = Map<K, T, KTraits, true>;
 
+class PoolAllocator;
+
 class RefCounted;
 
 template<typename T>
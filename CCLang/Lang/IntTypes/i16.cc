@@ -488,8 +488,25 @@ auto i16::atomic_sub_fetch(i16 rhs, MemOrder mem_order) volatile -> i16 {
     return __atomic_sub_fetch(&m_value, rhs.m_value, static_cast<UnderlyingType<MemOrder>>(mem_order));
 }
 
+auto i16::atomic_compare_exchange(i16& expected, i16 desired, MemOrder mem_order) volatile -> bool {
+    /* the failure order can't have the release semantic */
+    auto failure_mem_order = mem_order;
+    if ( mem_order == MemOrder::Release )
+        failure_mem_order = MemOrder::Relaxed;
+    else if ( mem_order == MemOrder::AcquireRelease )
+        failure_mem_order = MemOrder::Acquire;
+
+    return __atomic_compare_exchange_n(&m_value,
+                                       &expected.m_value,
+                                       desired.m_value,
+                                       false,
+                                       static_cast<UnderlyingType<MemOrder>>(mem_order),
+                                       static_cast<UnderlyingType<MemOrder>>(failure_mem_order));
+}
+
 auto i16::hash_code() const -> usize {
-    auto hash_key = as<usize>();
+    /* on the native value, the mixing relies on the wrapping arithmetic */
+    auto hash_key = as<usize>().unwrap();
     hash_key += ~(hash_key << 15);
     hash_key ^= (hash_key >> 10);
     hash_key += (hash_key << 3);
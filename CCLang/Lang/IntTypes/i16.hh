@@ -162,6 +162,8 @@ public:
     auto atomic_add_fetch(i16 rhs, MemOrder mem_order = MemOrder::Total) volatile -> i16;
     auto atomic_sub_fetch(i16 rhs, MemOrder mem_order = MemOrder::Total) volatile -> i16;
 
+    auto atomic_compare_exchange(i16& expected, i16 desired, MemOrder mem_order = MemOrder::Total) volatile -> bool;
+
     auto hash_code() const -> usize;
 
 private:
@@ -162,6 +162,8 @@ public:
     auto atomic_add_fetch(i32 rhs, MemOrder mem_order = MemOrder::Total) volatile -> i32;
     auto atomic_sub_fetch(i32 rhs, MemOrder mem_order = MemOrder::Total) volatile -> i32;
 
+    auto atomic_compare_exchange(i32& expected, i32 desired, MemOrder mem_order = MemOrder::Total) volatile -> bool;
+
     auto hash_code() const -> usize;
 
 private:
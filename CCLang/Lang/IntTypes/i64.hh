@@ -162,6 +162,8 @@ public:
     auto atomic_add_fetch(i64 rhs, MemOrder mem_order = MemOrder::Total) volatile -> i64;
     auto atomic_sub_fetch(i64 rhs, MemOrder mem_order = MemOrder::Total) volatile -> i64;
 
+    auto atomic_compare_exchange(i64& expected, i64 desired, MemOrder mem_order = MemOrder::Total) volatile -> bool;
+
     auto hash_code() const -> usize;
 
 private:
@@ -162,6 +162,8 @@ public:
     auto atomic_add_fetch(i8 rhs, MemOrder mem_order = MemOrder::Total) volatile -> i8;
     auto atomic_sub_fetch(i8 rhs, MemOrder mem_order = MemOrder::Total) volatile -> i8;
 
+    auto atomic_compare_exchange(i8& expected, i8 desired, MemOrder mem_order = MemOrder::Total) volatile -> bool;
+
     auto hash_code() const -> usize;
 
 private:
@@ -162,6 +162,8 @@ public:
     auto atomic_add_fetch(isize rhs, MemOrder mem_order = MemOrder::Total) volatile -> isize;
     auto atomic_sub_fetch(isize rhs, MemOrder mem_order = MemOrder::Total) volatile -> isize;
 
+    auto atomic_compare_exchange(isize& expected, isize desired, MemOrder mem_order = MemOrder::Total) volatile -> bool;
+
     auto hash_code() const -> usize;
 
 private:
@@ -171,6 +171,8 @@ public:
     auto atomic_add_fetch(u16 rhs, MemOrder mem_order = MemOrder::Total) volatile -> u16;
     auto atomic_sub_fetch(u16 rhs, MemOrder mem_order = MemOrder::Total) volatile -> u16;
 
+    auto atomic_compare_exchange(u16& expected, u16 desired, MemOrder mem_order = MemOrder::Total) volatile -> bool;
+
     auto hash_code() const -> usize;
 
 private:
@@ -171,6 +171,8 @@ public:
     auto atomic_add_fetch(u32 rhs, MemOrder mem_order = MemOrder::Total) volatile -> u32;
     auto atomic_sub_fetch(u32 rhs, MemOrder mem_order = MemOrder::Total) volatile -> u32;
 
+    auto atomic_compare_exchange(u32& expected, u32 desired, MemOrder mem_order = MemOrder::Total) volatile -> bool;
+
     auto hash_code() const -> usize;
 
 private:
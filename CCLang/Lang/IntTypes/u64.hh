@@ -171,6 +171,8 @@ public:
     auto atomic_add_fetch(u64 rhs, MemOrder mem_order = MemOrder::Total) volatile -> u64;
     auto atomic_sub_fetch(u64 rhs, MemOrder mem_order = MemOrder::Total) volatile -> u64;
 
+    auto atomic_compare_exchange(u64& expected, u64 desired, MemOrder mem_order = MemOrder::Total) volatile -> bool;
+
     auto hash_code() const -> usize;
 
 private:
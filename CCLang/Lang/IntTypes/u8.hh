@@ -171,6 +171,8 @@ public:
     auto atomic_add_fetch(u8 rhs, MemOrder mem_order = MemOrder::Total) volatile -> u8;
     auto atomic_sub_fetch(u8 rhs, MemOrder mem_order = MemOrder::Total) volatile -> u8;
 
+    auto atomic_compare_exchange(u8& expected, u8 desired, MemOrder mem_order = MemOrder::Total) volatile -> bool;
+
     auto hash_code() const -> usize;
 
 private:
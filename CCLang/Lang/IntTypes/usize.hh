@@ -176,6 +176,9 @@ public:
     [[nodiscard]]
     auto atomic_sub_fetch(usize, MemOrder = MemOrder::Total) volatile -> usize;
 
+    [[nodiscard]]
+    auto atomic_compare_exchange(usize&, usize, MemOrder = MemOrder::Total) volatile -> bool;
+
     [[nodiscard]]
     auto hash_code() const -> usize;
 
@@ -19,4 +19,16 @@ enum class MemOrder : int {
     Release        = __ATOMIC_RELEASE,
     AcquireRelease = __ATOMIC_ACQ_REL,
     Total          = __ATOMIC_SEQ_CST
-};
\ No newline at end of file
+};
+
+/**
+ * @brief Size of the cache lines, the atomics written by different threads are kept this far to not share them
+ */
+static constexpr __SIZE_TYPE__ C_CACHE_LINE_SIZE = 64;
+
+/**
+ * @brief Orders the memory accesses around it without being bound to an atomic value
+ */
+inline auto atomic_fence(MemOrder mem_order = MemOrder::Total) -> void {
+    __atomic_thread_fence(static_cast<int>(mem_order));
+}
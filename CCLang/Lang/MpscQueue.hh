@@ -0,0 +1,130 @@
+/**
+ * @brief
+ * This file is part of the MeetiX Operating System.
+ * Copyright (c) 2017-2022, Marco Cicognani (marco.cicognani@meetixos.org)
+ *
+ * @developers
+ * Marco Cicognani (marco.cicognani@meetixos.org)
+ *
+ * @license
+ * GNU General Public License version 3
+ */
+
+#pragma once
+
+#include <CCLang/Forward.hh>
+
+#include <CCLang/Lang/Cxx.hh>
+#include <CCLang/Lang/DenyCopy.hh>
+#include <CCLang/Lang/DenyMove.hh>
+#include <CCLang/Lang/IntTypes.hh>
+#include <CCLang/Lang/MemOrder.hh>
+#include <CCLang/Lang/Option.hh>
+
+/**
+ * @brief Lock-free bounded queue between any number of producer threads and one consumer thread.
+ * Each slot keeps a sequence number which tells to the producers and to the consumer whose turn it is, so a producer
+ * only races with the others to reserve the tail. Like SpscQueue<T, Capacity> the object contains no pointers and a
+ * zero-filled memory is already an empty queue
+ */
+template<typename T, __SIZE_TYPE__ Capacity>
+class MpscQueue final : public DenyCopy, public DenyMove {
+    static_assert(Capacity > 1 && (Capacity & (Capacity - 1)) == 0, "MpscQueue<T, Capacity> needs a power of two Capacity");
+
+public:
+    /**
+     * @brief Constructors
+     */
+    MpscQueue() = default;
+
+    ~MpscQueue() {
+        while ( pop().is_present() ) {
+        }
+    }
+
+    /**
+     * @brief Enqueues the given value, returns false when the queue is full.
+     * Could be called by any thread
+     */
+    auto push(T value) -> bool {
+        auto tail = m_tail.atomic_load(MemOrder::Relaxed);
+        while ( true ) {
+            auto&      slot     = slot_at(tail.unwrap());
+            auto const distance = static_cast<isize::NativeInt>(sequence_of(slot, tail.unwrap()) - tail.unwrap());
+            if ( distance == 0 ) {
+                /* the slot is free for this lap, reserve it. On failure the tail is reloaded */
+                if ( m_tail.atomic_compare_exchange(tail, tail.unwrap() + 1, MemOrder::Relaxed) ) {
+                    new (slot.value_ptr()) T(Cxx::move(value));
+                    slot.m_sequence.atomic_store(tail.unwrap() + 1 - slot_index(tail.unwrap()), MemOrder::Release);
+                    return true;
+                }
+            } else if ( distance < 0 ) {
+                /* the consumer still has to take the value of the previous lap */
+                return false;
+            } else {
+                tail = m_tail.atomic_load(MemOrder::Relaxed);
+            }
+        }
+    }
+
+    /**
+     * @brief Dequeues the oldest value, returns OptionNone when the queue is empty.
+     * Must be called only by the consumer
+     */
+    auto pop() -> Option<T> {
+        auto const head = m_head.unwrap();
+        auto&      slot = slot_at(head);
+        if ( sequence_of(slot, head) != head + 1 )
+            return OptionNone;
+
+        auto const value_ptr = slot.value_ptr();
+        auto       value     = Cxx::move(*value_ptr);
+        value_ptr->~T();
+
+        /* give back the slot to the producers of the next lap */
+        slot.m_sequence.atomic_store(head + Capacity - slot_index(head), MemOrder::Release);
+        m_head = head + 1;
+        return value;
+    }
+
+    /**
+     * @brief Getters, the count is a snapshot which could be already old
+     */
+    auto count() const -> usize {
+        auto const tail = const_cast<usize&>(m_tail).atomic_load(MemOrder::Acquire).unwrap();
+        return tail - m_head.unwrap();
+    }
+    auto is_empty() const -> bool {
+        return count() == 0;
+    }
+    static auto capacity() -> usize {
+        return Capacity;
+    }
+
+private:
+    struct Slot {
+        /* stored relative to the slot index, so the zero-filled slots start from their own index */
+        usize m_sequence = 0;
+        alignas(T) u8::NativeInt m_storage[sizeof(T)];
+
+        auto value_ptr() -> T* {
+            return Cxx::bit_cast<T*>(&m_storage);
+        }
+    };
+
+    static auto slot_index(usize::NativeInt position) -> usize::NativeInt {
+        return position & (Capacity - 1);
+    }
+    static auto sequence_of(Slot& slot, usize::NativeInt position) -> usize::NativeInt {
+        return slot.m_sequence.atomic_load(MemOrder::Acquire).unwrap() + slot_index(position);
+    }
+
+    auto slot_at(usize::NativeInt position) -> Slot& {
+        return m_slots[slot_index(position)];
+    }
+
+private:
+    alignas(C_CACHE_LINE_SIZE) usize m_tail = 0;
+    alignas(C_CACHE_LINE_SIZE) usize m_head = 0;
+    alignas(C_CACHE_LINE_SIZE) Slot m_slots[Capacity];
+};
@@ -15,6 +15,7 @@
 #include <CCLang/Forward.hh>
 
 #include <CCLang/Core/Assertions.hh>
+#include <CCLang/Core/Meta.hh>
 #include <CCLang/Lang/IntTypes.hh>
 #include <CCLang/Lang/ReverseIteratorSupport.hh>
 
@@ -99,9 +100,9 @@ public:
      */
     auto is_end() const -> bool {
         if constexpr ( IsReverse ) {
-            return m_index.template as<usize>() == from_rend(m_slice).index();
+            return m_index == -1;
         } else {
-            return m_index.template as<usize>() == from_end(m_slice).index();
+            return m_index == m_slice.len();
         }
     }
     auto index() const -> usize {
@@ -137,8 +138,9 @@ private:
     }
 
 private:
-    TSlice& m_slice;
-    TIndex  m_index;
+    /* the slice is a view, a copy keeps valid the iterators obtained from the temporary ones (i.e. Vector<T>::begin()) */
+    ::RemoveConst<TSlice> m_slice;
+    TIndex                m_index;
 };
 
 } /* namespace Details */
@@ -268,11 +270,11 @@ public:
     }
 
     auto sub_slice(usize start) const -> Slice<T> {
-        verify_less_with_msg$(start, m_raw_slice_len, "Slice<T> - Index out of bounds in sub_slice()");
+        verify_less_equal_with_msg$(start, m_raw_slice_len, "Slice<T> - Index out of bounds in sub_slice()");
         return Slice<T>::from_raw_parts(m_raw_slice_ptr + start, len() - start);
     }
     auto sub_slice(usize start, usize count) const -> Slice<T> {
-        verify_less_with_msg$(start + count, m_raw_slice_len, "Slice<T> - Index out of bounds in sub_slice()");
+        verify_less_equal_with_msg$(start + count, m_raw_slice_len, "Slice<T> - Index out of bounds in sub_slice()");
         return Slice<T>::from_raw_parts(m_raw_slice_ptr + start, count);
     }
 
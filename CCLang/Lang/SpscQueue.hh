@@ -0,0 +1,129 @@
+/**
+ * @brief
+ * This file is part of the MeetiX Operating System.
+ * Copyright (c) 2017-2022, Marco Cicognani (marco.cicognani@meetixos.org)
+ *
+ * @developers
+ * Marco Cicognani (marco.cicognani@meetixos.org)
+ *
+ * @license
+ * GNU General Public License version 3
+ */
+
+#pragma once
+
+#include <CCLang/Forward.hh>
+
+#include <CCLang/Lang/Cxx.hh>
+#include <CCLang/Lang/DenyCopy.hh>
+#include <CCLang/Lang/DenyMove.hh>
+#include <CCLang/Lang/IntTypes.hh>
+#include <CCLang/Lang/MemOrder.hh>
+#include <CCLang/Lang/Option.hh>
+
+/**
+ * @brief Lock-free bounded queue between exactly one producer and one consumer thread.
+ * The values are stored into the object itself, which contains no pointers: a zero-filled memory is already an empty
+ * queue, so it could be constructed into a memory area shared among processes
+ */
+template<typename T, __SIZE_TYPE__ Capacity>
+class SpscQueue final : public DenyCopy, public DenyMove {
+    static_assert(Capacity > 1 && (Capacity & (Capacity - 1)) == 0, "SpscQueue<T, Capacity> needs a power of two Capacity");
+
+public:
+    /**
+     * @brief Constructors
+     */
+    SpscQueue() = default;
+
+    ~SpscQueue() {
+        while ( pop().is_present() ) {
+        }
+    }
+
+    /**
+     * @brief Enqueues the given value, returns false when the queue is full.
+     * Must be called only by the producer
+     */
+    auto push(T value) -> bool {
+        auto const tail = m_tail.atomic_load(MemOrder::Relaxed).unwrap();
+
+        /* reload the index of the consumer only when the last seen one says that the queue is full */
+        if ( tail - m_cached_head.unwrap() == Capacity ) {
+            m_cached_head = m_head.atomic_load(MemOrder::Acquire);
+            if ( tail - m_cached_head.unwrap() == Capacity )
+                return false;
+        }
+
+        new (slot(tail)) T(Cxx::move(value));
+        m_tail.atomic_store(tail + 1, MemOrder::Release);
+        return true;
+    }
+
+    /**
+     * @brief Dequeues the oldest value, returns OptionNone when the queue is empty.
+     * Must be called only by the consumer
+     */
+    auto pop() -> Option<T> {
+        auto const head = m_head.atomic_load(MemOrder::Relaxed).unwrap();
+
+        /* reload the index of the producer only when the last seen one says that the queue is empty */
+        if ( head == m_cached_tail.unwrap() ) {
+            m_cached_tail = m_tail.atomic_load(MemOrder::Acquire);
+            if ( head == m_cached_tail.unwrap() )
+                return OptionNone;
+        }
+
+        auto const value_ptr = slot(head);
+        auto       value     = Cxx::move(*value_ptr);
+        value_ptr->~T();
+
+        m_head.atomic_store(head + 1, MemOrder::Release);
+        return value;
+    }
+
+    /**
+     * @brief Returns a copy of the oldest value without dequeuing it, OptionNone when the queue is empty.
+     * Must be called only by the consumer
+     */
+    auto peek() -> Option<T> {
+        auto const head = m_head.atomic_load(MemOrder::Relaxed).unwrap();
+        if ( head == m_cached_tail.unwrap() ) {
+            m_cached_tail = m_tail.atomic_load(MemOrder::Acquire);
+            if ( head == m_cached_tail.unwrap() )
+                return OptionNone;
+        }
+
+        return *slot(head);
+    }
+
+    /**
+     * @brief Getters, exact only when called by the producer or by the consumer while the other side is idle
+     */
+    auto count() const -> usize {
+        auto const head = const_cast<usize&>(m_head).atomic_load(MemOrder::Acquire).unwrap();
+        auto const tail = const_cast<usize&>(m_tail).atomic_load(MemOrder::Acquire).unwrap();
+        return tail - head;
+    }
+    auto is_empty() const -> bool {
+        return count() == 0;
+    }
+    static auto capacity() -> usize {
+        return Capacity;
+    }
+
+private:
+    auto slot(usize::NativeInt index) -> T* {
+        return Cxx::bit_cast<T*>(&m_storage) + (index & (Capacity - 1));
+    }
+
+private:
+    /* the indexes grow forever with wrapping arithmetic, each side keeps its cache line with the copy of the other one */
+    alignas(C_CACHE_LINE_SIZE) usize m_head        = 0;
+    usize                            m_cached_tail = 0;
+
+    alignas(C_CACHE_LINE_SIZE) usize m_tail        = 0;
+    usize                            m_cached_head = 0;
+
+    alignas(C_CACHE_LINE_SIZE) alignas(T) u8::NativeInt m_storage[sizeof(T) * Capacity];
+};
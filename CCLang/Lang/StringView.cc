@@ -14,7 +14,6 @@
 
 #include <CCLang/Alloc/Vector.hh>
 #include <CCLang/Core/AllOf.hh>
-#include <CCLang/Core/AnyOf.hh>
 #include <CCLang/Core/Assertions.hh>
 #include <CCLang/Core/CharTypes.hh>
 #include <CCLang/Core/ErrorOr.hh>
@@ -365,10 +364,9 @@ auto StringView::find(char needle, usize start) const -> Option<usize> {
         return {};
     }
 
-    for ( auto i : usize::range(0, len()) ) {
-        if ( at(i) == needle ) {
-            return i;
-        }
+    auto index_or_none = find_in_memory(as_slice().sub_slice(start), needle);
+    if ( index_or_none.is_present() ) {
+        return start + index_or_none.unwrap();
     }
     return {};
 }
@@ -378,17 +376,15 @@ auto StringView::find(StringView needle, usize start) const -> Option<usize> {
         return {};
     }
 
-    return find_in_memory(Slice<char const>::from_raw_parts(as_cstr() + start, len() - start),
-                          Slice<char const>::from_raw_parts(needle.as_cstr(), needle.len()));
+    auto index_or_none = find_in_memory(as_slice().sub_slice(start), needle.as_slice());
+    if ( index_or_none.is_present() ) {
+        return start + index_or_none.unwrap();
+    }
+    return {};
 }
 
 auto StringView::find_last(char needle) const -> Option<usize> {
-    for ( usize i = len() - 1; i > 0; --i ) {
-        if ( at(i) == needle ) {
-            return i;
-        }
-    }
-    return {};
+    return find_last_in_memory(as_slice(), needle);
 }
 
 auto StringView::find_all(StringView needle) const -> Vector<usize> {
@@ -397,19 +393,17 @@ auto StringView::find_all(StringView needle) const -> Vector<usize> {
 
 auto StringView::try_find_all(StringView needle) const -> ErrorOr<Vector<usize>> {
     auto positions = Vector<usize>::empty();
+    if ( needle.is_null_or_empty() ) {
+        return positions;
+    }
 
-    usize current_position = 0;
-    while ( current_position < len() ) {
-        auto ptr_index_or_none = find_in_memory(as_slice().sub_slice(current_position), needle.as_slice());
-        if ( !ptr_index_or_none.is_present() ) {
-            break;
-        }
-
-        auto ptr_index      = ptr_index_or_none.unwrap();
-        auto relative_index = ptr_index - usize(Cxx::bit_cast<unsigned int>(as_cstr() + current_position));
+    /* the occurrences may overlap, so the search restarts one char after each of them */
+    auto index_or_none = find(needle);
+    while ( index_or_none.is_present() ) {
+        auto const index = index_or_none.unwrap();
 
-        try$(positions.try_append(current_position + relative_index));
-        current_position += relative_index + 1;
+        try$(positions.try_append(index));
+        index_or_none = find(needle, index + 1);
     }
     return positions;
 }
@@ -539,15 +533,13 @@ auto StringView::contains(char rhs, CaseSensible case_sensible) const -> bool {
         return false;
     }
 
-    return any_of<char>(begin(), end(), [rhs, case_sensible](char const c) {
-        u32 c_as_rune = c;
-        u32 r_as_rune = rhs;
-        if ( case_sensible == CaseSensible::Yes ) {
-            c_as_rune = to_ascii_lowercase(c);
-            r_as_rune = to_ascii_lowercase(r_as_rune);
-        }
-        return c_as_rune == r_as_rune;
-    });
+    if ( case_sensible == CaseSensible::Yes ) {
+        return find(rhs).is_present();
+    }
+
+    auto const lower_rhs = static_cast<char>(to_ascii_lowercase(rhs).unwrap());
+    auto const upper_rhs = static_cast<char>(to_ascii_uppercase(rhs).unwrap());
+    return find(lower_rhs).is_present() || (upper_rhs != lower_rhs && find(upper_rhs).is_present());
 }
 
 auto StringView::begin() const -> StringView::ConstIterator {
@@ -575,9 +567,10 @@ auto StringView::as_slice() const -> Slice<char const> {
 }
 
 auto StringView::hash_code() const -> usize {
-    usize hash = 0;
+    /* on the native value, the one-at-a-time hash relies on the wrapping arithmetic */
+    usize::NativeInt hash = 0;
     for ( auto const c : m_chars_slice ) {
-        hash += usize(c);
+        hash += static_cast<unsigned char>(c);
         hash += (hash << 10);
         hash ^= (hash >> 6);
     }
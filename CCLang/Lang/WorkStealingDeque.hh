@@ -0,0 +1,138 @@
+/**
+ * @brief
+ * This file is part of the MeetiX Operating System.
+ * Copyright (c) 2017-2022, Marco Cicognani (marco.cicognani@meetixos.org)
+ *
+ * @developers
+ * Marco Cicognani (marco.cicognani@meetixos.org)
+ *
+ * @license
+ * GNU General Public License version 3
+ */
+
+#pragma once
+
+#include <CCLang/Forward.hh>
+
+#include <CCLang/Core/Meta.hh>
+#include <CCLang/Lang/DenyCopy.hh>
+#include <CCLang/Lang/DenyMove.hh>
+#include <CCLang/Lang/IntTypes.hh>
+#include <CCLang/Lang/MemOrder.hh>
+#include <CCLang/Lang/Option.hh>
+
+/**
+ * @brief Chase-Lev bounded work-stealing deque.
+ * The owner thread pushes and takes the values from the bottom like a stack, while any other thread steals the oldest
+ * ones from the top. The owner and the thieves race only for the last value.
+ * A thief could read a value which it then fails to steal, so only trivially copyable values are allowed
+ */
+template<typename T, __SIZE_TYPE__ Capacity>
+class WorkStealingDeque final : public DenyCopy, public DenyMove {
+    static_assert(Capacity > 1 && (Capacity & (Capacity - 1)) == 0, "WorkStealingDeque<T, Capacity> needs a power of two Capacity");
+    static_assert(is_trivially_copyable<T>, "WorkStealingDeque<T, Capacity> needs trivially copyable values");
+
+public:
+    /**
+     * @brief Constructors
+     */
+    WorkStealingDeque() = default;
+
+    /**
+     * @brief Pushes the given value to the bottom, returns false when the deque is full.
+     * Must be called only by the owner
+     */
+    auto push(T value) -> bool {
+        auto const bottom = m_bottom.atomic_load(MemOrder::Relaxed).unwrap();
+        auto const top    = m_top.atomic_load(MemOrder::Acquire).unwrap();
+        if ( bottom - top >= Capacity )
+            return false;
+
+        slot_at(bottom) = value;
+
+        /* the value must be visible before the thieves see the new bottom */
+        atomic_fence(MemOrder::Release);
+        m_bottom.atomic_store(bottom + 1, MemOrder::Relaxed);
+        return true;
+    }
+
+    /**
+     * @brief Takes the newest value from the bottom, returns OptionNone when the deque is empty.
+     * Must be called only by the owner
+     */
+    auto take() -> Option<T> {
+        auto const bottom = m_bottom.atomic_load(MemOrder::Relaxed).unwrap() - 1;
+        m_bottom.atomic_store(bottom, MemOrder::Relaxed);
+
+        /* the thieves must see the reserved bottom before the top is read */
+        atomic_fence(MemOrder::Total);
+        auto top = m_top.atomic_load(MemOrder::Relaxed);
+
+        auto const remaining = static_cast<isize::NativeInt>(bottom - top.unwrap());
+        if ( remaining < 0 ) {
+            m_bottom.atomic_store(bottom + 1, MemOrder::Relaxed);
+            return OptionNone;
+        }
+
+        auto const value = slot_at(bottom);
+        if ( remaining > 0 )
+            return value;
+
+        /* last value, race with the thieves for it */
+        auto const won = m_top.atomic_compare_exchange(top, top.unwrap() + 1, MemOrder::Total);
+        m_bottom.atomic_store(bottom + 1, MemOrder::Relaxed);
+        if ( won )
+            return value;
+        else
+            return OptionNone;
+    }
+
+    /**
+     * @brief Steals the oldest value from the top, returns OptionNone when the deque is empty or when another thread
+     * won the race for the same value. Could be called by any thread
+     */
+    auto steal() -> Option<T> {
+        auto top = m_top.atomic_load(MemOrder::Acquire);
+        atomic_fence(MemOrder::Total);
+        auto const bottom = m_bottom.atomic_load(MemOrder::Acquire).unwrap();
+
+        if ( static_cast<isize::NativeInt>(bottom - top.unwrap()) <= 0 )
+            return OptionNone;
+
+        auto const value = slot_at(top.unwrap());
+        if ( !m_top.atomic_compare_exchange(top, top.unwrap() + 1, MemOrder::Total) )
+            return OptionNone;
+
+        return value;
+    }
+
+    /**
+     * @brief Getters, the count is a snapshot which could be already old
+     */
+    auto count() const -> usize {
+        auto const bottom = const_cast<usize&>(m_bottom).atomic_load(MemOrder::Acquire).unwrap();
+        auto const top    = const_cast<usize&>(m_top).atomic_load(MemOrder::Acquire).unwrap();
+
+        auto const count = static_cast<isize::NativeInt>(bottom - top);
+        if ( count < 0 )
+            return 0;
+        else
+            return static_cast<usize::NativeInt>(count);
+    }
+    auto is_empty() const -> bool {
+        return count() == 0;
+    }
+    static auto capacity() -> usize {
+        return Capacity;
+    }
+
+private:
+    auto slot_at(usize::NativeInt position) -> T& {
+        return m_values[position & (Capacity - 1)];
+    }
+
+private:
+    alignas(C_CACHE_LINE_SIZE) usize m_top    = 0;
+    alignas(C_CACHE_LINE_SIZE) usize m_bottom = 0;
+    alignas(C_CACHE_LINE_SIZE) T m_values[Capacity]{};
+};
@@ -13,6 +13,7 @@
 #pragma once
 
 #include <CCLang/Alloc/New.hh>
+#include <CCLang/Alloc/InlineVector.hh>
 #include <CCLang/Alloc/List.hh>
 #include <CCLang/Alloc/Map.hh>
 #include <CCLang/Alloc/NonNullRef.hh>
@@ -43,10 +44,14 @@
 #include <CCLang/Lang/DenyMove.hh>
 #include <CCLang/Lang/Function.hh>
 #include <CCLang/Lang/IntTypes.hh>
+#include <CCLang/Lang/MemOrder.hh>
+#include <CCLang/Lang/MpscQueue.hh>
 #include <CCLang/Lang/Must.hh>
 #include <CCLang/Lang/Option.hh>
 #include <CCLang/Lang/Range.hh>
 #include <CCLang/Lang/Result.hh>
 #include <CCLang/Lang/ReverseIteratorSupport.hh>
+#include <CCLang/Lang/SpscQueue.hh>
 #include <CCLang/Lang/StringView.hh>
 #include <CCLang/Lang/Try.hh>
+#include <CCLang/Lang/WorkStealingDeque.hh>
@@ -38,6 +38,7 @@
 #include "memory/LowerHeap.hpp"
 #include "memory/paging.hpp"
 #include "memory/physical/PPallocator.hpp"
+#include "memory/physical/PPreferenceTracker.hpp"
 #include "memory/TemporaryPagingUtil.hpp"
 #include "multiboot/MultibootUtil.hpp"
 #include "system/BiosDataArea.hpp"
@@ -172,6 +173,9 @@ uint32_t EvaKernel::loadRamdisk(MultibootModule* ramdiskModule) {
         VirtAddr virt = ramdiskNewLocation + i * PAGE_SIZE;
         PhysAddr phys = AddressSpace::virtualToPhysical(ramdiskModule->moduleStart + i * PAGE_SIZE);
         AddressSpace::map(virt, phys, DEFAULT_KERNEL_TABLE_FLAGS, DEFAULT_KERNEL_PAGE_FLAGS);
+
+        // the page is mapped into the processes by s_map_file(), never give it back to the allocator
+        PPreferenceTracker::increment(phys);
     }
 
     // adjust module range
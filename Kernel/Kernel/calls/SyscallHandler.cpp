@@ -88,6 +88,9 @@ const SysCallHandler::CallHandler SysCallHandler::handlers[] = {
     [SYSCALL_ATTACH_CREATED_PROCESS]       = &SysCallHandler::attachCreatedProcess,
     [SYSCALL_CANCEL_PROCESS_CREATION]      = &SysCallHandler::cancelProcessCreation,
     [SYSCALL_WRITE_TLS_MASTER_FOR_PROCESS] = &SysCallHandler::writeTlsMasterForProcess,
+    [SYSCALL_IMAGE_CACHE_MAP_SEGMENT]      = &SysCallHandler::imageCacheMapSegment,
+    [SYSCALL_IMAGE_CACHE_STORE_SEGMENT]    = &SysCallHandler::imageCacheStoreSegment,
+    [SYSCALL_MAP_FILE_IN_SPACE]            = &SysCallHandler::mapFileInSpace,
 
     [SYSCALL_MESSAGE_SEND]    = &SysCallHandler::sendMessage,
     [SYSCALL_MESSAGE_RECEIVE] = &SysCallHandler::receiveMessage,
@@ -99,6 +102,7 @@ const SysCallHandler::CallHandler SysCallHandler::handlers[] = {
     [SYSCALL_MEMORY_ALLOCATE]       = &SysCallHandler::allocMem,
     [SYSCALL_MEMORY_LOWER_FREE]     = &SysCallHandler::lowerFree,
     [SYSCALL_MEMORY_LOWER_ALLOCATE] = &SysCallHandler::lowerMalloc,
+    [SYSCALL_MEMORY_QUERY_PAGE]     = &SysCallHandler::queryPage,
 
     [SYSCALL_LOG]              = &SysCallHandler::log,
     [SYSCALL_LOG_TOGGLE_VIDEO] = &SysCallHandler::setVideoLog,
@@ -110,6 +114,7 @@ const SysCallHandler::CallHandler SysCallHandler::handlers[] = {
     [SYSCALL_FS_FSTAT]                  = &SysCallHandler::fsFstat,
     [SYSCALL_FS_WRITE]                  = &SysCallHandler::fsWrite,
     [SYSCALL_FS_LENGTH]                 = &SysCallHandler::fsLength,
+    [SYSCALL_FS_MAP]                    = &SysCallHandler::fsMap,
     [SYSCALL_FS_PIPE]                   = &SysCallHandler::fsPipe,
     [SYSCALL_FS_SEEK]                   = &SysCallHandler::fsSeek,
     [SYSCALL_FS_TELL]                   = &SysCallHandler::fsTell,
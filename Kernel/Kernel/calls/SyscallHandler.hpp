@@ -117,6 +117,9 @@ private:
     static Thread* attachCreatedProcess(Thread* state);
     static Thread* cancelProcessCreation(Thread* state);
     static Thread* writeTlsMasterForProcess(Thread* state);
+    static Thread* imageCacheMapSegment(Thread* state);
+    static Thread* imageCacheStoreSegment(Thread* state);
+    static Thread* mapFileInSpace(Thread* state);
 
     /**
      * Messaging
@@ -134,6 +137,7 @@ private:
     static Thread* allocMem(Thread* state);
     static Thread* lowerFree(Thread* state);
     static Thread* lowerMalloc(Thread* state);
+    static Thread* queryPage(Thread* state);
 
     /**
      * Serial s_log
@@ -151,6 +155,7 @@ private:
     static Thread* fsFstat(Thread* state);
     static Thread* fsWrite(Thread* state);
     static Thread* fsLength(Thread* state);
+    static Thread* fsMap(Thread* state);
 
     /**
      * File system operations
@@ -24,6 +24,8 @@
 
 #include "Api/utils/local.hpp"
 #include "calls/SyscallHandler.hpp"
+#include "EvangelionNG.hpp"
+#include "executable/ImageCache.hh"
 #include "filesystem/filesystem.hpp"
 #include "filesystem/FsTransactionHandlerDiscoveryGetLength.hpp"
 #include "filesystem/FsTransactionHandlerDiscoveryOpen.hpp"
@@ -269,6 +271,9 @@ SYSCALL_HANDLER(fsWrite) {
         return currentThread;
     }
 
+    // cached executable segments of the node are not valid anymore
+    ImageCache::invalidate(node->id);
+
     // create and start the handler
     Contextual<SyscallFsWrite*> boundData(data, currentThread->process->pageDirectory);
     FsTransactionHandlerWrite*  handler     = new FsTransactionHandlerWrite(node, fd, boundData);
@@ -419,6 +424,59 @@ SYSCALL_HANDLER(fsLength) {
     return currentThread;
 }
 
+/**
+ * Maps a range of a ramdisk file directly into the address space of the current process
+ */
+SYSCALL_HANDLER(fsMap) {
+    Process*      process = currentThread->process;
+    SyscallFsMap* data    = (SyscallFsMap*)SYSCALL_DATA(currentThread->cpuState);
+    data->m_mapped_area   = nullptr;
+
+    // find the node
+    FsNode*                node;
+    FileDescriptorContent* fd;
+    if ( !FileSystem::nodeForDescriptor(process->main->id, data->m_open_fd, &node, &fd) ) {
+        data->m_map_status = FS_MAP_INVALID_FD;
+        return currentThread;
+    }
+
+    // only content which lies page-aligned on the ramdisk image can be mapped
+    RamdiskEntry* entry = FileSystem::ramdiskEntryForNode(node);
+    if ( !entry || !EvaKernel::ramdisk->isMappable(entry, 0, entry->datalength) ) {
+        data->m_map_status = FS_MAP_NOT_SUPPORTED;
+        return currentThread;
+    }
+    if ( !EvaKernel::ramdisk->isMappable(entry, data->m_offset, data->m_length) ) {
+        data->m_map_status = FS_MAP_INVALID_RANGE;
+        return currentThread;
+    }
+
+    uint32_t pages = PAGE_ALIGN_UP(data->m_length) / PAGE_SIZE;
+    uint8_t  flags = PROC_VIRTUAL_RANGE_FLAG_FILE_MAPPING;
+    if ( data->m_map_mode == FS_MAP_MODE_PRIVATE )
+        flags |= PROC_VIRTUAL_RANGE_FLAG_COPY_ON_WRITE;
+
+    VirtAddr area = process->virtualRanges.allocate(pages, flags);
+    if ( !area || !EvaKernel::ramdisk->mapContent(entry, data->m_offset, data->m_length, area) ) {
+        if ( area )
+            process->virtualRanges.free(area);
+        data->m_map_status = FS_MAP_ERROR;
+        return currentThread;
+    }
+
+    logDebug("%! (%i:%i) mapped %i pages of node %i at %h",
+             "do_syscall",
+             process->main->id,
+             currentThread->id,
+             pages,
+             node->id,
+             area);
+
+    data->m_mapped_area = (void*)area;
+    data->m_map_status  = FS_MAP_SUCCESSFUL;
+    return currentThread;
+}
+
 /**
  * Returns the cursor position of the provided file
  */
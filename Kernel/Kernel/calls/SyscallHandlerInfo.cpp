@@ -25,6 +25,7 @@
 #include <Api/Info.h>
 #include <BuildConfig.hpp>
 #include <calls/SyscallHandler.hpp>
+#include <executable/ImageCache.hh>
 #include <memory/physical/PPallocator.hpp>
 #include <system/pci/pci.hpp>
 #include <system/system.hpp>
@@ -63,6 +64,7 @@ SYSCALL_HANDLER(sysinfo) {
     // get ram size in KB
     data->m_memory_total_amount = (PPallocator::getInitialAmount() * PAGE_SIZE / 1024);
     data->m_memory_free_amount  = (PPallocator::getFreePageCount() * PAGE_SIZE / 1024);
+    data->m_image_cache_amount  = (ImageCache::getCachedPageCount() * PAGE_SIZE / 1024);
 
     // get number of cpu cores
     data->m_cpu_count = System::getNumberOfProcessors();
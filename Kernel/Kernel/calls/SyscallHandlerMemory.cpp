@@ -142,11 +142,15 @@ SYSCALL_HANDLER(shareMem) {
                 for ( uint32_t i = 0; i < pages; i++ ) {
                     PhysAddr physicalAddr = AddressSpace::virtualToPhysical(memory + i * PAGE_SIZE);
 
+                    // Keep the memory type, i.e. a shared write-combining framebuffer
+                    uint32_t cacheFlags = AddressSpace::getPageFlags(memory + i * PAGE_SIZE)
+                                        & (PAGE_WRITETHROUGH | PAGE_CACHE_DISABLED);
+
                     AddressSpace::switchToSpace(targetProcess->pageDirectory);
                     AddressSpace::map(virtualRangeBase + i * PAGE_SIZE,
                                       physicalAddr,
                                       DEFAULT_USER_TABLE_FLAGS,
-                                      DEFAULT_USER_PAGE_FLAGS);
+                                      DEFAULT_USER_PAGE_FLAGS | cacheFlags);
                     AddressSpace::switchToSpace(executingSpace);
                 }
 
@@ -199,6 +203,8 @@ SYSCALL_HANDLER(shareMem) {
  *
  * This does not make the current process the physical owner of the physical pages,
  * as they may possibly not be used otherwise once the process unmaps them.
+ *
+ * With MMIO_FLAG_WRITE_COMBINING the pages are mapped write-combining, for framebuffers.
  */
 SYSCALL_HANDLER(mapMmio) {
     Process* process = currentThread->process;
@@ -214,12 +220,16 @@ SYSCALL_HANDLER(mapMmio) {
         VirtAddr range    = process->virtualRanges.allocate(pages, PROC_VIRTUAL_RANGE_FLAG_NONE);
         uint32_t physical = (uint32_t)data->m_physical_address;
         if ( pages > 0 && range != 0 ) {
+            uint32_t pageFlags = DEFAULT_USER_PAGE_FLAGS;
+            if ( data->m_flags & MMIO_FLAG_WRITE_COMBINING )
+                pageFlags |= PAGE_WRITE_COMBINING;
+
             // Map the pages to the space
             for ( uint32_t i = 0; i < pages; i++ )
                 AddressSpace::map(range + i * PAGE_SIZE,
                                   physical + i * PAGE_SIZE,
                                   DEFAULT_USER_TABLE_FLAGS,
-                                  DEFAULT_USER_PAGE_FLAGS);
+                                  pageFlags);
 
             data->m_mapped_ptr = (void*)range;
         }
@@ -255,6 +265,14 @@ SYSCALL_HANDLER(unmap) {
             for ( uint32_t i = 0; i < range->pages; i++ )
                 PPallocator::free(AddressSpace::virtualToPhysical(range->base + i * PAGE_SIZE));
 
+        // File mappings share their pages, free only the ones not referenced anymore
+        else if ( range->flags & PROC_VIRTUAL_RANGE_FLAG_FILE_MAPPING )
+            for ( uint32_t i = 0; i < range->pages; i++ ) {
+                PhysAddr phys = AddressSpace::virtualToPhysical(range->base + i * PAGE_SIZE);
+                if ( phys && !PPreferenceTracker::decrement(phys) )
+                    PPallocator::free(phys);
+            }
+
         // Unmap pages
         for ( uint32_t i = 0; i < range->pages; i++ )
             AddressSpace::unmap(range->base + i * PAGE_SIZE);
@@ -392,3 +410,34 @@ SYSCALL_HANDLER(lowerFree) {
     }
     return currentThread;
 }
+
+/**
+ * Describes the page of the executing process which contains the given address: the physical page
+ * behind it, whether it is writable and how many references the physical page has. It lets the
+ * tests verify the sharing of the image cache and of the file mappings from userspace
+ */
+SYSCALL_HANDLER(queryPage) {
+    SyscallQueryPage* data = (SyscallQueryPage*)SYSCALL_DATA(currentThread->cpuState);
+    data->m_found          = false;
+
+    // only the user memory of the executing process can be queried
+    VirtAddr virt = PAGE_ALIGN_DOWN(data->m_address);
+    if ( virt >= CONST_KERNEL_AREA_START )
+        return currentThread;
+
+    PageDirectory directory = (PageDirectory)CONST_RECURSIVE_PAGE_DIRECTORY_ADDRESS;
+    uint32_t      ti        = TABLE_IN_DIRECTORY_INDEX(virt);
+    uint32_t      pi        = PAGE_IN_TABLE_INDEX(virt);
+    if ( !(directory[ti] & PAGE_TABLE_PRESENT) )
+        return currentThread;
+
+    uint32_t entry = CONST_RECURSIVE_PAGE_TABLE(ti)[pi];
+    if ( !(entry & PAGE_PRESENT) )
+        return currentThread;
+
+    data->m_found            = true;
+    data->m_physical_address = entry & ~PAGE_ALIGN_MASK;
+    data->m_writable         = (entry & PAGE_READWRITE) != 0;
+    data->m_references       = PPreferenceTracker::count(data->m_physical_address);
+    return currentThread;
+}
@@ -29,6 +29,8 @@
 #include <calls/SyscallHandler.hpp>
 #include <EvangelionNG.hpp>
 #include <executable/Elf32Loader.hpp>
+#include <executable/ImageCache.hh>
+#include <filesystem/filesystem.hpp>
 #include <logger/logger.hpp>
 #include <memory/AddressSpace.hpp>
 #include <memory/physical/PPallocator.hpp>
@@ -167,13 +169,9 @@ SYSCALL_HANDLER(createPagesInSpace) {
         if ( numberOfPages > 0 && numberOfPages <= CREATE_PAGE_IN_SPACE_MAXIMUM_PAGES ) {
             // Adjust the image range of the other process if necessary. This is required so that
             // the kernel can keep track of where the process image lays in this address space.
-            if ( !targetProcess->imageStart
-                 || targetProcess->imageStart > virtualAddressInTargetSpace )
-                targetProcess->imageStart = virtualAddressInTargetSpace;
-            if ( !targetProcess->imageEnd
-                 || targetProcess->imageEnd
-                        < (virtualAddressInTargetSpace + numberOfPages * PAGE_SIZE) )
-                targetProcess->imageEnd = virtualAddressInTargetSpace + numberOfPages * PAGE_SIZE;
+            targetProcess->extendImageRange(virtualAddressInTargetSpace,
+                                            virtualAddressInTargetSpace
+                                                + numberOfPages * PAGE_SIZE);
 
             // Create physical pages and map them into the target space. Remember the physical
             // addresses
@@ -234,6 +232,148 @@ SYSCALL_HANDLER(createPagesInSpace) {
     return currentThread;
 }
 
+/**
+ * Maps into the process under creation a segment of the executable cached by a previous spawn.
+ * The pages are shared with all the other processes which run the same executable
+ */
+SYSCALL_HANDLER(imageCacheMapSegment) {
+    Process* process = currentThread->process;
+
+    SyscallImageCacheSegment* data
+        = (SyscallImageCacheSegment*)SYSCALL_DATA(currentThread->cpuState);
+    data->m_success = false;
+
+    // Only kernel level
+    if ( process->securityLevel == SECURITY_LEVEL_KERNEL ) {
+        Thread*  targetThread  = (Thread*)data->m_process_creation_identifier;
+        Process* targetProcess = targetThread->process;
+
+        FsNode*                node;
+        FileDescriptorContent* fd;
+        if ( FileSystem::nodeForDescriptor(process->main->id, data->m_file_handle, &node, &fd) ) {
+            VirtAddr virtualStart = data->m_target_space_virtual_address;
+            uint32_t pagesCount   = data->m_pages_count;
+
+            if ( ImageCache::map(node->id, targetProcess, virtualStart, pagesCount, data->m_writable) ) {
+                targetProcess->extendImageRange(virtualStart, virtualStart + pagesCount * PAGE_SIZE);
+                data->m_success = true;
+
+                logDebug("%! (%i:%i) mapped %i cached pages of node %i in process %i at %h",
+                         "do_syscall",
+                         process->main->id,
+                         currentThread->id,
+                         pagesCount,
+                         node->id,
+                         targetThread->id,
+                         virtualStart);
+            }
+        }
+    }
+
+    else {
+        logWarn("%! (%i:%i) error: insufficient permissions: map cached segment",
+                "do_syscall",
+                process->main->id,
+                currentThread->id);
+    }
+
+    return currentThread;
+}
+
+/**
+ * Stores in the image cache a segment of the executable loaded into the process under creation
+ */
+SYSCALL_HANDLER(imageCacheStoreSegment) {
+    Process* process = currentThread->process;
+
+    SyscallImageCacheSegment* data
+        = (SyscallImageCacheSegment*)SYSCALL_DATA(currentThread->cpuState);
+    data->m_success = false;
+
+    // Only kernel level
+    if ( process->securityLevel == SECURITY_LEVEL_KERNEL ) {
+        Thread*  targetThread  = (Thread*)data->m_process_creation_identifier;
+        Process* targetProcess = targetThread->process;
+
+        FsNode*                node;
+        FileDescriptorContent* fd;
+        if ( FileSystem::nodeForDescriptor(process->main->id, data->m_file_handle, &node, &fd) )
+            data->m_success = ImageCache::store(node->id,
+                                                targetProcess,
+                                                data->m_target_space_virtual_address,
+                                                data->m_pages_count,
+                                                data->m_writable);
+    }
+
+    else {
+        logWarn("%! (%i:%i) error: insufficient permissions: store cached segment",
+                "do_syscall",
+                process->main->id,
+                currentThread->id);
+    }
+
+    return currentThread;
+}
+
+/**
+ * Maps a range of a ramdisk file directly into the image of the process under creation
+ */
+SYSCALL_HANDLER(mapFileInSpace) {
+    Process* process = currentThread->process;
+
+    SyscallMapFileInSpace* data = (SyscallMapFileInSpace*)SYSCALL_DATA(currentThread->cpuState);
+    data->m_mapped_pages        = 0;
+
+    // Only kernel level
+    if ( process->securityLevel == SECURITY_LEVEL_KERNEL ) {
+        Thread*  targetThread  = (Thread*)data->m_process_creation_identifier;
+        Process* targetProcess = targetThread->process;
+
+        FsNode*                node;
+        FileDescriptorContent* fd;
+        if ( !FileSystem::nodeForDescriptor(process->main->id, data->m_file_handle, &node, &fd) )
+            return currentThread;
+
+        RamdiskEntry* entry = FileSystem::ramdiskEntryForNode(node);
+        if ( !entry || !EvaKernel::ramdisk->isMappable(entry, data->m_file_offset, data->m_length) )
+            return currentThread;
+
+        // 'data' is not available in the target space, copy the values
+        uint32_t fileOffset   = data->m_file_offset;
+        uint32_t length       = data->m_length;
+        VirtAddr virtualStart = data->m_target_space_virtual_address;
+        uint32_t pagesCount   = PAGE_ALIGN_UP(length) / PAGE_SIZE;
+
+        // the pages are read-only inside the image range, so writes are resolved by copy-on-write
+        AddressSpace::switchToSpace(targetProcess->pageDirectory);
+        bool mapped = EvaKernel::ramdisk->mapContent(entry, fileOffset, length, virtualStart);
+        AddressSpace::switchToSpace(process->pageDirectory);
+
+        if ( mapped ) {
+            targetProcess->extendImageRange(virtualStart, virtualStart + pagesCount * PAGE_SIZE);
+            data->m_mapped_pages = pagesCount;
+
+            logDebug("%! (%i:%i) mapped %i pages of node %i in process %i at %h",
+                     "do_syscall",
+                     process->main->id,
+                     currentThread->id,
+                     pagesCount,
+                     node->id,
+                     targetThread->id,
+                     virtualStart);
+        }
+    }
+
+    else {
+        logWarn("%! (%i:%i) error: insufficient permissions: map file in space",
+                "do_syscall",
+                process->main->id,
+                currentThread->id);
+    }
+
+    return currentThread;
+}
+
 /**
  * Add the pending task to the execution queue
  */
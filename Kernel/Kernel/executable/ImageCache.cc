@@ -0,0 +1,210 @@
+/**
+ * @brief
+ * This file is part of the MeetiX Operating System.
+ * Copyright (c) 2017-2022, Marco Cicognani (marco.cicognani@meetixos.org)
+ *
+ * @developers
+ * Marco Cicognani (marco.cicognani@meetixos.org)
+ *
+ * @license
+ * GNU General Public License version 3
+ */
+
+#include <executable/ImageCache.hh>
+#include <logger/logger.hpp>
+#include <memory/AddressSpace.hpp>
+#include <memory/constants.hpp>
+#include <memory/paging.hpp>
+#include <memory/physical/PPallocator.hpp>
+#include <memory/physical/PPreferenceTracker.hpp>
+#include <system/smp/GlobalLock.hpp>
+
+static GlobalLock         s_cache_lock;
+static ImageCacheSegment* s_segments       = nullptr;
+static uint32_t           s_segments_count = 0;
+static uint32_t           s_cached_pages   = 0;
+
+/**
+ * @brief Releases the cache reference of each page of the segment and destroys it
+ */
+static void release_segment(ImageCacheSegment* segment) {
+    for ( uint32_t i = 0; i < segment->m_pages_count; ++i ) {
+        if ( !PPreferenceTracker::decrement(segment->m_phys_pages[i]) )
+            PPallocator::free(segment->m_phys_pages[i]);
+    }
+
+    s_cached_pages -= segment->m_pages_count;
+    --s_segments_count;
+
+    delete[] segment->m_phys_pages;
+    delete segment;
+}
+
+/**
+ * @brief Evicts the least recently used segment, which is always the tail of the list
+ */
+static void evict_least_recently_used() {
+    ImageCacheSegment* previous = nullptr;
+    ImageCacheSegment* current  = s_segments;
+    while ( current && current->m_next ) {
+        previous = current;
+        current  = current->m_next;
+    }
+    if ( !current )
+        return;
+
+    if ( previous )
+        previous->m_next = nullptr;
+    else
+        s_segments = nullptr;
+
+    logDebug("%! evicted segment %h of node %i", "imagecache", current->m_virt_start, current->m_node_id);
+    release_segment(current);
+}
+
+/**
+ * @brief Finds the segment and moves it to the head of the list
+ */
+static ImageCacheSegment* find_segment(FsVirtID node_id, VirtAddr virt_start, uint32_t pages_count, bool writable) {
+    ImageCacheSegment* previous = nullptr;
+    for ( auto segment = s_segments; segment; segment = segment->m_next ) {
+        if ( segment->m_node_id == node_id && segment->m_virt_start == virt_start && segment->m_pages_count == pages_count
+             && segment->m_writable == writable ) {
+            if ( previous ) {
+                previous->m_next = segment->m_next;
+                segment->m_next  = s_segments;
+                s_segments       = segment;
+            }
+            return segment;
+        }
+        previous = segment;
+    }
+    return nullptr;
+}
+
+bool ImageCache::map(FsVirtID node_id, Process* target, VirtAddr virt_start, uint32_t pages_count, bool writable) {
+    s_cache_lock.lock();
+
+    auto segment = find_segment(node_id, virt_start, pages_count, writable);
+    if ( !segment ) {
+        s_cache_lock.unlock();
+        return false;
+    }
+
+    /* share the pages read-only, the copy-on-write handler gives a private copy on first write */
+    auto     executing_space = AddressSpace::getCurrentSpace();
+    uint32_t mapped_count    = 0;
+    AddressSpace::switchToSpace(target->pageDirectory);
+    for ( ; mapped_count < pages_count; ++mapped_count ) {
+        if ( !AddressSpace::map(virt_start + mapped_count * PAGE_SIZE,
+                                segment->m_phys_pages[mapped_count],
+                                DEFAULT_USER_TABLE_FLAGS,
+                                DEFAULT_USER_PAGE_FLAGS & ~PAGE_READWRITE) )
+            break;
+        PPreferenceTracker::increment(segment->m_phys_pages[mapped_count]);
+    }
+
+    /* a partially mapped segment is undone, the caller loads the whole segment from the file */
+    auto all_mapped = mapped_count == pages_count;
+    if ( !all_mapped ) {
+        for ( uint32_t i = 0; i < mapped_count; ++i ) {
+            AddressSpace::unmap(virt_start + i * PAGE_SIZE);
+            PPreferenceTracker::decrement(segment->m_phys_pages[i]);
+        }
+        logWarn("%! failed to map segment %h of node %i", "imagecache", virt_start, node_id);
+    }
+    AddressSpace::switchToSpace(executing_space);
+
+    s_cache_lock.unlock();
+    return all_mapped;
+}
+
+bool ImageCache::store(FsVirtID node_id, Process* target, VirtAddr virt_start, uint32_t pages_count, bool writable) {
+    if ( !pages_count || pages_count > IMAGE_CACHE_MAXIMUM_SEGMENT_PAGES || (virt_start & PAGE_ALIGN_MASK) )
+        return false;
+    if ( virt_start + pages_count * PAGE_SIZE > CONST_USER_VIRTUAL_RANGES_START )
+        return false;
+
+    s_cache_lock.lock();
+    if ( find_segment(node_id, virt_start, pages_count, writable) ) {
+        s_cache_lock.unlock();
+        return true;
+    }
+
+    auto phys_pages = new PhysAddr[pages_count];
+
+    /* collect the physical pages of the loaded segment and make them read-only for the target */
+    auto executing_space = AddressSpace::getCurrentSpace();
+    auto directory       = (PageDirectory)CONST_RECURSIVE_PAGE_DIRECTORY_ADDRESS;
+    auto all_mapped      = true;
+    AddressSpace::switchToSpace(target->pageDirectory);
+    for ( uint32_t i = 0; i < pages_count; ++i ) {
+        VirtAddr virt = virt_start + i * PAGE_SIZE;
+        uint32_t ti   = TABLE_IN_DIRECTORY_INDEX(virt);
+        uint32_t pi   = PAGE_IN_TABLE_INDEX(virt);
+        if ( !directory[ti] || !CONST_RECURSIVE_PAGE_TABLE(ti)[pi] ) {
+            all_mapped = false;
+            break;
+        }
+        phys_pages[i] = AddressSpace::virtualToPhysical(virt);
+    }
+    if ( all_mapped ) {
+        for ( uint32_t i = 0; i < pages_count; ++i ) {
+            VirtAddr virt = virt_start + i * PAGE_SIZE;
+            CONST_RECURSIVE_PAGE_TABLE(TABLE_IN_DIRECTORY_INDEX(virt))[PAGE_IN_TABLE_INDEX(virt)] &= ~PAGE_READWRITE;
+            INVLPG(virt);
+            PPreferenceTracker::increment(phys_pages[i]);
+        }
+    }
+    AddressSpace::switchToSpace(executing_space);
+
+    if ( !all_mapped ) {
+        s_cache_lock.unlock();
+        delete[] phys_pages;
+        return false;
+    }
+
+    if ( s_segments_count >= IMAGE_CACHE_MAXIMUM_SEGMENTS )
+        evict_least_recently_used();
+
+    auto segment           = new ImageCacheSegment();
+    segment->m_node_id     = node_id;
+    segment->m_virt_start  = virt_start;
+    segment->m_pages_count = pages_count;
+    segment->m_writable    = writable;
+    segment->m_phys_pages  = phys_pages;
+    segment->m_next        = s_segments;
+    s_segments             = segment;
+
+    ++s_segments_count;
+    s_cached_pages += pages_count;
+
+    logDebug("%! stored segment %h (%i pages) of node %i", "imagecache", virt_start, pages_count, node_id);
+    s_cache_lock.unlock();
+    return true;
+}
+
+void ImageCache::invalidate(FsVirtID node_id) {
+    s_cache_lock.lock();
+
+    ImageCacheSegment* previous = nullptr;
+    ImageCacheSegment* segment  = s_segments;
+    while ( segment ) {
+        auto next = segment->m_next;
+        if ( segment->m_node_id == node_id ) {
+            if ( previous )
+                previous->m_next = next;
+            else
+                s_segments = next;
+            release_segment(segment);
+        } else
+            previous = segment;
+        segment = next;
+    }
+
+    s_cache_lock.unlock();
+}
+
+uint32_t ImageCache::getCachedPageCount() {
+    return s_cached_pages;
+}
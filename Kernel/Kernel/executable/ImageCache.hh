@@ -0,0 +1,85 @@
+/**
+ * @brief
+ * This file is part of the MeetiX Operating System.
+ * Copyright (c) 2017-2022, Marco Cicognani (marco.cicognani@meetixos.org)
+ *
+ * @developers
+ * Marco Cicognani (marco.cicognani@meetixos.org)
+ *
+ * @license
+ * GNU General Public License version 3
+ */
+
+#pragma once
+
+#include <Api/FileSystem.h>
+#include <Api/StdInt.h>
+#include <memory/memory.hpp>
+#include <tasking/process.hpp>
+
+/**
+ * @brief Maximum amount of pages of a single cacheable segment
+ */
+#define IMAGE_CACHE_MAXIMUM_SEGMENT_PAGES 0x4000
+
+/**
+ * @brief Maximum amount of segments kept in cache, the least recently used is evicted
+ */
+#define IMAGE_CACHE_MAXIMUM_SEGMENTS 64
+
+/**
+ * @brief Cached PT_LOAD segment of an executable file
+ */
+struct ImageCacheSegment {
+    FsVirtID           m_node_id;
+    VirtAddr           m_virt_start;
+    uint32_t           m_pages_count;
+    bool               m_writable;
+    PhysAddr*          m_phys_pages;
+    ImageCacheSegment* m_next;
+};
+
+/**
+ * @brief Kernel-wide cache of loaded executable segments keyed by filesystem node.
+ * Each cached physical page holds one reference in the PPreferenceTracker for the cache itself
+ * and one for each process which maps it. Pages are always mapped read-only into the processes,
+ * writes to writable segments are resolved by the copy-on-write page-fault path.
+ */
+class ImageCache {
+public:
+    /**
+     * @brief Maps into the given process the segment cached for the given node
+     *
+     * @param node_id:      the filesystem node of the executable
+     * @param target:       the process under creation
+     * @param virt_start:   the page-aligned start of the segment
+     * @param pages_count:  the amount of pages of the segment
+     * @param writable:     whether the segment is writable
+     * @return whether the segment was cached and mapped
+     */
+    static bool map(FsVirtID node_id, Process* target, VirtAddr virt_start, uint32_t pages_count, bool writable);
+
+    /**
+     * @brief Stores in cache the segment already loaded into the given process
+     *
+     * @param node_id:      the filesystem node of the executable
+     * @param target:       the process under creation which contains the loaded pages
+     * @param virt_start:   the page-aligned start of the segment
+     * @param pages_count:  the amount of pages of the segment
+     * @param writable:     whether the segment is writable
+     * @return whether the segment was stored
+     */
+    static bool store(FsVirtID node_id, Process* target, VirtAddr virt_start, uint32_t pages_count, bool writable);
+
+    /**
+     * @brief Drops all the segments cached for the given node, called when the file content changes
+     *
+     * @param node_id:      the filesystem node to invalidate
+     */
+    static void invalidate(FsVirtID node_id);
+
+    /**
+     * @return the amount of physical pages retained by the cache
+     */
+    static uint32_t getCachedPageCount();
+};
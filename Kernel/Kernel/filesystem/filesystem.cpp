@@ -25,6 +25,7 @@
 #include "filesystem/filesystem.hpp"
 
 #include "Api/utils/local.hpp"
+#include "EvangelionNG.hpp"
 #include "filesystem/FsDelegate.hpp"
 #include "filesystem/FsDelegateMount.hpp"
 #include "filesystem/FsDelegatePipe.hpp"
@@ -48,6 +49,8 @@ static FsNode* root;
 static FsNode* pipeRoot;
 static FsNode* mountRoot;
 
+static FsDelegate* ramdiskDelegate;
+
 /**
  *
  */
@@ -70,8 +73,8 @@ void FileSystem::initialize() {
     DEBUG_INTERFACE_FILESYSTEM_UPDATE_NODE(mountRoot);
 
     // ramdisk root
-    FsNode*     ramdiskRoot     = createNode();
-    FsDelegate* ramdiskDelegate = new FsDelegateRamdisk();
+    FsNode* ramdiskRoot = createNode();
+    ramdiskDelegate     = new FsDelegateRamdisk();
     ramdiskRoot->setDelegate(ramdiskDelegate);
     ramdiskRoot->name = (char*)"ramdisk";
     ramdiskRoot->type = FS_NODE_TYPE_MOUNTPOINT;
@@ -454,3 +457,12 @@ FsPipeStatus FileSystem::pipe(Thread* thread, FileHandle* outWrite, FileHandle*
     *outRead       = mapFile(thread->process->main->id, node, 0);
     return FS_PIPE_SUCCESSFUL;
 }
+
+/**
+ * @return the ramdisk entry which backs the node, 0 if the node is not on the ramdisk
+ */
+RamdiskEntry* FileSystem::ramdiskEntryForNode(FsNode* node) {
+    if ( node->getDelegate() != ramdiskDelegate || node->type != FS_NODE_TYPE_FILE )
+        return 0;
+    return EvaKernel::ramdisk->findById(node->physFsID);
+}
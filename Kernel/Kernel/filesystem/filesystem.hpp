@@ -35,6 +35,7 @@
 #include "filesystem/FsTransactionHandlerRead.hpp"
 #include "filesystem/FsTransactionHandlerReadDirectory.hpp"
 #include "filesystem/FsTransactionHandlerWrite.hpp"
+#include "ramdisk/RamdiskEntry.hpp"
 
 #include <tasking/tasking.hpp>
 
@@ -185,6 +186,11 @@ public:
      *
      */
     static void processForked(Pid source, Pid fork);
+
+    /**
+     * @return the ramdisk entry which backs the node, 0 if the node is not on the ramdisk
+     */
+    static RamdiskEntry* ramdiskEntryForNode(FsNode* node);
 };
 
 #endif
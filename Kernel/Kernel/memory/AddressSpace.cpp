@@ -264,3 +264,20 @@ PhysAddr AddressSpace::virtualToPhysical(VirtAddr addr) {
         return 0;
     return table[pi] & ~PAGE_ALIGN_MASK;
 }
+
+/**
+ * Reads for a given virtual address (which must exist in the currently mapped
+ * address space) the flags of the page which contains it.
+ *
+ * @param addr:		the address to resolve
+ * @return the page flags
+ */
+uint32_t AddressSpace::getPageFlags(VirtAddr addr) {
+    uint32_t  ti    = TABLE_IN_DIRECTORY_INDEX(addr);
+    uint32_t  pi    = PAGE_IN_TABLE_INDEX(addr);
+    PageTable table = CONST_RECURSIVE_PAGE_TABLE(ti);
+
+    if ( !table )
+        return 0;
+    return table[pi] & PAGE_ALIGN_MASK;
+}
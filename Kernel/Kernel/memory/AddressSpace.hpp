@@ -98,6 +98,15 @@ public:
      * @return the physical address
      */
     static PhysAddr virtualToPhysical(VirtAddr addr);
+
+    /**
+     * Reads for a given virtual address (which must exist in the currently mapped
+     * address space) the flags of the page which contains it.
+     *
+     * @param addr:		the address to resolve
+     * @return the page flags
+     */
+    static uint32_t getPageFlags(VirtAddr addr);
 };
 
 #endif
@@ -195,6 +195,18 @@ AddressRange* AddressRangePool::getRanges() {
     return first;
 }
 
+/**
+ * @param address:		an address inside the range to find
+ * @return the used range which contains the address, 0 if none
+ */
+AddressRange* AddressRangePool::findUsed(Address address) {
+    for ( AddressRange* range = first; range; range = range->next ) {
+        if ( range->used && address >= range->base && address < range->base + range->pages * PAGE_SIZE )
+            return range;
+    }
+    return 0;
+}
+
 /**
  * Clears the ranges
  */
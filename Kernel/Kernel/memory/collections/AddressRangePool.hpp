@@ -118,6 +118,12 @@ public:
      */
     AddressRange* getRanges();
 
+    /**
+     * @param address:		an address inside the range to find
+     * @return the used range which contains the address, 0 if none
+     */
+    AddressRange* findUsed(Address address);
+
     /**
      * Clears the ranges
      */
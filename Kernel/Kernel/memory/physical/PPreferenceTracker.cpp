@@ -59,5 +59,25 @@ int16_t PPreferenceTracker::decrement(PhysAddr address) {
 
     if ( !directory.tables[ti] )
         return 0;
+
+    // pages which were never tracked must not go negative, otherwise a later increment would
+    // leave them with a wrong count
+    if ( directory.tables[ti]->referenceCount[pi] <= 0 )
+        return 0;
     return --(directory.tables[ti]->referenceCount[pi]);
 }
+
+/**
+ * reads the references to the provided address
+ *
+ * @param address:		the physical address to look for
+ * @return the number of references to the provided address
+ */
+int16_t PPreferenceTracker::count(PhysAddr address) {
+    uint32_t ti = TABLE_IN_DIRECTORY_INDEX(address);
+    uint32_t pi = PAGE_IN_TABLE_INDEX(address);
+
+    if ( !directory.tables[ti] )
+        return 0;
+    return directory.tables[ti]->referenceCount[pi];
+}
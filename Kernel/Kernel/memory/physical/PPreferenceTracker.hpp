@@ -63,6 +63,14 @@ public:
      * @return the number of references to the provided address
      */
     static int16_t decrement(PhysAddr address);
+
+    /**
+     * reads the references to the provided address
+     *
+     * @param address:		the physical address to look for
+     * @return the number of references to the provided address
+     */
+    static int16_t count(PhysAddr address);
 };
 
 #endif
@@ -24,6 +24,11 @@
 
 #include <EvangelionNG.hpp>
 #include <logger/logger.hpp>
+#include <memory/AddressSpace.hpp>
+#include <memory/paging.hpp>
+#include <memory/physical/PPallocator.hpp>
+#include <memory/physical/PPreferenceTracker.hpp>
+#include <memory/TemporaryPagingUtil.hpp>
 #include <ramdisk/ramdisk.hpp>
 #include <utils/string.hpp>
 
@@ -108,6 +113,10 @@ RamdiskEntry* Ramdisk::load(MultibootModule* module) {
             header->datalength      = *datalengthptr;
             ramdiskPosition         = ramdiskPosition + 4;
 
+            // big files are page-aligned by the writer to be mapped directly into processes
+            if ( header->datalength >= RAMDISK_FILE_DATA_ALIGNMENT )
+                ramdiskPosition = PAGE_ALIGN_UP(ramdiskPosition);
+
             // Copy data
             header->data    = (uint8_t*)(ramdisk + ramdiskPosition);
             ramdiskPosition = ramdiskPosition + header->datalength;
@@ -298,3 +307,84 @@ RamdiskEntry* Ramdisk::createChild(RamdiskEntry* parent, const char* filename) {
 
     return newNode;
 }
+
+/**
+ * Tells whether the given range of the entry content can be mapped directly into the
+ * processes, which is the case when the content still lies page-aligned on the ramdisk image
+ *
+ * @param entry:		the file entry
+ * @param offset:		page-aligned offset into the content
+ * @param length:		length of the range in bytes
+ * @return whether mapContent() can be used for the range
+ */
+bool Ramdisk::isMappable(RamdiskEntry* entry, uint32_t offset, uint32_t length) {
+    if ( entry->type != RAMDISK_ENTRY_TYPE_FILE || !entry->dataOnRamdisk )
+        return false;
+
+    // written files live on the heap, small ones are packed without alignment
+    if ( entry->datalength < RAMDISK_FILE_DATA_ALIGNMENT || ((VirtAddr)entry->data & (PAGE_SIZE - 1)) )
+        return false;
+
+    return length && !(offset & (PAGE_SIZE - 1)) && offset < entry->datalength
+        && length <= entry->datalength - offset;
+}
+
+/**
+ * Maps a range of the entry content read-only into the current address space. The full
+ * pages are the ramdisk pages themselves, the last partial one is a zero-filled copy.
+ * Every mapped page gets a reference, so it can be released like any other shared page
+ *
+ * @param entry:		the file entry, must be mappable for the range
+ * @param offset:		page-aligned offset into the content
+ * @param length:		length of the range in bytes
+ * @param virt:			page-aligned target address in the current address space
+ * @return whether the range was mapped, on failure nothing is left mapped
+ */
+bool Ramdisk::mapContent(RamdiskEntry* entry, uint32_t offset, uint32_t length, VirtAddr virt) {
+    uint32_t pages = PAGE_ALIGN_UP(length) / PAGE_SIZE;
+    uint32_t flags = DEFAULT_USER_PAGE_FLAGS & ~PAGE_READWRITE;
+
+    uint32_t mapped = 0;
+    while ( mapped < pages ) {
+        uint8_t* content = entry->data + offset + mapped * PAGE_SIZE;
+        uint32_t bytes   = length - mapped * PAGE_SIZE;
+
+        PhysAddr phys;
+        if ( bytes >= PAGE_SIZE )
+            phys = AddressSpace::virtualToPhysical((VirtAddr)content);
+
+        // the range ends within this page, the rest must read as zero
+        else {
+            phys = PPallocator::allocate();
+            if ( !phys )
+                break;
+
+            VirtAddr temp = TemporaryPagingUtil::map(phys);
+            Memory::copy((void*)temp, content, bytes);
+            Memory::setBytes((void*)(temp + bytes), 0, PAGE_SIZE - bytes);
+            TemporaryPagingUtil::unmap(temp);
+        }
+
+        if ( !AddressSpace::map(virt + mapped * PAGE_SIZE, phys, DEFAULT_USER_TABLE_FLAGS, flags) ) {
+            if ( bytes < PAGE_SIZE )
+                PPallocator::free(phys);
+            break;
+        }
+        PPreferenceTracker::increment(phys);
+        ++mapped;
+    }
+
+    // roll back a partial mapping
+    if ( mapped < pages ) {
+        for ( uint32_t i = 0; i < mapped; i++ ) {
+            VirtAddr page = virt + i * PAGE_SIZE;
+            PhysAddr phys = AddressSpace::virtualToPhysical(page);
+
+            AddressSpace::unmap(page);
+            if ( !PPreferenceTracker::decrement(phys) )
+                PPallocator::free(phys);
+        }
+        return false;
+    }
+    return true;
+}
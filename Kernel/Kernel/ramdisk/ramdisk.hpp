@@ -27,6 +27,7 @@
 
 #include "Api/Ramdisk.h"
 #include "Api/StdInt.h"
+#include "Api/Types.h"
 
 #include <multiboot/multiboot.hpp>
 #include <ramdisk/RamdiskEntry.hpp>
@@ -123,6 +124,30 @@ public:
      * @return the new RamdiskEntry
      */
     RamdiskEntry* createChild(RamdiskEntry* parent, const char* filename);
+
+    /**
+     * Tells whether the given range of the entry content can be mapped directly into the
+     * processes, which is the case when the content still lies page-aligned on the ramdisk image
+     *
+     * @param entry:		the file entry
+     * @param offset:		page-aligned offset into the content
+     * @param length:		length of the range in bytes
+     * @return whether mapContent() can be used for the range
+     */
+    bool isMappable(RamdiskEntry* entry, uint32_t offset, uint32_t length);
+
+    /**
+     * Maps a range of the entry content read-only into the current address space. The full
+     * pages are the ramdisk pages themselves, the last partial one is a zero-filled copy.
+     * Every mapped page gets a reference, so it can be released like any other shared page
+     *
+     * @param entry:		the file entry, must be mappable for the range
+     * @param offset:		page-aligned offset into the content
+     * @param length:		length of the range in bytes
+     * @param virt:			page-aligned target address in the current address space
+     * @return whether the range was mapped, on failure nothing is left mapped
+     */
+    bool mapContent(RamdiskEntry* entry, uint32_t offset, uint32_t length, VirtAddr virt);
 };
 
 #endif
@@ -213,9 +213,14 @@ Thread* InterruptExceptionHandler::handlePageFault(Thread* currentThread) {
     }
 
     // Copy-on-write?
-    // Check if within binary image range
-    if ( accessedVirtual >= currentThread->process->imageStart
-         && accessedVirtual <= currentThread->process->imageEnd ) {
+    // Check if within binary image range or within a private file mapping
+    PageDirectory directory = (PageDirectory)CONST_RECURSIVE_PAGE_DIRECTORY_ADDRESS;
+    AddressRange* range     = currentThread->process->virtualRanges.findUsed(accessedVirtual);
+    bool          privateMapping
+        = range && (range->flags & PROC_VIRTUAL_RANGE_FLAG_COPY_ON_WRITE) && directory[TABLE_IN_DIRECTORY_INDEX(accessedVirtual)];
+    if ( (accessedVirtual >= currentThread->process->imageStart
+          && accessedVirtual <= currentThread->process->imageEnd)
+         || privateMapping ) {
         uint32_t  ti    = TABLE_IN_DIRECTORY_INDEX(accessedVirtual);
         uint32_t  pi    = PAGE_IN_TABLE_INDEX(accessedVirtual);
         PageTable table = CONST_RECURSIVE_PAGE_TABLE(ti);
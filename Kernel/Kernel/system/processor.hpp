@@ -103,6 +103,17 @@ enum class CpuidExtendedEcxFeature
 #define IA32_APIC_BASE_MSR        0x1B
 #define IA32_APIC_BASE_MSR_BSP    0x100
 #define IA32_APIC_BASE_MSR_ENABLE 0x800
+#define IA32_PAT_MSR              0x277
+
+/**
+ * Page attribute table memory types
+ */
+#define PAT_MEMORY_TYPE_UC              0x00
+#define PAT_MEMORY_TYPE_WC              0x01
+#define PAT_MEMORY_TYPE_WT              0x04
+#define PAT_MEMORY_TYPE_WB              0x06
+#define PAT_MEMORY_TYPE_UC_MINUS        0x07
+#define PAT_ENTRY(index, memoryType)    ((uint64_t)(memoryType) << ((index)*8))
 
 /**
  * Implementation in the assembler file
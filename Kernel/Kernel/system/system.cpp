@@ -63,6 +63,9 @@ void System::initializeBasicSystemPackage(PhysAddr initialPageDirectoryPhysical)
     // Enable SSE if available
     checkAndEnableSSE();
 
+    // Enable write-combining mappings if available
+    checkAndSetupPAT();
+
     // APIC must be available
     if ( Processor::hasFeature(CpuidStandardEdxFeature::APIC) ) {
         logDebug("%! APIC available", "cpu");
@@ -136,6 +139,9 @@ void System::initializeAdvancedPackage() {
     // Enable SSE if available
     checkAndEnableSSE();
 
+    // Each core has its own PAT
+    checkAndSetupPAT();
+
     // Initialize local APIC
     Lapic::initialize();
 }
@@ -218,3 +224,28 @@ void System::checkAndEnableSSE() {
     else
         logWarn("%! no support detected", "sse");
 }
+
+/**
+ * check and program the page attribute table.
+ * Only PA1 (selected by PWT alone) changes from write-through to write-combining, so all the
+ * existing mappings keep their memory type. PA4 must stay write-back, the kernel pages have the
+ * bit 7 (PAT on 4KiB pages) set
+ */
+void System::checkAndSetupPAT() {
+    if ( Processor::hasFeature(CpuidStandardEdxFeature::PAT) ) {
+        uint64_t pat = PAT_ENTRY(0, PAT_MEMORY_TYPE_WB) | PAT_ENTRY(1, PAT_MEMORY_TYPE_WC)
+                     | PAT_ENTRY(2, PAT_MEMORY_TYPE_UC_MINUS) | PAT_ENTRY(3, PAT_MEMORY_TYPE_UC)
+                     | PAT_ENTRY(4, PAT_MEMORY_TYPE_WB) | PAT_ENTRY(5, PAT_MEMORY_TYPE_WT)
+                     | PAT_ENTRY(6, PAT_MEMORY_TYPE_UC_MINUS) | PAT_ENTRY(7, PAT_MEMORY_TYPE_UC);
+
+        // The caches must not keep lines with the old memory type
+        asm volatile("wbinvd" ::: "memory");
+        Processor::writeMsr(IA32_PAT_MSR, (uint32_t)pat, (uint32_t)(pat >> 32));
+        asm volatile("wbinvd" ::: "memory");
+
+        logInfo("%! write-combining enabled", "pat");
+    }
+
+    else
+        logWarn("%! no support detected", "pat");
+}
@@ -81,6 +81,11 @@ public:
      * check and enable the SSE/SSE2 instructions set
      */
     static void checkAndEnableSSE();
+
+    /**
+     * check and program the page attribute table
+     */
+    static void checkAndSetupPAT();
 };
 
 #endif
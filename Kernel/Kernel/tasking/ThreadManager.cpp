@@ -358,10 +358,10 @@ bool ThreadManager::createThreadUserStack(Process* process, VirtAddr* outUserSta
 void ThreadManager::freeAndUnmap(VirtAddr start, VirtAddr end, AddressRangePool* ranges) {
     // parse all the addresses
     for ( VirtAddr address = start; address < end; address += PAGE_SIZE ) {
-        // free the physical page
+        // free the physical page only when it is not shared anymore (forks, image cache)
         PhysAddr paddress = AddressSpace::virtualToPhysical(address);
-        PPreferenceTracker::decrement(paddress);
-        PPallocator::free(paddress);
+        if ( paddress && !PPreferenceTracker::decrement(paddress) )
+            PPallocator::free(paddress);
 
         // unmap the page
         AddressSpace::unmap(address);
@@ -757,6 +757,14 @@ void ThreadManager::deleteTask(Thread* thread) {
         freeAndUnmap(process->tlsMasterInProcLocation,
                      process->tlsMasterTotalsize,
                      &process->virtualRanges);
+
+        // release the file mappings, their pages are freed by the last user
+        PageDirectory directory = (PageDirectory)CONST_RECURSIVE_PAGE_DIRECTORY_ADDRESS;
+        for ( AddressRange* range = process->virtualRanges.getRanges(); range; range = range->next ) {
+            if ( range->used && (range->flags & PROC_VIRTUAL_RANGE_FLAG_FILE_MAPPING)
+                 && directory[TABLE_IN_DIRECTORY_INDEX(range->base)] )
+                freeAndUnmap(range->base, range->base + range->pages * PAGE_SIZE, 0);
+        }
         AddressSpace::switchToSpace(currentSpace);
 
         // bye bye process
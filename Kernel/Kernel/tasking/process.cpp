@@ -83,3 +83,16 @@ void Process::setPath(const char* path) {
         sourcePath = new char[StringUtils::length(path) + 1];
     StringUtils::copy(sourcePath, path);
 }
+
+/**
+ * extends the image range of the process to include the provided area
+ *
+ * @param start:	the virtual address of the area start
+ * @param end:		the virtual address of the area end
+ */
+void Process::extendImageRange(VirtAddr start, VirtAddr end) {
+    if ( !imageStart || imageStart > start )
+        imageStart = start;
+    if ( !imageEnd || imageEnd < end )
+        imageEnd = end;
+}
@@ -37,6 +37,8 @@
  */
 #define PROC_VIRTUAL_RANGE_FLAG_NONE           0
 #define PROC_VIRTUAL_RANGE_FLAG_PHYSICAL_OWNER 1
+#define PROC_VIRTUAL_RANGE_FLAG_FILE_MAPPING   2
+#define PROC_VIRTUAL_RANGE_FLAG_COPY_ON_WRITE  4
 
 /**
  * signal handler descriptor
@@ -129,6 +131,14 @@ public:
      * @param path:		the path of the process
      */
     void setPath(const char* path);
+
+    /**
+     * extends the image range of the process to include the provided area
+     *
+     * @param start:	the virtual address of the area start
+     * @param end:		the virtual address of the area end
+     */
+    void extendImageRange(VirtAddr start, VirtAddr end);
 };
 
 #endif
@@ -51,6 +51,12 @@ const uint32_t PAGE_ACCESSED       = 32;
 const uint32_t PAGE_DIRTY          = 64;
 const uint32_t PAGE_GLOBAL         = 128;
 
+/**
+ * The PAT entry selected by the PWT bit alone is programmed as write-combining at boot,
+ * without PAT support the pages are write-through, which is still better than uncached
+ */
+const uint32_t PAGE_WRITE_COMBINING = PAGE_WRITETHROUGH;
+
 /**
  * Default flags
  */
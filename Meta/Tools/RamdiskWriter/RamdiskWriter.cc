@@ -81,6 +81,7 @@ void RamdiskWriter::create(const std::string& source_path, const std::string& ta
 
             /* write this directory recursively */
             auto cursor_pos = m_out_file.tellp();
+            m_image_start   = cursor_pos;
             write_recursive(source_path, source_path, "", 0, 0, false);
             auto written_bytes = m_out_file.tellp() - cursor_pos;
 
@@ -199,6 +200,15 @@ void RamdiskWriter::write_recursive(const std::string& base_path,
         buffer_ptr[3] = static_cast<char>((content_length >> 24) & 0xFF);
         m_out_file.write(buffer_ptr, 4);
 
+        /* page-align the content of big files, the kernel maps them directly into the processes */
+        if ( content_length >= C_FILE_DATA_ALIGNMENT ) {
+            auto misalignment = static_cast<uint32_t>(m_out_file.tellp() - m_image_start) % C_FILE_DATA_ALIGNMENT;
+            if ( misalignment ) {
+                std::fill_n(buffer_ptr, C_FILE_DATA_ALIGNMENT - misalignment, 0);
+                m_out_file.write(buffer_ptr, C_FILE_DATA_ALIGNMENT - misalignment);
+            }
+        }
+
         /* open the file-content */
         std::ifstream input_file;
         input_file.open(path, std::ios::in | std::ios::binary);
@@ -40,8 +40,16 @@ private:
                          uint32_t           parent_id,
                          bool               is_file);
 
+private:
+    /**
+     * @brief Content of files at least this big starts at an image offset multiple of it.
+     * Must match the kernel's page size
+     */
+    static constexpr uint32_t C_FILE_DATA_ALIGNMENT = 0x1000;
+
 private:
     int                      m_next_id{ 0 };
+    std::streamoff           m_image_start{ 0 };
     std::ofstream            m_out_file{};
     std::vector<std::string> m_ignores{ std::string{ "*.keep" } };
 };
@@ -12,8 +12,9 @@
 
 #include "HeadlessGUIScreen.hh"
 
-#include <cassert>
+#include <algorithm>
 #include <cstring>
+#include <LibGlyph/CairoRasterizer.hh>
 #include <LibGraphics/Color.hh>
 #include <LibGraphics/Text/FontLoader.hh>
 #include <LibGraphics/Video.hh>
@@ -22,8 +23,12 @@
 bool HeadlessGUIScreen::init() {
     auto mode_is_set = Graphics::Video::set_mode(1024, 768, 32, m_vbe_mode_info);
     if ( mode_is_set ) {
-        /* allocate the raster buffer */
-        m_raster_buffer = new RasterCell[width() * height()]{};
+        /* allocate the raster lines, the history follows the visible ones into the same ring */
+        auto raster_lines_or_error = LineRing<RasterCell>::try_with_size(width(), height(), m_scrollback_lines, RasterCell{});
+        if ( raster_lines_or_error.is_error() )
+            return false;
+
+        m_raster_lines = raster_lines_or_error.unwrap();
         m_back_context.resize(m_vbe_mode_info.m_width, m_vbe_mode_info.m_height);
 
         /* load the font for the rendering */
@@ -45,14 +50,18 @@ IO::Keyboard::Info HeadlessGUIScreen::read_input() {
 void HeadlessGUIScreen::clean() {
     Tasking::LockGuard lock_guard{ m_raster_buffer_lock };
 
-    for ( auto i = 0; i < width() * height(); ++i )
-        m_raster_buffer[i] = RasterCell{};
+    /* the history goes away too */
+    m_raster_lines.clear(RasterCell{});
+    m_view_offset          = 0;
+    m_pending_scroll_lines = 0;
+    m_needs_full_repaint   = true;
     repaint();
 }
 
 void HeadlessGUIScreen::backspace() {
     Tasking::LockGuard lock_guard{ m_raster_buffer_lock };
 
+    show_live_lines_unlocked();
     move_cursor_unlocked(m_cursor_position.x() - 1, m_cursor_position.y());
     write_char_unlocked(' ');
     move_cursor_unlocked(m_cursor_position.x() - 1, m_cursor_position.y());
@@ -63,10 +72,25 @@ void HeadlessGUIScreen::write_char(char c) {
     if ( !char_is_utf8(c) )
         return;
 
+    Tasking::LockGuard lock_guard{ m_raster_buffer_lock };
+
+    show_live_lines_unlocked();
     write_char_unlocked(c);
     repaint();
 }
 
+void HeadlessGUIScreen::write_text(const char* text, int text_len) {
+    Tasking::LockGuard lock_guard{ m_raster_buffer_lock };
+
+    /* the painter is woken up once for the whole run */
+    show_live_lines_unlocked();
+    for ( auto i = 0; i < text_len; ++i ) {
+        if ( char_is_utf8(text[i]) )
+            write_char_unlocked(text[i]);
+    }
+    repaint();
+}
+
 void HeadlessGUIScreen::move_cursor(int x, int y) {
     Tasking::LockGuard lock_guard{ m_raster_buffer_lock };
 
@@ -87,7 +111,7 @@ int HeadlessGUIScreen::width() {
 }
 
 int HeadlessGUIScreen::height() {
-    return m_vbe_mode_info.m_height / m_font_dimension.height();
+    return m_vbe_mode_info.m_height / cell_height();
 }
 
 void HeadlessGUIScreen::set_scroll_area_screen() {
@@ -106,79 +130,27 @@ void HeadlessGUIScreen::set_cursor_visible(bool visible) {
     /* TODO */
 }
 
+void HeadlessGUIScreen::scroll_view(int lines) {
+    Tasking::LockGuard lock_guard{ m_raster_buffer_lock };
+
+    /* positive values go back into the history */
+    auto view_offset = std::clamp(m_view_offset + lines, 0, static_cast<int>(m_raster_lines.history_count().unwrap()));
+    if ( view_offset != m_view_offset ) {
+        m_view_offset        = view_offset;
+        m_needs_full_repaint = true;
+        repaint();
+    }
+}
+
 [[noreturn]] void HeadlessGUIScreen::paint() {
+    DamageRect damage_rects[MAX_DAMAGE_RECTS];
     while ( true ) {
         auto render_start = s_millis();
 
-        auto cr              = m_back_context.cairo_context();
-        auto argb_background = screen_color_to_argb(color_background());
-
-        /* clear the screen buffer */
-        cairo_save(cr);
-        cairo_set_source_rgba(cr, ARGB_TO_CAIRO_PARAMS(argb_background));
-        cairo_set_operator(cr, CAIRO_OPERATOR_SOURCE);
-        cairo_paint(cr);
-        cairo_restore(cr);
-
-        /* paint the characters to the graphics buffer */
-        {
-            Tasking::LockGuard lock_guard{ m_raster_buffer_lock };
-
-            /* draw the cursor */
-            //            auto blink_on = s_millis() - m_last_input_ts < 300;
-            //            if ( blink_on ) {
-            //                cairo_save(cr);
-            //                cairo_set_source_rgba(cr, 1, 1, 1, 1);
-            //                cairo_rectangle(cr,
-            //                                m_cursor_position.x() * m_font_dimension.width(),
-            //                                m_cursor_position.y() * m_font_dimension.height() + 1,
-            //                                2,
-            //                                m_font_dimension.height() + 1);
-            //                cairo_fill(cr);
-            //                cairo_restore(cr);
-            //            }
-
-            /* resize the font to the given size */
-            cairo_set_font_face(cr, m_font->cairo_font_face());
-            cairo_set_font_size(cr, 14);
-
-            /* draw each character into the graphic buffer */
-            auto cairo_scaled_font = cairo_get_scaled_font(cr);
-            for ( auto y = 0; y < height(); ++y ) {
-                for ( auto x = 0; x < width(); ++x ) {
-                    auto const& raster_cell = m_raster_buffer[y * width() + x];
-
-                    /* draw cell background */
-                    cairo_save(cr);
-                    cairo_set_source_rgba(cr, ARGB_TO_CAIRO_PARAMS(raster_cell.m_background));
-                    cairo_rectangle(cr,
-                                    x * m_font_dimension.width(),
-                                    (y + 1) * (m_font_dimension.height() + 3),
-                                    m_font_dimension.width(),
-                                    m_font_dimension.height() + 2);
-                    cairo_fill(cr);
-                    cairo_restore(cr);
-
-                    /* skip cells with un-printable character */
-                    if ( !raster_cell )
-                        continue;
-
-                    /* obtain the character glyph to draw */
-                    auto const& char_layout = cached_char_layout(cairo_scaled_font, raster_cell.m_char);
-
-                    /* draw the glyph */
-                    cairo_save(cr);
-                    cairo_set_source_rgba(cr, ARGB_TO_CAIRO_PARAMS(raster_cell.m_foreground));
-                    cairo_translate(cr, x * m_font_dimension.width(), (y + 1) * (m_font_dimension.height() + 3));
-                    cairo_glyph_path(cr, char_layout.m_cairo_glyph, char_layout.m_text_cluster[0].num_glyphs);
-                    cairo_fill(cr);
-                    cairo_restore(cr);
-                }
-            }
-        }
-
-        /* blit to the screen */
-        blit_to_screen();
+        /* render only the changed cells, then blit only the changed areas */
+        auto damage_rects_count = render_damaged_cells(m_back_context.cairo_context(), damage_rects);
+        for ( auto i = 0; i < damage_rects_count; ++i )
+            blit_to_screen(damage_rects[i]);
 
         /* limit blit to video to 60 fps */
         auto render_time = s_millis() - render_start;
@@ -190,15 +162,146 @@ void HeadlessGUIScreen::set_cursor_visible(bool visible) {
     }
 }
 
-void HeadlessGUIScreen::blit_to_screen() const {
+int HeadlessGUIScreen::render_damaged_cells(cairo_t* cr, DamageRect* damage_rects) {
+    Tasking::LockGuard lock_guard{ m_raster_buffer_lock };
+
+    /* when every line scrolled away it is cheaper to render all again than to move the buffer */
+    if ( m_pending_scroll_lines >= height() )
+        m_needs_full_repaint = true;
+
+    /* the text is blended straight into the pixels of the back buffer, cairo is only used to rasterize the glyphs */
+    auto cairo_surface = m_back_context.cairo_surface();
+    cairo_surface_flush(cairo_surface);
+
+    Glyph::ArgbTarget argb_target{ reinterpret_cast<uint32_t*>(cairo_image_surface_get_data(cairo_surface)),
+                                   static_cast<usize>(cairo_image_surface_get_stride(cairo_surface) / sizeof(uint32_t)),
+                                   static_cast<usize>(m_vbe_mode_info.m_width),
+                                   static_cast<usize>(m_vbe_mode_info.m_height) };
+
+    auto blit_all_lines = m_needs_full_repaint || m_pending_scroll_lines > 0;
+    if ( m_needs_full_repaint ) {
+        /* clear the screen buffer, the margins out of the cells grid included */
+        Glyph::fill_rect(argb_target,
+                         0,
+                         0,
+                         argb_target.m_width,
+                         argb_target.m_height,
+                         screen_color_to_argb(color_background()));
+
+        for ( auto y = 0; y < height(); ++y ) {
+            for ( auto& raster_cell : m_raster_lines.line(y, m_view_offset) )
+                raster_cell.m_is_dirty = true;
+        }
+        damage_rects[0] = DamageRect{ 0, 0, m_vbe_mode_info.m_width, m_vbe_mode_info.m_height };
+    } else if ( m_pending_scroll_lines > 0 ) {
+        /* the dirty flags moved together with the cells, so only the new lines are rendered */
+        scroll_back_buffer(m_pending_scroll_lines);
+        damage_rects[0] = DamageRect{ 0, 0, width() * m_font_dimension.width(), height() * cell_height() };
+    }
+    m_needs_full_repaint   = false;
+    m_pending_scroll_lines = 0;
+
+    /* resize the font to the given size */
+    cairo_set_font_face(cr, m_font->cairo_font_face());
+    cairo_set_font_size(cr, FONT_SIZE);
+
+    /* draw each dirty character into the graphic buffer, collecting the rows changed into damage rects */
+    auto cairo_scaled_font  = cairo_get_scaled_font(cr);
+    auto damage_rects_count = blit_all_lines ? 1 : 0;
+    for ( auto y = 0; y < height(); ++y ) {
+        auto raster_line   = m_raster_lines.line(y, m_view_offset);
+        auto first_dirty_x = -1;
+        auto last_dirty_x  = -1;
+        for ( auto x = 0; x < width(); ++x ) {
+            auto& raster_cell = raster_line[x];
+            if ( !raster_cell.m_is_dirty )
+                continue;
+
+            render_cell(argb_target, cairo_scaled_font, x, y, raster_cell);
+            raster_cell.m_is_dirty = false;
+
+            if ( first_dirty_x == -1 )
+                first_dirty_x = x;
+            last_dirty_x = x;
+        }
+        if ( first_dirty_x == -1 || blit_all_lines )
+            continue;
+
+        /* coalesce the dirty span of this row with the rect of the row above, when adjacent */
+        DamageRect row_rect{ first_dirty_x * m_font_dimension.width(),
+                             y * cell_height(),
+                             (last_dirty_x - first_dirty_x + 1) * m_font_dimension.width(),
+                             cell_height() };
+        if ( damage_rects_count == 0 )
+            damage_rects[damage_rects_count++] = row_rect;
+        else {
+            auto& last_rect = damage_rects[damage_rects_count - 1];
+            if ( last_rect.m_y + last_rect.m_height != row_rect.m_y && damage_rects_count < MAX_DAMAGE_RECTS )
+                damage_rects[damage_rects_count++] = row_rect;
+            else {
+                /* adjacent rows, or no more room: extend the last rect to the bounding box of both */
+                auto left  = std::min(last_rect.m_x, row_rect.m_x);
+                auto right = std::max(last_rect.m_x + last_rect.m_width, row_rect.m_x + row_rect.m_width);
+                last_rect  = DamageRect{ left, last_rect.m_y, right - left, row_rect.m_y + row_rect.m_height - last_rect.m_y };
+            }
+        }
+    }
+
+    cairo_surface_mark_dirty(cairo_surface);
+    return damage_rects_count;
+}
+
+void HeadlessGUIScreen::render_cell(const Glyph::ArgbTarget& argb_target,
+                                    cairo_scaled_font_t*     cairo_scaled_font,
+                                    int                      x,
+                                    int                      y,
+                                    const RasterCell&        raster_cell) {
+    /* target only the cell, the glyphs which overflow it must not dirty the neighbours */
+    Glyph::ArgbTarget cell_target{ argb_target.m_pixels_ptr + y * cell_height() * argb_target.m_stride.unwrap()
+                                       + x * m_font_dimension.width(),
+                                   argb_target.m_stride,
+                                   static_cast<usize>(m_font_dimension.width()),
+                                   static_cast<usize>(cell_height()) };
+
+    /* draw cell background */
+    Glyph::fill_rect(cell_target, 0, 0, cell_target.m_width, cell_target.m_height, raster_cell.m_background);
+
+    /* skip cells with un-printable character */
+    if ( !raster_cell )
+        return;
+
+    /* obtain the glyph, rasterized only the first time, and blend it on the baseline leaving room for the descenders */
+    Glyph::GlyphKey glyph_key{ 0, FONT_SIZE, 0, static_cast<unsigned char>(raster_cell.m_char) };
+    auto glyph_bitmap_or_error = Glyph::try_find_or_rasterize_glyph(m_glyph_atlas, cairo_scaled_font, glyph_key);
+    if ( glyph_bitmap_or_error.is_error() )
+        return;
+
+    Glyph::blend_glyph(cell_target, glyph_bitmap_or_error.unwrap(), 0, cell_height() - 3, raster_cell.m_foreground);
+}
+
+void HeadlessGUIScreen::scroll_back_buffer(int lines) {
+    auto cairo_surface = m_back_context.cairo_surface();
+
+    /* move the rendered lines up instead of render them again */
+    auto surface_data   = cairo_image_surface_get_data(cairo_surface);
+    auto surface_stride = cairo_image_surface_get_stride(cairo_surface);
+    auto scrolled_bytes = lines * cell_height() * surface_stride;
+    auto grid_bytes     = height() * cell_height() * surface_stride;
+    std::memmove(surface_data, surface_data + scrolled_bytes, grid_bytes - scrolled_bytes);
+}
+
+void HeadlessGUIScreen::blit_to_screen(const DamageRect& damage_rect) const {
     auto video_buffer  = reinterpret_cast<u8*>(m_vbe_mode_info.m_linear_framebuffer);
     auto source_buffer = reinterpret_cast<Graphics::Color::ArgbGradient*>(
         cairo_image_surface_get_data(m_back_context.cairo_surface()));
 
-    for ( auto y = 0; y < m_vbe_mode_info.m_height; ++y ) {
+    /* copy only the scan-lines slices covered by the rect, the video memory is mapped write-combining */
+    video_buffer += damage_rect.m_y * m_vbe_mode_info.m_bytes_per_scanline;
+    for ( auto y = damage_rect.m_y; y < damage_rect.m_y + damage_rect.m_height; ++y ) {
         auto argb_pixel = reinterpret_cast<Graphics::Color::ArgbGradient*>(video_buffer);
-        for ( auto x = 0; x < m_vbe_mode_info.m_width; ++x )
-            argb_pixel[x] = source_buffer[y * m_vbe_mode_info.m_width + x];
+        Glyph::stream_copy_pixels(&argb_pixel[damage_rect.m_x],
+                                  &source_buffer[y * m_vbe_mode_info.m_width + damage_rect.m_x],
+                                  static_cast<usize>(damage_rect.m_width));
 
         /* go to next scan-line */
         video_buffer += m_vbe_mode_info.m_bytes_per_scanline;
@@ -217,22 +320,19 @@ void HeadlessGUIScreen::move_cursor_unlocked(int x, int y) {
         m_cursor_position = Graphics::Metrics::Point{ 0, y + 1 };
     if ( m_cursor_position.x() < 0 )
         m_cursor_position = Graphics::Metrics::Point{ width() - 1, y - 1 };
+    if ( m_cursor_position.y() < 0 )
+        m_cursor_position = Graphics::Metrics::Point{ 0, 0 };
 
     /* scroll screen if required */
     if ( m_cursor_position.y() >= height() ) {
-        auto buffer_width = width();
-        auto buffer_bytes = buffer_width * height() * sizeof(RasterCell);
-
-        /* move all one line up */
-        std::memmove(m_raster_buffer, &m_raster_buffer[buffer_width], buffer_bytes - buffer_width);
-
-        /* clean the last line */
-        for ( auto i = 0; i < width(); ++i )
-            m_raster_buffer[buffer_bytes - buffer_width + i]
-                = RasterCell{ '\0', color_background(), color_foreground() };
+        /* only the head of the ring moves, the top line goes into the history and the new last one is cleaned */
+        m_raster_lines.scroll_up(RasterCell{ '\0', color_background(), color_foreground() });
 
         /* back the cursor */
         m_cursor_position.set_y(m_cursor_position.y() - 1);
+
+        /* the painter moves the rendered lines too */
+        ++m_pending_scroll_lines;
     }
 }
 
@@ -241,46 +341,38 @@ void HeadlessGUIScreen::write_char_unlocked(char c) {
         move_cursor_unlocked(0, m_cursor_position.y() + 1);
     else {
         RasterCell raster_cell{ c, color_background(), color_foreground() };
-        int        raster_buffer_pos{ m_cursor_position.y() * width() + m_cursor_position.x() };
 
         /* append the new character to the buffer */
-        m_raster_buffer[raster_buffer_pos] = raster_cell;
-        m_last_input_ts                    = s_millis();
+        set_cell_unlocked(m_cursor_position.x(), m_cursor_position.y(), raster_cell);
+        m_last_input_ts = s_millis();
 
         /* advance the cursor */
         move_cursor_unlocked(m_cursor_position.x() + 1, m_cursor_position.y());
     }
 }
 
-HeadlessGUIScreen::CharLayout& HeadlessGUIScreen::cached_char_layout(cairo_scaled_font_t* font, char c) {
-    auto cache_entry = m_char_layout_cache.find(c);
-    if ( cache_entry != m_char_layout_cache.end() )
-        return cache_entry->second;
-    else {
-        CharLayout                 char_layout{};
-        char                       char_buffer[]{ c, '\0' };
-        cairo_text_cluster_flags_t text_cluster_flags{};
-
-        /* extract from the font the given character */
-        auto cairo_status = cairo_scaled_font_text_to_glyphs(font,
-                                                             0,
-                                                             0,
-                                                             char_buffer,
-                                                             1,
-                                                             &char_layout.m_cairo_glyph,
-                                                             &char_layout.m_glyph_count,
-                                                             &char_layout.m_text_cluster,
-                                                             &char_layout.m_cluster_count,
-                                                             &text_cluster_flags);
-        assert(cairo_status == CAIRO_STATUS_SUCCESS);
-
-        /* put the layout into the cache, then return it */
-        auto& layout_cache_entry = m_char_layout_cache[c];
-        layout_cache_entry       = char_layout;
-        return layout_cache_entry;
+void HeadlessGUIScreen::show_live_lines_unlocked() {
+    /* the output brings back the view to the last lines */
+    if ( m_view_offset != 0 ) {
+        m_view_offset        = 0;
+        m_needs_full_repaint = true;
     }
 }
 
+void HeadlessGUIScreen::set_cell_unlocked(int x, int y, const RasterCell& raster_cell) {
+    /* rewriting the same content must not cost a render */
+    auto& current_cell = m_raster_lines.line(y)[x];
+    if ( !current_cell.same_content(raster_cell) ) {
+        current_cell            = raster_cell;
+        current_cell.m_is_dirty = true;
+    }
+}
+
+int HeadlessGUIScreen::cell_height() const {
+    /* leave some space between the lines */
+    return m_font_dimension.height() + 3;
+}
+
 bool HeadlessGUIScreen::char_is_utf8(char c) {
     return c == 0x09 || c == 0x0A || c == 0x0D || (0x20 <= c && c <= 0x7E);
 }
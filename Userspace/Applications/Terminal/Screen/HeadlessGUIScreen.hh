@@ -15,9 +15,12 @@
 #include "Screen.hh"
 
 #include <cairo/cairo.h>
+#include <CCLang/Alloc/LineRing.hh>
 #include <LibGraphics/Color.hh>
 #include <LibGraphics/Context.hh>
 #include <LibGraphics/Text/Font.hh>
+#include <LibGlyph/AlphaBlit.hh>
+#include <LibGlyph/GlyphAtlas.hh>
 #include <LibGraphics/Video.hh>
 #include <LibTasking/Lock.hh>
 #include <LibTasking/Thread.hh>
@@ -38,14 +41,6 @@ class HeadlessGUIScreen : public Screen {
         HeadlessGUIScreen& m_gui_screen;
     };
 
-    struct CharLayout {
-    public:
-        cairo_glyph_t*        m_cairo_glyph{ nullptr };
-        int                   m_glyph_count{};
-        cairo_text_cluster_t* m_text_cluster{ nullptr };
-        int                   m_cluster_count{};
-    };
-
     struct RasterCell {
     public:
         char                          m_char{ '\0' };
@@ -59,13 +54,33 @@ class HeadlessGUIScreen : public Screen {
             , m_foreground{ screen_color_to_argb(foreground) } {}
 
         operator bool() const { return m_char != '\0'; }
+
+        bool same_content(const RasterCell& other) const {
+            return m_char == other.m_char && m_background == other.m_background && m_foreground == other.m_foreground;
+        }
+
+        /* set by the writers when the content changes, cleared by the painter once rendered */
+        bool m_is_dirty{ true };
     };
 
+    /* area of the screen, in pixels, which must be copied to the video memory */
+    struct DamageRect {
+    public:
+        int m_x{ 0 };
+        int m_y{ 0 };
+        int m_width{ 0 };
+        int m_height{ 0 };
+    };
+
+    static constexpr int MAX_DAMAGE_RECTS = 32;
+    static constexpr int FONT_SIZE        = 14;
+
 public:
-    ~HeadlessGUIScreen() override {
-        delete m_painter_thread;
-        delete[] m_raster_buffer;
-    }
+    static constexpr int DEFAULT_SCROLLBACK_LINES = 1000;
+
+    explicit HeadlessGUIScreen(int scrollback_lines = DEFAULT_SCROLLBACK_LINES)
+        : m_scrollback_lines{ scrollback_lines } {}
+    ~HeadlessGUIScreen() override { delete m_painter_thread; }
 
     bool init();
 
@@ -74,6 +89,7 @@ public:
     void clean() override;
     void backspace() override;
     void write_char(char c) override;
+    void write_text(const char* text, int text_len) override;
     void move_cursor(int x, int y) override;
 
     int cursor_x() override;
@@ -87,16 +103,27 @@ public:
 
     void set_cursor_visible(bool visible) override;
 
+    void scroll_view(int lines) override;
+
 private:
     [[noreturn]] void paint();
 
-    void blit_to_screen() const;
+    int  render_damaged_cells(cairo_t* cr, DamageRect* damage_rects);
+    void render_cell(const Glyph::ArgbTarget& argb_target,
+                     cairo_scaled_font_t*     cairo_scaled_font,
+                     int                      x,
+                     int                      y,
+                     const RasterCell&        raster_cell);
+    void scroll_back_buffer(int lines);
+    void blit_to_screen(const DamageRect& damage_rect) const;
     void repaint();
 
+    void set_cell_unlocked(int x, int y, const RasterCell& raster_cell);
+    int  cell_height() const;
+
     void move_cursor_unlocked(int x, int y);
     void write_char_unlocked(char c);
-
-    CharLayout& cached_char_layout(cairo_scaled_font_t* font, char c);
+    void show_live_lines_unlocked();
 
     static bool                          char_is_utf8(char c);
     static Graphics::Color::ArgbGradient screen_color_to_argb(ScreenColor screen_color);
@@ -109,8 +136,12 @@ private:
     Graphics::Text::Font*        m_font{ nullptr };
     Tasking::Lock                m_raster_buffer_lock{};
     Tasking::Lock                m_render_lock{};
-    RasterCell*                  m_raster_buffer{ nullptr };
+    LineRing<RasterCell>         m_raster_lines{ LineRing<RasterCell>::empty() };
+    int                          m_scrollback_lines{ DEFAULT_SCROLLBACK_LINES };
+    int                          m_view_offset{ 0 };
+    int                          m_pending_scroll_lines{ 0 };
+    bool                         m_needs_full_repaint{ true };
     PainterThread*               m_painter_thread{ nullptr };
-    std::map<char, CharLayout>   m_char_layout_cache{};
+    Glyph::GlyphAtlas            m_glyph_atlas{ Glyph::GlyphAtlas::empty() };
     u64                          m_last_input_ts{ 0 };
 };
@@ -43,21 +43,22 @@ void HeadlessScreen::backspace() {
 void HeadlessScreen::write_char(char c) {
     Tasking::LockGuard lock_guard{ m_lock };
 
-    if ( c == '\n' ) {
-        m_offset += SCREEN_WIDTH * 2;
-        m_offset -= m_offset % (SCREEN_WIDTH * 2);
-    } else {
-        m_output_current[m_offset++] = c;
-        m_output_current[m_offset++] = SC_COLOR(color_background(), color_foreground());
-    }
-
-    /* ensure valid offset */
-    normalize();
+    write_char_unlocked(c);
 
     /* re-position BIOS cursor */
     update_visual_cursor();
 }
 
+void HeadlessScreen::write_text(const char* text, int text_len) {
+    Tasking::LockGuard lock_guard{ m_lock };
+
+    for ( auto i = 0; i < text_len; ++i )
+        write_char_unlocked(text[i]);
+
+    /* the BIOS cursor goes through the I/O ports, move it only at the end of the run */
+    update_visual_cursor();
+}
+
 void HeadlessScreen::move_cursor(int x, int y) {
     Tasking::LockGuard lock_guard{ m_lock };
 
@@ -134,6 +135,19 @@ void HeadlessScreen::set_cursor_visible(bool visible) {
     }
 }
 
+void HeadlessScreen::write_char_unlocked(char c) {
+    if ( c == '\n' ) {
+        m_offset += SCREEN_WIDTH * 2;
+        m_offset -= m_offset % (SCREEN_WIDTH * 2);
+    } else {
+        m_output_current[m_offset++] = c;
+        m_output_current[m_offset++] = SC_COLOR(color_background(), color_foreground());
+    }
+
+    /* ensure valid offset */
+    normalize();
+}
+
 void HeadlessScreen::normalize() {
     if ( m_offset >= SCREEN_WIDTH * SCREEN_HEIGHT * 2 ) {
         m_offset = m_offset - SCREEN_WIDTH * 2;
@@ -30,6 +30,7 @@ public:
     void clean() override;
     void backspace() override;
     void write_char(char c) override;
+    void write_text(const char* text, int text_len) override;
     void move_cursor(int x, int y) override;
 
     int cursor_x() override;
@@ -44,6 +45,7 @@ public:
     void set_cursor_visible(bool visible) override;
 
 private:
+    void write_char_unlocked(char c);
     void normalize();
     void update_visual_cursor() const;
 
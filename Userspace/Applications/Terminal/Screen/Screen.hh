@@ -59,6 +59,12 @@ public:
     virtual void write_char(char c)        = 0;
     virtual void move_cursor(int x, int y) = 0;
 
+    /* writes a run of plain text, the screens override it to update the visible state once for the whole run */
+    virtual void write_text(const char* text, int text_len) {
+        for ( auto i = 0; i < text_len; ++i )
+            write_char(text[i]);
+    }
+
     virtual int cursor_x() = 0;
     virtual int cursor_y() = 0;
     virtual int width()    = 0;
@@ -70,6 +76,9 @@ public:
 
     virtual void set_cursor_visible(bool visible) = 0;
 
+    /* moves the view into the history by the given lines, only the screens which keep one override it */
+    virtual void scroll_view(int lines) {}
+
     [[nodiscard]] ScreenColor color_foreground() const { return m_color_foreground; }
     void                      set_color_foreground(int c) { m_color_foreground = c; }
 
@@ -29,35 +29,43 @@
 
 int main(int argc, const char** argv) {
     std::string headless_mode{};
+    std::string scrollback_lines{};
 
     Utils::ArgsParser args_parser{ "Terminal", V_MAJOR, V_MINOR, V_PATCH };
     args_parser.add_option(headless_mode, "Headless mode: GUI/Text", "headless", 'l', "Mode");
+    args_parser.add_option(scrollback_lines, "Lines of history kept by the GUI headless mode", "scrollback", 's', "Lines");
 
     /* parse the arguments */
     args_parser.parse(argc, argv);
 
     /* execute the terminal */
-    Terminal terminal{ headless_mode };
+    Terminal terminal{ headless_mode, scrollback_lines };
     return terminal.run();
 }
 
 void Terminal::OutputRoutineThread::run() {
-    constexpr usize BUFFER_LEN = 1024;
+    constexpr unsigned int MIN_BUFFER_LEN = 1024;
+    constexpr unsigned int MAX_BUFFER_LEN = 64 * 1024;
 
     StreamControlStatus status;
 
-    FsReadStatus read_status;
-    Local        buffer{ new char[BUFFER_LEN] };
-    auto         output_pipe = m_is_error ? m_terminal->m_shell_err : m_terminal->m_shell_out;
+    FsReadStatus      read_status;
+    std::vector<char> buffer(MIN_BUFFER_LEN);
+    auto              output_pipe = m_is_error ? m_terminal->m_shell_err : m_terminal->m_shell_out;
     while ( true ) {
-        /* read from the  */
-        auto read_bytes = s_read_s(output_pipe, buffer(), BUFFER_LEN, &read_status);
+        /* read from the shell */
+        auto read_bytes = s_read_s(output_pipe, buffer.data(), buffer.size(), &read_status);
         if ( read_status == FS_READ_SUCCESSFUL ) {
-            Tasking::LockGuard lock_guard{ m_terminal->m_screen_lock };
+            {
+                Tasking::LockGuard lock_guard{ m_terminal->m_screen_lock };
 
-            /* write the output */
-            for ( auto i = 0; i < read_bytes; i++ )
-                m_terminal->process_output_character(status, m_is_error, buffer()[i]);
+                /* write the output */
+                m_terminal->process_output(status, m_is_error, buffer.data(), static_cast<int>(read_bytes));
+            }
+
+            /* a filled buffer means that the shell writes faster than us, so read bigger batches */
+            if ( read_bytes == buffer.size() && buffer.size() < MAX_BUFFER_LEN )
+                buffer.resize(buffer.size() * 2);
         } else
             break;
     }
@@ -117,7 +125,8 @@ void Terminal::init_screen() {
 
         /* initialize the screen */
         if ( m_headless_mode == HeadLessMode::Gui ) {
-            auto gui_screen = new HeadlessGUIScreen{};
+            auto gui_screen = m_scrollback_lines < 0 ? new HeadlessGUIScreen{}
+                                                     : new HeadlessGUIScreen{ m_scrollback_lines };
             if ( gui_screen->init() )
                 m_screen = gui_screen;
             else {
@@ -193,29 +202,34 @@ void Terminal::write_shellkey_to_shell(int shell_key) const {
     write(m_shell_in, &buf, 3);
 }
 
+void Terminal::process_output(StreamControlStatus& status, bool is_err_stream, const char* buffer, int buffer_len) {
+    auto i = 0;
+    while ( i < buffer_len ) {
+        /* the runs of plain text go to the screen with one write, only the rest goes through the state machine */
+        if ( status.m_stream_status == TerminalStreamStatus::Text ) {
+            auto text_len = plain_text_len(&buffer[i], buffer_len - i);
+            if ( text_len > 0 ) {
+                write_text_to_screen(is_err_stream, &buffer[i], text_len);
+                i += text_len;
+                continue;
+            }
+        }
+
+        process_output_character(status, is_err_stream, buffer[i++]);
+    }
+}
+
 void Terminal::process_output_character(StreamControlStatus& status, bool is_err_stream, char c) {
     if ( status.m_stream_status == TerminalStreamStatus::Text ) {
         /* simple textual output */
         if ( c == '\r' )
             return;
-        else if ( c == '\t' ) {
-            m_screen->write_char(' ');
-            m_screen->write_char(' ');
-            m_screen->write_char(' ');
-            m_screen->write_char(' ');
-        } else if ( c == SHELLKEY_ESC )
+        else if ( c == '\t' )
+            m_screen->write_text("    ", 4);
+        else if ( c == SHELLKEY_ESC )
             status.m_stream_status = TerminalStreamStatus::LastWasEsc;
-        else {
-            /* save previous foreground for error */
-            auto last_foreground = m_screen->color_foreground();
-            if ( is_err_stream )
-                m_screen->set_color_foreground(SC_RED);
-
-            m_screen->write_char(c);
-
-            if ( is_err_stream )
-                m_screen->set_color_foreground(last_foreground);
-        }
+        else
+            write_text_to_screen(is_err_stream, &c, 1);
     } else if ( status.m_stream_status == TerminalStreamStatus::LastWasEsc ) {
         /* must be followed by [ for VT100 sequence or a terminal sequence */
         if ( c == '[' )
@@ -258,6 +272,18 @@ void Terminal::process_output_character(StreamControlStatus& status, bool is_err
     }
 }
 
+void Terminal::write_text_to_screen(bool is_err_stream, const char* text, int text_len) {
+    /* save previous foreground for error */
+    auto last_foreground = m_screen->color_foreground();
+    if ( is_err_stream )
+        m_screen->set_color_foreground(SC_RED);
+
+    m_screen->write_text(text, text_len);
+
+    if ( is_err_stream )
+        m_screen->set_color_foreground(last_foreground);
+}
+
 void Terminal::process_vt100_sequence(StreamControlStatus& status) {
     switch ( status.m_control_character ) {
         case 'A':
@@ -379,6 +405,18 @@ ScreenColor Terminal::convert_vt100_to_screen_color(int color) {
     }
 }
 
+int Terminal::plain_text_len(const char* buffer, int buffer_len) {
+    /* the printable characters and the new-lines need nothing more than a write to the screen */
+    auto text_len = 0;
+    while ( text_len < buffer_len ) {
+        auto c = buffer[text_len];
+        if ( c != '\n' && (c < 0x20 || c > 0x7E) )
+            break;
+        ++text_len;
+    }
+    return text_len;
+}
+
 bool Terminal::shell_is_alive() const {
     return s_get_pid_for_tid(m_shell_proc_id) == m_shell_proc_id;
 }
@@ -402,6 +440,12 @@ int Terminal::input_routine() {
 
                 /* clear the buffer */
                 buffer.clear();
+            } else if ( read_input.m_ctrl && read_input.m_key == "KEY_ARROW_UP" && read_input.m_is_pressed ) {
+                Tasking::LockGuard lock_guard{ m_screen_lock };
+                m_screen->scroll_view(1);
+            } else if ( read_input.m_ctrl && read_input.m_key == "KEY_ARROW_DOWN" && read_input.m_is_pressed ) {
+                Tasking::LockGuard lock_guard{ m_screen_lock };
+                m_screen->scroll_view(-1);
             } else if ( (read_input.m_ctrl && read_input.m_key == "KEY_C") || (read_input.m_key == "KEY_ESC") ) {
                 if ( m_current_proc_id )
                     s_raise_signal(m_current_proc_id, SIGINT);
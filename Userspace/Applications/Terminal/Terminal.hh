@@ -17,6 +17,8 @@
 
 #include <algorithm>
 #include <Api.h>
+#include <cstdlib>
+#include <vector>
 #include <LibIO/Shell.hh>
 #include <LibTasking/Lock.hh>
 #include <LibTasking/Thread.hh>
@@ -59,8 +61,9 @@ public:
     /**
      * @brief Constructor
      */
-    Terminal(const std::string& headless_mode)
-        : m_headless_mode{ (from_string(headless_mode)) } {}
+    Terminal(const std::string& headless_mode, const std::string& scrollback_lines)
+        : m_headless_mode{ (from_string(headless_mode)) }
+        , m_scrollback_lines{ scrollback_lines.empty() ? -1 : std::max(0, std::atoi(scrollback_lines.c_str())) } {}
     ~Terminal() {
         delete m_std_out_thread;
         delete m_err_out_thread;
@@ -79,11 +82,14 @@ private:
     void write_string_to_shell(const std::string& line) const;
     void write_shellkey_to_shell(int shell_key) const;
 
+    void process_output(StreamControlStatus& status, bool is_err_stream, const char* buffer, int buffer_len);
     void process_output_character(StreamControlStatus& status, bool is_err_stream, char c);
+    void write_text_to_screen(bool is_err_stream, const char* text, int text_len);
     void process_vt100_sequence(StreamControlStatus& status);
     void process_term_sequence(StreamControlStatus& status);
 
     static ScreenColor convert_vt100_to_screen_color(int color);
+    static int         plain_text_len(const char* buffer, int buffer_len);
 
     [[nodiscard]] bool shell_is_alive() const;
     int                input_routine();
@@ -95,6 +101,7 @@ private:
     OutputRoutineThread* m_std_out_thread{ nullptr };
     OutputRoutineThread* m_err_out_thread{ nullptr };
     HeadLessMode         m_headless_mode{ HeadLessMode::None };
+    int                  m_scrollback_lines{ -1 };
     Screen*              m_screen{ nullptr };
     Tasking::Lock        m_screen_lock{};
     bool                 m_do_echo{ true };
@@ -0,0 +1,98 @@
+/* * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * *  * * * * * * * *
+ * MeetiX OS By MeetiX OS Project [Marco Cicognani]                                    *
+ *                                                                                     *
+ * This program is free software; you can redistribute it and/or                       *
+ * modify it under the terms of the GNU General Public License                         *
+ * as published by the Free Software Foundation; either version 2                      *
+ * of the License, or (char *argumentat your option) any later version.                *
+ *                                                                                     *
+ * This program is distributed in the hope that it will be useful,                     *
+ * but WITHout ANY WARRANTY; without even the implied warranty of                      *
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the                       *
+ * GNU General Public License for more details.                                        *
+ *                                                                                     *
+ * You should have received a copy of the GNU General Public License                   *
+ * along with this program; if not, write to the Free Software                         *
+ * Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301  USA      *
+ * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * *  * * * * * * */
+
+#ifndef _COMMAND_HASH_
+#define _COMMAND_HASH_
+
+#include <Api.h>
+#include <map>
+#include <string>
+#include <string_view>
+
+/*
+ * milliseconds for which a command not found is remembered, no notification
+ * tells the shell when a file is created so the miss expires by itself
+ */
+#define COMMAND_HASH_MISS_MILLIS 1000
+
+/*
+ * the table is dropped entirely when it grows over this amount of entries
+ */
+#define COMMAND_HASH_MAXIMUM_ENTRIES 64
+
+/*
+ * class that remembers where the commands were found, like the hash of the
+ * unix shells. A found command is trusted until its spawn fails, a command not
+ * found only for COMMAND_HASH_MISS_MILLIS, and the whole table is dropped when
+ * the search path changes
+ */
+class CommandHash {
+public:
+    struct Entry {
+        std::string        name;
+        std::string        path;
+        bool               found;
+        unsigned long long missExpiration;
+        unsigned int       hits;
+    };
+
+    /*
+     * resolve the command name from the working directory, as full path or
+     * from the search path, without touching the filesystem when hashed.
+     * The name itself is returned when the command is not found
+     */
+    std::string resolve(const std::string_view& cwd, const std::string& name, const std::string& searchPath);
+
+    /*
+     * forget the hashed resolution and resolve it again, return whether the
+     * command is now found elsewhere
+     */
+    bool rehash(const std::string_view& cwd,
+                const std::string&      name,
+                const std::string&      searchPath,
+                std::string&            outPath);
+
+    /*
+     * forget all the resolutions
+     */
+    void clear();
+
+    /*
+     * get all the hashed resolutions
+     */
+    const std::map<std::string, Entry>& getEntries() const {
+        return entries;
+    }
+
+private:
+    // look for the command on the filesystem
+    bool probe(const std::string_view& cwd, const std::string& name, const std::string& searchPath, std::string& outPath);
+
+    // resolutions keyed by the command as seen from the working directory
+    std::map<std::string, Entry> entries;
+
+    // search path which produced the resolutions
+    std::string hashedSearchPath;
+};
+
+/*
+ * hash shared by the shell and the script interpreter
+ */
+extern CommandHash g_command_hash;
+
+#endif
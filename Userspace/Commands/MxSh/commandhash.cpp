@@ -0,0 +1,128 @@
+/* * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * *  * * * * * * * *
+ * MeetiX OS By MeetiX OS Project [Marco Cicognani]                                    *
+ *                                                                                     *
+ * This program is free software; you can redistribute it and/or                       *
+ * modify it under the terms of the GNU General Public License                         *
+ * as published by the Free Software Foundation; either version 2                      *
+ * of the License, or (char *argumentat your option) any later version.                *
+ *                                                                                     *
+ * This program is distributed in the hope that it will be useful,                     *
+ * but WITHout ANY WARRANTY; without even the implied warranty of                      *
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the                       *
+ * GNU General Public License for more details.                                        *
+ *                                                                                     *
+ * You should have received a copy of the GNU General Public License                   *
+ * along with this program; if not, write to the Free Software                         *
+ * Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301  USA      *
+ * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * *  * * * * * * */
+
+#include "CommandHash.hpp"
+
+CommandHash g_command_hash;
+
+/*
+ * check whether the file exists
+ */
+static bool fileExists(const std::string& path) {
+    FileHandle file;
+    if ( (file = s_open(path.c_str())) != -1 ) {
+        s_close(file);
+        return true;
+    }
+    return false;
+}
+
+/*
+ * resolve the command, from the hash when possible
+ */
+std::string CommandHash::resolve(const std::string_view& cwd, const std::string& name, const std::string& searchPath) {
+    // the resolutions are valid only for the search path which produced them
+    if ( searchPath != hashedSearchPath ) {
+        entries.clear();
+        hashedSearchPath = searchPath;
+    }
+
+    std::string key{ cwd };
+    key += "/" + name;
+
+    auto it = entries.find(key);
+    if ( it != entries.end() ) {
+        if ( it->second.found ) {
+            it->second.hits++;
+            return it->second.path;
+        }
+        if ( s_millis() < it->second.missExpiration )
+            return name;
+        entries.erase(it);
+    }
+
+    if ( entries.size() >= COMMAND_HASH_MAXIMUM_ENTRIES )
+        entries.clear();
+
+    Entry entry{ name, name, false, 0, 1 };
+    entry.found = probe(cwd, name, searchPath, entry.path);
+    if ( !entry.found )
+        entry.missExpiration = s_millis() + COMMAND_HASH_MISS_MILLIS;
+
+    entries[key] = entry;
+    return entry.path;
+}
+
+/*
+ * resolve again the command which failed to spawn
+ */
+bool CommandHash::rehash(const std::string_view& cwd,
+                         const std::string&      name,
+                         const std::string&      searchPath,
+                         std::string&            outPath) {
+    std::string key{ cwd };
+    key += "/" + name;
+
+    auto it = entries.find(key);
+    if ( it == entries.end() || !it->second.found )
+        return false;
+
+    auto failedPath = it->second.path;
+    entries.erase(it);
+
+    outPath = resolve(cwd, name, searchPath);
+    return outPath != failedPath;
+}
+
+/*
+ * forget all the resolutions
+ */
+void CommandHash::clear() {
+    entries.clear();
+}
+
+/*
+ * look for the command into the working directory, as full path and into the
+ * search path
+ */
+bool CommandHash::probe(const std::string_view& cwd, const std::string& name, const std::string& searchPath, std::string& outPath) {
+    // check for match with cwd
+    std::string path{ cwd };
+    path += "/" + name;
+    if ( fileExists(path) ) {
+        outPath = path;
+        return true;
+    }
+
+    // check for full path
+    if ( fileExists(name) ) {
+        outPath = name;
+        return true;
+    }
+
+    // check for the search path
+    path = searchPath + name;
+    if ( fileExists(path) ) {
+        outPath = path;
+        return true;
+    }
+
+    // nothing found
+    outPath = name;
+    return false;
+}
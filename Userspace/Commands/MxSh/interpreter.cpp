@@ -18,66 +18,112 @@
 
 #include "interpreter.hpp"
 
+#include "CommandHash.hpp"
+
 #include <iostream>
 #include <LibUtils/Utils.hh>
 
 using namespace std;
 
 /*
- * interpret the parsed script
+ * parse the value, the number is kept only when the whole text is a number
  */
-void MXinterpreter::interpret(LsDocument* script) {
-    // interpret script
-    for ( LsStatement* stat : script->statements ) {
-        string command = stat->pairs[0]->key;
-
-        if ( command == "log" )
-            log(stat);
-        else if ( command == "spawn_driver" )
-            spawn_driver(stat);
-        else if ( command == "spawn_app" )
-            spawn_app(stat);
-        else if ( command == "wait_for_id" )
-            wait_for_id(stat);
-        else if ( command == "sleep" )
-            sleep(stat);
-        else if ( command == "if" )
-            if_paradigm(stat);
-        else if ( command == "else" )
-            else_paradigm(stat);
-        else if ( command == "while" )
-            while_paradigm(stat);
-        else if ( command == "export" )
-            setUpVariable(stat);
-        else if ( command == "def" )
-            defineNewFunction(stat);
-    }
+void MXValue::assign(const std::string& value) {
+    text      = value;
+    textValid = true;
+
+    char* end;
+    number  = strtoll(value.c_str(), &end, 10);
+    numeric = !value.empty() && *end == '\0';
 }
 
-/**
- *	print instruction, log on COM1 and std_out
+/*
+ * add one, the not numeric values count as zero
  */
-void MXinterpreter::log(LsStatement* stat) {
-    cout << stat->pairs[0]->value << endl;
-    Utils::log(stat->pairs[0]->value.c_str());
+void MXValue::increment() {
+    number    = numeric ? number + 1 : 1;
+    numeric   = true;
+    textValid = false;
 }
 
-/**
- *	spawn_app application with spawn_driver security level
+/*
+ * get the text, written again only after the increments
  */
-void MXinterpreter::spawn_driver(LsStatement* stat) {
-    string path = stat->pairs[0]->value;
-    string args = findParam(stat, "args", "");
-    execWithSpawner(path, args, SECURITY_LEVEL_DRIVER);
+const std::string& MXValue::getText() {
+    if ( !textValid ) {
+        text      = std::to_string(number);
+        textValid = true;
+    }
+    return text;
 }
 
-/**
- *	script spawn_app
+/*
+ * run the compiled script
  */
-void MXinterpreter::spawn_app(LsStatement* stat) {
-    string path = stat->pairs[0]->value;
-    string args = findParam(stat, "args", "");
-    execWithSpawner(path, args, SECURITY_LEVEL_APPLICATION);
+void MXinterpreter::run(const MXProgram& program) {
+    // the variables start from the environment
+    slots.assign(program.slotNames.size(), MXValue{});
+    for ( uint32_t slot = 0; slot < slots.size(); slot++ )
+        slots[slot].assign(variables->getVariable(program.slotNames[slot]));
+
+    constants.assign(program.texts.size(), MXValue{});
+    for ( uint32_t text = 0; text < constants.size(); text++ ) {
+        auto& parts = program.texts[text].parts;
+        if ( parts.size() == 1 && parts[0].slot == MX_NO_SLOT )
+            constants[text].assign(parts[0].literal);
+    }
+
+    uint32_t pc = 0;
+    while ( pc < program.code.size() ) {
+        auto& instruction = program.code[pc++];
+
+        switch ( instruction.opcode ) {
+            case MX_OP_LOG: {
+                auto message = expand(program, instruction.a);
+                cout << message << endl;
+                Utils::log("%s", message.c_str());
+                break;
+            }
+            case MX_OP_SPAWN:
+                execWithSpawner(expand(program, instruction.a),
+                                expand(program, instruction.b),
+                                static_cast<SecurityLevel>(instruction.c));
+                break;
+            case MX_OP_WAIT_FOR_ID: {
+                auto identifier = expand(program, instruction.a);
+                Utils::log("Waiting for task which register '%s'", identifier.c_str());
+
+                while ( s_task_get_id(identifier.c_str()) < 0 )
+                    s_yield();
+
+                Utils::log("ID '%s' registered", identifier.c_str());
+                break;
+            }
+            case MX_OP_SLEEP: {
+                auto time = atoi(expand(program, instruction.a).c_str());
+                Utils::log("Sleeping for %d", time);
+                s_sleep(time);
+                break;
+            }
+            case MX_OP_SET:
+                slots[instruction.a].assign(expand(program, instruction.b));
+                break;
+            case MX_OP_EXPORT:
+                slots[instruction.a].assign(expand(program, instruction.b));
+                variables->setVariable(program.slotNames[instruction.a], slots[instruction.a].getText());
+                break;
+            case MX_OP_INCREMENT:
+                slots[instruction.a].increment();
+                break;
+            case MX_OP_JUMP:
+                pc = instruction.a;
+                break;
+            case MX_OP_JUMP_UNLESS:
+                if ( !evaluate(program, instruction.b) )
+                    pc = instruction.a;
+                break;
+        }
+    }
 }
 
 /**
@@ -90,93 +136,76 @@ void MXinterpreter::exec(string path, string args) {
 }
 
 /**
- *	wait_for_id while task registering
- */
-void MXinterpreter::wait_for_id(LsStatement* stat) {
-    string identifier = stat->pairs[0]->value;
-    Utils::log("Waiting for task which register '%s'", identifier.c_str());
-
-    while ( s_task_get_id(identifier.c_str()) < 0 )
-        s_yield();
-
-    Utils::log("ID '%s' registered", identifier.c_str());
-}
-
-/**
- *	lock application for n milliseconds
- */
-void MXinterpreter::sleep(LsStatement* stat) {
-    int time;
-
-    stringstream ss;
-    ss << stat->pairs[0]->value;
-    ss >> time;
-
-    Utils::log("Sleeping for %d", time);
-
-    s_sleep(time);
-}
-
-/**
- *	if paradigm
- */
-void MXinterpreter::if_paradigm(LsStatement* stat) {
-}
-
-/**
- *	else paradigm
+ *	replace the variables of the text with their values
  */
-void MXinterpreter::else_paradigm(LsStatement* stat) {
-}
-
-/**
- *	iteration while paradigm
- */
-void MXinterpreter::while_paradigm(LsStatement* stat) {
+string MXinterpreter::expand(const MXProgram& program, uint32_t text) {
+    auto& parts = program.texts[text].parts;
+    if ( parts.size() == 1 && parts[0].slot == MX_NO_SLOT )
+        return parts[0].literal;
+
+    string value;
+    for ( auto& part : parts ) {
+        if ( part.slot == MX_NO_SLOT )
+            value += part.literal;
+        else
+            value += slots[part.slot].getText();
+    }
+    return value;
 }
 
 /**
- *	create local variable in script
+ *	evaluate the condition of if and while
  */
-void MXinterpreter::setUpVariable(LsStatement* stat) {
-    string s = stat->pairs[0]->value;
-
-    int index = s.find('=');
-
-    if ( index != -1 ) {
-        string key   = s.substr(0, index);
-        string value = s.substr(index + 1);
-
-        variables->setVariable(key, value);
+bool MXinterpreter::evaluate(const MXProgram& program, uint32_t condition) {
+    auto& cond  = program.conditions[condition];
+    auto& value = slots[cond.slot];
+    if ( cond.kind == MX_CONDITION_TRUE )
+        return value.numeric ? value.number != 0 : !value.getText().empty();
+
+    // the texts made of one literal are parsed once
+    MXValue  expanded;
+    MXValue* other = &constants[cond.text];
+    if ( !other->textValid ) {
+        expanded.assign(expand(program, cond.text));
+        other = &expanded;
     }
 
+    int comparison;
+    if ( value.numeric && other->numeric )
+        comparison = value.number < other->number ? -1 : value.number > other->number ? 1 : 0;
     else
-        variables->setVariable(s, "0");
-}
-
-/**
- *	define new function
- */
-void MXinterpreter::defineNewFunction(LsStatement* stat) {
-}
-
-/**
- *	find parameters in instruction line
- */
-string MXinterpreter::findParam(LsStatement* stat, string key, string def) {
-    for ( auto p : stat->pairs ) {
-        if ( p->key == key )
-            return p->value;
+        comparison = value.getText().compare(other->getText());
+
+    switch ( cond.kind ) {
+        case MX_CONDITION_EQUAL:
+            return comparison == 0;
+        case MX_CONDITION_NOT_EQUAL:
+            return comparison != 0;
+        case MX_CONDITION_LESS:
+            return comparison < 0;
+        case MX_CONDITION_GREATER:
+            return comparison > 0;
+        default:
+            return false;
     }
-    return def;
 }
 
 /**
  *	spawn_app application with provided security level
  */
 Pid MXinterpreter::execWithSpawner(string path, string args, SecurityLevel slvl) {
+    // the commands given by name are resolved through the shell hash
+    auto programPath = path;
+    if ( !path.empty() && path[0] != '/' )
+        programPath = g_command_hash.resolve("/", path, variables->getVariable("PATH"));
+
     auto pid          = -1;
-    auto spawn_status = s_spawn_p(path.c_str(), args.c_str(), "/", slvl, &pid);
+    auto spawn_status = s_spawn_p(programPath.c_str(), args.c_str(), "/", slvl, &pid);
+
+    // the hashed program could have been moved or removed
+    if ( spawn_status == SPAWN_STATUS_IO_ERROR && programPath != path
+         && g_command_hash.rehash("/", path, variables->getVariable("PATH"), programPath) )
+        spawn_status = s_spawn_p(programPath.c_str(), args.c_str(), "/", slvl, &pid);
 
     if ( spawn_status != SPAWN_STATUS_SUCCESSFUL ) {
         std::stringstream ss;
@@ -20,7 +20,7 @@
 #define _MX_INTERPRETER_
 
 #include "Environment.hpp"
-#include "mxscript.hpp"
+#include "mxbytecode.hpp"
 
 #include <Api.h>
 #include <fstream>
@@ -28,45 +28,52 @@
 #include <sstream>
 #include <stdio.h>
 #include <stdlib.h>
+#include <string>
+#include <vector>
 #include <LibUtils/PropertyFileParser.hh>
 
 /*
- * class that provide basic interpretation commands
- * for script
+ * value of a script variable, the number is kept aside to not parse the text
+ * at each comparison or increment of the loops
+ */
+struct MXValue {
+    std::string text;
+    long long   number    = 0;
+    bool        numeric   = false;
+    bool        textValid = false;
+
+    void assign(const std::string& value);
+    void increment();
+    const std::string& getText();
+};
+
+/*
+ * class that runs the compiled scripts
  */
 class MXinterpreter {
 public:
     MXinterpreter(Environment* env) { variables = env; }
 
-    // interpret script, espected parsed document
-    void interpret(LsDocument* script);
-
-    // intrinsic function, script
-    void log(LsStatement* stat);
-    void spawn_app(LsStatement* stat);
-    void spawn_driver(LsStatement* stat);
-    void wait_for_id(LsStatement* stat);
-    void sleep(LsStatement* stat);
+    // run the compiled script
+    void run(const MXProgram& program);
 
     // intrisic function, line
     void exec(std::string path, std::string args);
 
-    // control structures
-    void if_paradigm(LsStatement* stat);
-    void else_paradigm(LsStatement* stat);
-    void while_paradigm(LsStatement* stat);
-
-    // expansion structures
-    void setUpVariable(LsStatement* stat);
-    void defineNewFunction(LsStatement* stat);
-
 private:
     // internal function
-    std::string findParam(LsStatement* stat, std::string key, std::string def);
+    std::string expand(const MXProgram& program, uint32_t text);
+    bool        evaluate(const MXProgram& program, uint32_t condition);
     Pid         execWithSpawner(std::string path, std::string args, SecurityLevel slvl);
 
     // map of environment variables
     Environment* variables;
+
+    // values of the variable slots of the running script
+    std::vector<MXValue> slots;
+
+    // values of the texts made of one literal
+    std::vector<MXValue> constants;
 };
 
 #endif
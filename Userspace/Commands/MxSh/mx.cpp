@@ -118,28 +118,17 @@ void MXShell::startRoutine() {
 void MXShell::scriptMode() {
     // check if there are arguments provided
     if ( !argument.empty() ) {
-        // load given script
-        FILE* scriptfile = fopen(argument.c_str(), "r");
-
-        // check if file exist
-        if ( scriptfile == nullptr ) {
-            Utils::log("%s: file not found", argument.c_str());
-            cerr << argument << ": file not found" << endl;
+        // load the compiled script, compiling it when not cached
+        MXProgram   program;
+        std::string error;
+        if ( !loadScript(argument, program, error) ) {
+            Utils::log("%s", error.c_str());
+            cerr << error << endl;
             return;
         }
 
-        // parse the script
-        scriptParser         = new MXScriptParser(scriptfile);
-        LsDocument* document = scriptParser->document();
-
-        // call interpreter
-        interpreter->interpret(document);
-
-        // deleting pointer
-        delete document;
-
-        // closing file
-        fclose(scriptfile);
+        // run it
+        interpreter->run(program);
     }
 
     // show error if no file provided
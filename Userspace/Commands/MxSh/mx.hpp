@@ -84,9 +84,6 @@ private:
     // object to script interpreter
     MXinterpreter* interpreter{};
 
-    // object to script parser
-    MXScriptParser* scriptParser{};
-
 public:
     // constructor
     MXShell() {
@@ -98,7 +95,6 @@ public:
     ~MXShell() {
         //        delete environment;
         //        delete interpreter;
-        //        delete scriptParser;
     }
 
     /*
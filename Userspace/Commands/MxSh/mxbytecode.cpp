@@ -0,0 +1,486 @@
+/* * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * *  * * * * * * * *
+ * MeetiX OS By MeetiX OS Project [Marco Cicognani]                                    *
+ *                                                                                     *
+ * This program is free software; you can redistribute it and/or                       *
+ * modify it under the terms of the GNU General Public License                         *
+ * as published by the Free Software Foundation; either version 2                      *
+ * of the License, or (char *argumentat your option) any later version.                *
+ *                                                                                     *
+ * This program is distributed in the hope that it will be useful,                     *
+ * but WITHout ANY WARRANTY; without even the implied warranty of                      *
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the                       *
+ * GNU General Public License for more details.                                        *
+ *                                                                                     *
+ * You should have received a copy of the GNU General Public License                   *
+ * along with this program; if not, write to the Free Software                         *
+ * Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301  USA      *
+ * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * *  * * * * * * */
+
+#include "mxbytecode.hpp"
+
+#include <Api.h>
+#include <ctype.h>
+#include <string.h>
+
+/*
+ * blocks still open while compiling, the jump to patch is the one which leaves
+ * the block or skips the if branch
+ */
+enum BlockKind
+{
+    BLOCK_IF,
+    BLOCK_ELSE,
+    BLOCK_WHILE
+};
+
+struct Block {
+    BlockKind kind;
+    uint32_t  loopStart;
+    uint32_t  pendingJump;
+};
+
+/*
+ * get the slot of the variable, the slot is added when the name is new
+ */
+static uint32_t slotOf(MXProgram& program, const std::string& name) {
+    for ( uint32_t slot = 0; slot < program.slotNames.size(); slot++ ) {
+        if ( program.slotNames[slot] == name )
+            return slot;
+    }
+
+    program.slotNames.push_back(name);
+    return program.slotNames.size() - 1;
+}
+
+/*
+ * variable names are made of letters, digits and underscores
+ */
+static bool isNameChar(char c) {
+    return isalnum(c) || c == '_';
+}
+
+/*
+ * split the value into literals and $NAME variables
+ */
+static uint32_t compileText(MXProgram& program, const std::string& value) {
+    MXText      text;
+    std::string literal;
+    for ( size_t i = 0; i < value.size(); ) {
+        if ( value[i] == '$' && i + 1 < value.size() && isNameChar(value[i + 1]) ) {
+            auto end = i + 1;
+            while ( end < value.size() && isNameChar(value[end]) )
+                end++;
+
+            if ( !literal.empty() ) {
+                text.parts.push_back(MXTextPart{ MX_NO_SLOT, literal });
+                literal.clear();
+            }
+            text.parts.push_back(MXTextPart{ slotOf(program, value.substr(i + 1, end - i - 1)), {} });
+            i = end;
+        } else
+            literal += value[i++];
+    }
+
+    if ( !literal.empty() || text.parts.empty() )
+        text.parts.push_back(MXTextPart{ MX_NO_SLOT, literal });
+
+    program.texts.push_back(text);
+    return program.texts.size() - 1;
+}
+
+/*
+ * compile "NAME", "NAME==TEXT", "NAME!=TEXT", "NAME<TEXT" or "NAME>TEXT"
+ */
+static bool compileCondition(MXProgram& program, const std::string& value, uint32_t& outCondition, std::string& error) {
+    static const struct {
+        const char*     op;
+        MXConditionKind kind;
+    } operators[] = {
+        { "==", MX_CONDITION_EQUAL },
+        { "!=", MX_CONDITION_NOT_EQUAL },
+        { "<", MX_CONDITION_LESS },
+        { ">", MX_CONDITION_GREATER },
+    };
+
+    MXCondition condition{ MX_CONDITION_TRUE, 0, MX_NO_SLOT };
+    std::string name = value;
+    for ( auto& op : operators ) {
+        auto pos = value.find(op.op);
+        if ( pos != std::string::npos ) {
+            name           = value.substr(0, pos);
+            condition.kind = op.kind;
+            condition.text = compileText(program, value.substr(pos + strlen(op.op)));
+            break;
+        }
+    }
+
+    if ( !name.empty() && name[0] == '$' )
+        name = name.substr(1);
+    if ( name.empty() ) {
+        error = "missing variable into condition '" + value + "'";
+        return false;
+    }
+
+    condition.slot = slotOf(program, name);
+    program.conditions.push_back(condition);
+    outCondition = program.conditions.size() - 1;
+    return true;
+}
+
+/*
+ * find parameters in instruction line
+ */
+static std::string findParam(LsStatement* stat, const std::string& key, const std::string& def) {
+    for ( auto p : stat->pairs ) {
+        if ( p->key == key )
+            return p->value;
+    }
+    return def;
+}
+
+/*
+ * compile the parsed script
+ */
+bool compileScript(LsDocument* document, MXProgram& program, std::string& error) {
+    std::vector<Block> blocks;
+
+    auto emit = [&program](MXOpcode opcode, uint32_t a = 0, uint32_t b = 0, uint32_t c = 0) {
+        program.code.push_back(MXInstruction{ opcode, a, b, c });
+    };
+
+    for ( LsStatement* stat : document->statements ) {
+        const std::string& command = stat->pairs[0]->key;
+        const std::string& value   = stat->pairs[0]->value;
+        uint32_t           here    = program.code.size();
+
+        if ( command == "log" )
+            emit(MX_OP_LOG, compileText(program, value));
+        else if ( command == "spawn_driver" || command == "spawn_app" ) {
+            auto level = command == "spawn_driver" ? SECURITY_LEVEL_DRIVER : SECURITY_LEVEL_APPLICATION;
+            auto path  = compileText(program, value);
+            emit(MX_OP_SPAWN, path, compileText(program, findParam(stat, "args", "")), level);
+        } else if ( command == "wait_for_id" )
+            emit(MX_OP_WAIT_FOR_ID, compileText(program, value));
+        else if ( command == "sleep" )
+            emit(MX_OP_SLEEP, compileText(program, value));
+        else if ( command == "export" || command == "set" ) {
+            auto opcode = command == "export" ? MX_OP_EXPORT : MX_OP_SET;
+            auto index  = value.find('=');
+            if ( index != std::string::npos )
+                emit(opcode, slotOf(program, value.substr(0, index)), compileText(program, value.substr(index + 1)));
+            else
+                emit(opcode, slotOf(program, value), compileText(program, "0"));
+        } else if ( command == "increment" )
+            emit(MX_OP_INCREMENT, slotOf(program, value));
+        else if ( command == "if" || command == "while" ) {
+            uint32_t condition;
+            if ( !compileCondition(program, value, condition, error) )
+                return false;
+
+            // the jump target is known at the end of the block
+            emit(MX_OP_JUMP_UNLESS, 0, condition);
+            blocks.push_back(Block{ command == "if" ? BLOCK_IF : BLOCK_WHILE, here, here });
+        } else if ( command == "else" ) {
+            if ( blocks.empty() || blocks.back().kind != BLOCK_IF ) {
+                error = "else without if";
+                return false;
+            }
+
+            // the if branch jumps over the else branch, which starts here
+            emit(MX_OP_JUMP);
+            program.code[blocks.back().pendingJump].a = program.code.size();
+            blocks.back().kind        = BLOCK_ELSE;
+            blocks.back().pendingJump = here;
+        } else if ( command == "end" ) {
+            if ( blocks.empty() ) {
+                error = "end without if or while";
+                return false;
+            }
+
+            auto block = blocks.back();
+            blocks.pop_back();
+            if ( block.kind == BLOCK_WHILE )
+                emit(MX_OP_JUMP, block.loopStart);
+            program.code[block.pendingJump].a = program.code.size();
+        }
+
+        // functions are not supported yet, the unknown commands are skipped
+    }
+
+    if ( !blocks.empty() ) {
+        error = "missing end of if or while";
+        return false;
+    }
+    return true;
+}
+
+/*
+ * the cached program is valid only for the source with the same length and hash
+ */
+static uint32_t hashSource(const std::string& source) {
+    uint32_t hash = 2166136261u;
+    for ( unsigned char c : source ) {
+        hash ^= c;
+        hash *= 16777619u;
+    }
+    return hash;
+}
+
+static void writeWord(std::string& out, uint32_t word) {
+    out.append(reinterpret_cast<const char*>(&word), sizeof(word));
+}
+
+static void writeString(std::string& out, const std::string& string) {
+    writeWord(out, string.size());
+    out += string;
+}
+
+/*
+ * serialize the program for the cache
+ */
+static std::string writeProgram(const MXProgram& program, uint32_t sourceLength, uint32_t sourceHash) {
+    std::string out;
+    writeWord(out, MX_BYTECODE_MAGIC);
+    writeWord(out, MX_BYTECODE_VERSION);
+    writeWord(out, sourceLength);
+    writeWord(out, sourceHash);
+
+    writeWord(out, program.code.size());
+    for ( auto& instruction : program.code ) {
+        writeWord(out, instruction.opcode);
+        writeWord(out, instruction.a);
+        writeWord(out, instruction.b);
+        writeWord(out, instruction.c);
+    }
+
+    writeWord(out, program.texts.size());
+    for ( auto& text : program.texts ) {
+        writeWord(out, text.parts.size());
+        for ( auto& part : text.parts ) {
+            writeWord(out, part.slot);
+            writeString(out, part.literal);
+        }
+    }
+
+    writeWord(out, program.conditions.size());
+    for ( auto& condition : program.conditions ) {
+        writeWord(out, condition.kind);
+        writeWord(out, condition.slot);
+        writeWord(out, condition.text);
+    }
+
+    writeWord(out, program.slotNames.size());
+    for ( auto& name : program.slotNames )
+        writeString(out, name);
+    return out;
+}
+
+/*
+ * reader of the cached program which never goes over its end
+ */
+class ProgramReader {
+public:
+    ProgramReader(const std::string& in) : in(in), position(0) {
+    }
+
+    bool word(uint32_t& out) {
+        if ( in.size() - position < sizeof(out) )
+            return false;
+
+        memcpy(&out, in.data() + position, sizeof(out));
+        position += sizeof(out);
+        return true;
+    }
+
+    bool string(std::string& out) {
+        uint32_t length;
+        if ( !word(length) || in.size() - position < length )
+            return false;
+
+        out.assign(in, position, length);
+        position += length;
+        return true;
+    }
+
+    bool count(uint32_t& out) {
+        // each element takes at least a word
+        return word(out) && out <= (in.size() - position) / sizeof(uint32_t);
+    }
+
+    bool atEnd() const {
+        return position == in.size();
+    }
+
+private:
+    const std::string& in;
+    size_t             position;
+};
+
+/*
+ * deserialize the cached program, the operands are checked to never let the
+ * interpreter go out of the program
+ */
+static bool readProgram(const std::string& in, uint32_t sourceLength, uint32_t sourceHash, MXProgram& program) {
+    ProgramReader reader(in);
+
+    uint32_t magic, version, length, hash, count;
+    if ( !reader.word(magic) || !reader.word(version) || !reader.word(length) || !reader.word(hash) )
+        return false;
+    if ( magic != MX_BYTECODE_MAGIC || version != MX_BYTECODE_VERSION || length != sourceLength || hash != sourceHash )
+        return false;
+
+    if ( !reader.count(count) )
+        return false;
+    program.code.resize(count);
+    for ( auto& instruction : program.code ) {
+        uint32_t opcode;
+        if ( !reader.word(opcode) || !reader.word(instruction.a) || !reader.word(instruction.b) || !reader.word(instruction.c) )
+            return false;
+        if ( opcode > MX_OP_JUMP_UNLESS )
+            return false;
+        instruction.opcode = static_cast<MXOpcode>(opcode);
+    }
+
+    if ( !reader.count(count) )
+        return false;
+    program.texts.resize(count);
+    for ( auto& text : program.texts ) {
+        if ( !reader.count(count) )
+            return false;
+        text.parts.resize(count);
+        for ( auto& part : text.parts ) {
+            if ( !reader.word(part.slot) || !reader.string(part.literal) )
+                return false;
+        }
+    }
+
+    if ( !reader.count(count) )
+        return false;
+    program.conditions.resize(count);
+    for ( auto& condition : program.conditions ) {
+        uint32_t kind;
+        if ( !reader.word(kind) || !reader.word(condition.slot) || !reader.word(condition.text) )
+            return false;
+        if ( kind > MX_CONDITION_GREATER )
+            return false;
+        condition.kind = static_cast<MXConditionKind>(kind);
+    }
+
+    if ( !reader.count(count) )
+        return false;
+    program.slotNames.resize(count);
+    for ( auto& name : program.slotNames ) {
+        if ( !reader.string(name) )
+            return false;
+    }
+    if ( !reader.atEnd() )
+        return false;
+
+    // check the operands
+    auto isText = [&program](uint32_t text) { return text < program.texts.size(); };
+    auto isSlot = [&program](uint32_t slot) { return slot < program.slotNames.size(); };
+    for ( auto& text : program.texts ) {
+        for ( auto& part : text.parts ) {
+            if ( part.slot != MX_NO_SLOT && !isSlot(part.slot) )
+                return false;
+        }
+    }
+    for ( auto& condition : program.conditions ) {
+        if ( !isSlot(condition.slot) || (condition.kind != MX_CONDITION_TRUE && !isText(condition.text)) )
+            return false;
+    }
+    for ( auto& instruction : program.code ) {
+        bool valid;
+        switch ( instruction.opcode ) {
+            case MX_OP_SPAWN:
+                valid = isText(instruction.a) && isText(instruction.b);
+                break;
+            case MX_OP_SET:
+            case MX_OP_EXPORT:
+                valid = isSlot(instruction.a) && isText(instruction.b);
+                break;
+            case MX_OP_INCREMENT:
+                valid = isSlot(instruction.a);
+                break;
+            case MX_OP_JUMP:
+                valid = instruction.a <= program.code.size();
+                break;
+            case MX_OP_JUMP_UNLESS:
+                valid = instruction.a <= program.code.size() && instruction.b < program.conditions.size();
+                break;
+            default:
+                valid = isText(instruction.a);
+                break;
+        }
+        if ( !valid )
+            return false;
+    }
+    return true;
+}
+
+/*
+ * read the whole file
+ */
+static bool readFile(const std::string& path, std::string& out) {
+    FILE* file = fopen(path.c_str(), "r");
+    if ( !file )
+        return false;
+
+    char   buffer[4096];
+    size_t read;
+    while ( (read = fread(buffer, 1, sizeof(buffer), file)) > 0 )
+        out.append(buffer, read);
+
+    fclose(file);
+    return true;
+}
+
+/*
+ * free the parsed script
+ */
+static void deleteDocument(LsDocument* document) {
+    for ( LsStatement* stat : document->statements ) {
+        for ( LsPair* pair : stat->pairs )
+            delete pair;
+        delete stat;
+    }
+    delete document;
+}
+
+/*
+ * load the compiled script from the cache or compile it
+ */
+bool loadScript(const std::string& path, MXProgram& program, std::string& error) {
+    std::string source;
+    if ( !readFile(path, source) ) {
+        error = path + ": file not found";
+        return false;
+    }
+
+    auto        sourceHash = hashSource(source);
+    std::string cachePath  = path + MX_BYTECODE_EXTENSION;
+    std::string cache;
+    if ( readFile(cachePath, cache) && readProgram(cache, source.size(), sourceHash, program) )
+        return true;
+
+    // the cache is missing, stale or broken
+    program = MXProgram{};
+
+    MXScriptParser parser(source);
+    LsDocument*    document = parser.document();
+    bool           compiled = compileScript(document, program, error);
+    deleteDocument(document);
+    if ( !compiled ) {
+        error = path + ": " + error;
+        return false;
+    }
+
+    // the cache only speeds up the next runs, the script runs even when it can't be written
+    FILE* cacheFile = fopen(cachePath.c_str(), "w");
+    if ( cacheFile ) {
+        auto bytecode = writeProgram(program, source.size(), sourceHash);
+        fwrite(bytecode.data(), 1, bytecode.size(), cacheFile);
+        fclose(cacheFile);
+    }
+    return true;
+}
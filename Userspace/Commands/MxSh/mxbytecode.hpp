@@ -0,0 +1,124 @@
+/* * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * *  * * * * * * * *
+ * MeetiX OS By MeetiX OS Project [Marco Cicognani]                                    *
+ *                                                                                     *
+ * This program is free software; you can redistribute it and/or                       *
+ * modify it under the terms of the GNU General Public License                         *
+ * as published by the Free Software Foundation; either version 2                      *
+ * of the License, or (char *argumentat your option) any later version.                *
+ *                                                                                     *
+ * This program is distributed in the hope that it will be useful,                     *
+ * but WITHout ANY WARRANTY; without even the implied warranty of                      *
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the                       *
+ * GNU General Public License for more details.                                        *
+ *                                                                                     *
+ * You should have received a copy of the GNU General Public License                   *
+ * along with this program; if not, write to the Free Software                         *
+ * Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301  USA      *
+ * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * *  * * * * * * */
+
+#ifndef _MX_BYTECODE_
+#define _MX_BYTECODE_
+
+#include "mxscript.hpp"
+
+#include <stdint.h>
+#include <string>
+#include <vector>
+
+/*
+ * compiled scripts are cached next to the script, into a file with the same
+ * name and this extension
+ */
+#define MX_BYTECODE_EXTENSION ".mxc"
+#define MX_BYTECODE_MAGIC     0x43584d00
+#define MX_BYTECODE_VERSION   1
+
+/*
+ * marks the text parts which are literals instead of variables
+ */
+#define MX_NO_SLOT 0xffffffff
+
+/*
+ * instructions of the compiled scripts, the comments tell the used operands
+ */
+enum MXOpcode : uint32_t
+{
+    MX_OP_LOG,          // a: text
+    MX_OP_SPAWN,        // a: path text, b: arguments text, c: security level
+    MX_OP_WAIT_FOR_ID,  // a: text
+    MX_OP_SLEEP,        // a: text
+    MX_OP_SET,          // a: slot, b: text
+    MX_OP_EXPORT,       // a: slot, b: text
+    MX_OP_INCREMENT,    // a: slot
+    MX_OP_JUMP,         // a: target instruction
+    MX_OP_JUMP_UNLESS,  // a: target instruction, b: condition
+};
+
+struct MXInstruction {
+    MXOpcode opcode;
+    uint32_t a;
+    uint32_t b;
+    uint32_t c;
+};
+
+/*
+ * piece of a text, the literal or the variable of the slot
+ */
+struct MXTextPart {
+    uint32_t    slot;
+    std::string literal;
+};
+
+/*
+ * value of a statement, already split into literals and variable slots
+ */
+struct MXText {
+    std::vector<MXTextPart> parts;
+};
+
+/*
+ * conditions of if and while: the variable alone is true when not empty and
+ * not 0, otherwise the variable is compared with the text. The comparison is
+ * numeric when both are numbers
+ */
+enum MXConditionKind : uint32_t
+{
+    MX_CONDITION_TRUE,
+    MX_CONDITION_EQUAL,
+    MX_CONDITION_NOT_EQUAL,
+    MX_CONDITION_LESS,
+    MX_CONDITION_GREATER,
+};
+
+struct MXCondition {
+    MXConditionKind kind;
+    uint32_t        slot;
+    uint32_t        text;
+};
+
+/*
+ * compiled script
+ */
+struct MXProgram {
+    std::vector<MXInstruction> code;
+    std::vector<MXText>        texts;
+    std::vector<MXCondition>   conditions;
+    std::vector<std::string>   slotNames;
+};
+
+/*
+ * compile the parsed script, on error return false and fill the message.
+ * Besides log, spawn_app, spawn_driver, wait_for_id, sleep and export the
+ * scripts can use "set: NAME=VALUE" for script variables, "increment: NAME",
+ * and the blocks "if: CONDITION" [else] end and "while: CONDITION" end.
+ * The values can refer the variables as $NAME
+ */
+bool compileScript(LsDocument* document, MXProgram& program, std::string& error);
+
+/*
+ * load the compiled script from its cache or compile it and update the cache,
+ * on error return false and fill the message
+ */
+bool loadScript(const std::string& path, MXProgram& program, std::string& error);
+
+#endif
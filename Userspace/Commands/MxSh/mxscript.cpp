@@ -25,8 +25,7 @@ using namespace std;
 /**
  *
  */
-MXScriptParser::MXScriptParser(FILE* fileToParse) {
-    file = fileToParse;
+MXScriptParser::MXScriptParser(const std::string& sourceToParse) : source(sourceToParse), position(0) {
     step();
 }
 
@@ -34,7 +33,7 @@ MXScriptParser::MXScriptParser(FILE* fileToParse) {
  *
  */
 void MXScriptParser::step() {
-    c = fgetc(file);
+    c = position < source.size() ? source[position++] : EOF;
 }
 
 /**
@@ -64,7 +63,7 @@ LsStatement* MXScriptParser::statement() {
     // skip line end & spaces
     while ( c == '\n' || isspace(c) || c == '#' ) {
         if ( c == '#' ) {
-            while ( c != '\n' ) {
+            while ( c != '\n' && c != EOF ) {
                 step();
             }
             step();
@@ -110,12 +109,8 @@ LsPair* MXScriptParser::pair() {
     if ( c == ':' )
         step();
 
-    // value
+    // value, the block statements like else and end have none
     string v = value();
-    if ( v.empty() ) {
-        delete p;
-        return 0;
-    }
 
     p->key   = k;
     p->value = v;
@@ -135,7 +130,12 @@ string MXScriptParser::key() {
         ks << c;
         step();
     }
-    return ks.str();
+
+    // drop the trailing spaces of the keys without value
+    string k = ks.str();
+    while ( !k.empty() && isspace(k.back()) )
+        k.pop_back();
+    return k;
 }
 
 /**
@@ -51,11 +51,12 @@ struct LsDocument {
  */
 class MXScriptParser {
 private:
-    FILE* file;
-    char  c;
+    const std::string& source;
+    size_t             position;
+    char               c;
 
 public:
-    MXScriptParser(FILE* fileToParse);
+    MXScriptParser(const std::string& sourceToParse);
 
     void step();
 
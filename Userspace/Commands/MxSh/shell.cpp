@@ -22,6 +22,7 @@
  * Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301  USA      *
  * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * *  * * * * * * */
 
+#include "CommandHash.hpp"
 #include "mx.hpp"
 #include "parser.hpp"
 
@@ -129,39 +130,11 @@ bool read_input_line(std::string& line) {
     return true;
 }
 
-/**
- *
- */
-bool fileExists(const std::string& path) {
-    FileHandle file;
-    if ( (file = s_open(path.c_str())) != -1 ) {
-        s_close(file);
-        return true;
-    }
-    return false;
-}
-
 /**
  *
  */
 std::string findProgram(const std::string_view& cwd, const std::string& name) {
-    // check for match with cwd
-    std::string path{ cwd };
-    path += "/" + name;
-    if ( fileExists(path) )
-        return path;
-
-    // check for full path
-    if ( fileExists(name) )
-        return name;
-
-    // check for /applications folder
-    path = g_shell_env->getVariable("PATH") + name;
-    if ( fileExists(path) )
-        return path;
-
-    // nothing found
-    return name;
+    return g_command_hash.resolve(cwd, name, g_shell_env->getVariable("PATH"));
 }
 
 /**
@@ -194,6 +167,20 @@ bool handleBuiltin(const std::string_view& cwd, ProgramCall* call) {
         return true;
     }
 
+    if ( call->program == "hash" ) {
+        if ( call->arguments.empty() ) {
+            std::cout << "hits\tcommand" << std::endl;
+            for ( auto& entry : g_command_hash.getEntries() ) {
+                if ( entry.second.found )
+                    std::cout << entry.second.hits << '\t' << entry.second.path << std::endl;
+            }
+        } else if ( call->arguments.size() == 1 && call->arguments.at(0) == "-r" )
+            g_command_hash.clear();
+        else
+            std::cerr << "Usage:\thash [-r]" << std::endl;
+        return true;
+    }
+
     if ( call->program == "exit" ) {
         exit(EXIT_SUCCESS);
     }
@@ -269,13 +256,25 @@ void run_command(const std::string& line, const std::string_view& cwd) {
         // do spawning
         Pid         outPid;
         FileHandle  outStdio[3];
-        SpawnStatus status = s_spawn_poi(findProgram(cwd, call->program).c_str(),
-                                         args_ss.str().c_str(),
-                                         cwd.data(),
-                                         SECURITY_LEVEL_APPLICATION,
-                                         &outPid,
-                                         outStdio,
-                                         inStdio);
+        auto        programPath = findProgram(cwd, call->program);
+        SpawnStatus status      = s_spawn_poi(programPath.c_str(),
+                                              args_ss.str().c_str(),
+                                              cwd.data(),
+                                              SECURITY_LEVEL_APPLICATION,
+                                              &outPid,
+                                              outStdio,
+                                              inStdio);
+
+        // the hashed program could have been moved or removed
+        if ( status == SPAWN_STATUS_IO_ERROR
+             && g_command_hash.rehash(cwd, call->program, g_shell_env->getVariable("PATH"), programPath) )
+            status = s_spawn_poi(programPath.c_str(),
+                                 args_ss.str().c_str(),
+                                 cwd.data(),
+                                 SECURITY_LEVEL_APPLICATION,
+                                 &outPid,
+                                 outStdio,
+                                 inStdio);
 
         // check result
         if ( status == SPAWN_STATUS_SUCCESSFUL ) {
@@ -164,6 +164,25 @@ typedef enum {
     FS_WRITE_ERROR
 } FsWriteStatus;
 
+/**
+ * @brief Modes for the {fsMap} system call
+ */
+typedef enum {
+    FS_MAP_MODE_SHARED, /* read-only pages shared with every other mapping of the file */
+    FS_MAP_MODE_PRIVATE /* copy-on-write pages, the writes stay private to the process */
+} FsMapMode;
+
+/**
+ * @brief Status codes for the {fsMap} system call
+ */
+typedef enum {
+    FS_MAP_SUCCESSFUL,
+    FS_MAP_INVALID_FD,
+    FS_MAP_NOT_SUPPORTED, /* the file content is not page-aligned in memory, must be read */
+    FS_MAP_INVALID_RANGE,
+    FS_MAP_ERROR
+} FsMapStatus;
+
 /**
  * @brief Status codes for the {fsClose} system call
  */
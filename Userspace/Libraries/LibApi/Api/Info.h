@@ -46,6 +46,7 @@ typedef struct {
     char         m_cpu_vendor[32];
     unsigned int m_memory_total_amount;
     unsigned int m_memory_free_amount;
+    unsigned int m_image_cache_amount;
 } A_PACKED SystemInfo;
 
 /**
@@ -36,6 +36,12 @@ extern "C" {
 #define TABLE_IN_DIRECTORY_INDEX(address) ((usize)(((address) / PAGE_SIZE) / 1024))
 #define PAGE_IN_TABLE_INDEX(address)      ((usize)(((address) / PAGE_SIZE) % 1024))
 
+/**
+ * @brief s_map_mmio_f flags
+ */
+#define MMIO_FLAG_NONE            (0)      /* Default device memory, uncached by the MTRRs */
+#define MMIO_FLAG_WRITE_COMBINING (1 << 0) /* Stores are buffered and written in bursts, for framebuffers */
+
 #ifdef __cplusplus
 }
 #endif
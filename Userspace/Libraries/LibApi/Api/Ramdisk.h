@@ -33,6 +33,12 @@ typedef enum {
  */
 #define RAMDISK_MAXIMUM_PATH_LENGTH 512
 
+/**
+ * @brief Content of files at least this big is page-aligned inside the ramdisk image,
+ * this allows the kernel to map it directly into the processes
+ */
+#define RAMDISK_FILE_DATA_ALIGNMENT 0x1000
+
 /**
  * @brief Ramdisk entries types
  */
@@ -87,6 +87,9 @@ enum SyscallNumber {
     SYSCALL_ATTACH_CREATED_PROCESS,
     SYSCALL_CANCEL_PROCESS_CREATION,
     SYSCALL_WRITE_TLS_MASTER_FOR_PROCESS,
+    SYSCALL_IMAGE_CACHE_MAP_SEGMENT,
+    SYSCALL_IMAGE_CACHE_STORE_SEGMENT,
+    SYSCALL_MAP_FILE_IN_SPACE,
 
     /**
      * @brief IPC messages system calls
@@ -104,6 +107,7 @@ enum SyscallNumber {
     SYSCALL_MEMORY_ALLOCATE,
     SYSCALL_MEMORY_LOWER_FREE,
     SYSCALL_MEMORY_LOWER_ALLOCATE,
+    SYSCALL_MEMORY_QUERY_PAGE,
 
     /**
      * Syscalls for serial s_log management
@@ -121,6 +125,7 @@ enum SyscallNumber {
     SYSCALL_FS_FSTAT,
     SYSCALL_FS_WRITE,
     SYSCALL_FS_LENGTH,
+    SYSCALL_FS_MAP,
 
     /**
      * Syscalls for File System operation
@@ -42,6 +42,18 @@ typedef struct {
     unsigned int   m_read_bytes;
 } A_PACKED SyscallFsRead;
 
+/**
+ * @brief s_map_file system call data
+ */
+typedef struct {
+    FileHandle   m_open_fd;
+    unsigned int m_offset;
+    unsigned int m_length;
+    FsMapMode    m_map_mode;
+    void*        m_mapped_area;
+    FsMapStatus  m_map_status;
+} A_PACKED SyscallFsMap;
+
 /**
  * @brief s_write system call data
  */
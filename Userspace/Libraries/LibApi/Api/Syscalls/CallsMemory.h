@@ -43,6 +43,7 @@ typedef struct {
 typedef struct {
     void*        m_physical_address;
     unsigned int m_region_size;
+    int          m_flags;
     void*        m_mapped_ptr;
 } A_PACKED SyscallMapMmio;
 
@@ -68,6 +69,17 @@ typedef struct {
     void* m_region_ptr;
 } A_PACKED SyscallLowerFree;
 
+/**
+ * @brief s_query_page system call data
+ */
+typedef struct {
+    unsigned int m_address;
+    bool         m_found;
+    unsigned int m_physical_address;
+    bool         m_writable;
+    unsigned int m_references;
+} A_PACKED SyscallQueryPage;
+
 /**
  * @brief s_set_break system call data
  */
@@ -69,6 +69,30 @@ typedef struct {
     bool                      m_success;
 } A_PACKED SyscallWriteTlsMasterForProcess;
 
+/**
+ * @brief s_map_cached_segment/s_store_cached_segment system call data
+ */
+typedef struct {
+    ProcessCreationIdentifier m_process_creation_identifier;
+    FileHandle                m_file_handle;
+    Address                   m_target_space_virtual_address;
+    unsigned int              m_pages_count;
+    bool                      m_writable;
+    bool                      m_success;
+} A_PACKED SyscallImageCacheSegment;
+
+/**
+ * @brief s_map_file_in_space system call data
+ */
+typedef struct {
+    ProcessCreationIdentifier m_process_creation_identifier;
+    FileHandle                m_file_handle;
+    unsigned int              m_file_offset;
+    unsigned int              m_length;
+    Address                   m_target_space_virtual_address;
+    unsigned int              m_mapped_pages;
+} A_PACKED SyscallMapFileInSpace;
+
 /**
  * @brief Process configuration struct
  */
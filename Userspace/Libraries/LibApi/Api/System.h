@@ -42,7 +42,9 @@ typedef enum {
     SPAWN_STATUS_IO_ERROR,
     SPAWN_STATUS_MEMORY_ERROR,
     SPAWN_STATUS_FORMAT_ERROR,
-    SPAWN_STATUS_UNKNOWN
+    SPAWN_STATUS_UNKNOWN,
+    SPAWN_STATUS_FILE_ACTION_ERROR,
+    SPAWN_STATUS_PROTOCOL_ERROR
 } SpawnStatus;
 
 /**
@@ -61,11 +63,38 @@ typedef struct {
     unsigned int       m_path_len;
     unsigned int       m_args_len;
     unsigned int       m_workdir_len;
+    unsigned int       m_file_actions_len;
     FileHandle         m_stdin;
     FileHandle         m_stdout;
     FileHandle         m_stderr;
 } A_PACKED SpawnCommandSpawnRequest;
 
+/**
+ * @brief File actions applied by the spawner to the new process before it starts.
+ * When a request carries file actions the spawner doesn't create the standard I/O pipes:
+ * the new process only receives the given standard I/O descriptors of the requester and
+ * then the actions are applied in order, like a posix_spawn() file actions list
+ */
+typedef enum {
+    SPAWN_FILE_ACTION_CLOSE,
+    SPAWN_FILE_ACTION_DUP2,
+    SPAWN_FILE_ACTION_OPEN,
+    SPAWN_FILE_ACTION_CHDIR
+} SpawnFileActionType;
+
+/**
+ * @brief Single file action, the path of the OPEN and CHDIR actions immediately follows the
+ * record and <m_path_len> includes the null terminator
+ */
+typedef struct {
+    SpawnFileActionType m_action;
+    FileHandle          m_fd;
+    FileHandle          m_source_fd;
+    int                 m_open_flags;
+    int                 m_open_mode;
+    unsigned int        m_path_len;
+} A_PACKED SpawnFileAction;
+
 typedef struct {
     SpawnStatus m_spawn_status;
     Pid         m_new_process_id;
@@ -84,6 +84,9 @@ void s_atomic_block_dual(bool* atom1, bool* atom2);
  * @param-opt inStdio:      if supplied, the given descriptors which are valid for the executing
  * process are used as the stdin/out/err for the spawned process; an entry might be -1 to be ignored
  * and default behaviour being applied
+ * @param-opt file_actions:  buffer of {SpawnFileAction} records applied in order to the new process,
+ * when given no standard I/O pipe is created and <out_stdio> is filled with {FD_NONE}
+ * @param-opt file_actions_len: size in bytes of the <file_actions> buffer
  * @return one of the {SpawnStatus} codes
  *
  * @security-level APPLICATION
@@ -98,6 +101,15 @@ SpawnStatus s_spawn_poi(const char*   path,
                         Pid*          out_pid,
                         FileHandle    out_stdio[3],
                         FileHandle    in_stdio[3]);
+SpawnStatus s_spawn_poia(const char*   path,
+                         const char*   args,
+                         const char*   work_dir,
+                         SecurityLevel security_level,
+                         Pid*          out_pid,
+                         FileHandle    out_stdio[3],
+                         FileHandle    in_stdio[3],
+                         const void*   file_actions,
+                         unsigned int  file_actions_len);
 
 /**
  * Register the current process as a kernel
@@ -337,6 +349,24 @@ unsigned int s_get_executable_path(char* buffer);
 unsigned int s_read(FileHandle fd, void* buffer, unsigned int buffer_len);
 unsigned int s_read_s(FileHandle fd, void* buffer, unsigned int buffer_len, FsReadStatus* out_status);
 
+/**
+ * Maps a range of the file into the address space without copying it. Only files whose content
+ * lies page-aligned in memory (the big files of the ramdisk image) are supported, for the others
+ * FS_MAP_NOT_SUPPORTED is returned and the content must be read with s_read.
+ * The area is released with s_unmap_mem.
+ *
+ * @param fd:               the file descriptor
+ * @param offset:           page-aligned offset into the file
+ * @param length:           the length in bytes of the range to map
+ * @param mode:             one of the {FsMapMode} modes
+ * @param-opt outStatus:    filled with one of the {FsMapStatus} codes
+ * @return a pointer to the mapped area, or nullptr otherwise
+ *
+ * @security-level APPLICATION
+ */
+void* s_map_file(FileHandle fd, unsigned int offset, unsigned int length, FsMapMode mode);
+void* s_map_file_s(FileHandle fd, unsigned int offset, unsigned int length, FsMapMode mode, FsMapStatus* out_status);
+
 /**
  * Writes bytes from the buffer to the file.
  *
@@ -570,11 +600,13 @@ void s_wait_for_irq(unsigned char irq);
  *
  * @param address:     the physical memory address that should be mapped
  * @param size:        the size that should be mapped
+ * @param-opt flags:   the MMIO_FLAG_* flags of the mapping
  * @return a pointer to the mapped area within the executing processes address space
  *
  * @security-level DRIVER
  */
 void* s_map_mmio(void* address, unsigned int size);
+void* s_map_mmio_f(void* address, unsigned int size, int flags);
 
 /**
  * Unmaps the given memory area.
@@ -585,6 +617,19 @@ void* s_map_mmio(void* address, unsigned int size);
  */
 void s_unmap_mem(void* area);
 
+/**
+ * Describes the page of the executing process which contains the given address
+ *
+ * @param address:                  an address of the executing process
+ * @param-opt out_physical_address: filled with the physical address of the page
+ * @param-opt out_writable:         filled with whether the page is mapped writable
+ * @param-opt out_references:       filled with the references to the physical page
+ * @return whether the page is mapped
+ *
+ * @security-level APPLICATION
+ */
+bool s_query_page(void* address, unsigned int* out_physical_address, bool* out_writable, unsigned int* out_references);
+
 /**
  * Adjusts the program heap break.
  *
@@ -770,6 +815,51 @@ void s_configure_process(ProcessCreationIdentifier process, ProcessConfiguration
  */
 void* s_create_pages_in_spaces(ProcessCreationIdentifier process, Address virtual_address, unsigned int pages_count);
 
+/**
+ * Maps into the process under creation the pages of an executable segment previously stored in
+ * the kernel image cache. Read-only segments are shared, writable ones are copy-on-write.
+ *
+ * @param process:          the process creation identifier
+ * @param file:             the executable file handle, used as cache key
+ * @param virtual_address:  the page-aligned address of the segment in the target space
+ * @param pages_count:      number of pages of the segment
+ * @param writable:         whether the segment is writable
+ * @return whether the segment was found in cache and mapped
+ *
+ * @security-level KERNEL
+ */
+bool s_map_cached_segment(ProcessCreationIdentifier process, FileHandle file, Address virtual_address, unsigned int pages_count, bool writable);
+
+/**
+ * Stores into the kernel image cache the pages of a segment already loaded into the process
+ * under creation, so that next spawns of the same executable can use <s_map_cached_segment>.
+ *
+ * @param process:          the process creation identifier
+ * @param file:             the executable file handle, used as cache key
+ * @param virtual_address:  the page-aligned address of the segment in the target space
+ * @param pages_count:      number of pages of the segment
+ * @param writable:         whether the segment is writable
+ * @return whether the segment was stored
+ *
+ * @security-level KERNEL
+ */
+bool s_store_cached_segment(ProcessCreationIdentifier process, FileHandle file, Address virtual_address, unsigned int pages_count, bool writable);
+
+/**
+ * Maps a range of the file directly into the image of the process under creation, like s_map_file
+ * does. The pages are copy-on-write, the bytes of the last page after the range are zero.
+ *
+ * @param process:          the process creation identifier
+ * @param file:             the file handle
+ * @param file_offset:      page-aligned offset into the file
+ * @param length:           the length in bytes of the range to map
+ * @param virtual_address:  the page-aligned address in the target space
+ * @return the number of mapped pages, zero if the file can't be mapped
+ *
+ * @security-level KERNEL
+ */
+unsigned int s_map_file_in_space(ProcessCreationIdentifier process, FileHandle file, unsigned int file_offset, unsigned int length, Address virtual_address);
+
 /**
  * Creates a thread-local-storage area for a process and copies/zeroes the given amount of bytes
  * from the content.
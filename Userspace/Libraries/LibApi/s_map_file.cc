@@ -0,0 +1,27 @@
+/**
+ * @brief
+ * This file is part of the MeetiX Operating System.
+ * Copyright (c) 2017-2022, Marco Cicognani (marco.cicognani@meetixos.org)
+ *
+ * @developers
+ * Marco Cicognani (marco.cicognani@meetixos.org)
+ *
+ * @license
+ * GNU General Public License version 3
+ */
+
+
+#include <Api/User.h>
+
+void* s_map_file(FileHandle fd, unsigned int offset, unsigned int length, FsMapMode mode) {
+    return s_map_file_s(fd, offset, length, mode, nullptr);
+}
+
+void* s_map_file_s(FileHandle fd, unsigned int offset, unsigned int length, FsMapMode mode, FsMapStatus* out_status) {
+    SyscallFsMap data{ fd, offset, length, mode, nullptr, FS_MAP_ERROR };
+    do_syscall(SYSCALL_FS_MAP, (usize)&data);
+
+    if ( out_status )
+        *out_status = data.m_map_status;
+    return data.m_mapped_area;
+}
@@ -0,0 +1,20 @@
+/**
+ * @brief
+ * This file is part of the MeetiX Operating System.
+ * Copyright (c) 2017-2022, Marco Cicognani (marco.cicognani@meetixos.org)
+ *
+ * @developers
+ * Marco Cicognani (marco.cicognani@meetixos.org)
+ *
+ * @license
+ * GNU General Public License version 3
+ */
+
+
+#include <Api/User.h>
+
+unsigned int s_map_file_in_space(ProcessCreationIdentifier process, FileHandle file, unsigned int file_offset, unsigned int length, Address virtual_address) {
+    SyscallMapFileInSpace data{ process, file, file_offset, length, virtual_address, 0 };
+    do_syscall(SYSCALL_MAP_FILE_IN_SPACE, (usize)&data);
+    return data.m_mapped_pages;
+}
@@ -10,10 +10,15 @@
  * GNU General Public License version 3
  */
 
+#include <Api/Memory.h>
 #include <Api/User.h>
 
 void* s_map_mmio(void* address, usize size) {
-    SyscallMapMmio data{ address, size };
+    return s_map_mmio_f(address, size, MMIO_FLAG_NONE);
+}
+
+void* s_map_mmio_f(void* address, usize size, i32 flags) {
+    SyscallMapMmio data{ address, size, flags };
     do_syscall(SYSCALL_MEMORY_MAP_MMIO, (usize)&data);
     return data.m_mapped_ptr;
 }
@@ -0,0 +1,28 @@
+/**
+ * @brief
+ * This file is part of the MeetiX Operating System.
+ * Copyright (c) 2017-2022, Marco Cicognani (marco.cicognani@meetixos.org)
+ *
+ * @developers
+ * Marco Cicognani (marco.cicognani@meetixos.org)
+ *
+ * @license
+ * GNU General Public License version 3
+ */
+
+#include <Api/User.h>
+
+bool s_query_page(void* address, unsigned int* out_physical_address, bool* out_writable, unsigned int* out_references) {
+    SyscallQueryPage data{ reinterpret_cast<Address>(address), false, 0, false, 0 };
+    do_syscall(SYSCALL_MEMORY_QUERY_PAGE, (usize)&data);
+
+    if ( data.m_found ) {
+        if ( out_physical_address )
+            *out_physical_address = data.m_physical_address;
+        if ( out_writable )
+            *out_writable = data.m_writable;
+        if ( out_references )
+            *out_references = data.m_references;
+    }
+    return data.m_found;
+}
@@ -40,6 +40,18 @@ SpawnStatus s_spawn_poi(const char*   path,
                         Pid*          out_pid,
                         FileHandle    out_stdio[3],
                         FileHandle    in_stdio[3]) {
+    return s_spawn_poia(path, args, work_dir, security_level, out_pid, out_stdio, in_stdio, nullptr, 0);
+}
+
+SpawnStatus s_spawn_poia(const char*   path,
+                         const char*   args,
+                         const char*   work_dir,
+                         SecurityLevel security_level,
+                         Pid*          out_pid,
+                         FileHandle    out_stdio[3],
+                         FileHandle    in_stdio[3],
+                         const void*   file_actions,
+                         unsigned int  file_actions_len) {
     auto spawn_status = SPAWN_STATUS_UNKNOWN;
 
     /* obtain the Spawner thread id as message endpoint */
@@ -54,7 +66,7 @@ SpawnStatus s_spawn_poi(const char*   path,
     auto path_len       = string_len(path) + 1;
     auto args_len       = string_len(args) + 1;
     auto work_dir_len   = string_len(work_dir) + 1;
-    auto message_len    = sizeof(SpawnCommandSpawnRequest) + path_len + args_len + work_dir_len;
+    auto message_len    = sizeof(SpawnCommandSpawnRequest) + path_len + args_len + work_dir_len + file_actions_len;
     auto request_buffer = Local{ new u8[message_len] };
 
     /* fill the request header */
@@ -65,6 +77,7 @@ SpawnStatus s_spawn_poi(const char*   path,
     request_cmd->m_path_len                 = path_len;
     request_cmd->m_args_len                 = args_len;
     request_cmd->m_workdir_len              = work_dir_len;
+    request_cmd->m_file_actions_len         = file_actions_len;
 
     /* fill-out the standard I/O */
     if ( in_stdio ) {
@@ -84,6 +97,10 @@ SpawnStatus s_spawn_poi(const char*   path,
     memory_copy(request_ptr, args, args_len);
     request_ptr += args_len;
     memory_copy(request_ptr, work_dir, work_dir_len);
+    if ( file_actions_len > 0 ) {
+        request_ptr += work_dir_len;
+        memory_copy(request_ptr, file_actions, file_actions_len);
+    }
 
     /* send the message request */
     auto send_status = s_send_message_t(spawner_tid, request_buffer(), message_len, msg_tx);
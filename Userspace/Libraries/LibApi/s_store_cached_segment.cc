@@ -0,0 +1,19 @@
+/**
+ * @brief
+ * This file is part of the MeetiX Operating System.
+ * Copyright (c) 2017-2022, Marco Cicognani (marco.cicognani@meetixos.org)
+ *
+ * @developers
+ * Marco Cicognani (marco.cicognani@meetixos.org)
+ *
+ * @license
+ * GNU General Public License version 3
+ */
+
+#include <Api/User.h>
+
+bool s_store_cached_segment(ProcessCreationIdentifier process, FileHandle file, Address virtual_address, unsigned int pages_count, bool writable) {
+    SyscallImageCacheSegment data{ process, file, virtual_address, pages_count, writable, false };
+    do_syscall(SYSCALL_IMAGE_CACHE_STORE_SEGMENT, (usize)&data);
+    return data.m_success;
+}
@@ -0,0 +1,220 @@
+/**
+ * @brief
+ * This file is part of the MeetiX Operating System.
+ * Copyright (c) 2017-2022, Marco Cicognani (marco.cicognani@meetixos.org)
+ *
+ * @developers
+ * Marco Cicognani (marco.cicognani@meetixos.org)
+ *
+ * @license
+ * GNU General Public License version 3
+ */
+
+#pragma clang diagnostic push
+#pragma ide diagnostic   ignored "modernize-deprecated-headers"
+#pragma ide diagnostic   ignored "modernize-use-trailing-return-type"
+
+#include <LibApi/Api.h>
+#include <LibC/errno.h>
+#include <LibC/spawn.h>
+#include <LibC/stdlib.h>
+#include <LibC/string.h>
+#include <LibC/stdio.h>
+
+static int append_file_action(posix_spawn_file_actions_t* file_actions,
+                              SpawnFileActionType         action_type,
+                              int                         fd,
+                              int                         source_fd,
+                              int                         open_flags,
+                              mode_t                      open_mode,
+                              const char*                 path) {
+    if ( !file_actions )
+        return EINVAL;
+    if ( fd < 0 || (action_type == SPAWN_FILE_ACTION_DUP2 && source_fd < 0) )
+        return EBADF;
+
+    /* grow the buffer geometrically, a spawn usually carries only a few actions */
+    auto const path_len   = path ? strlen(path) + 1 : 0;
+    auto const record_len = sizeof(SpawnFileAction) + path_len;
+    if ( file_actions->m_actions_len + record_len > file_actions->m_actions_capacity ) {
+        auto new_capacity = file_actions->m_actions_capacity ? file_actions->m_actions_capacity * 2 : 128;
+        while ( new_capacity < file_actions->m_actions_len + record_len )
+            new_capacity *= 2;
+
+        auto new_actions = reinterpret_cast<uint8_t*>(realloc(file_actions->m_actions, new_capacity));
+        if ( !new_actions )
+            return ENOMEM;
+
+        file_actions->m_actions          = new_actions;
+        file_actions->m_actions_capacity = new_capacity;
+    }
+
+    /* append the record and its path */
+    auto record          = reinterpret_cast<SpawnFileAction*>(file_actions->m_actions + file_actions->m_actions_len);
+    record->m_action     = action_type;
+    record->m_fd         = fd;
+    record->m_source_fd  = source_fd;
+    record->m_open_flags = open_flags;
+    record->m_open_mode  = open_mode;
+    record->m_path_len   = path_len;
+    if ( path_len > 0 )
+        memcpy(reinterpret_cast<uint8_t*>(record) + sizeof(SpawnFileAction), path, path_len);
+
+    file_actions->m_actions_len += record_len;
+    return 0;
+}
+
+static int spawn_status_to_errno(SpawnStatus spawn_status) {
+    switch ( spawn_status ) {
+        case SPAWN_STATUS_SUCCESSFUL:
+            return 0;
+        case SPAWN_STATUS_IO_ERROR:
+            return ENOENT;
+        case SPAWN_STATUS_MEMORY_ERROR:
+            return ENOMEM;
+        case SPAWN_STATUS_FORMAT_ERROR:
+            return ENOEXEC;
+        case SPAWN_STATUS_FILE_ACTION_ERROR:
+            return EBADF;
+        case SPAWN_STATUS_PROTOCOL_ERROR:
+            return EINVAL;
+        default:
+            return EIO;
+    }
+}
+
+extern "C" {
+
+int posix_spawn(pid_t*                            pid,
+                const char*                       path,
+                const posix_spawn_file_actions_t* file_actions,
+                const posix_spawnattr_t*,
+                char* const argv[],
+                char* const[]) {
+    if ( !path )
+        return EINVAL;
+
+    /* the executable path is given to the process as first argument, join the others */
+    char   args[CLIARGS_BUFFER_LENGTH];
+    size_t args_len = 0;
+    args[0]         = '\0';
+    if ( argv && argv[0] ) {
+        for ( auto arg = &argv[1]; *arg; ++arg ) {
+            auto const arg_len = strlen(*arg);
+            if ( args_len + arg_len + 2 > sizeof(args) )
+                return E2BIG;
+
+            if ( args_len > 0 )
+                args[args_len++] = ' ';
+            memcpy(args + args_len, *arg, arg_len + 1);
+            args_len += arg_len;
+        }
+    }
+
+    /* the process starts in the current working directory, the CHDIR actions are applied by the spawner */
+    char work_dir[PATH_MAX];
+    if ( s_get_working_directory_l(work_dir, sizeof(work_dir)) != GET_WORKING_DIRECTORY_SUCCESSFUL )
+        return EIO;
+
+    /* the standard I/O is inherited and the file actions are sent within the same request */
+    FileHandle in_stdio[3]  = { STDIN_FILENO, STDOUT_FILENO, STDERR_FILENO };
+    auto const actions      = file_actions ? file_actions->m_actions : nullptr;
+    auto const actions_len  = file_actions ? file_actions->m_actions_len : 0;
+    Pid        spawned_pid  = -1;
+    auto const spawn_status = s_spawn_poia(path,
+                                           args,
+                                           work_dir,
+                                           SECURITY_LEVEL_APPLICATION,
+                                           &spawned_pid,
+                                           nullptr,
+                                           in_stdio,
+                                           actions,
+                                           actions_len);
+    if ( spawn_status == SPAWN_STATUS_SUCCESSFUL && pid )
+        *pid = spawned_pid;
+    return spawn_status_to_errno(spawn_status);
+}
+
+int posix_spawnp(pid_t*                            pid,
+                 const char*                       file,
+                 const posix_spawn_file_actions_t* file_actions,
+                 const posix_spawnattr_t*          attributes,
+                 char* const                       argv[],
+                 char* const                       envp[]) {
+    /* the spawner already looks up the executables into the PATH directories */
+    return posix_spawn(pid, file, file_actions, attributes, argv, envp);
+}
+
+int posix_spawn_file_actions_init(posix_spawn_file_actions_t* file_actions) {
+    if ( !file_actions )
+        return EINVAL;
+
+    file_actions->m_actions          = nullptr;
+    file_actions->m_actions_len      = 0;
+    file_actions->m_actions_capacity = 0;
+    return 0;
+}
+
+int posix_spawn_file_actions_destroy(posix_spawn_file_actions_t* file_actions) {
+    if ( !file_actions )
+        return EINVAL;
+
+    free(file_actions->m_actions);
+    return posix_spawn_file_actions_init(file_actions);
+}
+
+int posix_spawn_file_actions_addclose(posix_spawn_file_actions_t* file_actions, int fd) {
+    return append_file_action(file_actions, SPAWN_FILE_ACTION_CLOSE, fd, FD_NONE, 0, 0, nullptr);
+}
+
+int posix_spawn_file_actions_adddup2(posix_spawn_file_actions_t* file_actions, int fd, int new_fd) {
+    return append_file_action(file_actions, SPAWN_FILE_ACTION_DUP2, new_fd, fd, 0, 0, nullptr);
+}
+
+int posix_spawn_file_actions_addopen(posix_spawn_file_actions_t* file_actions,
+                                     int                         fd,
+                                     const char*                 path,
+                                     int                         flags,
+                                     mode_t                      mode) {
+    if ( !path )
+        return EINVAL;
+    return append_file_action(file_actions, SPAWN_FILE_ACTION_OPEN, fd, FD_NONE, flags, mode, path);
+}
+
+int posix_spawn_file_actions_addchdir_np(posix_spawn_file_actions_t* file_actions, const char* path) {
+    if ( !path )
+        return EINVAL;
+    return append_file_action(file_actions, SPAWN_FILE_ACTION_CHDIR, 0, FD_NONE, 0, 0, path);
+}
+
+int posix_spawnattr_init(posix_spawnattr_t* attributes) {
+    if ( !attributes )
+        return EINVAL;
+
+    attributes->m_flags = 0;
+    return 0;
+}
+
+int posix_spawnattr_destroy(posix_spawnattr_t* attributes) {
+    return posix_spawnattr_init(attributes);
+}
+
+int posix_spawnattr_getflags(const posix_spawnattr_t* attributes, short* flags) {
+    if ( !attributes || !flags )
+        return EINVAL;
+
+    *flags = attributes->m_flags;
+    return 0;
+}
+
+int posix_spawnattr_setflags(posix_spawnattr_t* attributes, short flags) {
+    if ( !attributes )
+        return EINVAL;
+
+    attributes->m_flags = flags;
+    return 0;
+}
+
+} /* extern "C" */
+
+#pragma clang diagnostic pop
@@ -0,0 +1,63 @@
+/**
+ * @brief
+ * This file is part of the MeetiX Operating System.
+ * Copyright (c) 2017-2022, Marco Cicognani (marco.cicognani@meetixos.org)
+ *
+ * @developers
+ * Marco Cicognani (marco.cicognani@meetixos.org)
+ *
+ * @license
+ * GNU General Public License version 3
+ */
+
+#pragma once
+#pragma clang diagnostic push
+#pragma ide diagnostic   ignored "modernize-deprecated-headers"
+#pragma ide diagnostic   ignored "modernize-use-trailing-return-type"
+
+#include <fcntl.h>
+#include <stddef.h>
+#include <stdint.h>
+#include <sys/types.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/**
+ * @brief File actions are packed as the {SpawnFileAction} records of the spawner request,
+ * so posix_spawn() sends them as they are
+ */
+struct posix_spawn_file_actions_t {
+    uint8_t* m_actions;
+    size_t   m_actions_len;
+    size_t   m_actions_capacity;
+};
+
+struct posix_spawnattr_t {
+    short m_flags;
+};
+
+TYPE_ALIAS(posix_spawn_file_actions_t, struct posix_spawn_file_actions_t);
+TYPE_ALIAS(posix_spawnattr_t, struct posix_spawnattr_t);
+
+int posix_spawn(pid_t*, const char*, const posix_spawn_file_actions_t*, const posix_spawnattr_t*, char* const[], char* const[]);
+int posix_spawnp(pid_t*, const char*, const posix_spawn_file_actions_t*, const posix_spawnattr_t*, char* const[], char* const[]);
+
+int posix_spawn_file_actions_init(posix_spawn_file_actions_t*);
+int posix_spawn_file_actions_destroy(posix_spawn_file_actions_t*);
+int posix_spawn_file_actions_addclose(posix_spawn_file_actions_t*, int);
+int posix_spawn_file_actions_adddup2(posix_spawn_file_actions_t*, int, int);
+int posix_spawn_file_actions_addopen(posix_spawn_file_actions_t*, int, const char*, int, mode_t);
+int posix_spawn_file_actions_addchdir_np(posix_spawn_file_actions_t*, const char*);
+
+int posix_spawnattr_init(posix_spawnattr_t*);
+int posix_spawnattr_destroy(posix_spawnattr_t*);
+int posix_spawnattr_getflags(const posix_spawnattr_t*, short*);
+int posix_spawnattr_setflags(posix_spawnattr_t*, short);
+
+#ifdef __cplusplus
+} /* extern "C" */
+#endif
+
+#pragma clang diagnostic pop
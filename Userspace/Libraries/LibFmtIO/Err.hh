@@ -17,13 +17,13 @@
 namespace FmtIO {
 
 template<typename... TArgs>
-auto err(StringView format_view, TArgs&&... args) -> ErrorOr<void> {
-   return vout(stdout, format_view, Cxx::forward<TArgs>(args)...);
+auto err(FormatString<TypeIdentity<TArgs>...> format_string, TArgs const&... args) -> ErrorOr<void> {
+   return vout(stderr, format_string, args...);
 }
 
 template<typename... TArgs>
-auto errln(StringView format_view, TArgs&&... args) -> ErrorOr<void> {
-   return voutln(stdout, format_view, Cxx::forward<TArgs>(args)...);
+auto errln(FormatString<TypeIdentity<TArgs>...> format_string, TArgs const&... args) -> ErrorOr<void> {
+   return voutln(stderr, format_string, args...);
 }
 
 } /* namespace FmtIO */
\ No newline at end of file
@@ -17,13 +17,13 @@
 namespace FmtIO {
 
 template<typename... TArgs>
-auto out(StringView format_view, TArgs&&... args) -> ErrorOr<void> {
-    return vout(stdout, format_view, Cxx::forward<TArgs>(args)...);
+auto out(FormatString<TypeIdentity<TArgs>...> format_string, TArgs const&... args) -> ErrorOr<void> {
+    return vout(stdout, format_string, args...);
 }
 
 template<typename... TArgs>
-auto outln(StringView format_view, TArgs&&... args) -> ErrorOr<void> {
-    return voutln(stdout, format_view, Cxx::forward<TArgs>(args)...);
+auto outln(FormatString<TypeIdentity<TArgs>...> format_string, TArgs const&... args) -> ErrorOr<void> {
+    return voutln(stdout, format_string, args...);
 }
 
 } /* namespace FmtIO */
\ No newline at end of file
@@ -16,7 +16,9 @@
 
 #include <CCLang/Alloc/StringBuilder.hh>
 #include <CCLang/Alloc/Text/Format.hh>
+#include <CCLang/Alloc/Text/FormatString.hh>
 #include <CCLang/Core/ErrorOr.hh>
+#include <CCLang/Core/Meta.hh>
 #include <CCLang/Lang/Cxx.hh>
 #include <CCLang/Lang/StringView.hh>
 #include <CCLang/Lang/Try.hh>
@@ -40,23 +42,23 @@ auto background(Color background) -> StringView;
 auto reset() -> StringView;
 
 template<typename... TArgs>
-auto vout(FILE* file, StringView format_view, TArgs&&... args) -> ErrorOr<void> {
-    /* format the arguments according to the given <format_view> */
+auto vout(FILE* file, FormatString<TypeIdentity<TArgs>...> format_string, TArgs const&... args) -> ErrorOr<void> {
+    /* format the arguments according to the given <format_string>, already parsed at compile time */
     auto string_builder = StringBuilder::construct_empty();
-    try$(format(string_builder, format_view, Cxx::forward<TArgs>(args)...));
+    try$(format(string_builder, format_string, args...));
 
     /* write the result into the stdout */
     auto const res = fwrite(string_builder.as_string_view().as_cstr(), 1, string_builder.len(), file);
     if ( res < string_builder.len() )
-        return Error::construct_from_code(static_cast<ErrnoCode>(ferror(stdout)));
+        return Error::construct_from_code(static_cast<ErrnoCode>(ferror(file)));
     else
         return {};
 }
 
 template<typename... TArgs>
-auto voutln(FILE* file, StringView format_view, TArgs&&... args) -> ErrorOr<void> {
-    try$(vout(file, format_view, Cxx::forward<TArgs>(args)...));
-    try$(vout(file, "\n"sv));
+auto voutln(FILE* file, FormatString<TypeIdentity<TArgs>...> format_string, TArgs const&... args) -> ErrorOr<void> {
+    try$(vout(file, format_string, args...));
+    try$(vout(file, "\n"));
     return {};
 }
 
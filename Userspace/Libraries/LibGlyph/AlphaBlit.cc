@@ -0,0 +1,269 @@
+/**
+ * @brief
+ * This file is part of the MeetiX Operating System.
+ * Copyright (c) 2017-2022, Marco Cicognani (marco.cicognani@meetixos.org)
+ *
+ * @developers
+ * Marco Cicognani (marco.cicognani@meetixos.org)
+ *
+ * @license
+ * GNU General Public License version 3
+ */
+
+#include <LibGlyph/AlphaBlit.hh>
+
+namespace Glyph {
+namespace {
+
+using Pixel = u32::NativeInt;
+using Alpha = u8::NativeInt;
+
+/**
+ * @brief Rounded <value / 255> for the values up to 255 * 255, without the division
+ */
+inline auto div_255(Pixel value) -> Pixel {
+    value += 128;
+    return (value + (value >> 8)) >> 8;
+}
+
+inline auto blend_pixel(Pixel target_pixel, Pixel argb_color, Alpha alpha) -> Pixel {
+    if ( alpha == 0 )
+        return target_pixel;
+    else if ( alpha == 255 )
+        return argb_color;
+
+    Pixel blended_pixel = 0;
+    for ( auto shift = 0; shift < 32; shift += 8 ) {
+        auto const color_channel  = (argb_color >> shift) & 0xff;
+        auto const target_channel = (target_pixel >> shift) & 0xff;
+        blended_pixel |= div_255(color_channel * alpha + target_channel * (255 - alpha)) << shift;
+    }
+    return blended_pixel;
+}
+
+/**
+ * @brief Premultiplied source-over: the target shows through by the transparency of the source
+ */
+inline auto blend_premultiplied_pixel(Pixel target_pixel, Pixel source_pixel) -> Pixel {
+    auto const transparency = 255 - (source_pixel >> 24);
+    if ( transparency == 0 )
+        return source_pixel;
+    else if ( source_pixel == 0 )
+        return target_pixel;
+
+    Pixel blended_pixel = 0;
+    for ( auto shift = 0; shift < 32; shift += 8 ) {
+        auto const source_channel = (source_pixel >> shift) & 0xff;
+        auto const target_channel = (target_pixel >> shift) & 0xff;
+        blended_pixel |= (source_channel + div_255(target_channel * transparency)) << shift;
+    }
+    return blended_pixel;
+}
+
+/**
+ * @brief Clips the span [start, start + len) to [0, limit) and returns the count of skipped leading items
+ */
+inline auto clip_span(isize::NativeInt& start, isize::NativeInt& len, isize::NativeInt limit) -> isize::NativeInt {
+    isize::NativeInt skipped = 0;
+    if ( start < 0 ) {
+        skipped = -start;
+        len += start;
+        start = 0;
+    }
+    if ( start + len > limit )
+        len = limit - start;
+    return skipped;
+}
+
+#ifdef __SSE2__
+/* the vector extensions keep the intrinsics headers, which need the hosted libc, out */
+using Bytes16 = char __attribute__((vector_size(16)));
+using Words8  = short __attribute__((vector_size(16)));
+using UWords8 = unsigned short __attribute__((vector_size(16)));
+
+using Quads2  = long long __attribute__((vector_size(16)));
+
+inline auto widen_low(Bytes16 bytes) -> UWords8 {
+    return reinterpret_cast<UWords8>(__builtin_ia32_punpcklbw128(bytes, Bytes16{}));
+}
+
+inline auto widen_high(Bytes16 bytes) -> UWords8 {
+    return reinterpret_cast<UWords8>(__builtin_ia32_punpckhbw128(bytes, Bytes16{}));
+}
+
+/**
+ * @brief Blends 4 pixels at once with the same arithmetic of blend_pixel(), widening the channels to 16 bits
+ */
+inline auto blend_4_pixels(Pixel* target_ptr, UWords8 color_16, Alpha const* alpha_ptr) -> void {
+    Pixel alphas;
+    __builtin_memcpy(&alphas, alpha_ptr, sizeof(Pixel));
+    if ( alphas == 0 )
+        return;
+
+    auto const color_8 = __builtin_ia32_packuswb128(reinterpret_cast<Words8>(color_16), reinterpret_cast<Words8>(color_16));
+    if ( alphas == 0xffffffff ) {
+        __builtin_memcpy(target_ptr, &color_8, sizeof(Bytes16));
+        return;
+    }
+
+    /* spread each alpha to the four channels of its pixel */
+    auto alpha_8 = Bytes16{};
+    __builtin_memcpy(&alpha_8, &alphas, sizeof(Pixel));
+    alpha_8 = __builtin_ia32_punpcklbw128(alpha_8, alpha_8);
+    alpha_8 = reinterpret_cast<Bytes16>(__builtin_ia32_punpcklwd128(reinterpret_cast<Words8>(alpha_8), reinterpret_cast<Words8>(alpha_8)));
+
+    Bytes16 target_8;
+    __builtin_memcpy(&target_8, target_ptr, sizeof(Bytes16));
+
+    auto blend_half = [color_16](UWords8 target_16, UWords8 alpha_16) {
+        auto const value_16 = color_16 * alpha_16 + target_16 * (255 - alpha_16) + 128;
+        return reinterpret_cast<Words8>((value_16 + (value_16 >> 8)) >> 8);
+    };
+
+    auto const low_16  = blend_half(widen_low(target_8), widen_low(alpha_8));
+    auto const high_16 = blend_half(widen_high(target_8), widen_high(alpha_8));
+    auto const blended_8 = __builtin_ia32_packuswb128(low_16, high_16);
+    __builtin_memcpy(target_ptr, &blended_8, sizeof(Bytes16));
+}
+
+/**
+ * @brief Composes 4 premultiplied pixels at once with the same arithmetic of blend_premultiplied_pixel()
+ */
+inline auto blend_4_premultiplied_pixels(Pixel* target_ptr, Pixel const* source_ptr) -> void {
+    Bytes16 source_8;
+    __builtin_memcpy(&source_8, source_ptr, sizeof(Bytes16));
+
+    /* the fully opaque and the fully transparent spans are the most common into the surfaces */
+    auto const opaque_mask = __builtin_ia32_pmovmskb128(__builtin_ia32_pcmpeqb128(source_8, Bytes16{} - 1));
+    if ( (opaque_mask & 0x8888) == 0x8888 ) {
+        __builtin_memcpy(target_ptr, &source_8, sizeof(Bytes16));
+        return;
+    }
+    if ( __builtin_ia32_pmovmskb128(__builtin_ia32_pcmpeqb128(source_8, Bytes16{})) == 0xffff )
+        return;
+
+    Bytes16 target_8;
+    __builtin_memcpy(&target_8, target_ptr, sizeof(Bytes16));
+
+    auto blend_half = [](UWords8 source_16, UWords8 target_16) {
+        /* spread the alpha word of each pixel to its four channels */
+        auto const alpha_16 = reinterpret_cast<UWords8>(
+            __builtin_ia32_pshufhw(__builtin_ia32_pshuflw(reinterpret_cast<Words8>(source_16), 0xff), 0xff));
+        auto const value_16 = target_16 * (255 - alpha_16) + 128;
+        return reinterpret_cast<Words8>(source_16 + ((value_16 + (value_16 >> 8)) >> 8));
+    };
+
+    auto const low_16    = blend_half(widen_low(source_8), widen_low(target_8));
+    auto const high_16   = blend_half(widen_high(source_8), widen_high(target_8));
+    auto const blended_8 = __builtin_ia32_packuswb128(low_16, high_16);
+    __builtin_memcpy(target_ptr, &blended_8, sizeof(Bytes16));
+}
+#endif
+
+} /* namespace */
+
+auto fill_rect(ArgbTarget const& argb_target, isize x, isize y, usize width, usize height, u32 argb_color) -> void {
+    auto start_x = x.unwrap();
+    auto start_y = y.unwrap();
+    auto len_x   = static_cast<isize::NativeInt>(width.unwrap());
+    auto len_y   = static_cast<isize::NativeInt>(height.unwrap());
+    clip_span(start_x, len_x, static_cast<isize::NativeInt>(argb_target.m_width.unwrap()));
+    clip_span(start_y, len_y, static_cast<isize::NativeInt>(argb_target.m_height.unwrap()));
+    if ( len_x <= 0 || len_y <= 0 )
+        return;
+
+    auto row_ptr = argb_target.m_pixels_ptr + start_y * argb_target.m_stride.unwrap() + start_x;
+    for ( auto row = 0; row < len_y; ++row ) {
+        for ( auto column = 0; column < len_x; ++column )
+            row_ptr[column] = argb_color.unwrap();
+        row_ptr += argb_target.m_stride.unwrap();
+    }
+}
+
+auto blend_glyph(ArgbTarget const& argb_target, GlyphBitmap const& glyph_bitmap, isize pen_x, isize pen_y, u32 argb_color)
+    -> void {
+    auto start_x = pen_x.unwrap() + glyph_bitmap.m_bearing_x.unwrap();
+    auto start_y = pen_y.unwrap() + glyph_bitmap.m_bearing_y.unwrap();
+    auto len_x   = static_cast<isize::NativeInt>(glyph_bitmap.m_width.unwrap());
+    auto len_y   = static_cast<isize::NativeInt>(glyph_bitmap.m_height.unwrap());
+    auto const skipped_x = clip_span(start_x, len_x, static_cast<isize::NativeInt>(argb_target.m_width.unwrap()));
+    auto const skipped_y = clip_span(start_y, len_y, static_cast<isize::NativeInt>(argb_target.m_height.unwrap()));
+    if ( len_x <= 0 || len_y <= 0 )
+        return;
+
+    auto const color = argb_color.unwrap();
+    auto target_row_ptr = argb_target.m_pixels_ptr + start_y * argb_target.m_stride.unwrap() + start_x;
+    auto alpha_row_ptr  = glyph_bitmap.m_alpha_ptr + skipped_y * glyph_bitmap.m_stride.unwrap() + skipped_x;
+
+#ifdef __SSE2__
+    Bytes16 color_8;
+    for ( auto i = 0; i < 4; ++i )
+        __builtin_memcpy(reinterpret_cast<Pixel*>(&color_8) + i, &color, sizeof(Pixel));
+    auto const color_16 = widen_low(color_8);
+#endif
+
+    for ( auto row = 0; row < len_y; ++row ) {
+        isize::NativeInt column = 0;
+#ifdef __SSE2__
+        for ( ; column + 4 <= len_x; column += 4 )
+            blend_4_pixels(target_row_ptr + column, color_16, alpha_row_ptr + column);
+#endif
+        for ( ; column < len_x; ++column )
+            target_row_ptr[column] = blend_pixel(target_row_ptr[column], color, alpha_row_ptr[column]);
+
+        target_row_ptr += argb_target.m_stride.unwrap();
+        alpha_row_ptr += glyph_bitmap.m_stride.unwrap();
+    }
+}
+
+auto blend_surface(ArgbTarget const& argb_target, ArgbTarget const& argb_source, isize x, isize y) -> void {
+    auto start_x = x.unwrap();
+    auto start_y = y.unwrap();
+    auto len_x   = static_cast<isize::NativeInt>(argb_source.m_width.unwrap());
+    auto len_y   = static_cast<isize::NativeInt>(argb_source.m_height.unwrap());
+    auto const skipped_x = clip_span(start_x, len_x, static_cast<isize::NativeInt>(argb_target.m_width.unwrap()));
+    auto const skipped_y = clip_span(start_y, len_y, static_cast<isize::NativeInt>(argb_target.m_height.unwrap()));
+    if ( len_x <= 0 || len_y <= 0 )
+        return;
+
+    auto target_row_ptr = argb_target.m_pixels_ptr + start_y * argb_target.m_stride.unwrap() + start_x;
+    auto source_row_ptr = argb_source.m_pixels_ptr + skipped_y * argb_source.m_stride.unwrap() + skipped_x;
+    for ( auto row = 0; row < len_y; ++row ) {
+        isize::NativeInt column = 0;
+#ifdef __SSE2__
+        for ( ; column + 4 <= len_x; column += 4 )
+            blend_4_premultiplied_pixels(target_row_ptr + column, source_row_ptr + column);
+#endif
+        for ( ; column < len_x; ++column )
+            target_row_ptr[column] = blend_premultiplied_pixel(target_row_ptr[column], source_row_ptr[column]);
+
+        target_row_ptr += argb_target.m_stride.unwrap();
+        source_row_ptr += argb_source.m_stride.unwrap();
+    }
+}
+
+auto stream_copy_pixels(u32::NativeInt* target_ptr, u32::NativeInt const* source_ptr, usize pixels_count) -> void {
+    auto const count = pixels_count.unwrap();
+
+#ifdef __SSE2__
+    usize::NativeInt pixel = 0;
+
+    /* the 16 bytes non-temporal stores need an aligned target, the source can stay unaligned */
+    for ( ; pixel < count && (reinterpret_cast<usize::NativeInt>(target_ptr + pixel) & 15) != 0; ++pixel )
+        __builtin_ia32_movnti(reinterpret_cast<int*>(target_ptr + pixel), static_cast<int>(source_ptr[pixel]));
+    for ( ; pixel + 4 <= count; pixel += 4 ) {
+        Quads2 pixels_4;
+        __builtin_memcpy(&pixels_4, source_ptr + pixel, sizeof(Quads2));
+        __builtin_ia32_movntdq(reinterpret_cast<Quads2*>(target_ptr + pixel), pixels_4);
+    }
+    for ( ; pixel < count; ++pixel )
+        __builtin_ia32_movnti(reinterpret_cast<int*>(target_ptr + pixel), static_cast<int>(source_ptr[pixel]));
+
+    /* the non-temporal stores are weakly ordered, make them visible before returning */
+    __builtin_ia32_sfence();
+#else
+    __builtin_memcpy(target_ptr, source_ptr, count * sizeof(Pixel));
+#endif
+}
+
+} /* namespace Glyph */
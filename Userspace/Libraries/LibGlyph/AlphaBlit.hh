@@ -0,0 +1,56 @@
+/**
+ * @brief
+ * This file is part of the MeetiX Operating System.
+ * Copyright (c) 2017-2022, Marco Cicognani (marco.cicognani@meetixos.org)
+ *
+ * @developers
+ * Marco Cicognani (marco.cicognani@meetixos.org)
+ *
+ * @license
+ * GNU General Public License version 3
+ */
+
+#pragma once
+
+#include <CCLang/Lang/IntTypes.hh>
+#include <LibGlyph/GlyphAtlas.hh>
+
+namespace Glyph {
+
+/**
+ * @brief Destination of the blits: 32 bits ARGB pixels (i.e. a CAIRO_FORMAT_ARGB32 surface), stride in pixels
+ */
+struct ArgbTarget {
+    u32::NativeInt* m_pixels_ptr;
+    usize           m_stride;
+    usize           m_width;
+    usize           m_height;
+};
+
+/**
+ * @brief Fills the given rectangle with an opaque color
+ */
+auto fill_rect(ArgbTarget const& argb_target, isize x, isize y, usize width, usize height, u32 argb_color) -> void;
+
+/**
+ * @brief Blends the coverage of the glyph into the target with the given opaque color, placing its pen position
+ * at <pen_x, pen_y>. The parts out of the target are clipped.
+ * Uses SSE2 when the library is built for it
+ */
+auto blend_glyph(ArgbTarget const& argb_target, GlyphBitmap const& glyph_bitmap, isize pen_x, isize pen_y, u32 argb_color) -> void;
+
+/**
+ * @brief Composes the premultiplied ARGB pixels of the source over the target (the "over" operator of cairo) placing
+ * its top-left pixel at <x, y>. The parts out of the target are clipped.
+ * Uses SSE2 when the library is built for it
+ */
+auto blend_surface(ArgbTarget const& argb_target, ArgbTarget const& argb_source, isize x, isize y) -> void;
+
+/**
+ * @brief Copies a span of pixels with non-temporal stores, for the blits to a write-combining framebuffer:
+ * the stores are merged into full bursts and the caches are not filled with lines which are never read back.
+ * Uses SSE2 when the library is built for it, a plain copy otherwise
+ */
+auto stream_copy_pixels(u32::NativeInt* target_ptr, u32::NativeInt const* source_ptr, usize pixels_count) -> void;
+
+} /* namespace Glyph */
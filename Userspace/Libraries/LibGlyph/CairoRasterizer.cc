@@ -0,0 +1,124 @@
+/**
+ * @brief
+ * This file is part of the MeetiX Operating System.
+ * Copyright (c) 2017-2022, Marco Cicognani (marco.cicognani@meetixos.org)
+ *
+ * @developers
+ * Marco Cicognani (marco.cicognani@meetixos.org)
+ *
+ * @license
+ * GNU General Public License version 3
+ */
+
+#include <LibGlyph/CairoRasterizer.hh>
+
+#include <CCLang/Core/ScopeGuard.hh>
+#include <CCLang/Lang/Try.hh>
+
+namespace Glyph {
+namespace {
+
+auto encode_utf8(u32 codepoint, char* utf8_buffer) -> int {
+    auto const value = codepoint.unwrap();
+    if ( value < 0x80 ) {
+        utf8_buffer[0] = static_cast<char>(value);
+        return 1;
+    } else if ( value < 0x800 ) {
+        utf8_buffer[0] = static_cast<char>(0xc0 | value >> 6);
+        utf8_buffer[1] = static_cast<char>(0x80 | (value & 0x3f));
+        return 2;
+    } else if ( value < 0x10000 ) {
+        utf8_buffer[0] = static_cast<char>(0xe0 | value >> 12);
+        utf8_buffer[1] = static_cast<char>(0x80 | (value >> 6 & 0x3f));
+        utf8_buffer[2] = static_cast<char>(0x80 | (value & 0x3f));
+        return 3;
+    } else {
+        utf8_buffer[0] = static_cast<char>(0xf0 | value >> 18);
+        utf8_buffer[1] = static_cast<char>(0x80 | (value >> 12 & 0x3f));
+        utf8_buffer[2] = static_cast<char>(0x80 | (value >> 6 & 0x3f));
+        utf8_buffer[3] = static_cast<char>(0x80 | (value & 0x3f));
+        return 4;
+    }
+}
+
+auto floor_to_int(double value) -> i32::NativeInt {
+    auto const truncated = static_cast<i32::NativeInt>(value);
+    return truncated > value ? truncated - 1 : truncated;
+}
+
+auto ceil_to_int(double value) -> i32::NativeInt {
+    auto const truncated = static_cast<i32::NativeInt>(value);
+    return truncated < value ? truncated + 1 : truncated;
+}
+
+} /* namespace */
+
+auto try_rasterize_glyph(GlyphAtlas& glyph_atlas, cairo_scaled_font_t* cairo_scaled_font, GlyphKey const& glyph_key)
+    -> ErrorOr<GlyphBitmap> {
+    char utf8_buffer[4];
+    auto const utf8_len = encode_utf8(glyph_key.m_codepoint, utf8_buffer);
+
+    /* obtain the glyphs of the codepoint and their ink extents */
+    cairo_glyph_t* cairo_glyphs       = nullptr;
+    int            cairo_glyphs_count = 0;
+    auto const     cairo_status       = cairo_scaled_font_text_to_glyphs(cairo_scaled_font,
+                                                                0,
+                                                                0,
+                                                                utf8_buffer,
+                                                                utf8_len,
+                                                                &cairo_glyphs,
+                                                                &cairo_glyphs_count,
+                                                                nullptr,
+                                                                nullptr,
+                                                                nullptr);
+    if ( cairo_status != CAIRO_STATUS_SUCCESS )
+        return Error::from_code(ErrorCode::Invalid);
+
+    ScopeGuard cairo_glyphs_guard{ [cairo_glyphs] { cairo_glyph_free(cairo_glyphs); } };
+
+    cairo_text_extents_t text_extents;
+    cairo_scaled_font_glyph_extents(cairo_scaled_font, cairo_glyphs, cairo_glyphs_count, &text_extents);
+
+    auto const bearing_x = floor_to_int(text_extents.x_bearing);
+    auto const bearing_y = floor_to_int(text_extents.y_bearing);
+    auto const width     = ceil_to_int(text_extents.x_bearing + text_extents.width) - bearing_x;
+    auto const height    = ceil_to_int(text_extents.y_bearing + text_extents.height) - bearing_y;
+
+    /* the blank glyphs are cached too, without coverage */
+    if ( text_extents.width <= 0 || text_extents.height <= 0 )
+        return glyph_atlas.try_insert(glyph_key, nullptr, 0, 0, 0, 0, 0);
+
+    /* draw the glyphs with the top-left of their ink at the origin of a coverage-only surface */
+    auto const cairo_surface = cairo_image_surface_create(CAIRO_FORMAT_A8, width, height);
+    ScopeGuard cairo_surface_guard{ [cairo_surface] { cairo_surface_destroy(cairo_surface); } };
+    auto const cairo_context = cairo_create(cairo_surface);
+    ScopeGuard cairo_context_guard{ [cairo_context] { cairo_destroy(cairo_context); } };
+
+    for ( auto i = 0; i < cairo_glyphs_count; ++i ) {
+        cairo_glyphs[i].x -= bearing_x;
+        cairo_glyphs[i].y -= bearing_y;
+    }
+    cairo_set_scaled_font(cairo_context, cairo_scaled_font);
+    cairo_set_source_rgba(cairo_context, 0, 0, 0, 1);
+    cairo_show_glyphs(cairo_context, cairo_glyphs, cairo_glyphs_count);
+    cairo_surface_flush(cairo_surface);
+
+    return glyph_atlas.try_insert(glyph_key,
+                                  cairo_image_surface_get_data(cairo_surface),
+                                  static_cast<usize::NativeInt>(cairo_image_surface_get_stride(cairo_surface)),
+                                  static_cast<u16::NativeInt>(width),
+                                  static_cast<u16::NativeInt>(height),
+                                  static_cast<i16::NativeInt>(bearing_x),
+                                  static_cast<i16::NativeInt>(bearing_y));
+}
+
+auto try_find_or_rasterize_glyph(GlyphAtlas& glyph_atlas, cairo_scaled_font_t* cairo_scaled_font, GlyphKey const& glyph_key)
+    -> ErrorOr<GlyphBitmap> {
+    auto glyph_bitmap_or_none = glyph_atlas.find(glyph_key);
+    if ( glyph_bitmap_or_none.is_present() )
+        return glyph_bitmap_or_none.unwrap();
+
+    return try_rasterize_glyph(glyph_atlas, cairo_scaled_font, glyph_key);
+}
+
+} /* namespace Glyph */
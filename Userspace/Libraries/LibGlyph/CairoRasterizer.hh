@@ -0,0 +1,34 @@
+/**
+ * @brief
+ * This file is part of the MeetiX Operating System.
+ * Copyright (c) 2017-2022, Marco Cicognani (marco.cicognani@meetixos.org)
+ *
+ * @developers
+ * Marco Cicognani (marco.cicognani@meetixos.org)
+ *
+ * @license
+ * GNU General Public License version 3
+ */
+
+#pragma once
+
+#include <cairo/cairo.h>
+#include <CCLang/Core/ErrorOr.hh>
+#include <LibGlyph/GlyphAtlas.hh>
+
+namespace Glyph {
+
+/**
+ * @brief Rasterizes with cairo the glyph of the key into the atlas.
+ * The given scaled font must be the face, size and style which the key stands for
+ */
+auto try_rasterize_glyph(GlyphAtlas& glyph_atlas, cairo_scaled_font_t* cairo_scaled_font, GlyphKey const& glyph_key)
+    -> ErrorOr<GlyphBitmap>;
+
+/**
+ * @brief Returns the glyph from the atlas, rasterizing it only the first time
+ */
+auto try_find_or_rasterize_glyph(GlyphAtlas& glyph_atlas, cairo_scaled_font_t* cairo_scaled_font, GlyphKey const& glyph_key)
+    -> ErrorOr<GlyphBitmap>;
+
+} /* namespace Glyph */
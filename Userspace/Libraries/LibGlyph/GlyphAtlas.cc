@@ -0,0 +1,102 @@
+/**
+ * @brief
+ * This file is part of the MeetiX Operating System.
+ * Copyright (c) 2017-2022, Marco Cicognani (marco.cicognani@meetixos.org)
+ *
+ * @developers
+ * Marco Cicognani (marco.cicognani@meetixos.org)
+ *
+ * @license
+ * GNU General Public License version 3
+ */
+
+#include <LibGlyph/GlyphAtlas.hh>
+
+#include <CCLang/Alloc/New.hh>
+#include <CCLang/Core/ScopeGuard.hh>
+#include <CCLang/Lang/Cxx.hh>
+#include <CCLang/Lang/Try.hh>
+
+namespace Glyph {
+
+auto GlyphKey::packed() const -> u64 {
+    /* 16 bits of font identifier and 8 bits of pixel size are enough for the faces loaded by an application */
+    return u64(m_font_id.unwrap() & 0xffff) << 48 | u64(m_pixel_size.unwrap() & 0xff) << 40
+         | u64(m_style.unwrap()) << 32 | u64(m_codepoint.unwrap());
+}
+
+auto GlyphAtlas::empty() -> GlyphAtlas {
+    return GlyphAtlas();
+}
+
+GlyphAtlas::GlyphAtlas(GlyphAtlas&& rhs)
+    : m_glyphs(Cxx::move(rhs.m_glyphs))
+    , m_pages(Cxx::move(rhs.m_pages))
+    , m_shelf_y(Cxx::exchange(rhs.m_shelf_y, 0))
+    , m_shelf_height(Cxx::exchange(rhs.m_shelf_height, 0))
+    , m_shelf_x(Cxx::exchange(rhs.m_shelf_x, 0)) {
+}
+
+GlyphAtlas::~GlyphAtlas() {
+    for ( auto const page_ptr : m_pages )
+        Details::internal_heap_dealloc(page_ptr, C_PAGE_SIDE * C_PAGE_SIDE);
+}
+
+auto GlyphAtlas::find(GlyphKey const& glyph_key) const -> Option<GlyphBitmap> {
+    auto const& glyph_bitmap = try$(m_glyphs.at(glyph_key.packed()));
+    return glyph_bitmap;
+}
+
+auto GlyphAtlas::try_insert(GlyphKey const& glyph_key,
+                            u8::NativeInt const* alpha_ptr,
+                            usize stride,
+                            u16 width,
+                            u16 height,
+                            i16 bearing_x,
+                            i16 bearing_y) -> ErrorOr<GlyphBitmap> {
+    auto const cell_ptr = try$(try_reserve_cell(width, height));
+    for ( auto const y : usize::range(0, height.as<usize>()) )
+        Cxx::memcpy(cell_ptr + (y * C_PAGE_SIDE).unwrap(), alpha_ptr + (y * stride).unwrap(), width.as<usize>());
+
+    auto const glyph_bitmap = GlyphBitmap{ cell_ptr, C_PAGE_SIDE, width, height, bearing_x, bearing_y };
+    try$(m_glyphs.try_insert(glyph_key.packed(), glyph_bitmap));
+    return glyph_bitmap;
+}
+
+auto GlyphAtlas::glyphs_count() const -> usize {
+    return m_glyphs.count();
+}
+
+auto GlyphAtlas::pages_count() const -> usize {
+    return m_pages.count();
+}
+
+auto GlyphAtlas::try_reserve_cell(u16 width, u16 height) -> ErrorOr<u8::NativeInt*> {
+    if ( width.as<usize>() > C_PAGE_SIDE || height.as<usize>() > C_PAGE_SIDE )
+        return Error::from_code(ErrorCode::BadParameter);
+
+    /* open a new shelf when the current one is full, and a new page when there is no room for the shelf */
+    if ( m_shelf_x + width.unwrap() > C_PAGE_SIDE ) {
+        m_shelf_y      += m_shelf_height;
+        m_shelf_height = 0;
+        m_shelf_x      = 0;
+    }
+    if ( m_pages.is_empty() || m_shelf_y + height.unwrap() > C_PAGE_SIDE ) {
+        auto const page_ptr = static_cast<u8::NativeInt*>(try$(Details::internal_heap_alloc(C_PAGE_SIDE * C_PAGE_SIDE)));
+        ScopeGuard page_guard{ [page_ptr] { Details::internal_heap_dealloc(page_ptr, C_PAGE_SIDE * C_PAGE_SIDE); } };
+        try$(m_pages.try_append(page_ptr));
+        page_guard.disarm();
+
+        m_shelf_y      = 0;
+        m_shelf_height = 0;
+        m_shelf_x      = 0;
+    }
+
+    auto const cell_ptr = m_pages.last() + m_shelf_y * C_PAGE_SIDE + m_shelf_x;
+    m_shelf_x += width.unwrap();
+    if ( height.unwrap() > m_shelf_height )
+        m_shelf_height = height.unwrap();
+    return cell_ptr;
+}
+
+} /* namespace Glyph */
@@ -0,0 +1,102 @@
+/**
+ * @brief
+ * This file is part of the MeetiX Operating System.
+ * Copyright (c) 2017-2022, Marco Cicognani (marco.cicognani@meetixos.org)
+ *
+ * @developers
+ * Marco Cicognani (marco.cicognani@meetixos.org)
+ *
+ * @license
+ * GNU General Public License version 3
+ */
+
+#pragma once
+
+#include <CCLang/Alloc/Map.hh>
+#include <CCLang/Alloc/Vector.hh>
+#include <CCLang/Core/ErrorOr.hh>
+#include <CCLang/Lang/DenyCopy.hh>
+#include <CCLang/Lang/IntTypes.hh>
+#include <CCLang/Lang/Option.hh>
+
+namespace Glyph {
+
+/**
+ * @brief Identifies a rasterized glyph. The font identifier is chosen by the users of the atlas, which must give
+ * different identifiers to different font faces
+ */
+struct GlyphKey {
+    u32 m_font_id;
+    u16 m_pixel_size;
+    u8  m_style;
+    u32 m_codepoint;
+
+    auto packed() const -> u64;
+};
+
+/**
+ * @brief A8 coverage of a glyph stored into the atlas.
+ * The bearings are the offset of the top-left pixel from the pen position on the baseline
+ */
+struct GlyphBitmap {
+    u8::NativeInt const* m_alpha_ptr;
+    usize                m_stride;
+    u16                  m_width;
+    u16                  m_height;
+    i16                  m_bearing_x;
+    i16                  m_bearing_y;
+};
+
+/**
+ * @brief Cache of glyphs rasterized once into A8 pages, packed in shelves.
+ * The pages are never moved, so the GlyphBitmap given out stay valid for the life of the atlas
+ */
+class GlyphAtlas final : public DenyCopy {
+public:
+    static constexpr usize::NativeInt C_PAGE_SIDE = 512;
+
+public:
+    /**
+     * @brief Non-Error safe factory functions
+     */
+    static auto empty() -> GlyphAtlas;
+
+    GlyphAtlas(GlyphAtlas&&);
+    ~GlyphAtlas();
+
+    /**
+     * @brief Returns the glyph rasterized for the given key, if any
+     */
+    auto find(GlyphKey const& glyph_key) const -> Option<GlyphBitmap>;
+
+    /**
+     * @brief Copies the given coverage into the atlas and returns where it lives now
+     */
+    auto try_insert(GlyphKey const& glyph_key,
+                    u8::NativeInt const* alpha_ptr,
+                    usize stride,
+                    u16 width,
+                    u16 height,
+                    i16 bearing_x,
+                    i16 bearing_y) -> ErrorOr<GlyphBitmap>;
+
+    /**
+     * @brief Getters
+     */
+    auto glyphs_count() const -> usize;
+    auto pages_count() const -> usize;
+
+private:
+    explicit GlyphAtlas() = default;
+
+    auto try_reserve_cell(u16 width, u16 height) -> ErrorOr<u8::NativeInt*>;
+
+private:
+    Map<u64, GlyphBitmap>   m_glyphs       = Map<u64, GlyphBitmap>::empty();
+    Vector<u8::NativeInt*>  m_pages        = Vector<u8::NativeInt*>::empty();
+    usize::NativeInt        m_shelf_y      = 0;
+    usize::NativeInt        m_shelf_height = 0;
+    usize::NativeInt        m_shelf_x      = 0;
+};
+
+} /* namespace Glyph */
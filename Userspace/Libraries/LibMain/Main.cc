@@ -18,7 +18,7 @@
 #include <CCLang/Lang/Must.hh>
 
 auto runtime_error(Error error) -> int {
-    must$(FmtIO::errln("{}Runtime Error{} in {}"sv, FmtIO::foreground(FmtIO::Color::Red), FmtIO::reset(), error));
+    must$(FmtIO::errln("{}Runtime Error{} in {}", FmtIO::foreground(FmtIO::Color::Red), FmtIO::reset(), error));
     return EXIT_FAILURE;
 }
 
@@ -12,24 +12,458 @@
 
 #include <LibRT/Heap.hh>
 
-auto Heap::rt_alloc(usize, CleanMem) -> ErrorOr<void*> {
-    return Error::from_literal("Not Yet Implemented"sv);
+#include <LibApi/Api.h>
+
+#include <CCLang/Core/Assertions.hh>
+#include <CCLang/Core/ScopeGuard.hh>
+#include <CCLang/Lang/Cxx.hh>
+#include <CCLang/Lang/MemOrder.hh>
+#include <CCLang/Lang/Try.hh>
+
+namespace {
+
+constexpr usize::NativeInt C_PAGE_SIZE          = 4096;
+constexpr usize::NativeInt C_SPAN_SIZE          = 64 * 1024;
+constexpr usize::NativeInt C_MAX_SMALL_SIZE     = 8192;
+constexpr usize::NativeInt C_SIZE_CLASSES_COUNT = 64;
+constexpr usize::NativeInt C_MIN_ALIGNMENT      = 8;
+
+/**
+ * @brief Size classes: 8 bytes steps up to 128, then 8 classes for each power of two up to C_MAX_SMALL_SIZE, so the
+ * internal fragmentation stays under 12.5%
+ */
+constexpr auto size_class_of(usize::NativeInt size) -> usize::NativeInt {
+    if ( size <= 128 )
+        return (size + (size == 0) - 1) / 8;
+
+    auto const log2 = sizeof(usize::NativeInt) * 8 - 1 - __builtin_clzl(size - 1);
+    return 16 + (log2 - 7) * 8 + ((size - 1) >> (log2 - 3)) - 8;
+}
+
+constexpr auto size_class_size(usize::NativeInt size_class) -> usize::NativeInt {
+    if ( size_class < 16 )
+        return (size_class + 1) * 8;
+
+    auto const log2 = (size_class - 16) / 8 + 7;
+    return (9 + (size_class - 16) % 8) << (log2 - 3);
+}
+
+static_assert(size_class_of(C_MAX_SMALL_SIZE) == C_SIZE_CLASSES_COUNT - 1);
+static_assert(size_class_size(size_class_of(129)) == 144);
+static_assert(size_class_size(C_SIZE_CLASSES_COUNT - 1) == C_MAX_SMALL_SIZE);
+
+/**
+ * @brief Count of objects moved at once between a thread cache and the central lists
+ */
+constexpr auto batch_size_of(usize::NativeInt size_class) -> usize::NativeInt {
+    auto const batch_size = 32 * 1024 / size_class_size(size_class);
+    if ( batch_size < 2 )
+        return 2;
+    else if ( batch_size > 32 )
+        return 32;
+    else
+        return batch_size;
+}
+
+/**
+ * @brief Lock for the shared structures, which yields the CPU to the owner when busy
+ */
+class HeapLock final {
+public:
+    auto lock() -> void {
+        usize expected = 0;
+        while ( !m_is_locked.atomic_compare_exchange(expected, 1, MemOrder::Acquire) ) {
+            expected = 0;
+            s_yield();
+        }
+    }
+    auto unlock() -> void {
+        m_is_locked.atomic_store(0, MemOrder::Release);
+    }
+
+private:
+    usize m_is_locked{};
+};
+
+struct FreeObject {
+    FreeObject* m_next_object;
+};
+
+/**
+ * @brief Run of C_SPAN_SIZE bytes obtained from the kernel and split into objects of a single size class.
+ * The objects are carved lazily, so the pages are touched only when needed
+ */
+struct Span {
+    Span*            m_prev_span;
+    Span*            m_next_span;
+    u8::NativeInt*   m_area_ptr;
+    FreeObject*      m_free_objects;
+    usize::NativeInt m_size_class;
+    usize::NativeInt m_used_count;
+    usize::NativeInt m_carved_count;
+
+    auto capacity() const -> usize::NativeInt {
+        return C_SPAN_SIZE / size_class_size(m_size_class);
+    }
+
+    auto is_full() const -> bool {
+        return m_used_count == capacity();
+    }
+
+    auto take_object() -> FreeObject* {
+        ++m_used_count;
+        if ( m_free_objects != nullptr )
+            return Cxx::exchange(m_free_objects, m_free_objects->m_next_object);
+
+        return reinterpret_cast<FreeObject*>(m_area_ptr + m_carved_count++ * size_class_size(m_size_class));
+    }
+
+    auto give_back_object(FreeObject* free_object) -> void {
+        free_object->m_next_object = Cxx::exchange(m_free_objects, free_object);
+        --m_used_count;
+    }
+};
+
+/**
+ * @brief Owner of the spans: maps each page to its span and recycles the span descriptors.
+ * The user space of MeetiX is 32 bits wide, so two levels of 1024 entries cover all the pages
+ */
+class PageHeap final {
+public:
+    auto try_alloc_span(usize::NativeInt size_class) -> ErrorOr<Span*> {
+        m_lock.lock();
+        ScopeGuard unlock_guard{ [this] { m_lock.unlock(); } };
+
+        auto const span = try$(try_alloc_span_descriptor());
+        auto const area_ptr = static_cast<u8::NativeInt*>(s_alloc_mem(C_SPAN_SIZE));
+        if ( area_ptr == nullptr ) {
+            release_span_descriptor(span);
+            return Error::from_code(ErrorCode::NoMemory);
+        }
+
+        auto const first_page = page_of(area_ptr);
+        for ( auto page = first_page; page < first_page + C_SPAN_SIZE / C_PAGE_SIZE; ++page ) {
+            if ( m_span_leaves[page / C_LEAF_ENTRIES] == nullptr ) {
+                auto const leaf_ptr = s_alloc_mem(sizeof(SpanLeaf));
+                if ( leaf_ptr == nullptr ) {
+                    s_unmap_mem(area_ptr);
+                    release_span_descriptor(span);
+                    return Error::from_code(ErrorCode::NoMemory);
+                }
+
+                Cxx::memset(leaf_ptr, 0, sizeof(SpanLeaf));
+                m_span_leaves[page / C_LEAF_ENTRIES] = static_cast<SpanLeaf*>(leaf_ptr);
+            }
+            m_span_leaves[page / C_LEAF_ENTRIES]->m_spans[page % C_LEAF_ENTRIES] = span;
+        }
+
+        *span = Span{ nullptr, nullptr, area_ptr, nullptr, size_class, 0, 0 };
+        return span;
+    }
+
+    auto release_span(Span* span) -> void {
+        m_lock.lock();
+        ScopeGuard unlock_guard{ [this] { m_lock.unlock(); } };
+
+        /* the leaves are never released, they are few and the next spans will reuse them */
+        auto const first_page = page_of(span->m_area_ptr);
+        for ( auto page = first_page; page < first_page + C_SPAN_SIZE / C_PAGE_SIZE; ++page )
+            m_span_leaves[page / C_LEAF_ENTRIES]->m_spans[page % C_LEAF_ENTRIES] = nullptr;
+
+        s_unmap_mem(span->m_area_ptr);
+        release_span_descriptor(span);
+    }
+
+    /**
+     * @brief Returns the span of the given object. The leaves of a live span are stable, so no lock is needed
+     */
+    auto span_of(void* object_ptr) const -> Span* {
+        auto const page      = page_of(object_ptr);
+        auto const span_leaf = m_span_leaves[page / C_LEAF_ENTRIES];
+        verify_not_null_with_msg$(span_leaf, "Heap - Tried to release an object which doesn't belong to the heap");
+
+        auto const span = span_leaf->m_spans[page % C_LEAF_ENTRIES];
+        verify_not_null_with_msg$(span, "Heap - Tried to release an object which doesn't belong to the heap");
+        return span;
+    }
+
+private:
+    static constexpr usize::NativeInt C_LEAF_ENTRIES = 1024;
+
+    struct SpanLeaf {
+        Span* m_spans[C_LEAF_ENTRIES];
+    };
+
+    static auto page_of(void* ptr) -> usize::NativeInt {
+        auto const page = reinterpret_cast<usize::NativeInt>(ptr) / C_PAGE_SIZE;
+        verify_less_with_msg$(page, C_LEAF_ENTRIES * C_LEAF_ENTRIES, "Heap - Span outside of the 32 bits address space");
+        return page;
+    }
+
+    auto try_alloc_span_descriptor() -> ErrorOr<Span*> {
+        if ( m_free_descriptors == nullptr ) {
+            auto const page_ptr = static_cast<Span*>(s_alloc_mem(C_PAGE_SIZE));
+            if ( page_ptr == nullptr )
+                return Error::from_code(ErrorCode::NoMemory);
+
+            for ( auto i = C_PAGE_SIZE / sizeof(Span); i > 0; --i )
+                release_span_descriptor(page_ptr + i - 1);
+        }
+
+        /* the free descriptors are linked through their first field */
+        return reinterpret_cast<Span*>(Cxx::exchange(m_free_descriptors, m_free_descriptors->m_next_object));
+    }
+
+    auto release_span_descriptor(Span* span) -> void {
+        m_free_descriptors = new (span) FreeObject{ m_free_descriptors };
+    }
+
+private:
+    HeapLock    m_lock;
+    FreeObject* m_free_descriptors = nullptr;
+    SpanLeaf*   m_span_leaves[C_LEAF_ENTRIES]{};
+};
+
+/**
+ * @brief List of the spans of a size class which still have objects to give, shared by all the threads.
+ * An empty span is kept aside to not bounce between the kernel and the heap at the edges
+ */
+class CentralList final {
+public:
+    auto try_fetch_objects(usize::NativeInt size_class, usize::NativeInt count, FreeObject*& objects_list) -> ErrorOr<void> {
+        m_lock.lock();
+        ScopeGuard unlock_guard{ [this] { m_lock.unlock(); } };
+
+        for ( auto i = 0u; i < count; ++i ) {
+            if ( m_partial_spans == nullptr ) {
+                if ( m_empty_span != nullptr )
+                    push_partial_span(Cxx::exchange(m_empty_span, nullptr));
+                else if ( i > 0 )
+                    return {};
+                else
+                    push_partial_span(try$(s_page_heap.try_alloc_span(size_class)));
+            }
+
+            auto const object          = m_partial_spans->take_object();
+            object->m_next_object      = objects_list;
+            objects_list               = object;
+            if ( m_partial_spans->is_full() )
+                remove_partial_span(m_partial_spans);
+        }
+        return {};
+    }
+
+    auto release_objects(FreeObject* objects_list, usize::NativeInt count) -> void {
+        m_lock.lock();
+        ScopeGuard unlock_guard{ [this] { m_lock.unlock(); } };
+
+        for ( auto i = 0u; i < count; ++i ) {
+            auto const object = Cxx::exchange(objects_list, objects_list->m_next_object);
+            auto const span   = s_page_heap.span_of(object);
+            if ( span->is_full() )
+                push_partial_span(span);
+
+            span->give_back_object(object);
+            if ( span->m_used_count == 0 ) {
+                remove_partial_span(span);
+                if ( m_empty_span == nullptr )
+                    m_empty_span = span;
+                else
+                    s_page_heap.release_span(span);
+            }
+        }
+    }
+
+    static PageHeap s_page_heap;
+
+private:
+    auto push_partial_span(Span* span) -> void {
+        span->m_prev_span = nullptr;
+        span->m_next_span = m_partial_spans;
+        if ( m_partial_spans != nullptr )
+            m_partial_spans->m_prev_span = span;
+        m_partial_spans = span;
+    }
+
+    auto remove_partial_span(Span* span) -> void {
+        if ( span->m_prev_span != nullptr )
+            span->m_prev_span->m_next_span = span->m_next_span;
+        else
+            m_partial_spans = span->m_next_span;
+
+        if ( span->m_next_span != nullptr )
+            span->m_next_span->m_prev_span = span->m_prev_span;
+    }
+
+private:
+    HeapLock m_lock;
+    Span*    m_partial_spans = nullptr;
+    Span*    m_empty_span    = nullptr;
+};
+
+/* constant initialized, the heap is used by the static constructors too */
+constinit PageHeap CentralList::s_page_heap;
+
+constinit CentralList s_central_lists[C_SIZE_CLASSES_COUNT];
+
+/**
+ * @brief Objects owned by a single thread, served without any synchronization.
+ * The caches of the terminated threads are not given back
+ */
+struct ThreadCache {
+    FreeObject*      m_objects_lists[C_SIZE_CLASSES_COUNT];
+    usize::NativeInt m_objects_counts[C_SIZE_CLASSES_COUNT];
+
+    auto try_alloc(usize::NativeInt size_class) -> ErrorOr<void*> {
+        if ( m_objects_lists[size_class] == nullptr ) {
+            auto const batch_size = batch_size_of(size_class);
+            try$(s_central_lists[size_class].try_fetch_objects(size_class, batch_size, m_objects_lists[size_class]));
+
+            /* the central list could give less objects than requested */
+            m_objects_counts[size_class] = 0;
+            for ( auto object = m_objects_lists[size_class]; object != nullptr; object = object->m_next_object )
+                ++m_objects_counts[size_class];
+        }
+
+        --m_objects_counts[size_class];
+        return Cxx::exchange(m_objects_lists[size_class], m_objects_lists[size_class]->m_next_object);
+    }
+
+    auto dealloc(void* ptr, usize::NativeInt size_class) -> void {
+        m_objects_lists[size_class] = new (ptr) FreeObject{ m_objects_lists[size_class] };
+
+        /* keep at most two batches, the oldest objects go back to their spans */
+        auto const batch_size = batch_size_of(size_class);
+        if ( ++m_objects_counts[size_class] > 2 * batch_size ) {
+            auto batch_end = m_objects_lists[size_class];
+            for ( auto i = 1u; i < batch_size; ++i )
+                batch_end = batch_end->m_next_object;
+
+            s_central_lists[size_class].release_objects(Cxx::exchange(batch_end->m_next_object, nullptr), m_objects_counts[size_class] - batch_size);
+            m_objects_counts[size_class] = batch_size;
+        }
+    }
+};
+
+constinit thread_local ThreadCache s_thread_cache;
+
+/**
+ * @brief The size classes able to serve the given alignment, which is a power of two
+ */
+auto aligned_size_class_of(usize::NativeInt size, usize::NativeInt alignment) -> usize::NativeInt {
+    auto size_class = size_class_of(size < alignment ? alignment : size);
+    while ( size_class < C_SIZE_CLASSES_COUNT && size_class_size(size_class) % alignment != 0 )
+        ++size_class;
+
+    return size_class;
 }
 
-auto Heap::rt_realloc(void*, usize) -> ErrorOr<void*> {
-    return Error::from_literal("Not Yet Implemented"sv);
+auto page_align_up(usize::NativeInt size) -> usize::NativeInt {
+    return (size + C_PAGE_SIZE - 1) & ~(C_PAGE_SIZE - 1);
 }
 
-auto Heap::rt_dealloc(void*, usize) -> ErrorOr<void> {
-    return Error::from_literal("Not Yet Implemented"sv);
+auto try_alloc_large(usize::NativeInt size) -> ErrorOr<void*> {
+    auto const area_ptr = s_alloc_mem(page_align_up(size));
+    if ( area_ptr == nullptr )
+        return Error::from_code(ErrorCode::NoMemory);
+
+    return area_ptr;
 }
 
-auto Heap::rt_alloc_aligned(usize, usize, CleanMem) -> ErrorOr<void*> {
-    return Error::from_literal("Not Yet Implemented"sv);
+auto try_alloc_sized(usize::NativeInt size, usize::NativeInt size_class, Heap::CleanMem clean_mem) -> ErrorOr<void*> {
+    void* ptr;
+    if ( size_class < C_SIZE_CLASSES_COUNT )
+        ptr = try$(s_thread_cache.try_alloc(size_class));
+    else
+        ptr = try$(try_alloc_large(size));
+
+    /* neither the recycled objects nor the pages given by the kernel are granted to be clean */
+    if ( clean_mem == Heap::CleanMem::Yes )
+        Cxx::memset(ptr, 0, size);
+    return ptr;
 }
 
-auto Heap::rt_dealloc_aligned(void*, usize, usize) -> ErrorOr<void> {
-    return Error::from_literal("Not Yet Implemented"sv);
+auto dealloc_sized(void* ptr, usize::NativeInt size_class) -> void {
+    if ( size_class < C_SIZE_CLASSES_COUNT )
+        s_thread_cache.dealloc(ptr, size_class);
+    else
+        s_unmap_mem(ptr);
+}
+
+auto size_class_for(usize::NativeInt size) -> usize::NativeInt {
+    if ( size > C_MAX_SMALL_SIZE )
+        return C_SIZE_CLASSES_COUNT;
+    else
+        return size_class_of(size);
+}
+
+} /* namespace */
+
+auto Heap::rt_alloc(usize size, CleanMem clean_mem) -> ErrorOr<void*> {
+    return try_alloc_sized(size.unwrap(), size_class_for(size.unwrap()), clean_mem);
+}
+
+auto Heap::rt_realloc(void* ptr, usize size, usize new_size) -> ErrorOr<void*> {
+    if ( ptr == nullptr )
+        return rt_alloc(new_size, CleanMem::No);
+
+    /* the same size class, or the same count of pages, already fits the new size */
+    auto const size_class     = size_class_for(size.unwrap());
+    auto const new_size_class = size_class_for(new_size.unwrap());
+    if ( size_class == new_size_class ) {
+        if ( size_class < C_SIZE_CLASSES_COUNT || page_align_up(size.unwrap()) == page_align_up(new_size.unwrap()) )
+            return ptr;
+    }
+
+    auto const new_ptr = try$(try_alloc_sized(new_size.unwrap(), new_size_class, CleanMem::No));
+    Cxx::memcpy(new_ptr, ptr, usize::min(size, new_size));
+    dealloc_sized(ptr, size_class);
+    return new_ptr;
+}
+
+auto Heap::rt_dealloc(void* ptr, usize size) -> ErrorOr<void> {
+    if ( ptr == nullptr )
+        return {};
+
+    dealloc_sized(ptr, size_class_for(size.unwrap()));
+    return {};
+}
+
+auto Heap::rt_alloc_aligned(usize size, usize alignment, CleanMem clean_mem) -> ErrorOr<void*> {
+    if ( alignment == 0 || (alignment & (alignment - 1)) != 0 )
+        return Error::from_code(ErrorCode::BadParameter);
+    if ( alignment <= C_MIN_ALIGNMENT )
+        return rt_alloc(size, clean_mem);
+
+    if ( size <= C_MAX_SMALL_SIZE && alignment <= C_PAGE_SIZE )
+        return try_alloc_sized(size.unwrap(), aligned_size_class_of(size.unwrap(), alignment.unwrap()), clean_mem);
+    if ( alignment <= C_PAGE_SIZE )
+        return try_alloc_sized(size.unwrap(), C_SIZE_CLASSES_COUNT, clean_mem);
+
+    /* the pages are aligned only to C_PAGE_SIZE, the start of the area is kept right before the aligned pointer */
+    auto const area_ptr    = static_cast<u8::NativeInt*>(try$(try_alloc_large(size.unwrap() + alignment.unwrap())));
+    auto const aligned_ptr = reinterpret_cast<u8::NativeInt*>(
+        (reinterpret_cast<usize::NativeInt>(area_ptr) + alignment.unwrap()) & ~(alignment.unwrap() - 1));
+    reinterpret_cast<void**>(aligned_ptr)[-1] = area_ptr;
+
+    if ( clean_mem == CleanMem::Yes )
+        Cxx::memset(aligned_ptr, 0, size);
+    return aligned_ptr;
+}
+
+auto Heap::rt_dealloc_aligned(void* ptr, usize size, usize alignment) -> ErrorOr<void> {
+    if ( ptr == nullptr )
+        return {};
+    if ( alignment <= C_MIN_ALIGNMENT )
+        return rt_dealloc(ptr, size);
+
+    if ( size <= C_MAX_SMALL_SIZE && alignment <= C_PAGE_SIZE )
+        dealloc_sized(ptr, aligned_size_class_of(size.unwrap(), alignment.unwrap()));
+    else if ( alignment <= C_PAGE_SIZE )
+        dealloc_sized(ptr, C_SIZE_CLASSES_COUNT);
+    else
+        s_unmap_mem(static_cast<void**>(ptr)[-1]);
+    return {};
 }
 
 /* CCLang.Alloc.New plugin support */
@@ -38,6 +472,10 @@ auto __rt_heap_plugin_alloc(usize size, bool clean) -> ErrorOr<void*> {
     return Heap::rt_alloc(size, clean ? Heap::CleanMem::Yes : Heap::CleanMem::No);
 }
 
+auto __rt_heap_plugin_realloc(void* ptr, usize size, usize new_size) -> ErrorOr<void*> {
+    return Heap::rt_realloc(ptr, size, new_size);
+}
+
 auto __rt_heap_plugin_dealloc(void* ptr, usize size) -> ErrorOr<void> {
     return Heap::rt_dealloc(ptr, size);
 }
@@ -15,6 +15,12 @@
 #include <CCLang/Core/ErrorOr.hh>
 #include <CCLang/Lang/IntTypes.hh>
 
+/**
+ * @brief Size-class heap of the MeetiX runtime.
+ * The small sizes are served by per-thread caches of objects, refilled in batches from per-class lists of 64KiB
+ * spans obtained from the kernel, which gets back the spans left empty. The bigger sizes are mapped directly.
+ * The deallocation functions want the same size (and alignment) given at allocation time
+ */
 namespace Heap {
 
 enum class CleanMem : bool {
@@ -23,7 +29,7 @@ enum class CleanMem : bool {
 };
 
 auto rt_alloc(usize size, CleanMem clean_mem) -> ErrorOr<void*>;
-auto rt_realloc(void* ptr, usize new_size) -> ErrorOr<void*>;
+auto rt_realloc(void* ptr, usize size, usize new_size) -> ErrorOr<void*>;
 auto rt_dealloc(void* ptr, usize size) -> ErrorOr<void>;
 
 auto rt_alloc_aligned(usize size, usize alignment, CleanMem clean_mem) -> ErrorOr<void*>;
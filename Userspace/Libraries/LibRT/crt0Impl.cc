@@ -48,7 +48,7 @@ extern "C++" auto cc_main(Vector<StringView>) -> ErrorOr<void>;
 
 static Function<void(Error const&)> s_runtime_error_catcher = [](Error const& error) {
     auto string_builder = StringBuilder::empty();
-    must$(format(string_builder, "\e[31mRuntime Error\e[0m in {}"sv, error));
+    must$(format(string_builder, "\e[31mRuntime Error\e[0m in {}", error));
 
     s_log(string_builder.as_string_view().as_cstr());
 };
@@ -45,7 +45,7 @@
 #define verify_equal$(lhs, rhs)                                                                                                                                \
     do {                                                                                                                                                       \
         if ( !(lhs == rhs) ) [[unlikely]] {                                                                                                                    \
-            FmtIO::errln("\t{}VerifyEqual Failed{} in {}\n\t> {{ {}{} == {}{} }}"sv,                                                                           \
+            FmtIO::errln("\t{}VerifyEqual Failed{} in {}\n\t> {{ {}{} == {}{} }}",                                                                             \
                          FmtIO::foreground(FmtIO::Color::Red),                                                                                                 \
                          FmtIO::reset(),                                                                                                                       \
                          SourceLocation::from_here(),                                                                                                          \
@@ -61,7 +61,7 @@
 #define verify_not_equal$(lhs, rhs)                                                                                                                            \
     do {                                                                                                                                                       \
         if ( !(lhs != rhs) ) [[unlikely]] {                                                                                                                    \
-            FmtIO::errln("\t{}VerifyNotEqual Failed{} in {}\n\t> {{ {}{} != {}{} }}"sv,                                                                        \
+            FmtIO::errln("\t{}VerifyNotEqual Failed{} in {}\n\t> {{ {}{} != {}{} }}",                                                                          \
                          FmtIO::foreground(FmtIO::Color::Red),                                                                                                 \
                          FmtIO::reset(),                                                                                                                       \
                          SourceLocation::from_here(),                                                                                                          \
@@ -77,7 +77,7 @@
 #define verify_greater$(lhs, rhs)                                                                                                                              \
     do {                                                                                                                                                       \
         if ( !(lhs > rhs) ) [[unlikely]] {                                                                                                                     \
-            FmtIO::errln("\t{}VerifyGreater Failed{} in {}\n\t> {{ {}{} > {}{} }}"sv,                                                                          \
+            FmtIO::errln("\t{}VerifyGreater Failed{} in {}\n\t> {{ {}{} > {}{} }}",                                                                            \
                          FmtIO::foreground(FmtIO::Color::Red),                                                                                                 \
                          FmtIO::reset(),                                                                                                                       \
                          SourceLocation::from_here(),                                                                                                          \
@@ -93,7 +93,7 @@
 #define verify_greater_equal$(lhs, rhs)                                                                                                                        \
     do {                                                                                                                                                       \
         if ( !(lhs >= rhs) ) [[unlikely]] {                                                                                                                    \
-            FmtIO::errln("\t{}VerifyGreaterEqual Failed{} in {}\n\t> {{ {}{} >= {}{} }}"sv,                                                                    \
+            FmtIO::errln("\t{}VerifyGreaterEqual Failed{} in {}\n\t> {{ {}{} >= {}{} }}",                                                                      \
                          FmtIO::foreground(FmtIO::Color::Red),                                                                                                 \
                          FmtIO::reset(),                                                                                                                       \
                          SourceLocation::from_here(),                                                                                                          \
@@ -109,7 +109,7 @@
 #define verify_less$(lhs, rhs)                                                                                                                                 \
     do {                                                                                                                                                       \
         if ( !(lhs < rhs) ) [[unlikely]] {                                                                                                                     \
-            FmtIO::errln("\t{}VerifyLess Failed{} in {}\n\t> {{ {}{} < {}{} }}"sv,                                                                             \
+            FmtIO::errln("\t{}VerifyLess Failed{} in {}\n\t> {{ {}{} < {}{} }}",                                                                               \
                          FmtIO::foreground(FmtIO::Color::Red),                                                                                                 \
                          FmtIO::reset(),                                                                                                                       \
                          SourceLocation::from_here(),                                                                                                          \
@@ -125,7 +125,7 @@
 #define verify_less_equal$(lhs, rhs)                                                                                                                           \
     do {                                                                                                                                                       \
         if ( !(lhs <= rhs) ) [[unlikely]] {                                                                                                                    \
-            FmtIO::errln("\t{}VerifyLessEqual Failed{} in {}\n\t> {{ {}{} <= {}{} }}"sv,                                                                       \
+            FmtIO::errln("\t{}VerifyLessEqual Failed{} in {}\n\t> {{ {}{} <= {}{} }}",                                                                         \
                          FmtIO::foreground(FmtIO::Color::Red),                                                                                                 \
                          FmtIO::reset(),                                                                                                                       \
                          SourceLocation::from_here(),                                                                                                          \
@@ -147,7 +147,7 @@
     do {                                                                                                                                                       \
         auto value_or_none = expr;                                                                                                                             \
         if ( !value_or_none.is_present() ) [[unlikely]] {                                                                                                      \
-            FmtIO::errln("\t{}VerifyIsPresent Failed{} in {}\n\t> {{ {}{}.is_present(){} }}"sv,                                                                \
+            FmtIO::errln("\t{}VerifyIsPresent Failed{} in {}\n\t> {{ {}{}.is_present(){} }}",                                                                  \
                          FmtIO::foreground(FmtIO::Color::Red),                                                                                                 \
                          FmtIO::reset(),                                                                                                                       \
                          SourceLocation::from_here(),                                                                                                          \
@@ -163,7 +163,7 @@
     do {                                                                                                                                                       \
         auto value_or_none = expr;                                                                                                                             \
         if ( !value_or_none.is_present() || !(value_or_none.unwrap() == value) ) [[unlikely]] {                                                                \
-            FmtIO::errln("\t{}VerifyIsPresentEqual Failed{} in {}\n\t> {{ {}{} == Some({}){} }}"sv,                                                            \
+            FmtIO::errln("\t{}VerifyIsPresentEqual Failed{} in {}\n\t> {{ {}{} == Some({}){} }}",                                                              \
                          FmtIO::foreground(FmtIO::Color::Red),                                                                                                 \
                          FmtIO::reset(),                                                                                                                       \
                          SourceLocation::from_here(),                                                                                                          \
@@ -180,9 +180,9 @@
     do {                                                                                                                                                       \
         auto value_or_none = expr;                                                                                                                             \
         if ( value_or_none.is_present() ) [[unlikely]] {                                                                                                       \
-            FmtIO::errln(FmtIO::foreground(FmtIO::Color::Red),                                                                                                 \
+            FmtIO::errln("\t{}VerifyIsNone Failed{} in {}\n\t> {{ {}!{}.is_present(){} }}",                                                                    \
+                         FmtIO::foreground(FmtIO::Color::Red),                                                                                                 \
                          FmtIO::reset(),                                                                                                                       \
-                         "\t{}VerifyIsNone Failed{} in {}\n\t> {{ {}!{}.is_present(){} }}"sv,                                                                  \
                          SourceLocation::from_here(),                                                                                                          \
                          FmtIO::foreground(FmtIO::Color::Red),                                                                                                 \
                          as_string_view$(expr),                                                                                                                \
@@ -196,9 +196,9 @@
     do {                                                                                                                                                       \
         auto error_or_value = expr;                                                                                                                            \
         if ( !error_or_value.is_value() ) [[unlikely]] {                                                                                                       \
-            FmtIO::errln(FmtIO::foreground(FmtIO::Color::Red),                                                                                                 \
+            FmtIO::errln("\t{}VerifyIsValue Failed{} in {}\n\t> {{ {}{}.is_value(){} }}",                                                                      \
+                         FmtIO::foreground(FmtIO::Color::Red),                                                                                                 \
                          FmtIO::reset(),                                                                                                                       \
-                         "\t{}VerifyIsValue Failed{} in {}\n\t> {{ {}{}.is_value(){} }}"sv,                                                                    \
                          SourceLocation::from_here(),                                                                                                          \
                          FmtIO::foreground(FmtIO::Color::Red),                                                                                                 \
                          as_string_view$(expr),                                                                                                                \
@@ -212,7 +212,7 @@
     do {                                                                                                                                                       \
         auto error_or_value = expr;                                                                                                                            \
         if ( !error_or_value.is_value() || !(error_or_value.unwrap() == value) ) [[unlikely]] {                                                                \
-            FmtIO::errln("\t{}VerifyIsValueEqual Failed{} in {}\n\t> {{ {}{} == Value({}){} }}"sv,                                                             \
+            FmtIO::errln("\t{}VerifyIsValueEqual Failed{} in {}\n\t> {{ {}{} == Value({}){} }}",                                                               \
                          FmtIO::foreground(FmtIO::Color::Red),                                                                                                 \
                          FmtIO::reset(),                                                                                                                       \
                          SourceLocation::from_here(),                                                                                                          \
@@ -229,7 +229,7 @@
     do {                                                                                                                                                       \
         auto error_or_value = expr;                                                                                                                            \
         if ( !error_or_value.is_error() || !(error_or_value.unwrap_error() == error) ) [[unlikely]] {                                                          \
-            FmtIO::errln("\t{}Verify Failed{} in {}\n\t> {{ {}{} == Error({}){} }}"sv,                                                                         \
+            FmtIO::errln("\t{}Verify Failed{} in {}\n\t> {{ {}{} == Error({}){} }}",                                                                           \
                          FmtIO::foreground(FmtIO::Color::Red),                                                                                                 \
                          FmtIO::reset(),                                                                                                                       \
                          SourceLocation::from_here(),                                                                                                          \
@@ -0,0 +1,248 @@
+/* * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * *  * * * * * * * *
+ * MeetiX OS By MeetiX OS Project [Marco Cicognani]                                    *
+ *                                                                                     *
+ * This program is free software; you can redistribute it and/or                       *
+ * modify it under the terms of the GNU General Public License                         *
+ * as published by the Free Software Foundation; either version 2                      *
+ * of the License, or (char *argumentat your option) any later version.                *
+ *                                                                                     *
+ * This program is distributed in the hope that it will be useful,                     *
+ * but WITHout ANY WARRANTY; without even the implied warranty of                      *
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the                       *
+ * GNU General Public License for more details.                                        *
+ *                                                                                     *
+ * You should have received a copy of the GNU General Public License                   *
+ * along with this program; if not, write to the Free Software                         *
+ * Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301  USA      *
+ * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * *  * * * * * * */
+
+#ifndef __INPUT_EVENT_RING__
+#define __INPUT_EVENT_RING__
+
+#include <Api.h>
+#include <CCLang/Lang/MemOrder.hh>
+#include <CCLang/Lang/SpscQueue.hh>
+#include <stdint.h>
+
+namespace Input {
+
+/**
+ * Number of events that each ring keeps, the IRQ thread never waits for the
+ * consumer until this many events are not handled
+ */
+#define EVENT_RING_CAPACITY 256
+
+/**
+ * The lower bits of the mouse flags byte tell which buttons are pressed
+ */
+#define MOUSE_BUTTONS_MASK 0x07
+
+/**
+ * Kind of the published events
+ */
+enum EventType : uint8_t
+{
+    EVENT_TYPE_KEYBOARD,
+    EVENT_TYPE_MOUSE
+};
+
+/**
+ * Single keyboard or mouse event, stamped by the driver when received
+ */
+struct Event {
+    uint64_t  m_timestamp;
+    EventType m_type;
+    uint8_t   m_scancode;
+    int8_t    m_flags;
+    int16_t   m_move_x;
+    int16_t   m_move_y;
+};
+
+/**
+ * States of the mouse motion parked by the driver while the ring is full
+ */
+enum PendingMotionState : uint8_t
+{
+    PENDING_MOTION_NONE,
+    PENDING_MOTION_READY,
+    PENDING_MOTION_TAKING
+};
+
+/**
+ * Lock-free ring of events between the driver (the producer) and a single
+ * consumer thread. It lives into the memory shared with the consumer, and a
+ * zero-filled memory is already an empty ring.
+ *
+ * The driver never waits for the consumer to handle each event: it only wakes
+ * the consumer, once, when it is sleeping on an empty ring. When the ring is
+ * full the mouse motion is accumulated into a parked event, which the consumer
+ * takes once it has emptied the ring. The scancodes and the button changes
+ * instead wait for a free slot to not lose any key or click.
+ */
+class EventRing {
+public:
+    /**
+     * Publishes the given event, must be called only by the driver
+     *
+     * @param event:	the event to publish
+     */
+    void push(Event event) {
+        Event pending;
+        if ( claimPendingMotion(pending) ) {
+            if ( canCoalesce(pending, event) ) {
+                accumulateMotion(pending, event);
+                event = pending;
+            } else {
+                // a button change or a scancode keeps the order of the events
+                waitToPush(pending);
+            }
+        }
+
+        if ( !m_queue.push(event) ) {
+            if ( isMotion(event) ) {
+                m_pending_motion = event;
+                __atomic_store_n(&m_pending_state, PENDING_MOTION_READY, __ATOMIC_RELEASE);
+                wakeConsumer();
+                return;
+            }
+            waitToPush(event);
+        }
+
+        if ( event.m_type == EVENT_TYPE_MOUSE )
+            m_last_buttons = event.m_flags & MOUSE_BUTTONS_MASK;
+        wakeConsumer();
+    }
+
+    /**
+     * Takes the oldest event, merging into it the following mouse motions with
+     * the same buttons pressed. Must be called only by the consumer
+     *
+     * @param out:	filled with the taken event
+     * @return whether an event was available
+     */
+    bool pop(Event& out) {
+        auto event = m_queue.pop();
+        if ( !event.is_present() )
+            return takePendingMotion(out);
+
+        out = event.unwrap();
+        if ( out.m_type == EVENT_TYPE_MOUSE ) {
+            for ( auto next = m_queue.peek(); next.is_present(); next = m_queue.peek() ) {
+                auto nextEvent = next.unwrap();
+                if ( !canCoalesce(out, nextEvent) )
+                    break;
+
+                accumulateMotion(out, nextEvent);
+                m_queue.pop();
+            }
+        }
+        return true;
+    }
+
+    /**
+     * Blocks the consumer until the ring contains at least one event
+     */
+    void waitForEvents() {
+        while ( !hasEvents() ) {
+            __atomic_store_n(&m_atom_nothing_queued, true, __ATOMIC_RELAXED);
+            atomic_fence(MemOrder::Total);
+
+            // the driver could have published before seeing the flag
+            if ( hasEvents() ) {
+                __atomic_store_n(&m_atom_nothing_queued, false, __ATOMIC_RELAXED);
+                return;
+            }
+            s_atomic_block(&m_atom_nothing_queued);
+        }
+    }
+
+private:
+    void waitToPush(const Event& event) {
+        while ( !m_queue.push(event) )
+            s_yield();
+    }
+
+    bool hasEvents() const {
+        return !m_queue.is_empty() || __atomic_load_n(&m_pending_state, __ATOMIC_ACQUIRE) == PENDING_MOTION_READY;
+    }
+
+    /**
+     * Takes back the parked motion before the consumer does, only the driver
+     * calls it
+     */
+    bool claimPendingMotion(Event& out) {
+        while ( true ) {
+            uint8_t expected = PENDING_MOTION_READY;
+            if ( __atomic_compare_exchange_n(&m_pending_state, &expected, PENDING_MOTION_NONE, false, __ATOMIC_ACQUIRE,
+                                             __ATOMIC_ACQUIRE) ) {
+                out = m_pending_motion;
+                return true;
+            }
+            if ( expected == PENDING_MOTION_NONE )
+                return false;
+
+            // the consumer is copying it
+            s_yield();
+        }
+    }
+
+    /**
+     * Takes the parked motion, it is newer than any queued event so only the
+     * consumer calls it and only when the ring is empty
+     */
+    bool takePendingMotion(Event& out) {
+        uint8_t expected = PENDING_MOTION_READY;
+        if ( !__atomic_compare_exchange_n(&m_pending_state, &expected, PENDING_MOTION_TAKING, false, __ATOMIC_ACQUIRE,
+                                          __ATOMIC_RELAXED) )
+            return false;
+
+        out = m_pending_motion;
+        __atomic_store_n(&m_pending_state, PENDING_MOTION_NONE, __ATOMIC_RELEASE);
+        return true;
+    }
+
+    /**
+     * Clears the flag on which the consumer sleeps, only when it is set
+     */
+    void wakeConsumer() {
+        atomic_fence(MemOrder::Total);
+        if ( __atomic_load_n(&m_atom_nothing_queued, __ATOMIC_RELAXED) )
+            __atomic_store_n(&m_atom_nothing_queued, false, __ATOMIC_RELAXED);
+    }
+
+    /**
+     * Tells whether the event moves the mouse without changing the pressed
+     * buttons, only these events can wait into the driver
+     */
+    bool isMotion(const Event& event) const {
+        return event.m_type == EVENT_TYPE_MOUSE && (event.m_flags & MOUSE_BUTTONS_MASK) == m_last_buttons;
+    }
+
+    static bool canCoalesce(const Event& event, const Event& next) {
+        return next.m_type == EVENT_TYPE_MOUSE
+            && (event.m_flags & MOUSE_BUTTONS_MASK) == (next.m_flags & MOUSE_BUTTONS_MASK);
+    }
+
+    static void accumulateMotion(Event& event, const Event& next) {
+        event.m_timestamp = next.m_timestamp;
+        event.m_move_x += next.m_move_x;
+        event.m_move_y += next.m_move_y;
+    }
+
+private:
+    SpscQueue<Event, EVENT_RING_CAPACITY> m_queue;
+
+    /* the consumer sleeps on this while the ring is empty */
+    alignas(C_CACHE_LINE_SIZE) bool m_atom_nothing_queued;
+
+    /* the motion parked while the ring is full, the state tells who owns it */
+    alignas(C_CACHE_LINE_SIZE) uint8_t m_pending_state;
+    Event m_pending_motion;
+
+    /* written only by the driver */
+    uint8_t m_last_buttons;
+};
+
+} // namespace Input
+
+#endif
@@ -24,9 +24,12 @@
 
 #include "Input.hpp"
 
+#include "InputProtocol.hpp"
+
 #include <Api.h>
 #include <LibIO/Input.hh>
 #include <math.h>
+#include <new>
 #include <sstream>
 #include <stdio.h>
 #include <string.h>
@@ -52,8 +55,8 @@ uint32_t keyboardReceiverTransaction;
 /**
  *
  */
-uint64_t               packetsCount = 0;
-IO::Input::SharedArea* sharedArea;
+uint64_t                packetsCount = 0;
+Input::SharedEventArea* sharedArea;
 
 /**
  *
@@ -66,17 +69,15 @@ int main() {
     }
 
     // set up shared memory
-    sharedArea = (IO::Input::SharedArea*)s_alloc_mem(sizeof(IO::Input::SharedArea));
-    if ( !sharedArea ) {
+    auto areaMemory = s_alloc_mem(sizeof(Input::SharedEventArea));
+    if ( !areaMemory ) {
         Utils::log("failed to allocate transfer memory area");
         return 1;
     }
 
-    // initialize memory area
-    sharedArea->m_keyboard.m_atom_nothing_queued = true;
-    sharedArea->m_keyboard.m_atom_unhandled      = false;
-    sharedArea->m_mouse.m_atom_nothing_queued    = true;
-    sharedArea->m_mouse.m_atom_unhandled         = false;
+    // initialize memory area with empty event rings
+    sharedArea            = new (areaMemory) Input::SharedEventArea();
+    sharedArea->m_version = INPUT_SHARED_AREA_VERSION;
 
     // initialize mouse
     initializeMouse();
@@ -96,14 +97,13 @@ int main() {
             auto req = (IO::Input::RegisterRequest*)MESSAGE_CONTENT(buf);
 
             // share area with requester
-            Pid                    requesterPid = s_get_pid_for_tid(mes->m_sender_tid);
-            IO::Input::SharedArea* sharedInTarget
-                = (IO::Input::SharedArea*)s_share_mem((void*)sharedArea, sizeof(IO::Input::SharedArea), requesterPid);
+            Pid   requesterPid   = s_get_pid_for_tid(mes->m_sender_tid);
+            void* sharedInTarget = s_share_mem((void*)sharedArea, sizeof(Input::SharedEventArea), requesterPid);
 
             // send response
-            IO::Input::RegisterResponse response;
-            response.m_shared_area = sharedInTarget;
-            s_send_message_t(mes->m_sender_tid, &response, sizeof(IO::Input::RegisterResponse), mes->m_transaction);
+            Input::RegisterResponse response;
+            response.m_shared_area = (Input::SharedEventArea*)sharedInTarget;
+            s_send_message_t(mes->m_sender_tid, &response, sizeof(Input::RegisterResponse), mes->m_transaction);
         }
     }
 }
@@ -191,17 +191,14 @@ void handleMouseData(uint8_t b) {
                 int16_t offX = valX - ((flags << 4) & 0x100);
                 int16_t offY = valY - ((flags << 3) & 0x100);
 
-                // wait for handling and set
-                s_atomic_block(&sharedArea->m_mouse.m_atom_unhandled);
-
-                // write data
-                sharedArea->m_mouse.m_move_x = offX;
-                sharedArea->m_mouse.m_move_y = offY;
-                sharedArea->m_mouse.m_flags  = flags;
-
-                // show waiter that data is queue
-                sharedArea->m_mouse.m_atom_nothing_queued = false;
-                sharedArea->m_mouse.m_atom_unhandled      = true;
+                // publish without waiting for the previous events to be handled
+                Input::Event event{};
+                event.m_timestamp = s_millis();
+                event.m_type      = Input::EVENT_TYPE_MOUSE;
+                event.m_flags     = flags;
+                event.m_move_x    = offX;
+                event.m_move_y    = offY;
+                sharedArea->m_mouse.push(event);
             }
 
             mousePacketNumber = 0;
@@ -213,15 +210,12 @@ void handleMouseData(uint8_t b) {
  *
  */
 void handleKeyboardData(uint8_t b) {
-    // wait for handling and set
-    s_atomic_block(&sharedArea->m_keyboard.m_atom_unhandled);
-
-    // write data
-    sharedArea->m_keyboard.m_scancode = b;
-
-    // show waiter that data is queue
-    sharedArea->m_keyboard.m_atom_nothing_queued = false;
-    sharedArea->m_keyboard.m_atom_unhandled      = true;
+    // publish without waiting for the previous scancodes to be handled
+    Input::Event event{};
+    event.m_timestamp = s_millis();
+    event.m_type      = Input::EVENT_TYPE_KEYBOARD;
+    event.m_scancode  = b;
+    sharedArea->m_keyboard.push(event);
 }
 
 /**
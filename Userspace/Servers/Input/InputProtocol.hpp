@@ -0,0 +1,55 @@
+/* * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * *  * * * * * * * *
+ * MeetiX OS By MeetiX OS Project [Marco Cicognani]                                    *
+ *                                                                                     *
+ * This program is free software; you can redistribute it and/or                       *
+ * modify it under the terms of the GNU General Public License                         *
+ * as published by the Free Software Foundation; either version 2                      *
+ * of the License, or (char *argumentat your option) any later version.                *
+ *                                                                                     *
+ * This program is distributed in the hope that it will be useful,                     *
+ * but WITHout ANY WARRANTY; without even the implied warranty of                      *
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the                       *
+ * GNU General Public License for more details.                                        *
+ *                                                                                     *
+ * You should have received a copy of the GNU General Public License                   *
+ * along with this program; if not, write to the Free Software                         *
+ * Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301  USA      *
+ * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * *  * * * * * * */
+
+#ifndef __INPUT_PROTOCOL__
+#define __INPUT_PROTOCOL__
+
+#include "EventRing.hpp"
+
+#include <stdint.h>
+
+namespace Input {
+
+/**
+ * Layout version of the shared area, the consumers must check it before
+ * reading the rings
+ */
+#define INPUT_SHARED_AREA_VERSION 2
+
+/**
+ * Memory area shared by the driver with each registered consumer. The driver
+ * publishes the keyboard and the mouse events into their rings, each one read
+ * by a single consumer thread
+ */
+struct SharedEventArea {
+    uint32_t  m_version;
+    EventRing m_keyboard;
+    EventRing m_mouse;
+};
+
+/**
+ * Response to the registration of a consumer, the area is already mapped into
+ * the address space of the requester
+ */
+struct RegisterResponse {
+    SharedEventArea* m_shared_area;
+};
+
+} // namespace Input
+
+#endif
@@ -32,15 +32,9 @@
  *
  */
 LoaderStatus Elf32Loader::load(uintptr_t* outEntryAddr) {
-    // check header
-    Elf32Ehdr    hdr;
-    LoaderStatus headerStat = readAndValidateElfHeader(file, &hdr);
-    if ( headerStat != LS_SUCCESSFUL )
-        return headerStat;
-
-    // perform image loading
-    LoaderStatus status = loadImage(&hdr);
-    *outEntryAddr       = hdr.e_entry;
+    // the image was already validated by readImage()
+    LoaderStatus status = loadImage();
+    *outEntryAddr       = image.header.e_entry;
     return status;
 }
 
@@ -66,35 +60,31 @@ LoaderStatus Elf32Loader::readAndValidateElfHeader(FileHandle file, Elf32Ehdr* h
 }
 
 /**
- *
+ * Reads and validates the ELF header and reads all the program headers of the file
  */
-LoaderStatus Elf32Loader::checkForElfBinaryAndReset(FileHandle file) {
-    // read and validate ELF header
-    Elf32Ehdr    hdrBuf;
-    LoaderStatus stat = readAndValidateElfHeader(file, &hdrBuf);
-
-    // reset file
-    s_seek(file, 0, FS_SEEK_SET);
-
-    return stat;
+LoaderStatus Elf32Loader::readImage(FileHandle file, Elf32Image* image) {
+    LoaderStatus stat = readAndValidateElfHeader(file, &image->header);
+    if ( stat != LS_SUCCESSFUL )
+        return stat;
+
+    image->programHeaders.resize(image->header.e_phnum);
+    for ( uint32_t i = 0; i < image->header.e_phnum; i++ ) {
+        uint32_t phdrOffset = image->header.e_phoff + image->header.e_phentsize * i;
+        if ( !Utils::File::read_bytes(file, phdrOffset, (uint8_t*)&image->programHeaders[i], sizeof(Elf32Phdr)) ) {
+            klog("unable to read segment header from file");
+            return LS_IO_ERROR;
+        }
+    }
+    return LS_SUCCESSFUL;
 }
 
 /**
  *
  */
-LoaderStatus Elf32Loader::loadImage(Elf32Ehdr* hdr) {
+LoaderStatus Elf32Loader::loadImage() {
     // Load segments
-    for ( uint32_t i = 0; i < hdr->e_phnum; i++ ) {
-        uint32_t phdrOffset = hdr->e_phoff + hdr->e_phentsize * i;
-        uint32_t phdrLength = sizeof(Elf32Phdr);
-        uint8_t  phdrBuffer[phdrLength];
-
-        if ( !Utils::File::read_bytes(file, phdrOffset, phdrBuffer, phdrLength) ) {
-            klog("unable to read segment header from file");
-            return LS_IO_ERROR;
-        }
-
-        Elf32Phdr* phdr = (Elf32Phdr*)phdrBuffer;
+    for ( auto& programHeader : image.programHeaders ) {
+        const Elf32Phdr* phdr = &programHeader;
 
         if ( phdr->p_type == PT_LOAD ) {
             LoaderStatus segStat = loadLoadSegment(phdr);
@@ -120,7 +110,7 @@ LoaderStatus Elf32Loader::loadImage(Elf32Ehdr* hdr) {
 /**
  *
  */
-LoaderStatus Elf32Loader::loadTlsSegment(Elf32Phdr* phdr) {
+LoaderStatus Elf32Loader::loadTlsSegment(const Elf32Phdr* phdr) {
     // take values
     uint32_t numBytesCopy = phdr->p_filesz;
     uint32_t numBytesZero = phdr->p_memsz;
@@ -156,13 +146,26 @@ LoaderStatus Elf32Loader::loadTlsSegment(Elf32Phdr* phdr) {
 /**
  *
  */
-LoaderStatus Elf32Loader::loadLoadSegment(Elf32Phdr* phdr) {
+LoaderStatus Elf32Loader::loadLoadSegment(const Elf32Phdr* phdr) {
     uint32_t memStart = phdr->p_vaddr & ~0xFFF;
     uint32_t memEnd   = ((phdr->p_vaddr + phdr->p_memsz) + 0x1000) & ~0xFFF;
 
     uint32_t totalPages  = (memEnd - memStart) / 0x1000;
     uint32_t loadedPages = 0;
 
+    // Map the file content straight from the ramdisk, then only the zero pages are left to create
+    if ( phdr->p_filesz && (phdr->p_offset & 0xFFF) == (phdr->p_vaddr & 0xFFF) ) {
+        uint32_t fileStart  = phdr->p_offset & ~0xFFF;
+        uint32_t fileLength = phdr->p_offset + phdr->p_filesz - fileStart;
+        loadedPages         = s_map_file_in_space(procIdent, file, fileStart, fileLength, memStart);
+    }
+
+    // Share the pages already loaded by a previous spawn of the same executable
+    bool writable = (phdr->p_flags & PF_W) != 0;
+    if ( !loadedPages && s_map_cached_segment(procIdent, file, memStart, totalPages, writable) )
+        return LS_SUCCESSFUL;
+
+    bool     fileMapped   = loadedPages > 0;
     uint32_t offsetInFile = 0;
 
     while ( loadedPages < totalPages ) {
@@ -193,7 +196,7 @@ LoaderStatus Elf32Loader::loadLoadSegment(Elf32Phdr* phdr) {
         }
 
         // Read file to memory
-        if ( !Utils::File::read_bytes(file, phdr->p_offset + offsetInFile, &area[copyOffsetInArea], copyAmount) ) {
+        if ( copyAmount && !Utils::File::read_bytes(file, phdr->p_offset + offsetInFile, &area[copyOffsetInArea], copyAmount) ) {
             klog("unable to read LOAD segment");
             return LS_IO_ERROR;
         }
@@ -214,6 +217,9 @@ LoaderStatus Elf32Loader::loadLoadSegment(Elf32Phdr* phdr) {
         offsetInFile += copyAmount;
     }
 
+    // Give the loaded pages to the kernel image cache for the next spawns
+    if ( !fileMapped && !s_store_cached_segment(procIdent, file, memStart, totalPages, writable) )
+        klog("unable to cache LOAD segment at 0x%x", memStart);
     return LS_SUCCESSFUL;
 }
 
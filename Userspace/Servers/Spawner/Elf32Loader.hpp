@@ -28,6 +28,7 @@
 #include "loader.hpp"
 
 #include <Api/ELF32.h>
+#include <vector>
 
 /**
  *
@@ -43,13 +44,25 @@ enum Elf32ValidationStatus
     ELF32_VALIDATION_NOT_STANDARD_ELF
 };
 
+/**
+ * Validated ELF header with its program headers, read once and shared between spawns
+ */
+struct Elf32Image {
+    Elf32Ehdr              header;
+    std::vector<Elf32Phdr> programHeaders;
+};
+
 /**
  *
  */
 class Elf32Loader : public Loader {
+private:
+    const Elf32Image& image;
+
 public:
     //
-    Elf32Loader(ProcessCreationIdentifier target, FileHandle file) : Loader(target, file) {
+    Elf32Loader(ProcessCreationIdentifier target, FileHandle file, const Elf32Image& image)
+        : Loader(target, file), image(image) {
     }
 
     //
@@ -61,13 +74,13 @@ public:
 
     //
     static LoaderStatus readAndValidateElfHeader(FileHandle file, Elf32Ehdr* hdrBuf);
-    static LoaderStatus checkForElfBinaryAndReset(FileHandle file);
+    static LoaderStatus readImage(FileHandle file, Elf32Image* image);
 
 private:
     //
-    LoaderStatus loadImage(Elf32Ehdr* hdr);
-    LoaderStatus loadTlsSegment(Elf32Phdr* phdr);
-    LoaderStatus loadLoadSegment(Elf32Phdr* phdr);
+    LoaderStatus loadImage();
+    LoaderStatus loadTlsSegment(const Elf32Phdr* phdr);
+    LoaderStatus loadLoadSegment(const Elf32Phdr* phdr);
 
     //
     static Elf32ValidationStatus validate(Elf32Ehdr* header);
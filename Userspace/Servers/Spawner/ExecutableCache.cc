@@ -0,0 +1,179 @@
+/**
+ * @brief
+ * This file is part of the MeetiX Operating System.
+ * Copyright (c) 2017-2022, Marco Cicognani (marco.cicognani@meetixos.org)
+ *
+ * @developers
+ * Marco Cicognani (marco.cicognani@meetixos.org)
+ *
+ * @license
+ * GNU General Public License version 3
+ */
+
+#include "ExecutableCache.hh"
+
+#include <cstring>
+#include <fcntl.h>
+#include <LibTasking/Lock.hh>
+#include <LibTasking/LockGuard.hh>
+#include <LibUtils/Arguments.hh>
+#include <LibUtils/Environment.hh>
+#include <LibUtils/File.hh>
+#include <map>
+
+/**
+ * @brief The caches are dropped entirely when they grow over this amount of entries
+ */
+static constexpr usize C_MAXIMUM_ENTRIES = 64;
+
+/**
+ * @brief A path not found is answered without probing for this amount of milliseconds, no notification
+ * tells the spawner when a file is created into the PATH directories so the miss expires by itself
+ */
+static constexpr unsigned long long C_MISSING_PATH_MILLIS = 1000;
+
+struct CachedImage {
+    long long                         m_file_length;
+    std::shared_ptr<const Elf32Image> m_image;
+};
+
+static Tasking::Lock                             s_lock{};
+static std::string                               s_search_path{};
+static std::map<std::string, std::string>        s_resolved_paths{};
+static std::map<std::string, unsigned long long> s_missing_paths{};
+static std::map<std::string, CachedImage>        s_images{};
+
+FileHandle ExecutableCache::open(const char* path, std::string& resolved_path) {
+    auto search_path = Utils::Environment::get("PATH");
+    {
+        Tasking::LockGuard lock_guard{ s_lock };
+
+        /* the resolutions are valid only for the PATH which produced them */
+        if ( search_path != s_search_path ) {
+            s_resolved_paths.clear();
+            s_missing_paths.clear();
+            s_search_path = search_path;
+        }
+
+        auto it = s_resolved_paths.find(path);
+        if ( it != s_resolved_paths.end() )
+            resolved_path = it->second;
+        else {
+            auto missing_it = s_missing_paths.find(path);
+            if ( missing_it != s_missing_paths.end() ) {
+                if ( s_millis() < missing_it->second )
+                    return FD_NONE;
+                s_missing_paths.erase(missing_it);
+            }
+        }
+    }
+
+    /* open directly the already resolved path */
+    if ( !resolved_path.empty() ) {
+        auto file = s_open_f(resolved_path.c_str(), O_RDONLY);
+        if ( file != FD_NONE )
+            return file;
+
+        Tasking::LockGuard lock_guard{ s_lock };
+        s_resolved_paths.erase(path);
+    }
+
+    auto file = probe(path, search_path, resolved_path);
+
+    Tasking::LockGuard lock_guard{ s_lock };
+    if ( file != FD_NONE ) {
+        if ( s_resolved_paths.size() >= C_MAXIMUM_ENTRIES )
+            s_resolved_paths.clear();
+        s_resolved_paths[path] = resolved_path;
+    } else {
+        if ( s_missing_paths.size() >= C_MAXIMUM_ENTRIES )
+            s_missing_paths.clear();
+        s_missing_paths[path] = s_millis() + C_MISSING_PATH_MILLIS;
+    }
+    return file;
+}
+
+std::shared_ptr<const Elf32Image> ExecutableCache::elf_image(const std::string& resolved_path, FileHandle file, LoaderStatus* out_status) {
+    auto                              file_length = s_length(file);
+    std::shared_ptr<const Elf32Image> cached_image{};
+    {
+        Tasking::LockGuard lock_guard{ s_lock };
+
+        /* the length is the cheapest hint that the executable was rewritten */
+        auto it = s_images.find(resolved_path);
+        if ( it != s_images.end() && it->second.m_file_length == file_length )
+            cached_image = it->second.m_image;
+    }
+
+    /* a rebuilt executable can keep its length, the headers into the file must still be the cached ones */
+    if ( cached_image && headers_match(file, *cached_image) ) {
+        *out_status = LS_SUCCESSFUL;
+        return cached_image;
+    }
+
+    /* read the image outside the lock, the other workers must not wait for this I/O */
+    auto image  = std::make_shared<Elf32Image>();
+    *out_status = Elf32Loader::readImage(file, image.get());
+    if ( *out_status != LS_SUCCESSFUL )
+        return nullptr;
+
+    Tasking::LockGuard lock_guard{ s_lock };
+    if ( s_images.size() >= C_MAXIMUM_ENTRIES )
+        s_images.clear();
+    s_images[resolved_path] = CachedImage{ file_length, image };
+    return image;
+}
+
+bool ExecutableCache::headers_match(FileHandle file, const Elf32Image& image) {
+    Elf32Ehdr header;
+    if ( !Utils::File::read_bytes(file, 0, reinterpret_cast<uint8_t*>(&header), sizeof(Elf32Ehdr))
+         || memcmp(&header, &image.header, sizeof(Elf32Ehdr)) != 0 )
+        return false;
+
+    /* the validated header tells where the program headers are, read them with a single read when packed */
+    auto const headers_count = image.programHeaders.size();
+    if ( header.e_phentsize == sizeof(Elf32Phdr) ) {
+        std::vector<Elf32Phdr> program_headers(headers_count);
+        return Utils::File::read_bytes(file,
+                                       header.e_phoff,
+                                       reinterpret_cast<uint8_t*>(program_headers.data()),
+                                       headers_count * sizeof(Elf32Phdr))
+            && memcmp(program_headers.data(), image.programHeaders.data(), headers_count * sizeof(Elf32Phdr)) == 0;
+    }
+
+    for ( usize i = 0; i < headers_count; ++i ) {
+        Elf32Phdr program_header;
+        if ( !Utils::File::read_bytes(file,
+                                      header.e_phoff + header.e_phentsize * i,
+                                      reinterpret_cast<uint8_t*>(&program_header),
+                                      sizeof(Elf32Phdr))
+             || memcmp(&program_header, &image.programHeaders[i], sizeof(Elf32Phdr)) != 0 )
+            return false;
+    }
+    return true;
+}
+
+FileHandle ExecutableCache::probe(const char* path, const std::string& search_path, std::string& resolved_path) {
+    /* try open with provided path */
+    FileHandle file;
+    if ( (file = s_open_f(path, O_RDONLY)) != FD_NONE ) {
+        resolved_path = path;
+        return file;
+    }
+
+    /* try adding the path */
+    auto paths = Utils::Arguments::split(search_path, ':');
+    for ( auto& dir : paths ) {
+        /* app directory is composited */
+        if ( dir == "Apps" )
+            dir += std::string{ path } + std::string{ "/Bin" };
+
+        /* try open the file */
+        resolved_path = dir + std::string{ path };
+        if ( (file = s_open_f(resolved_path.c_str(), O_RDONLY)) != FD_NONE )
+            return file;
+    }
+
+    resolved_path.clear();
+    return FD_NONE;
+}
@@ -0,0 +1,50 @@
+/**
+ * @brief
+ * This file is part of the MeetiX Operating System.
+ * Copyright (c) 2017-2022, Marco Cicognani (marco.cicognani@meetixos.org)
+ *
+ * @developers
+ * Marco Cicognani (marco.cicognani@meetixos.org)
+ *
+ * @license
+ * GNU General Public License version 3
+ */
+
+#pragma once
+
+#include "Elf32Loader.hpp"
+
+#include <Api.h>
+#include <memory>
+#include <string>
+
+/**
+ * @brief Caches shared by the spawner workers: where the requested executables were found and
+ * their validated ELF images, so that repeated spawns skip the PATH probing and the header reads
+ */
+class ExecutableCache {
+public:
+    /**
+     * @brief Opens the executable at path, probing the PATH directories only when the path
+     * was never resolved or the resolved file disappeared. A path not found is remembered for
+     * a short time and every resolution is dropped when the PATH changes
+     * @param path The path requested by the client
+     * @param resolved_path Filled with the path of the opened file
+     * @return The handle of the opened file or FD_NONE
+     */
+    static FileHandle open(const char* path, std::string& resolved_path);
+
+    /**
+     * @brief Returns the validated ELF image of the opened executable. The cached image is
+     * used only when the length of the file and its ELF and program headers are unchanged
+     * @param resolved_path The path returned by open()
+     * @param file The opened executable
+     * @param out_status Filled with the status of the reading
+     * @return The image or nullptr when the file is not a valid executable
+     */
+    static std::shared_ptr<const Elf32Image> elf_image(const std::string& resolved_path, FileHandle file, LoaderStatus* out_status);
+
+private:
+    static bool       headers_match(FileHandle file, const Elf32Image& image);
+    static FileHandle probe(const char* path, const std::string& search_path, std::string& resolved_path);
+};
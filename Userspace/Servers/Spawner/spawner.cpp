@@ -25,19 +25,51 @@
 #include "spawner.hpp"
 
 #include "Elf32Loader.hpp"
+#include "ExecutableCache.hh"
 #include "Power.hpp"
 
 #include <Api/ByteWise.h>
-#include <fcntl.h>
+#include <deque>
+#include <map>
+#include <LibTasking/Lock.hh>
+#include <LibTasking/LockGuard.hh>
+#include <LibTasking/Thread.hh>
+#include <LibUtils/File.hh>
+#include <LibUtils/Utils.hh>
 #include <stdarg.h>
 #include <stdio.h>
 #include <string.h>
-#include <LibUtils/Arguments.hh>
-#include <LibUtils/Environment.hh>
-#include <LibUtils/File.hh>
-#include <LibUtils/Utils.hh>
 #include <vector>
 
+/**
+ * Spawn request waiting for a worker, the message is copied out of the receive buffer
+ */
+struct SpawnJob {
+    std::vector<uint8_t> request;
+    Tid                  requester;
+    MessageTransaction   transaction;
+};
+
+/**
+ * Thread which serves the queued spawn requests. The loading of the segments
+ * overlaps only with the other spawns served by the other workers: a single
+ * spawn is not split, because its descriptors and arguments are a few calls
+ * while a helper thread for the loading would cost a thread creation each
+ */
+class SpawnWorker : public Tasking::Thread {
+public:
+    SpawnWorker() : Tasking::Thread{ "SpawnWorker" } {
+    }
+    ~SpawnWorker() override = default;
+
+protected:
+    [[noreturn]] void run() override;
+};
+
+static std::deque<SpawnJob*> jobs;
+static Tasking::Lock         jobsLock;
+static bool                  jobsEmpty = true;
+
 /**
  *
  */
@@ -50,6 +82,10 @@ int main(int argc, char* argv[]) {
         return -1;
     }
 
+    // start the workers before the shell, it spawns right away
+    for ( int i = 0; i < SPAWNER_WORKERS_COUNT; i++ )
+        (new SpawnWorker())->start();
+
     // initialize the system userspace
     init();
 
@@ -72,7 +108,9 @@ void init() {
                              &out_stdio,
                              FD_NONE,
                              FD_NONE,
-                             FD_NONE);
+                             FD_NONE,
+                             nullptr,
+                             0);
 
     if ( stat == SPAWN_STATUS_SUCCESSFUL )
         klog("MxSh executed in process %d", sh_pid);
@@ -88,7 +126,7 @@ void init() {
     klog("spawner server ready");
 
     // defining size for messages
-    const size_t requestLenMax = sizeof(MessageHeader) + sizeof(SpawnCommandSpawnRequest) + 1024;
+    const size_t requestLenMax = sizeof(MessageHeader) + MESSAGE_MAXIMUM_LENGTH;
     while ( true ) {
         // creating buffer for message
         uint8_t requestBuffer[requestLenMax];
@@ -101,9 +139,13 @@ void init() {
         auto header        = (MessageHeader*)requestBuffer;
         auto commandHeader = (SpawnCommandHeader*)MESSAGE_CONTENT(header);
 
-        if ( commandHeader->m_command == SPAWN_COMMAND_SPAWN_REQUEST )
-            processSpawnRequest((SpawnCommandSpawnRequest*)commandHeader, header->m_sender_tid, header->m_transaction);
-        else if ( commandHeader->m_command == SPAWN_COMMAND_SHUTDOWN_MACHINE
+        // spawns are served concurrently by the workers, the loop goes back to receive
+        if ( commandHeader->m_command == SPAWN_COMMAND_SPAWN_REQUEST ) {
+            auto content = (uint8_t*)commandHeader;
+            pushJob(new SpawnJob{ std::vector<uint8_t>(content, content + header->m_message_len),
+                                  header->m_sender_tid,
+                                  header->m_transaction });
+        } else if ( commandHeader->m_command == SPAWN_COMMAND_SHUTDOWN_MACHINE
                   || commandHeader->m_command == SPAWN_COMMAND_REBOOT_MACHINE )
             processHaltMachine(commandHeader->m_command);
         else
@@ -111,6 +153,49 @@ void init() {
     }
 }
 
+/**
+ *
+ */
+void pushJob(SpawnJob* job) {
+    Tasking::LockGuard lock_guard{ jobsLock };
+    jobs.push_back(job);
+    jobsEmpty = false;
+}
+
+/**
+ *
+ */
+SpawnJob* popJob() {
+    while ( true ) {
+        {
+            Tasking::LockGuard lock_guard{ jobsLock };
+            if ( !jobs.empty() ) {
+                auto job = jobs.front();
+                jobs.pop_front();
+                return job;
+            }
+            jobsEmpty = true;
+        }
+
+        // sleep until pushJob() queues something
+        s_atomic_block(&jobsEmpty);
+    }
+}
+
+/**
+ *
+ */
+[[noreturn]] void SpawnWorker::run() {
+    while ( true ) {
+        auto job = popJob();
+        processSpawnRequest((SpawnCommandSpawnRequest*)job->request.data(),
+                            job->request.size(),
+                            job->requester,
+                            job->transaction);
+        delete job;
+    }
+}
+
 /**
  *
  */
@@ -124,7 +209,43 @@ void protocolError(std::string msg, ...) {
 /**
  *
  */
-void processSpawnRequest(SpawnCommandSpawnRequest* request, Tid requester, MessageTransaction tx) {
+bool validateSpawnRequest(const SpawnCommandSpawnRequest* request, size_t requestLen) {
+    if ( requestLen < sizeof(SpawnCommandSpawnRequest) )
+        return false;
+
+    // each part must fit into what is left, so the sum never overflows
+    auto         pos       = (const char*)request + sizeof(SpawnCommandSpawnRequest);
+    size_t       remaining = requestLen - sizeof(SpawnCommandSpawnRequest);
+    unsigned int stringLens[] = { request->m_path_len, request->m_args_len, request->m_workdir_len };
+    for ( auto len : stringLens ) {
+        if ( !len || len > remaining || pos[len - 1] != '\0' )
+            return false;
+
+        pos += len;
+        remaining -= len;
+    }
+    return request->m_file_actions_len <= remaining;
+}
+
+/**
+ *
+ */
+void processSpawnRequest(SpawnCommandSpawnRequest* request,
+                         size_t                    requestLen,
+                         Tid                       requester,
+                         MessageTransaction        tx) {
+    if ( !validateSpawnRequest(request, requestLen) ) {
+        protocolError("malformed spawn request: length %i, task %i", requestLen, requester);
+
+        SpawnCommandSpawnResponse response{};
+        response.m_spawn_status = SPAWN_STATUS_PROTOCOL_ERROR;
+        response.m_stdin_write  = FD_NONE;
+        response.m_stdout_read  = FD_NONE;
+        response.m_stderr_read  = FD_NONE;
+        s_send_message_t(requester, &response, sizeof(SpawnCommandSpawnResponse), tx);
+        return;
+    }
+
     SecurityLevel secLvl = request->m_security_level;
 
     auto pos = (const char*)request;
@@ -137,6 +258,9 @@ void processSpawnRequest(SpawnCommandSpawnRequest* request, Tid requester, Messa
     pos       = pos + request->m_args_len;
 
     auto workdir = pos;
+    pos          = pos + request->m_workdir_len;
+
+    auto fileActions = (const uint8_t*)pos;
 
     // parameters ready, perform spawn
     Pid         oPid;
@@ -155,7 +279,9 @@ void processSpawnRequest(SpawnCommandSpawnRequest* request, Tid requester, Messa
                                     &oFdErr,
                                     request->m_stdin,
                                     request->m_stdout,
-                                    request->m_stderr);
+                                    request->m_stderr,
+                                    fileActions,
+                                    request->m_file_actions_len);
 
     // send response
     SpawnCommandSpawnResponse response;
@@ -218,6 +344,134 @@ bool setupStdio(Pid         createdPid,
     return true;
 }
 
+/**
+ *
+ */
+static std::string absolutePath(const std::string& workdir, const char* path) {
+    if ( path[0] == '/' )
+        return path;
+    if ( !workdir.empty() && workdir.back() == '/' )
+        return workdir + path;
+    return workdir + "/" + path;
+}
+
+/**
+ * Descriptor which will be cloned into the new process
+ */
+struct ChildFd {
+    Pid        owner;
+    FileHandle fd;
+};
+
+/**
+ *
+ */
+bool applyFileActions(Pid            createdPid,
+                      Pid            requesterPid,
+                      const uint8_t* actions,
+                      uint32_t       actionsLen,
+                      FileHandle     inStdin,
+                      FileHandle     inStdout,
+                      FileHandle     inStderr,
+                      std::string&   workdir) {
+    auto                          thisPid = s_get_pid();
+    std::map<FileHandle, ChildFd> childFds;
+    std::vector<FileHandle>       openedFds;
+
+    // the process starts only with the standard I/O given by the requester
+    FileHandle stdio[] = { inStdin, inStdout, inStderr };
+    for ( FileHandle fd = STDIN_FILENO; fd <= STDERR_FILENO; ++fd ) {
+        if ( stdio[fd] != FD_NONE )
+            childFds[fd] = ChildFd{ requesterPid, stdio[fd] };
+    }
+
+    // build the descriptor table without touching the process, so that CLOSE is only a removal
+    auto success = true;
+    auto pos     = actions;
+    auto end     = actions + actionsLen;
+    while ( success && pos < end ) {
+        if ( end - pos < (ptrdiff_t)sizeof(SpawnFileAction) ) {
+            protocolError("truncated file action");
+            success = false;
+            break;
+        }
+
+        // the path length is checked against what is left before moving on, it comes from the requester
+        auto action = (const SpawnFileAction*)pos;
+        auto path   = (const char*)(pos + sizeof(SpawnFileAction));
+        if ( action->m_path_len > (size_t)(end - pos) - sizeof(SpawnFileAction)
+             || (action->m_path_len > 0 && path[action->m_path_len - 1] != '\0') ) {
+            protocolError("malformed path in file action %i", action->m_action);
+            success = false;
+            break;
+        }
+        pos = pos + sizeof(SpawnFileAction) + action->m_path_len;
+
+        switch ( action->m_action ) {
+            case SPAWN_FILE_ACTION_CLOSE:
+                childFds.erase(action->m_fd);
+                break;
+
+            case SPAWN_FILE_ACTION_DUP2: {
+                // descriptors not yet touched by an action are the ones of the requester
+                ChildFd source{ requesterPid, action->m_source_fd };
+                auto    it = childFds.find(action->m_source_fd);
+                if ( it != childFds.end() )
+                    source = it->second;
+                childFds[action->m_fd] = source;
+                break;
+            }
+
+            case SPAWN_FILE_ACTION_OPEN: {
+                if ( action->m_path_len == 0 ) {
+                    success = false;
+                    break;
+                }
+
+                FsOpenStatus openStat;
+                auto         fd = s_open_fms(absolutePath(workdir, path).c_str(), action->m_open_flags, action->m_open_mode, &openStat);
+                if ( openStat != FS_OPEN_SUCCESSFUL ) {
+                    klog("file action failed to open %s with status %i", path, openStat);
+                    success = false;
+                    break;
+                }
+
+                openedFds.push_back(fd);
+                childFds[action->m_fd] = ChildFd{ thisPid, fd };
+                break;
+            }
+
+            case SPAWN_FILE_ACTION_CHDIR:
+                if ( action->m_path_len == 0 )
+                    success = false;
+                else
+                    workdir = absolutePath(workdir, path);
+                break;
+
+            default:
+                protocolError("unknown file action %i", action->m_action);
+                success = false;
+                break;
+        }
+    }
+
+    // clone the resulting table into the process
+    if ( success ) {
+        for ( auto& [targetFd, source] : childFds ) {
+            if ( s_clone_fd_t(source.fd, source.owner, targetFd, createdPid) == FD_NONE ) {
+                klog("file action failed to clone %i of process %i into %i", source.fd, source.owner, targetFd);
+                success = false;
+                break;
+            }
+        }
+    }
+
+    // the process owns its copies now
+    for ( auto fd : openedFds )
+        s_close(fd);
+    return success;
+}
+
 /**
  *
  */
@@ -240,67 +494,35 @@ void writeCliArgs(ProcessCreationIdentifier targetProc, const char* args) {
 /**
  *
  */
-BinaryFormat detectFormat(FileHandle file) {
-    // try to detect the format
-    BinaryFormat form = BF_UNKNOWN;
-    if ( Elf32Loader::checkForElfBinaryAndReset(file) == LS_SUCCESSFUL )
-        form = BF_ELF32;
-
-    return form;
-}
-
-/*
- *
- */
-bool findFile(const char* path, FileHandle* file) {
-    // try open with provided path
-    if ( (*file = s_open_f(path, O_RDONLY)) != FD_NONE )
-        return true;
-
-    // try adding the path
-    auto paths = Utils::Arguments::split(Utils::Environment::get("PATH"), ':');
-    for ( auto& dir : paths ) {
-        // app directory is composited
-        if ( dir == "Apps" )
-            dir += std::string{ path } + std::string{ "/Bin" };
-
-        // try open the file
-        if ( (*file = s_open_f((dir + std::string(path)).c_str(), O_RDONLY)) != FD_NONE )
-            return true;
-    }
-
-    return false;
-}
-
-/**
- *
- */
-SpawnStatus spawn(const char*   path,
-                  const char*   args,
-                  const char*   workdir,
-                  SecurityLevel secLvl,
-                  Pid           requesterPid,
-                  Pid*          outPid,
-                  FileHandle*   outStdin,
-                  FileHandle*   outStdout,
-                  FileHandle*   outStderr,
-                  FileHandle    inStdin,
-                  FileHandle    inStdout,
-                  FileHandle    inStderr) {
-    // file of executable
-    FileHandle file;
-
+SpawnStatus spawn(const char*    path,
+                  const char*    args,
+                  const char*    workdir,
+                  SecurityLevel  secLvl,
+                  Pid            requesterPid,
+                  Pid*           outPid,
+                  FileHandle*    outStdin,
+                  FileHandle*    outStdout,
+                  FileHandle*    outStderr,
+                  FileHandle     inStdin,
+                  FileHandle     inStdout,
+                  FileHandle     inStderr,
+                  const uint8_t* fileActions,
+                  uint32_t       fileActionsLen) {
     // open input file
-    if ( !findFile(path, &file) ) {
+    std::string resolvedPath;
+    FileHandle  file = ExecutableCache::open(path, resolvedPath);
+    if ( file == FD_NONE ) {
         klog("unable to open the file: %s, it doesn't exist on PATH directory", path);
         return SPAWN_STATUS_IO_ERROR;
     }
 
-    // detect format
-    BinaryFormat format = detectFormat(file);
-    if ( format == BF_UNKNOWN ) {
+    // ELF is the only known format
+    LoaderStatus imageStat;
+    auto         image = ExecutableCache::elf_image(resolvedPath, file, &imageStat);
+    if ( !image ) {
         klog("binary has an unknown format: %s", path);
-        return SPAWN_STATUS_FORMAT_ERROR;
+        s_close(file);
+        return imageStat == LS_IO_ERROR ? SPAWN_STATUS_IO_ERROR : SPAWN_STATUS_FORMAT_ERROR;
     }
 
     // create empty target process
@@ -313,22 +535,33 @@ SpawnStatus spawn(const char*   path,
     s_configure_process(targetProc, configuration);
 
     // create a loader
-    Loader* loader;
-    if ( format == BF_ELF32 )
-        loader = new Elf32Loader(targetProc, file);
-    // else if (format == BF_ELF64) loader = new Elf64Loader(targetProc, file);
-    else {
-        klog("no loader implementation for binary format %i", format);
-        return SPAWN_STATUS_FORMAT_ERROR;
-    }
-
-    // setup standard I/O
-    if ( !setupStdio(targetPid, requesterPid, outStdin, outStdout, outStderr, inStdin, inStdout, inStderr) )
+    Elf32Loader loader{ targetProc, file, *image };
+
+    // setup the descriptors requested by the file actions or the standard I/O pipes
+    std::string workingDirectory{ workdir };
+    if ( fileActionsLen > 0 ) {
+        *outStdin  = FD_NONE;
+        *outStdout = FD_NONE;
+        *outStderr = FD_NONE;
+
+        if ( !applyFileActions(targetPid,
+                               requesterPid,
+                               fileActions,
+                               fileActionsLen,
+                               inStdin,
+                               inStdout,
+                               inStderr,
+                               workingDirectory) ) {
+            s_cancel_process_creation(targetProc);
+            s_close(file);
+            return SPAWN_STATUS_FILE_ACTION_ERROR;
+        }
+    } else if ( !setupStdio(targetPid, requesterPid, outStdin, outStdout, outStderr, inStdin, inStdout, inStderr) )
         klog("unable to setup stdio for process %i", targetPid);
 
     // perform loading
     uintptr_t    entryAddress;
-    LoaderStatus ldrStat   = loader->load(&entryAddress);
+    LoaderStatus ldrStat   = loader.load(&entryAddress);
     SpawnStatus  spawnStat = SPAWN_STATUS_UNKNOWN;
 
     if ( ldrStat == LS_SUCCESSFUL ) {
@@ -336,7 +569,7 @@ SpawnStatus spawn(const char*   path,
         writeCliArgs(targetProc, args);
 
         // set working directory
-        s_set_working_directory_p(workdir, targetProc);
+        s_set_working_directory_p(workingDirectory.c_str(), targetProc);
 
         // attached loaded process
         s_attach_created_process(targetProc, entryAddress);
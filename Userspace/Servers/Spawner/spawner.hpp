@@ -29,13 +29,11 @@
 #    define __SPAWNER__
 
 /**
- *
+ * number of threads which serve the spawn requests concurrently
  */
-enum BinaryFormat
-{
-    BF_UNKNOWN,
-    BF_ELF32
-};
+#    define SPAWNER_WORKERS_COUNT 4
+
+struct SpawnJob;
 
 /**
  * create the environment file with prefixed enviroment variables
@@ -52,6 +50,16 @@ void init();
  */
 [[noreturn]] void receiveRequests();
 
+/**
+ * Queues a spawn request for the workers
+ */
+void pushJob(SpawnJob* job);
+
+/**
+ * Takes the oldest queued spawn request, blocking the calling worker while the queue is empty
+ */
+SpawnJob* popJob();
+
 /**
  *
  */
@@ -62,12 +70,29 @@ void protocolError(std::string msg, ...);
  *
  * @param request
  * 		incoming message
+ * @param requestLen
+ * 		received length of the message, the lengths into the request are checked against it
  * @param requester
  * 		tid of requester
  * @param tx
  * 		transaction to respond on
  */
-void processSpawnRequest(SpawnCommandSpawnRequest* request, Tid requester, MessageTransaction tx);
+void processSpawnRequest(SpawnCommandSpawnRequest* request,
+                         size_t                    requestLen,
+                         Tid                       requester,
+                         MessageTransaction        tx);
+
+/**
+ * Checks that the strings and the file actions of the request fit into the
+ * received length, and that the strings are terminated
+ *
+ * @param request
+ * 		incoming message
+ * @param requestLen
+ * 		received length of the message
+ * @return whether the request is well formed
+ */
+bool validateSpawnRequest(const SpawnCommandSpawnRequest* request, size_t requestLen);
 
 /**
  * Creates the standard input & output streams for the process
@@ -93,6 +118,31 @@ bool setupStdio(Pid         createdPid,
                 FileHandle  inStdout,
                 FileHandle  inStderr);
 
+/**
+ * Builds the descriptor table of the process <createdPid> from the given standard I/O
+ * descriptors of the requester and the list of {SpawnFileAction}, then clones it into the process.
+ * The CHDIR actions update <workdir>, which is also used to resolve relative paths
+ *
+ * @param createdPid
+ * 		target process id
+ * @param requesterPid
+ * 		process id of the requesting task
+ * @param actions
+ * 		buffer of file actions
+ * @param actionsLen
+ * 		size in bytes of <actions>
+ * @param workdir
+ * 		target working directory
+ */
+bool applyFileActions(Pid            createdPid,
+                      Pid            requesterPid,
+                      const uint8_t* actions,
+                      uint32_t       actionsLen,
+                      FileHandle     inStdin,
+                      FileHandle     inStdout,
+                      FileHandle     inStderr,
+                      std::string&   workdir);
+
 /**
  * Places the given command line arguments in the kernel buffer
  * for the target process <targetProc>.
@@ -104,11 +154,6 @@ bool setupStdio(Pid         createdPid,
  */
 void writeCliArgs(ProcessCreationIdentifier targetProc, const char* args);
 
-/**
- *
- */
-BinaryFormat detectFormat(FileHandle file);
-
 /**
  * Spawns the binary at <path> passing the arguments <args>. As security level,
  * the level <sec_lvl> is set. The out parameters are filled with the respective
@@ -124,18 +169,22 @@ BinaryFormat detectFormat(FileHandle file);
  * 		security level
  * @param requesterPid
  * 		process m_command of the requester
+ * @param fileActions
+ * 		optional file actions, see applyFileActions()
  */
-SpawnStatus spawn(const char*   path,
-                  const char*   args,
-                  const char*   workdir,
-                  SecurityLevel sec_lvl,
-                  Pid           requesterPid,
-                  Pid*          outPid,
-                  FileHandle*   outStdin,
-                  FileHandle*   outStdout,
-                  FileHandle*   outStderr,
-                  FileHandle    inStdin,
-                  FileHandle    inStdout,
-                  FileHandle    inStderr);
+SpawnStatus spawn(const char*    path,
+                  const char*    args,
+                  const char*    workdir,
+                  SecurityLevel  sec_lvl,
+                  Pid            requesterPid,
+                  Pid*           outPid,
+                  FileHandle*    outStdin,
+                  FileHandle*    outStdout,
+                  FileHandle*    outStderr,
+                  FileHandle     inStdin,
+                  FileHandle     inStdout,
+                  FileHandle     inStderr,
+                  const uint8_t* fileActions,
+                  uint32_t       fileActionsLen);
 
 #endif
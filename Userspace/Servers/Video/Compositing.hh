@@ -0,0 +1,99 @@
+/**
+ * @brief
+ * This file is part of the MeetiX Operating System.
+ * Copyright (c) 2017-2022, Marco Cicognani (marco.cicognani@meetixos.org)
+ *
+ * @developers
+ * Marco Cicognani (marco.cicognani@meetixos.org)
+ *
+ * @license
+ * GNU General Public License version 3
+ */
+
+#pragma once
+
+#include <stdint.h>
+
+/**
+ * @brief Messages of the compositing API of the video driver. Each request starts with
+ * the command, like the mode setting ones, with values which don't clash with them.
+ *
+ * A client creates a surface and receives two shared buffers of premultiplied
+ * ARGB pixels. It draws into the back one and submits it with the damaged
+ * rectangle: the driver replies with the buffer to draw into next, and composes
+ * the front buffers of all the surfaces into the framebuffer once per frame.
+ */
+#define COMPOSITING_COMMAND_CREATE_SURFACE  0x100
+#define COMPOSITING_COMMAND_SUBMIT_SURFACE  0x101
+#define COMPOSITING_COMMAND_DESTROY_SURFACE 0x102
+#define COMPOSITING_COMMAND_FRAME_STATS     0x103
+
+/**
+ * @brief Cadence of the composition, the frames are composed only when damaged
+ */
+#define COMPOSITING_FRAME_MILLIS 16
+
+/**
+ * @brief Frame-time histogram: one bucket per millisecond, the last one counts the
+ * slower frames too
+ */
+#define COMPOSITING_FRAME_TIME_BUCKETS 33
+
+namespace Compositing {
+
+/**
+ * @brief Rectangle in screen coordinates
+ */
+struct Rect {
+    int32_t m_x;
+    int32_t m_y;
+    int32_t m_width;
+    int32_t m_height;
+};
+
+struct CreateSurfaceRequest {
+    uint32_t m_command;
+    Rect     m_bounds;
+    bool     m_opaque;
+};
+
+struct CreateSurfaceResponse {
+    bool      m_successful;
+    uint32_t  m_surface_id;
+    uint32_t  m_stride;
+    uint32_t* m_buffers[2];
+};
+
+/**
+ * @brief The damage is relative to the surface
+ */
+struct SubmitSurfaceRequest {
+    uint32_t m_command;
+    uint32_t m_surface_id;
+    uint8_t  m_buffer;
+    Rect     m_damage;
+};
+
+struct SubmitSurfaceResponse {
+    bool    m_successful;
+    uint8_t m_next_buffer;
+};
+
+/**
+ * @brief No response is sent
+ */
+struct DestroySurfaceRequest {
+    uint32_t m_command;
+    uint32_t m_surface_id;
+};
+
+struct FrameStatsRequest {
+    uint32_t m_command;
+};
+
+struct FrameStatsResponse {
+    uint64_t m_composed_frames;
+    uint32_t m_frame_time_histogram[COMPOSITING_FRAME_TIME_BUCKETS];
+};
+
+} /* namespace Compositing */
@@ -0,0 +1,272 @@
+/**
+ * @brief
+ * This file is part of the MeetiX Operating System.
+ * Copyright (c) 2017-2022, Marco Cicognani (marco.cicognani@meetixos.org)
+ *
+ * @developers
+ * Marco Cicognani (marco.cicognani@meetixos.org)
+ *
+ * @license
+ * GNU General Public License version 3
+ */
+
+#include "Compositor.hh"
+
+#include <LibGlyph/AlphaBlit.hh>
+#include <string.h>
+
+namespace {
+
+bool is_empty(const Compositing::Rect& rect) {
+    return rect.m_width <= 0 || rect.m_height <= 0;
+}
+
+Compositing::Rect intersect(const Compositing::Rect& lhs, const Compositing::Rect& rhs) {
+    auto const left   = lhs.m_x > rhs.m_x ? lhs.m_x : rhs.m_x;
+    auto const top    = lhs.m_y > rhs.m_y ? lhs.m_y : rhs.m_y;
+    auto const right  = lhs.m_x + lhs.m_width < rhs.m_x + rhs.m_width ? lhs.m_x + lhs.m_width : rhs.m_x + rhs.m_width;
+    auto const bottom = lhs.m_y + lhs.m_height < rhs.m_y + rhs.m_height ? lhs.m_y + lhs.m_height : rhs.m_y + rhs.m_height;
+    return Compositing::Rect{ left, top, right - left, bottom - top };
+}
+
+Compositing::Rect unite(const Compositing::Rect& lhs, const Compositing::Rect& rhs) {
+    auto const left   = lhs.m_x < rhs.m_x ? lhs.m_x : rhs.m_x;
+    auto const top    = lhs.m_y < rhs.m_y ? lhs.m_y : rhs.m_y;
+    auto const right  = lhs.m_x + lhs.m_width > rhs.m_x + rhs.m_width ? lhs.m_x + lhs.m_width : rhs.m_x + rhs.m_width;
+    auto const bottom = lhs.m_y + lhs.m_height > rhs.m_y + rhs.m_height ? lhs.m_y + lhs.m_height : rhs.m_y + rhs.m_height;
+    return Compositing::Rect{ left, top, right - left, bottom - top };
+}
+
+bool contains(const Compositing::Rect& outer, const Compositing::Rect& inner) {
+    return inner.m_x >= outer.m_x && inner.m_y >= outer.m_y && inner.m_x + inner.m_width <= outer.m_x + outer.m_width
+        && inner.m_y + inner.m_height <= outer.m_y + outer.m_height;
+}
+
+Compositing::Rect clip_to_surface(const Compositing::Rect& damage, int32_t width, int32_t height) {
+    /* computed on 64 bits, the values come from the clients and can overflow */
+    auto const left   = damage.m_x > 0 ? static_cast<int64_t>(damage.m_x) : 0;
+    auto const top    = damage.m_y > 0 ? static_cast<int64_t>(damage.m_y) : 0;
+    auto const right  = static_cast<int64_t>(damage.m_x) + damage.m_width < width ? static_cast<int64_t>(damage.m_x) + damage.m_width : width;
+    auto const bottom = static_cast<int64_t>(damage.m_y) + damage.m_height < height ? static_cast<int64_t>(damage.m_y) + damage.m_height : height;
+    if ( right <= left || bottom <= top )
+        return Compositing::Rect{};
+    return Compositing::Rect{ static_cast<int32_t>(left),
+                              static_cast<int32_t>(top),
+                              static_cast<int32_t>(right - left),
+                              static_cast<int32_t>(bottom - top) };
+}
+
+uint32_t surface_buffer_size(const Compositing::Rect& bounds) {
+    return bounds.m_width * bounds.m_height * sizeof(uint32_t);
+}
+
+} /* namespace */
+
+Compositor::Compositor(uint32_t* framebuffer, uint32_t width, uint32_t height, uint32_t framebuffer_stride)
+    : m_framebuffer{ framebuffer }
+    , m_width{ width }
+    , m_height{ height }
+    , m_framebuffer_stride{ framebuffer_stride }
+    , m_back_buffer{ static_cast<uint32_t*>(s_alloc_mem(width * height * sizeof(uint32_t))) } {
+}
+
+bool Compositor::is_valid_bounds(const Compositing::Rect& bounds) const {
+    /* the surfaces are never larger than the screen and lie at most one screen away from it, so neither the size of
+     * their buffers nor their coordinates can overflow */
+    auto const width  = static_cast<int32_t>(m_width);
+    auto const height = static_cast<int32_t>(m_height);
+    return !is_empty(bounds) && bounds.m_width <= width && bounds.m_height <= height && bounds.m_x >= -width
+        && bounds.m_x <= width && bounds.m_y >= -height && bounds.m_y <= height;
+}
+
+Compositor::~Compositor() {
+    for ( uint32_t i = 0; i < m_surfaces_count; ++i ) {
+        s_unmap_mem(m_surfaces[i].m_buffers[0]);
+        s_unmap_mem(m_surfaces[i].m_buffers[1]);
+    }
+    if ( m_back_buffer )
+        s_unmap_mem(m_back_buffer);
+}
+
+const Compositor::Surface* Compositor::create_surface(Pid owner, const Compositing::Rect& bounds, bool opaque) {
+    if ( !is_valid_bounds(bounds) || m_surfaces_count == COMPOSITOR_MAX_SURFACES )
+        return nullptr;
+
+    Surface surface{};
+    surface.m_id     = m_next_surface_id++;
+    surface.m_owner  = owner;
+    surface.m_bounds = bounds;
+    surface.m_opaque = opaque;
+    surface.m_buffers[0] = static_cast<uint32_t*>(s_alloc_mem(surface_buffer_size(bounds)));
+    surface.m_buffers[1] = static_cast<uint32_t*>(s_alloc_mem(surface_buffer_size(bounds)));
+    if ( !surface.m_buffers[0] || !surface.m_buffers[1] ) {
+        for ( auto buffer : surface.m_buffers ) {
+            if ( buffer )
+                s_unmap_mem(buffer);
+        }
+        return nullptr;
+    }
+
+    m_surfaces[m_surfaces_count] = surface;
+    return &m_surfaces[m_surfaces_count++];
+}
+
+bool Compositor::submit_surface(Pid owner, uint32_t surface_id, uint8_t buffer, const Compositing::Rect& damage, uint8_t& next_buffer) {
+    auto surface = find_surface(owner, surface_id);
+    if ( !surface || buffer > 1 )
+        return false;
+
+    surface->m_front_buffer = buffer;
+    next_buffer             = buffer ^ 1;
+
+    /* the first content shows the whole surface */
+    auto const& bounds = surface->m_bounds;
+    if ( !surface->m_has_content ) {
+        surface->m_has_content = true;
+        add_damage(bounds);
+    } else {
+        auto const clipped = clip_to_surface(damage, bounds.m_width, bounds.m_height);
+        if ( !is_empty(clipped) )
+            add_damage(Compositing::Rect{ bounds.m_x + clipped.m_x, bounds.m_y + clipped.m_y, clipped.m_width, clipped.m_height });
+    }
+    return true;
+}
+
+bool Compositor::destroy_surface(Pid owner, uint32_t surface_id) {
+    auto surface = find_surface(owner, surface_id);
+    if ( !surface )
+        return false;
+
+    remove_surface(surface);
+    return true;
+}
+
+uint32_t Compositor::release_dead_clients(bool (*is_alive)(Pid)) {
+    uint32_t released_count = 0;
+    Pid      alive_owner    = 0;
+    for ( uint32_t i = 0; i < m_surfaces_count; ) {
+        auto const owner = m_surfaces[i].m_owner;
+        if ( owner == alive_owner || is_alive(owner) ) {
+            alive_owner = owner;
+            ++i;
+            continue;
+        }
+
+        /* the next surface slides into this index */
+        remove_surface(&m_surfaces[i]);
+        ++released_count;
+    }
+    return released_count;
+}
+
+void Compositor::remove_surface(Surface* surface) {
+    if ( surface->m_has_content )
+        add_damage(surface->m_bounds);
+
+    s_unmap_mem(surface->m_buffers[0]);
+    s_unmap_mem(surface->m_buffers[1]);
+
+    /* keep the stacking order of the surfaces above */
+    auto const index = static_cast<uint32_t>(surface - m_surfaces);
+    memmove(m_surfaces + index, m_surfaces + index + 1, (m_surfaces_count - index - 1) * sizeof(Surface));
+    --m_surfaces_count;
+}
+
+bool Compositor::compose_frame() {
+    if ( m_damage_count == 0 )
+        return false;
+
+    /* compose all the damage before copying it, the framebuffer is written only once per frame */
+    for ( uint32_t i = 0; i < m_damage_count; ++i )
+        compose_rect(m_damage_rects[i]);
+
+    for ( uint32_t i = 0; i < m_damage_count; ++i ) {
+        auto const& rect = m_damage_rects[i];
+        for ( auto y = rect.m_y; y < rect.m_y + rect.m_height; ++y )
+            Glyph::stream_copy_pixels(m_framebuffer + y * m_framebuffer_stride + rect.m_x,
+                                      m_back_buffer + y * m_width + rect.m_x,
+                                      rect.m_width);
+    }
+
+    m_damage_count = 0;
+    ++m_composed_frames;
+    return true;
+}
+
+void Compositor::record_frame_time(uint64_t millis) {
+    auto const bucket = millis < COMPOSITING_FRAME_TIME_BUCKETS ? millis : COMPOSITING_FRAME_TIME_BUCKETS - 1;
+    ++m_frame_time_histogram[bucket];
+}
+
+void Compositor::frame_stats(Compositing::FrameStatsResponse& stats) const {
+    stats.m_composed_frames = m_composed_frames;
+    memcpy(stats.m_frame_time_histogram, m_frame_time_histogram, sizeof(m_frame_time_histogram));
+}
+
+Compositor::Surface* Compositor::find_surface(Pid owner, uint32_t surface_id) {
+    for ( uint32_t i = 0; i < m_surfaces_count; ++i ) {
+        if ( m_surfaces[i].m_id == surface_id )
+            return m_surfaces[i].m_owner == owner ? &m_surfaces[i] : nullptr;
+    }
+    return nullptr;
+}
+
+void Compositor::add_damage(Compositing::Rect rect) {
+    rect = intersect(rect, Compositing::Rect{ 0, 0, static_cast<int32_t>(m_width), static_cast<int32_t>(m_height) });
+    if ( is_empty(rect) )
+        return;
+
+    /* the overlapping rectangles are merged to not compose the same pixels twice */
+    for ( uint32_t i = 0; i < m_damage_count; ++i ) {
+        if ( !is_empty(intersect(m_damage_rects[i], rect)) ) {
+            m_damage_rects[i] = unite(m_damage_rects[i], rect);
+            return;
+        }
+    }
+
+    if ( m_damage_count == COMPOSITOR_MAX_DAMAGE_RECTS ) {
+        for ( uint32_t i = 1; i < m_damage_count; ++i )
+            m_damage_rects[0] = unite(m_damage_rects[0], m_damage_rects[i]);
+        m_damage_rects[0] = unite(m_damage_rects[0], rect);
+        m_damage_count    = 1;
+        return;
+    }
+    m_damage_rects[m_damage_count++] = rect;
+}
+
+void Compositor::compose_rect(const Compositing::Rect& rect) {
+    auto const back_target = Glyph::ArgbTarget{ m_back_buffer, m_width, m_width, m_height };
+
+    /* the surfaces under the topmost opaque one which covers the whole rectangle are hidden */
+    uint32_t first_visible = 0;
+    bool     covered       = false;
+    for ( auto i = m_surfaces_count; i > 0 && !covered; --i ) {
+        auto const& surface = m_surfaces[i - 1];
+        if ( surface.m_has_content && surface.m_opaque && contains(surface.m_bounds, rect) ) {
+            first_visible = i - 1;
+            covered       = true;
+        }
+    }
+    if ( !covered )
+        Glyph::fill_rect(back_target, rect.m_x, rect.m_y, rect.m_width, rect.m_height, COMPOSITOR_BACKGROUND_COLOR);
+
+    for ( auto i = first_visible; i < m_surfaces_count; ++i ) {
+        auto const& surface = m_surfaces[i];
+        auto const  visible = intersect(surface.m_bounds, rect);
+        if ( !surface.m_has_content || is_empty(visible) )
+            continue;
+
+        auto const stride     = static_cast<uint32_t>(surface.m_bounds.m_width);
+        auto const source_ptr = surface.m_buffers[surface.m_front_buffer] + (visible.m_y - surface.m_bounds.m_y) * stride
+                              + (visible.m_x - surface.m_bounds.m_x);
+        if ( surface.m_opaque ) {
+            for ( auto row = 0; row < visible.m_height; ++row )
+                memcpy(m_back_buffer + (visible.m_y + row) * m_width + visible.m_x,
+                       source_ptr + row * stride,
+                       visible.m_width * sizeof(uint32_t));
+        } else {
+            auto const source = Glyph::ArgbTarget{ source_ptr, stride, static_cast<uint32_t>(visible.m_width), static_cast<uint32_t>(visible.m_height) };
+            Glyph::blend_surface(back_target, source, visible.m_x, visible.m_y);
+        }
+    }
+}
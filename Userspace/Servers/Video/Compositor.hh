@@ -0,0 +1,133 @@
+/**
+ * @brief
+ * This file is part of the MeetiX Operating System.
+ * Copyright (c) 2017-2022, Marco Cicognani (marco.cicognani@meetixos.org)
+ *
+ * @developers
+ * Marco Cicognani (marco.cicognani@meetixos.org)
+ *
+ * @license
+ * GNU General Public License version 3
+ */
+
+#pragma once
+
+#include "Compositing.hh"
+
+#include <Api.h>
+
+/**
+ * @brief Background of the screen parts which no surface covers
+ */
+#define COMPOSITOR_BACKGROUND_COLOR 0xff101820
+
+/**
+ * @brief Surfaces shown at the same time
+ */
+#define COMPOSITOR_MAX_SURFACES 64
+
+/**
+ * @brief Damaged rectangles kept apart before merging them all into their bounds
+ */
+#define COMPOSITOR_MAX_DAMAGE_RECTS 8
+
+/**
+ * @brief Composes the surfaces of the clients into a back buffer and copies only its damaged parts to the framebuffer,
+ * once per frame, so the clients never draw into the visible framebuffer and a slow one never holds the others.
+ * The surfaces are stacked in creation order, the last created on top. Nothing is written to the framebuffer before
+ * the first submit, so the clients which still draw into it directly keep working
+ */
+class Compositor {
+public:
+    struct Surface {
+        uint32_t          m_id{ 0 };
+        Pid               m_owner{ 0 };
+        Compositing::Rect m_bounds{};
+        uint32_t*         m_buffers[2]{};
+        uint8_t           m_front_buffer{ 0 };
+        bool              m_has_content{ false };
+        bool              m_opaque{ false };
+    };
+
+    /**
+     * @param framebuffer The visible 32 bits framebuffer
+     * @param framebuffer_stride The pixels between two rows of the framebuffer
+     */
+    Compositor(uint32_t* framebuffer, uint32_t width, uint32_t height, uint32_t framebuffer_stride);
+    ~Compositor();
+
+    Compositor(const Compositor&)            = delete;
+    Compositor& operator=(const Compositor&) = delete;
+
+    /**
+     * @brief Returns whether the back buffer was allocated
+     */
+    bool is_valid() const {
+        return m_back_buffer != nullptr;
+    }
+
+    /**
+     * @brief Allocates the two buffers of a new surface on top of the others, the surface is shown from its first
+     * submit on
+     * @return The surface or nullptr when the bounds are empty or larger than the screen, there are too many surfaces
+     * or the memory is exhausted
+     */
+    const Surface* create_surface(Pid owner, const Compositing::Rect& bounds, bool opaque);
+
+    /**
+     * @brief Shows the given buffer of the surface from the next frame on. The buffer must contain the whole surface,
+     * the damage tells only which part of the screen changed
+     * @param damage The changed rectangle, relative to the surface
+     * @param next_buffer Filled with the buffer which the client can draw into
+     * @return Whether the surface exists and belongs to the owner
+     */
+    bool submit_surface(Pid owner, uint32_t surface_id, uint8_t buffer, const Compositing::Rect& damage, uint8_t& next_buffer);
+
+    /**
+     * @brief Releases the buffers of the surface and damages the screen under it
+     */
+    bool destroy_surface(Pid owner, uint32_t surface_id);
+
+    /**
+     * @brief Destroys the surfaces of the clients which exited without destroying them
+     * @param is_alive Tells whether the owner process still exists
+     * @return The amount of destroyed surfaces
+     */
+    uint32_t release_dead_clients(bool (*is_alive)(Pid));
+
+    /**
+     * @brief Composes the damaged rectangles into the back buffer and copies them to the framebuffer
+     * @return Whether there was something to compose
+     */
+    bool compose_frame();
+
+    /**
+     * @brief Frame-time histogram
+     */
+    void record_frame_time(uint64_t millis);
+    void frame_stats(Compositing::FrameStatsResponse& stats) const;
+
+private:
+    bool     is_valid_bounds(const Compositing::Rect& bounds) const;
+    Surface* find_surface(Pid owner, uint32_t surface_id);
+    void     remove_surface(Surface* surface);
+    void     add_damage(Compositing::Rect rect);
+    void     compose_rect(const Compositing::Rect& rect);
+
+private:
+    uint32_t* m_framebuffer{ nullptr };
+    uint32_t  m_width{ 0 };
+    uint32_t  m_height{ 0 };
+    uint32_t  m_framebuffer_stride{ 0 };
+    uint32_t* m_back_buffer{ nullptr };
+
+    Surface  m_surfaces[COMPOSITOR_MAX_SURFACES]{};
+    uint32_t m_surfaces_count{ 0 };
+    uint32_t m_next_surface_id{ 1 };
+
+    Compositing::Rect m_damage_rects[COMPOSITOR_MAX_DAMAGE_RECTS]{};
+    uint32_t          m_damage_count{ 0 };
+
+    uint64_t m_composed_frames{ 0 };
+    uint32_t m_frame_time_histogram[COMPOSITING_FRAME_TIME_BUCKETS]{};
+};
@@ -0,0 +1,76 @@
+/**
+ * @brief
+ * This file is part of the MeetiX Operating System.
+ * Copyright (c) 2017-2022, Marco Cicognani (marco.cicognani@meetixos.org)
+ *
+ * @developers
+ * Marco Cicognani (marco.cicognani@meetixos.org)
+ *
+ * @license
+ * GNU General Public License version 3
+ */
+
+#include "ModeTable.hh"
+
+bool ModeTable::add_mode(uint16_t number, const ModeInfoBlock& mode_info) {
+    if ( m_count == VIDEO_MAX_MODES )
+        return false;
+
+    // Must be supported by hardware
+    if ( (mode_info.modeAttributes & 0x1) != 0x1 )
+        return false;
+
+    // Need LFB support
+    if ( (mode_info.modeAttributes & 0x90) != 0x90 )
+        return false;
+
+    // Need direct color mode
+    if ( mode_info.memoryModel != 6 )
+        return false;
+
+    auto& mode                = m_modes[m_count++];
+    mode.m_number             = number;
+    mode.m_width              = mode_info.resolutionX;
+    mode.m_height             = mode_info.resolutionY;
+    mode.m_bpp                = mode_info.bpp;
+    mode.m_bytes_per_scanline = mode_info.linBytesPerScanline;
+    mode.m_lfb_physical_base  = mode_info.lfbPhysicalBase;
+    return true;
+}
+
+const VbeMode* ModeTable::find_best(uint32_t wanted_width, uint32_t wanted_height, uint32_t wanted_bpp) const {
+    const VbeMode* best_mode            = nullptr;
+    uint32_t       best_depth_diff      = -1;
+    uint32_t       best_resolution_diff = -1;
+    uint32_t       wanted_resolution    = wanted_width * wanted_height;
+
+    for ( uint32_t i = 0; i < m_count; ++i ) {
+        auto const& mode = m_modes[i];
+
+        uint32_t resolution = mode.m_width * mode.m_height;
+        uint32_t resolution_diff
+            = (resolution > wanted_resolution) ? (resolution - wanted_resolution) : (wanted_resolution - resolution);
+        uint32_t depth_diff = (mode.m_bpp > wanted_bpp) ? (mode.m_bpp - wanted_bpp) : (wanted_bpp - mode.m_bpp);
+
+        if ( resolution_diff < best_resolution_diff
+             || (resolution_diff == best_resolution_diff && depth_diff < best_depth_diff) ) {
+            best_mode            = &mode;
+            best_depth_diff      = depth_diff;
+            best_resolution_diff = resolution_diff;
+
+            // Break on perfect match
+            if ( depth_diff == 0 && resolution_diff == 0 )
+                break;
+        }
+    }
+    return best_mode;
+}
+
+void ModeTable::list_modes(VideoModes::ListModesResponse& response) const {
+    response.m_modes_count = m_count;
+    for ( uint32_t i = 0; i < m_count; ++i ) {
+        response.m_modes[i].m_width         = m_modes[i].m_width;
+        response.m_modes[i].m_height        = m_modes[i].m_height;
+        response.m_modes[i].m_bit_per_pixel = m_modes[i].m_bpp;
+    }
+}
@@ -0,0 +1,62 @@
+/**
+ * @brief
+ * This file is part of the MeetiX Operating System.
+ * Copyright (c) 2017-2022, Marco Cicognani (marco.cicognani@meetixos.org)
+ *
+ * @developers
+ * Marco Cicognani (marco.cicognani@meetixos.org)
+ *
+ * @license
+ * GNU General Public License version 3
+ */
+
+#pragma once
+
+#include "Video.hpp"
+#include "VideoModes.hh"
+
+#include <stdint.h>
+
+/**
+ * @brief Usable VBE mode, with the informations needed to enable it and to map its framebuffer
+ */
+struct VbeMode {
+    uint16_t m_number;
+    uint16_t m_width;
+    uint16_t m_height;
+    uint8_t  m_bpp;
+    uint16_t m_bytes_per_scanline;
+    uint32_t m_lfb_physical_base;
+};
+
+/**
+ * @brief Modes enumerated once from the BIOS, every VM86 call costs a round-trip through the kernel monitor, so the
+ * mode switches look for the wanted mode here and do only the call which enables it
+ */
+class ModeTable {
+public:
+    /**
+     * @brief Keeps the mode when the hardware supports it with a linear framebuffer and direct colors
+     * @return Whether the mode was kept
+     */
+    bool add_mode(uint16_t number, const ModeInfoBlock& mode_info);
+
+    /**
+     * @brief Returns the mode nearest to the wanted resolution, then to the wanted depth, or nullptr when the
+     * table is empty
+     */
+    const VbeMode* find_best(uint32_t wanted_width, uint32_t wanted_height, uint32_t wanted_bpp) const;
+
+    /**
+     * @brief Fills the response to the clients with the kept modes
+     */
+    void list_modes(VideoModes::ListModesResponse& response) const;
+
+    uint32_t count() const {
+        return m_count;
+    }
+
+private:
+    VbeMode  m_modes[VIDEO_MAX_MODES]{};
+    uint32_t m_count{ 0 };
+};
@@ -24,6 +24,10 @@
 
 #include "Video.hpp"
 
+#include "Compositor.hh"
+#include "ModeTable.hh"
+
+#include <Api/Memory.h>
 #include <LibGraphics/Video.hh>
 #include <sstream>
 #include <stdint.h>
@@ -31,6 +35,35 @@
 #include <string.h>
 #include <LibUtils/Utils.hh>
 
+/**
+ * Compositor of the current video mode, nullptr when the mode is not 32 bits.
+ * The message thread and the compositor thread access it under compositorLock
+ */
+Compositor* compositor     = nullptr;
+bool        compositorLock = false;
+Tid         compositorTid  = -1;
+
+/**
+ * Interval of the checks for the surfaces of the exited clients
+ */
+#define COMPOSITOR_RELEASE_MILLIS 1000
+
+/**
+ * Modes enumerated at the start of the driver
+ */
+ModeTable modeTable;
+
+/**
+ * Largest request received by the driver
+ */
+template<typename T, typename... Ts>
+constexpr size_t largestRequest() {
+    if constexpr ( sizeof...(Ts) == 0 )
+        return sizeof(T);
+    else
+        return sizeof(T) > largestRequest<Ts...>() ? sizeof(T) : largestRequest<Ts...>();
+}
+
 /**
  *
  */
@@ -94,8 +127,7 @@ bool setVideoMode(uint32_t mode, bool flatFrameBuffer) {
 /**
  *
  */
-bool setVideoMode(uint32_t wantedWidth, uint32_t wantedHeight, uint32_t wantedBpp, VesaVideoInfo& result) {
-    bool successful  = false;
+bool loadModeTable() {
     bool debugOutput = false;
 
     // Get VBE mode info
@@ -109,11 +141,6 @@ bool setVideoMode(uint32_t wantedWidth, uint32_t wantedHeight, uint32_t wantedBp
         // Load modes
         ModeInfoBlock* modeInfoBlock = (ModeInfoBlock*)s_lower_malloc(VBE_MODE_INFO_BLOCK_SIZE);
 
-        uint32_t bestMatchingMode        = 0;
-        uint32_t bestFoundDepthDiff      = -1;
-        uint32_t bestFoundResolutionDiff = -1;
-        uint32_t wantedResolution        = wantedWidth * wantedHeight;
-
         Utils::log("farptr: %d, seg: %d, off: %d, linear: %d",
                    vbeInfoBlock->videoModeFarPtr,
                    FAR_PTR_SEGMENT(vbeInfoBlock->videoModeFarPtr),
@@ -144,67 +171,7 @@ bool setVideoMode(uint32_t wantedWidth, uint32_t wantedHeight, uint32_t wantedBp
                            modeInfoBlock->lfbPhysicalBase);
             }
 
-            // Must be supported by hardware
-            if ( (modeInfoBlock->modeAttributes & 0x1) != 0x1 )
-                continue;
-
-            // Need LFB support
-            if ( (modeInfoBlock->modeAttributes & 0x90) != 0x90 )
-                continue;
-
-            // Need direct color mode
-            if ( modeInfoBlock->memoryModel != 6 )
-                continue;
-
-            // Check if it's matching better
-            uint32_t resolution = modeInfoBlock->resolutionX * modeInfoBlock->resolutionY;
-            uint32_t resolutionDiff
-                = (resolution > wantedResolution) ? (resolution - wantedResolution) : (wantedResolution - resolution);
-            uint32_t depthDiff = (modeInfoBlock->bpp > wantedBpp) ? (modeInfoBlock->bpp - wantedBpp)
-                                                                  : (wantedBpp - modeInfoBlock->bpp);
-
-            if ( resolutionDiff < bestFoundResolutionDiff
-                 || (resolutionDiff == bestFoundResolutionDiff && depthDiff < bestFoundDepthDiff) ) {
-                bestMatchingMode        = mode;
-                bestFoundDepthDiff      = depthDiff;
-                bestFoundResolutionDiff = resolutionDiff;
-
-                if ( debugOutput ) {
-                    Utils::log("vbe: updated best matching mode to %ix%ix%i",
-                               modeInfoBlock->resolutionX,
-                               modeInfoBlock->resolutionY,
-                               modeInfoBlock->bpp);
-                }
-
-                // Break on perfect match
-                if ( depthDiff == 0 && resolutionDiff == 0 )
-                    break;
-            }
-        }
-
-        // If a matching mode was found
-        if ( bestMatchingMode != 0 ) {
-            // Enable the best matching mode
-            Utils::log("performing mode switch to %i", bestMatchingMode);
-            if ( setVideoMode(bestMatchingMode, true) ) {
-                // Reload mode info into buffer
-                bool couldReloadModeInfo = loadModeInfo(bestMatchingMode, modeInfoBlock);
-
-                // Reloading successful?
-                if ( couldReloadModeInfo ) {
-                    // Create MMIO mapping
-                    void* area = s_map_mmio((void*)modeInfoBlock->lfbPhysicalBase,
-                                            modeInfoBlock->linBytesPerScanline * modeInfoBlock->resolutionY);
-
-                    // Write out
-                    result.resolutionX      = modeInfoBlock->resolutionX;
-                    result.resolutionY      = modeInfoBlock->resolutionY;
-                    result.bpp              = modeInfoBlock->bpp;
-                    result.bytesPerScanline = modeInfoBlock->linBytesPerScanline;
-                    result.lfb              = area;
-                    successful              = true;
-                }
-            }
+            modeTable.add_mode(mode, *modeInfoBlock);
         }
 
         s_lower_free(modeInfoBlock);
@@ -212,7 +179,35 @@ bool setVideoMode(uint32_t wantedWidth, uint32_t wantedHeight, uint32_t wantedBp
 
     s_lower_free(vbeInfoBlock);
 
-    return successful;
+    Utils::log("enumerated %i usable video modes", modeTable.count());
+    return modeTable.count() > 0;
+}
+
+/**
+ *
+ */
+bool setVideoMode(uint32_t wantedWidth, uint32_t wantedHeight, uint32_t wantedBpp, VesaVideoInfo& result) {
+    const VbeMode* mode = modeTable.find_best(wantedWidth, wantedHeight, wantedBpp);
+    if ( !mode )
+        return false;
+
+    // Enable the best matching mode, the only VM86 call of the switch
+    Utils::log("performing mode switch to %i", mode->m_number);
+    if ( !setVideoMode(mode->m_number, true) )
+        return false;
+
+    // Create MMIO mapping, write-combining to burst the blits to the video memory
+    void* area = s_map_mmio_f((void*)mode->m_lfb_physical_base,
+                              mode->m_bytes_per_scanline * mode->m_height,
+                              MMIO_FLAG_WRITE_COMBINING);
+
+    // Write out
+    result.resolutionX      = mode->m_width;
+    result.resolutionY      = mode->m_height;
+    result.bpp              = mode->m_bpp;
+    result.bytesPerScanline = mode->m_bytes_per_scanline;
+    result.lfb              = area;
+    return true;
 }
 
 /**
@@ -224,9 +219,19 @@ int main() {
         return -1;
     }
 
+    // ask the BIOS for the modes only once, each VM86 call is slow and serializes the kernel
+    if ( !loadModeTable() )
+        Utils::log("no usable video mode found");
+
     Utils::log("vesa initialized");
 
-    size_t  buflen = sizeof(MessageHeader) + sizeof(Graphics::Video::SetModeRequest);
+    size_t buflen = sizeof(MessageHeader)
+                  + largestRequest<Graphics::Video::SetModeRequest,
+                                   Compositing::CreateSurfaceRequest,
+                                   Compositing::SubmitSurfaceRequest,
+                                   Compositing::DestroySurfaceRequest,
+                                   Compositing::FrameStatsRequest,
+                                   VideoModes::ListModesRequest>();
     uint8_t buf[buflen];
 
     while ( true ) {
@@ -253,8 +258,9 @@ int main() {
             uint8_t       bpp  = request->m_bit_per_pixel;
 
             Utils::log("attempting to set video mode");
+            uint64_t switchStart = s_millis();
             if ( setVideoMode(resX, resY, bpp, result) ) {
-                Utils::log("changed video mode to %ix%ix%i", resX, resY, bpp);
+                Utils::log("changed video mode to %ix%ix%i in %i ms", resX, resY, bpp, (uint32_t)(s_millis() - switchStart));
                 uint32_t lfbSize                  = result.bytesPerScanline * result.resolutionY;
                 void*    addressInRequestersSpace = s_share_mem(result.lfb, lfbSize, requester);
 
@@ -265,6 +271,8 @@ int main() {
                 response.m_mode_info.m_bit_per_pixel      = (uint8_t)result.bpp;
                 response.m_mode_info.m_bytes_per_scanline = (uint16_t)result.bytesPerScanline;
 
+                // the surfaces of the previous mode don't fit the new one
+                setupCompositor(result);
             }
 
             else {
@@ -279,6 +287,16 @@ int main() {
                              header->m_transaction);
         }
 
+        else if ( *(uint32_t*)MESSAGE_CONTENT(buf) == VIDEO_COMMAND_LIST_MODES ) {
+            VideoModes::ListModesResponse response{};
+            modeTable.list_modes(response);
+            s_send_message_t(header->m_sender_tid, &response, sizeof(response), header->m_transaction);
+        }
+
+        else if ( handleCompositingRequest(header, MESSAGE_CONTENT(buf)) ) {
+            // handled by the compositor
+        }
+
         else {
             std::stringstream ukn;
             ukn << "received unknown command " << vbeheader->m_command << " from task " << header->m_sender_tid;
@@ -288,3 +306,125 @@ int main() {
 
     return 0;
 }
+
+/**
+ *
+ */
+void setupCompositor(const VesaVideoInfo& videoInfo) {
+    s_atomic_lock(&compositorLock);
+
+    delete compositor;
+    compositor = nullptr;
+
+    if ( videoInfo.bpp == 32 ) {
+        compositor = new Compositor((uint32_t*)videoInfo.lfb,
+                                    videoInfo.resolutionX,
+                                    videoInfo.resolutionY,
+                                    videoInfo.bytesPerScanline / sizeof(uint32_t));
+        if ( !compositor->is_valid() ) {
+            Utils::log("failed to allocate the compositor back buffer");
+            delete compositor;
+            compositor = nullptr;
+        }
+    } else
+        Utils::log("compositing is available only on 32 bits modes");
+
+    compositorLock = false;
+
+    if ( compositor && compositorTid == -1 )
+        compositorTid = s_create_thread_n((void*)compositorThread, "compositor");
+}
+
+/**
+ *
+ */
+void compositorThread() {
+    uint64_t lastRelease = s_millis();
+    while ( true ) {
+        uint64_t frameStart = s_millis();
+
+        s_atomic_lock(&compositorLock);
+        // the clients which exit without destroying their surfaces leave them to us
+        if ( compositor && frameStart - lastRelease >= COMPOSITOR_RELEASE_MILLIS ) {
+            compositor->release_dead_clients(isProcessAlive);
+            lastRelease = frameStart;
+        }
+        if ( compositor && compositor->compose_frame() )
+            compositor->record_frame_time(s_millis() - frameStart);
+        compositorLock = false;
+
+        // keep a fixed cadence, like a vertical blank
+        uint64_t frameTime = s_millis() - frameStart;
+        if ( frameTime < COMPOSITING_FRAME_MILLIS )
+            s_sleep(COMPOSITING_FRAME_MILLIS - frameTime);
+    }
+}
+
+/**
+ *
+ */
+bool isProcessAlive(Pid pid) {
+    ProcessDescriptor descriptor;
+    return s_get_process_descriptor(pid, &descriptor);
+}
+
+/**
+ *
+ */
+bool handleCompositingRequest(MessageHeader* header, void* content) {
+    uint32_t command = *(uint32_t*)content;
+    if ( command < COMPOSITING_COMMAND_CREATE_SURFACE || command > COMPOSITING_COMMAND_FRAME_STATS )
+        return false;
+
+    Pid requesterPid = s_get_pid_for_tid(header->m_sender_tid);
+    s_atomic_lock(&compositorLock);
+
+    if ( command == COMPOSITING_COMMAND_CREATE_SURFACE ) {
+        auto request = (Compositing::CreateSurfaceRequest*)content;
+
+        Compositing::CreateSurfaceResponse response{};
+        if ( compositor ) {
+            auto surface = compositor->create_surface(requesterPid, request->m_bounds, request->m_opaque);
+            if ( surface ) {
+                uint32_t bufferSize = surface->m_bounds.m_width * surface->m_bounds.m_height * sizeof(uint32_t);
+
+                response.m_successful = true;
+                response.m_surface_id = surface->m_id;
+                response.m_stride     = surface->m_bounds.m_width;
+                for ( int i = 0; i < 2; ++i )
+                    response.m_buffers[i] = (uint32_t*)s_share_mem(surface->m_buffers[i], bufferSize, requesterPid);
+            }
+        }
+        s_send_message_t(header->m_sender_tid, &response, sizeof(response), header->m_transaction);
+    }
+
+    else if ( command == COMPOSITING_COMMAND_SUBMIT_SURFACE ) {
+        auto request = (Compositing::SubmitSurfaceRequest*)content;
+
+        // the reply tells the client which buffer the composition doesn't read anymore
+        Compositing::SubmitSurfaceResponse response{};
+        response.m_successful = compositor
+                             && compositor->submit_surface(requesterPid,
+                                                           request->m_surface_id,
+                                                           request->m_buffer,
+                                                           request->m_damage,
+                                                           response.m_next_buffer);
+        s_send_message_t(header->m_sender_tid, &response, sizeof(response), header->m_transaction);
+    }
+
+    else if ( command == COMPOSITING_COMMAND_DESTROY_SURFACE ) {
+        auto request = (Compositing::DestroySurfaceRequest*)content;
+        if ( compositor )
+            compositor->destroy_surface(requesterPid, request->m_surface_id);
+    }
+
+    else {
+        Compositing::FrameStatsResponse response{};
+        if ( compositor )
+            compositor->frame_stats(response);
+        s_send_message_t(header->m_sender_tid, &response, sizeof(response), header->m_transaction);
+    }
+
+    compositorLock = false;
+    return true;
+}
@@ -124,4 +124,42 @@ struct VesaVideoInfo {
     void*    lfb;
 };
 
+/**
+ * Enumerates once the modes of the BIOS into the mode table
+ *
+ * @return whether at least a usable mode was found
+ */
+bool loadModeTable();
+
+/**
+ * Creates the compositor for the given video mode, and starts the thread which
+ * composes the frames the first time
+ *
+ * @param videoInfo:	the enabled video mode
+ */
+void setupCompositor(const VesaVideoInfo& videoInfo);
+
+/**
+ * Composes a frame each COMPOSITING_FRAME_MILLIS when something was damaged,
+ * and each COMPOSITOR_RELEASE_MILLIS releases the surfaces of the exited clients
+ */
+void compositorThread();
+
+/**
+ * Tells whether the process still exists
+ *
+ * @param pid:		the id of the process
+ * @return whether the process exists
+ */
+bool isProcessAlive(Pid pid);
+
+/**
+ * Handles the requests of the compositing API
+ *
+ * @param header:	the header of the received message
+ * @param content:	the content of the received message
+ * @return whether the message was a compositing request
+ */
+bool handleCompositingRequest(MessageHeader* header, void* content);
+
 #endif
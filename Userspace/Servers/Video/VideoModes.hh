@@ -0,0 +1,45 @@
+/**
+ * @brief
+ * This file is part of the MeetiX Operating System.
+ * Copyright (c) 2017-2022, Marco Cicognani (marco.cicognani@meetixos.org)
+ *
+ * @developers
+ * Marco Cicognani (marco.cicognani@meetixos.org)
+ *
+ * @license
+ * GNU General Public License version 3
+ */
+
+#pragma once
+
+#include <stdint.h>
+
+/**
+ * @brief Lists the video modes enumerated by the driver at its start, so the clients choose among the real ones
+ * without asking the BIOS. The value doesn't clash with the other commands of the driver
+ */
+#define VIDEO_COMMAND_LIST_MODES 0x110
+
+/**
+ * @brief Modes kept by the driver, the others are not listed nor settable
+ */
+#define VIDEO_MAX_MODES 128
+
+namespace VideoModes {
+
+struct Mode {
+    uint16_t m_width;
+    uint16_t m_height;
+    uint8_t  m_bit_per_pixel;
+};
+
+struct ListModesRequest {
+    uint32_t m_command;
+};
+
+struct ListModesResponse {
+    uint32_t m_modes_count;
+    Mode     m_modes[VIDEO_MAX_MODES];
+};
+
+} /* namespace VideoModes */
@@ -0,0 +1,167 @@
+/**
+ * @brief
+ * This file is part of the MeetiX Operating System.
+ * Copyright (c) 2017-2022, Marco Cicognani (marco.cicognani@meetixos.org)
+ *
+ * @developers
+ * Marco Cicognani (marco.cicognani@meetixos.org)
+ *
+ * @license
+ * GNU General Public License version 3
+ */
+
+#include <CCLang/Alloc/ArenaAllocator.hh>
+#include <CCLang/Alloc/List.hh>
+#include <CCLang/Alloc/Map.hh>
+#include <CCLang/Alloc/PoolAllocator.hh>
+#include <CCLang/Alloc/String.hh>
+#include <CCLang/Alloc/Vector.hh>
+#include <CCLang/Lang/Cxx.hh>
+#include <LibUnitTest/Assertions.hh>
+#include <LibUnitTest/Case.hh>
+
+template<typename TContainer>
+auto container_in(Allocator* allocator) -> TContainer {
+    if ( allocator != nullptr ) {
+        return TContainer::with_allocator(*allocator);
+    } else {
+        return TContainer::empty();
+    }
+}
+
+/**
+ * @brief Request-scoped workload: splits a command line, collects the options and keeps a copy of the arguments
+ */
+auto parse_then_discard(StringView command_line, Allocator* allocator) -> usize {
+    auto arguments        = container_in<Vector<StringView>>(allocator);
+    auto options          = container_in<Map<StringView, StringView>>(allocator);
+    auto arguments_copies = container_in<List<String>>(allocator);
+
+    usize token_start = 0;
+    while ( token_start < command_line.len() ) {
+        auto const token_end = command_line.find(' ', token_start).unwrap_or(command_line.len());
+        auto const token     = command_line.sub_string_view(token_start, token_end - token_start);
+        token_start          = token_end + 1;
+
+        auto const equal_index = token.find('=').unwrap_or(token.len());
+        if ( token.starts_with("--"sv) && equal_index < token.len() ) {
+            options.insert(token.sub_string_view(2, equal_index - 2), token.sub_string_view(equal_index + 1));
+        } else {
+            arguments.append(token);
+            if ( allocator != nullptr ) {
+                arguments_copies.append(String::from_view(token, *allocator));
+            } else {
+                arguments_copies.append(String::from_view(token));
+            }
+        }
+    }
+
+    return arguments.count() + options.count() + arguments_copies.count();
+}
+
+auto const C_COMMAND_LINE = "/Apps/Terminal/Terminal.app --cols=80 --rows=25 --font=Mono --shell=/Bins/MxSh/MxSh.app /Users/Root/Workspace"sv;
+
+TEST_CASE(arena_serves_containers_from_one_chunk) {
+    auto arena = ArenaAllocator::empty();
+
+    for ( auto const _ : usize::range(0, 100) ) {
+        verify_equal$(parse_then_discard(C_COMMAND_LINE, &arena), 8);
+        arena.reset();
+    }
+
+    verify_greater$(arena.allocations_count(), 100);
+    verify_equal$(arena.chunk_allocations_count(), 1);
+}
+
+TEST_CASE(arena_reset_gives_back_clean_memory) {
+    auto arena = ArenaAllocator::with_chunk_size(256);
+
+    auto const first_ptr = static_cast<char*>(arena.try_alloc(64).unwrap());
+    Cxx::memset(first_ptr, 0xaa, 64);
+    arena.reset();
+
+    auto const second_ptr = static_cast<char*>(arena.try_alloc(64).unwrap());
+    verify_equal$(first_ptr, second_ptr);
+    for ( auto const i : usize::range(0, 64) ) {
+        verify_equal$(second_ptr[i.unwrap()], 0);
+    }
+}
+
+TEST_CASE(arena_rolls_back_the_last_allocation) {
+    auto arena = ArenaAllocator::empty();
+
+    auto const first_ptr = arena.try_alloc(32).unwrap();
+    arena.dealloc(first_ptr, 32);
+    verify_equal$(arena.try_alloc(16).unwrap(), first_ptr);
+}
+
+TEST_CASE(arena_allocations_bigger_than_the_chunk) {
+    auto arena = ArenaAllocator::with_chunk_size(128);
+
+    auto vector = Vector<u32>::with_allocator(arena);
+    for ( auto const i : u32::range(0, 1000) ) {
+        vector.append(i);
+    }
+
+    verify_equal$(vector.count(), 1000);
+    verify_equal$(vector.last(), 999);
+}
+
+TEST_CASE(pool_recycles_list_nodes) {
+    auto pool = PoolAllocator::for_type<List<i32>::Node>(64);
+    auto list = List<i32>::with_allocator(pool);
+
+    for ( auto const _ : usize::range(0, 2) ) {
+        for ( auto const i : i32::range(0, 100) ) {
+            list.append(i);
+        }
+        list.erase_if([](i32 const& value) { return value % 2 == 0; });
+        verify_equal$(list.count(), 50);
+        list.clear();
+    }
+
+    verify_equal$(pool.allocations_count(), 200);
+    verify_equal$(pool.slab_allocations_count(), 2);
+    verify_equal$(pool.fallback_allocations_count(), 0);
+}
+
+TEST_CASE(pool_forwards_bigger_requests) {
+    auto pool = PoolAllocator::with_block_size(16);
+
+    auto const big_ptr = pool.try_alloc(64).unwrap();
+    pool.dealloc(big_ptr, 64);
+
+    verify_equal$(pool.allocations_count(), 0);
+    verify_equal$(pool.slab_allocations_count(), 0);
+    verify_equal$(pool.fallback_allocations_count(), 1);
+}
+
+BENCHMARK_CASE(one_hundred_thousand_parses_on_global_heap) {
+    for ( auto const _ : usize::range(0, 100'000) ) {
+        verify_equal$(parse_then_discard(C_COMMAND_LINE, nullptr), 8);
+    }
+}
+
+BENCHMARK_CASE(one_hundred_thousand_parses_on_arena) {
+    auto arena = ArenaAllocator::empty();
+    for ( auto const _ : usize::range(0, 100'000) ) {
+        verify_equal$(parse_then_discard(C_COMMAND_LINE, &arena), 8);
+        arena.reset();
+    }
+
+    /* one heap allocation against the hundreds of thousands served by the arena */
+    verify_equal$(arena.chunk_allocations_count(), 1);
+}
+
+BENCHMARK_CASE(one_hundred_thousand_list_appends_on_pool) {
+    auto pool = PoolAllocator::for_type<List<u32>::Node>();
+    auto list = List<u32>::with_allocator(pool);
+    for ( auto const i : u32::range(0, 100'000) ) {
+        list.append(i);
+        if ( list.count() == 64 ) {
+            list.clear();
+        }
+    }
+
+    verify_equal$(pool.slab_allocations_count(), 1);
+}
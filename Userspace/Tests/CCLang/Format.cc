@@ -25,6 +25,14 @@ void ensure_formatted(StringView expected_result, StringView format_view, Args..
     verify_equal$(string_builder.as_string_view(), expected_result);
 }
 
+template<typename... Args>
+void ensure_literal_formatted(StringView expected_result, FormatString<TypeIdentity<Args>...> format_string, Args... args) {
+    auto string_builder = StringBuilder::empty();
+
+    verify_is_value$(format(string_builder, format_string, args...));
+    verify_equal$(string_builder.as_string_view(), expected_result);
+}
+
 TEST_CASE(string_format) {
     ensure_formatted("Caught nullptr Exception at yz"sv, "Caught {} {} at {}{}"sv, nullptr, "Exception"sv, 'y', 'z');
 }
@@ -144,8 +152,11 @@ TEST_CASE(no_precision_no_trailing_number) {
     ensure_formatted("0"sv, "{:.0}"sv, 0.1);
 }
 
-TEST_CASE(yay_this_implementation_sucks) {
-    ensure_formatted("0"sv, "{:.0}"sv, 0.99999999999);
+TEST_CASE(precision_rounds_to_nearest) {
+    ensure_formatted("1"sv, "{:.0}"sv, 0.99999999999);
+    ensure_formatted("0.13"sv, "{:.2}"sv, 0.125);
+    ensure_formatted("10"sv, "{:.1}"sv, 9.96);
+    ensure_formatted("0"sv, "{:.2}"sv, 0.0004);
 }
 
 TEST_CASE(precision_with_trailing_zeros) {
@@ -158,6 +169,20 @@ TEST_CASE(magnitude_less_than_zero) {
     ensure_formatted("0.654"sv, "{}"sv, 0.654);
 }
 
+TEST_CASE(shortest_round_trip_format) {
+    ensure_formatted("0.1"sv, "{}"sv, 0.1);
+    ensure_formatted("0.3333333333333333"sv, "{}"sv, 1.0 / 3.0);
+    ensure_formatted("0.30000000000000004"sv, "{}"sv, 0.1 + 0.2);
+    ensure_formatted("123456789012345680000"sv, "{}"sv, 123456789012345678901.0);
+    ensure_formatted("0.000001"sv, "{}"sv, 1e-6);
+    ensure_formatted("0"sv, "{}"sv, 0.0);
+    ensure_formatted("+2.5"sv, "{:+}"sv, 2.5);
+    ensure_formatted("1.1"sv, "{}"sv, 1.1f);
+    ensure_formatted("0.3"sv, "{}"sv, 0.3f);
+    ensure_formatted("16777216"sv, "{}"sv, 16777216.0f);
+    ensure_formatted("  -0.25"sv, "{:>7}"sv, -0.25f);
+}
+
 TEST_CASE(list_format) {
     auto const list = List<i32>::from_list({ 1, 2, 3, 4, 5, 6 });
     ensure_formatted("[ 1, 2, 3, 4, 5, 6 ]"sv, "{}"sv, list.clone());
@@ -171,4 +196,100 @@ TEST_CASE(range_format) {
 TEST_CASE(map_format) {
     auto const unordered_map = OrderedMap<StringView, usize>::from_list({ { "z"sv, 1 }, { "y"sv, 2 }, { "x"sv, 3 } });
     ensure_formatted("{ z: 1, y: 2, x: 3 }"sv, "{}"sv, unordered_map.clone());
-}
\ No newline at end of file
+}
+TEST_CASE(compile_time_format_string) {
+    ensure_literal_formatted("Caught nullptr Exception at yz"sv, "Caught {} {} at {}{}", nullptr, "Exception"sv, 'y', 'z');
+    ensure_literal_formatted("no placeholders"sv, "no placeholders");
+    ensure_literal_formatted(""sv, "");
+    ensure_literal_formatted("{abc}"sv, "{{{}}}", "abc"sv);
+    ensure_literal_formatted("{0042/foo/      42/foo"sv, "{{{:04}/{}/{:8}/{}", 42u, "foo"sv, 42u, "foo"sv);
+    ensure_literal_formatted("0X000000FF"sv, "{:#08X}", 0xff);
+    ensure_literal_formatted("** 13***"sv, "{:*^ 8}", 13);
+    ensure_literal_formatted("42        "sv, "{: <010}", 42);
+    ensure_literal_formatted("  abcd   "sv, "{:^9}", "abcd"sv);
+    ensure_literal_formatted("abcdef"sv, "{:4.6}", "abcdefghi"sv);
+    ensure_literal_formatted("a"sv, "{:c}", static_cast<i32>('a'));
+    ensure_literal_formatted("1.120"sv, "{:0.3}", 1.12);
+    ensure_literal_formatted("[ 1, 2, 3 ]"sv, "{}", List<i32>::from_list({ 1, 2, 3 }));
+}
+
+TEST_CASE(compile_time_format_string_display_as) {
+    ensure_literal_formatted("42"sv, "{}", 42);
+    ensure_literal_formatted("0b101"sv, "{:#b}", 5);
+    ensure_literal_formatted("0B101"sv, "{:#B}", 5);
+    ensure_literal_formatted("0744"sv, "{:#o}", 0744);
+    ensure_literal_formatted("1"sv, "{:d}", true);
+    ensure_literal_formatted("ff"sv, "{:x}", 0xff);
+    ensure_literal_formatted("FF"sv, "{:X}", 0xff);
+    ensure_literal_formatted("a"sv, "{:c}", static_cast<u32>('a'));
+    ensure_literal_formatted("abcd  "sv, "{:6s}", "abcd"sv);
+    ensure_literal_formatted("1.500"sv, "{:0.3f}", 1.5);
+    ensure_literal_formatted("ff"sv, "{:a}", 255.0);
+    ensure_literal_formatted("FF"sv, "{:A}", 255.0);
+    ensure_literal_formatted("+7"sv, "{:+}", 7);
+    ensure_literal_formatted(" 7"sv, "{: }", 7);
+
+    auto ptr = Cxx::bit_cast<void*>(0x4000);
+    if ( sizeof(usize) == 4 )
+        ensure_literal_formatted("0x00004000"sv, "{:p}", ptr);
+    else if ( sizeof(usize) == 8 )
+        ensure_literal_formatted("0x0000000000004000"sv, "{:p}", ptr);
+}
+
+TEST_CASE(compile_time_format_string_layout) {
+    FormatString<u32, StringView> const format_string{ "id: {:#08x} name: {:>12}!" };
+
+    verify_equal$(format_string.literal_view(0), "id: "sv);
+    verify_equal$(format_string.literal_view(1), " name: "sv);
+    verify_equal$(format_string.literal_view(2), "!"sv);
+
+    auto const id_result = format_string.placeholder(0).as_parser_result();
+    verify_equal$(id_result.m_display_as, FormatParser::DisplayAs::Hex);
+    verify_equal$(id_result.m_show_base, FormatParser::ShowBase::Yes);
+    verify_equal$(id_result.m_zero_pad, FormatParser::ZeroPad::Yes);
+    verify_is_present_equal$(id_result.m_width, 8);
+
+    auto const name_result = format_string.placeholder(1).as_parser_result();
+    verify_equal$(name_result.m_alignment, FormatParser::Alignment::Right);
+    verify_is_present_equal$(name_result.m_width, 12);
+    verify_false$(name_result.m_precision.is_present());
+}
+
+TEST_CASE(compile_time_format_string_appended) {
+    auto string_builder = StringBuilder::empty();
+
+    verify_is_value$(format(string_builder, "Hi {}", "john"sv));
+    verify_is_value$(format(string_builder, " I'm your {} friend", "best"sv));
+
+    verify_equal$(string_builder.as_string_view(), "Hi john I'm your best friend"sv);
+}
+
+BENCHMARK_CASE(one_hundred_thousand_shortest_floating_formats) {
+    auto value = 0.1;
+    for ( auto const _ : usize::range(0, 100'000) ) {
+        auto string_builder = StringBuilder::empty();
+        verify_is_value$(format(string_builder, "{} {}", value, static_cast<f32>(value)));
+        value *= 1.0001;
+    }
+}
+
+BENCHMARK_CASE(one_hundred_thousand_integral_formats) {
+    for ( auto const i : u64::range(0, 100'000) ) {
+        auto string_builder = StringBuilder::empty();
+        verify_is_value$(format(string_builder, "{} {:x} {:o}", i * 0x1234567u, i, i));
+    }
+}
+
+BENCHMARK_CASE(one_hundred_thousand_runtime_parsed_formats) {
+    for ( auto const _ : usize::range(0, 100'000) ) {
+        auto string_builder = StringBuilder::empty();
+        verify_is_value$(format(string_builder, "{}:{} [{:#08x}] {:>8}"sv, "Spawner"sv, 42u, 0xdeadu, "ready"sv));
+    }
+}
+
+BENCHMARK_CASE(one_hundred_thousand_compile_time_parsed_formats) {
+    for ( auto const _ : usize::range(0, 100'000) ) {
+        auto string_builder = StringBuilder::empty();
+        verify_is_value$(format(string_builder, "{}:{} [{:#08x}] {:>8}", "Spawner"sv, 42u, 0xdeadu, "ready"sv));
+    }
+}
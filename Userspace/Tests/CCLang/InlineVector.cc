@@ -0,0 +1,95 @@
+/**
+ * @brief
+ * This file is part of the MeetiX Operating System.
+ * Copyright (c) 2017-2022, Marco Cicognani (marco.cicognani@meetixos.org)
+ *
+ * @developers
+ * Marco Cicognani (marco.cicognani@meetixos.org)
+ *
+ * @license
+ * GNU General Public License version 3
+ */
+
+#include <CCLang/Alloc/InlineVector.hh>
+#include <CCLang/Alloc/String.hh>
+#include <CCLang/Alloc/Vector.hh>
+#include <CCLang/Lang/Cxx.hh>
+#include <CCLang/Lang/StringView.hh>
+#include <LibUnitTest/Assertions.hh>
+#include <LibUnitTest/Case.hh>
+
+TEST_CASE(default_constructor) {
+    auto const inline_vector = InlineVector<i32, 4>::empty();
+
+    verify$(inline_vector.is_empty());
+    verify$(inline_vector.is_inline());
+    verify_equal$(inline_vector.capacity(), 4);
+}
+
+TEST_CASE(stays_inline_until_the_capacity) {
+    auto inline_vector = InlineVector<i32, 4>::from_list({ 1, 2, 3, 4 });
+    verify$(inline_vector.is_inline());
+    verify_equal$(inline_vector.count(), 4);
+
+    inline_vector.append(5);
+    verify_false$(inline_vector.is_inline());
+    verify_equal$(inline_vector.count(), 5);
+
+    i32 expected = 1;
+    for ( auto const value : inline_vector ) {
+        verify_equal$(value, expected++);
+    }
+
+    inline_vector.clear();
+    verify$(inline_vector.is_inline());
+}
+
+TEST_CASE(move_inline_and_allocated) {
+    auto inline_vector = InlineVector<String, 2>::empty();
+    inline_vector.append(String::from_view("Hello"sv));
+
+    auto moved_inline = Cxx::move(inline_vector);
+    verify$(inline_vector.is_empty());
+    verify_equal$(moved_inline.first(), "Hello"sv);
+
+    moved_inline.append(String::from_view("MeetiX"sv));
+    moved_inline.append(String::from_view("Operating System"sv));
+    verify_false$(moved_inline.is_inline());
+
+    auto moved_allocated = Cxx::move(moved_inline);
+    verify$(moved_inline.is_inline());
+    verify_equal$(moved_allocated.count(), 3);
+    verify_equal$(moved_allocated.last(), "Operating System"sv);
+}
+
+TEST_CASE(erase_and_take_last) {
+    auto inline_vector = InlineVector<String, 4>::empty();
+    inline_vector.append(String::from_view("a"sv));
+    inline_vector.append(String::from_view("b"sv));
+    inline_vector.append(String::from_view("c"sv));
+
+    verify_is_value$(inline_vector.erase_at(0));
+    verify_equal$(inline_vector.first(), "b"sv);
+    verify_equal$(inline_vector.take_last(), "c"sv);
+    verify_equal$(inline_vector.count(), 1);
+}
+
+BENCHMARK_CASE(one_hundred_thousand_short_sequences_on_vector) {
+    for ( auto const i : usize::range(0, 100'000) ) {
+        auto vector = Vector<usize>::empty();
+        for ( auto const j : usize::range(0, 6) ) {
+            vector.append(i + j);
+        }
+        verify_equal$(vector.count(), 6);
+    }
+}
+
+BENCHMARK_CASE(one_hundred_thousand_short_sequences_inline) {
+    for ( auto const i : usize::range(0, 100'000) ) {
+        auto inline_vector = InlineVector<usize, 8>::empty();
+        for ( auto const j : usize::range(0, 6) ) {
+            inline_vector.append(i + j);
+        }
+        verify$(inline_vector.is_inline());
+    }
+}
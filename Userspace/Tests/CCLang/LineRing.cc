@@ -0,0 +1,127 @@
+/**
+ * @brief
+ * This file is part of the MeetiX Operating System.
+ * Copyright (c) 2017-2022, Marco Cicognani (marco.cicognani@meetixos.org)
+ *
+ * @developers
+ * Marco Cicognani (marco.cicognani@meetixos.org)
+ *
+ * @license
+ * GNU General Public License version 3
+ */
+
+#include <CCLang/Alloc/LineRing.hh>
+#include <CCLang/Lang/Cxx.hh>
+#include <LibUnitTest/Assertions.hh>
+#include <LibUnitTest/Case.hh>
+
+/* same grid of the headless terminal at 1024x768 */
+static constexpr auto LINE_LEN      = 128;
+static constexpr auto VISIBLE_LINES = 45;
+static constexpr auto HISTORY_LINES = 1000;
+
+static auto write_line(Slice<char> line, usize line_index) -> void {
+    auto const first_char = (line_index % 95).unwrap();
+    for ( auto x = 0u; x < line.len().unwrap(); ++x ) {
+        line.data()[x] = static_cast<char>((first_char + x) % 95 + 32);
+    }
+}
+
+TEST_CASE(default_constructor) {
+    auto const line_ring = LineRing<char>::empty();
+    verify$(line_ring.is_empty());
+}
+
+TEST_CASE(invalid_size) {
+    verify$(LineRing<char>::try_with_size(0, 10, 10, ' ').is_error());
+    verify$(LineRing<char>::try_with_size(10, 0, 10, ' ').is_error());
+}
+
+TEST_CASE(lines_are_blank) {
+    auto line_ring = LineRing<char>::with_size(4, 3, 2, '.');
+    verify_equal$(line_ring.line_len(), 4);
+    verify_equal$(line_ring.visible_lines(), 3);
+    verify_equal$(line_ring.history_capacity(), 2);
+    verify_equal$(line_ring.history_count(), 0);
+
+    for ( auto const y : usize::range(0, 3) ) {
+        for ( auto const c : line_ring.line(y) ) {
+            verify_equal$(c, '.');
+        }
+    }
+}
+
+TEST_CASE(scroll_up_keeps_the_history) {
+    auto line_ring = LineRing<i32>::with_size(2, 2, 3, 0);
+    for ( auto const i : i32::range(1, 10) ) {
+        line_ring.line(1).fill(i);
+        line_ring.scroll_up(0);
+    }
+
+    /* the history stops growing at its capacity */
+    verify_equal$(line_ring.history_count(), 3);
+    verify_equal$(line_ring.line(0).first(), 9);
+    verify_equal$(line_ring.line(1).first(), 0);
+
+    /* the scrolled back view shows the older lines first */
+    verify_equal$(line_ring.line(0, 3).first(), 6);
+    verify_equal$(line_ring.line(1, 3).first(), 7);
+    verify_equal$(line_ring.line(0, 1).first(), 8);
+    verify_equal$(line_ring.line(1, 1).first(), 9);
+}
+
+TEST_CASE(scroll_up_without_history) {
+    auto line_ring = LineRing<i32>::with_size(3, 2, 0, 0);
+    line_ring.line(0).fill(1);
+    line_ring.line(1).fill(2);
+    line_ring.scroll_up(-1);
+
+    verify_equal$(line_ring.history_count(), 0);
+    verify_equal$(line_ring.line(0).last(), 2);
+    verify_equal$(line_ring.line(1).last(), -1);
+}
+
+TEST_CASE(clear_forgets_the_history) {
+    auto line_ring = LineRing<char>::with_size(8, 2, 4, ' ');
+    for ( auto const i : usize::range(0, 5) ) {
+        write_line(line_ring.line(1), i);
+        line_ring.scroll_up(' ');
+    }
+
+    line_ring.clear('x');
+    verify_equal$(line_ring.history_count(), 0);
+    verify_equal$(line_ring.line(0).first(), 'x');
+    verify_equal$(line_ring.line(1).last(), 'x');
+}
+
+TEST_CASE(move_constructor) {
+    auto line_ring = LineRing<char>::with_size(8, 2, 4, ' ');
+    line_ring.line(0).fill('a');
+    line_ring.scroll_up(' ');
+
+    auto moved_ring = Cxx::move(line_ring);
+    verify$(line_ring.is_empty());
+    verify_equal$(moved_ring.history_count(), 1);
+    verify_equal$(moved_ring.line(0, 1).first(), 'a');
+}
+
+BENCHMARK_CASE(one_million_lines_into_line_ring) {
+    auto line_ring = LineRing<char>::with_size(LINE_LEN, VISIBLE_LINES, HISTORY_LINES, ' ');
+    for ( auto const i : usize::range(0, 1'000'000) ) {
+        write_line(line_ring.line(VISIBLE_LINES - 1), i);
+        line_ring.scroll_up(' ');
+    }
+    verify_equal$(line_ring.history_count(), HISTORY_LINES);
+}
+
+BENCHMARK_CASE(one_million_lines_into_memmoved_grid) {
+    static char s_grid[LINE_LEN * VISIBLE_LINES];
+    for ( auto const i : usize::range(0, 1'000'000) ) {
+        write_line(Slice<char>::from_raw_parts(s_grid + LINE_LEN * (VISIBLE_LINES - 1), LINE_LEN), i);
+
+        /* what the terminal did before, the whole grid goes one line up */
+        Cxx::memmove(s_grid, s_grid + LINE_LEN, LINE_LEN * (VISIBLE_LINES - 1));
+        Cxx::memset(s_grid + LINE_LEN * (VISIBLE_LINES - 1), ' ', LINE_LEN);
+    }
+    verify_equal$(s_grid[LINE_LEN * (VISIBLE_LINES - 1)], ' ');
+}
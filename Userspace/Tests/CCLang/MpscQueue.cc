@@ -0,0 +1,94 @@
+/**
+ * @brief
+ * This file is part of the MeetiX Operating System.
+ * Copyright (c) 2017-2022, Marco Cicognani (marco.cicognani@meetixos.org)
+ *
+ * @developers
+ * Marco Cicognani (marco.cicognani@meetixos.org)
+ *
+ * @license
+ * GNU General Public License version 3
+ */
+
+#include <Api.h>
+#include <CCLang/Lang/MpscQueue.hh>
+#include <LibUnitTest/Assertions.hh>
+#include <LibUnitTest/Case.hh>
+
+static constexpr auto PRODUCER_THREADS     = 4;
+static constexpr auto PRODUCER_INDEX_SHIFT = 24;
+
+static MpscQueue<u32, 1024> s_mpsc_queue;
+static usize                s_next_producer_index = 0;
+
+/**
+ * Each producer tags its values with its own index, so the consumer checks the order per producer
+ */
+static void produce_values(void* values_count) {
+    auto const producer_index = s_next_producer_index.atomic_fetch_add(1, MemOrder::Relaxed).as<u32>();
+    for ( auto const i : u32::range(0, reinterpret_cast<usize::NativeInt>(values_count)) ) {
+        while ( !s_mpsc_queue.push(producer_index << PRODUCER_INDEX_SHIFT | i) )
+            s_yield();
+    }
+}
+
+static auto consume_values(u32 values_per_producer) -> bool {
+    u32 next_values[PRODUCER_THREADS] = {};
+    for ( auto const _ : usize::range(0, PRODUCER_THREADS * values_per_producer.unwrap()) ) {
+        auto value_or_none = s_mpsc_queue.pop();
+        while ( !value_or_none.is_present() ) {
+            s_yield();
+            value_or_none = s_mpsc_queue.pop();
+        }
+
+        auto const value          = value_or_none.unwrap();
+        auto const producer_index = (value >> PRODUCER_INDEX_SHIFT).unwrap();
+        if ( producer_index >= PRODUCER_THREADS || (value & 0xffffff) != next_values[producer_index] )
+            return false;
+
+        ++next_values[producer_index];
+    }
+    return s_mpsc_queue.is_empty();
+}
+
+static auto transfer_values(u32 values_per_producer) -> bool {
+    Tid producer_tids[PRODUCER_THREADS];
+
+    s_next_producer_index.atomic_store(0, MemOrder::Relaxed);
+    for ( auto& tid : producer_tids ) {
+        tid = s_create_thread_d(reinterpret_cast<void*>(produce_values), reinterpret_cast<void*>(values_per_producer.unwrap()));
+        if ( tid == -1 )
+            return false;
+    }
+
+    auto const all_in_order = consume_values(values_per_producer);
+    for ( auto const tid : producer_tids )
+        s_join(tid);
+    return all_in_order;
+}
+
+TEST_CASE(push_and_pop_in_order) {
+    auto mpsc_queue = MpscQueue<i32, 8>{};
+    verify$(mpsc_queue.is_empty());
+
+    for ( auto const i : i32::range(0, 8) )
+        verify$(mpsc_queue.push(i));
+    verify_false$(mpsc_queue.push(8));
+    verify_equal$(mpsc_queue.count(), 8);
+
+    for ( auto const i : i32::range(0, 4) )
+        verify_is_present_equal$(mpsc_queue.pop(), i);
+    for ( auto const i : i32::range(8, 12) )
+        verify$(mpsc_queue.push(i));
+    for ( auto const i : i32::range(4, 12) )
+        verify_is_present_equal$(mpsc_queue.pop(), i);
+    verify_is_none$(mpsc_queue.pop());
+}
+
+TEST_CASE(stress_from_four_producers) {
+    verify$(transfer_values(25'000));
+}
+
+BENCHMARK_CASE(one_million_values_from_four_producers) {
+    verify$(transfer_values(250'000));
+}
@@ -135,4 +135,136 @@ TEST_CASE(ensure_capacity) {
     verify_greater_equal$(set.capacity(), 10'000);
     verify_equal$(set.count(), 0);
     verify$(set.is_empty());
-}
\ No newline at end of file
+}
+TEST_CASE(remove_with_iterator) {
+    auto set = Set<i32>::from_list({ 1, 2, 3 });
+
+    while ( !set.is_empty() ) {
+        verify$(set.remove(set.begin()));
+    }
+    verify_false$(set.remove(set.end()));
+    verify_equal$(set.count(), 0);
+}
+
+TEST_CASE(many_values) {
+    auto set = Set<u32>::empty();
+    for ( auto const i : u32::range(0, 10'000) ) {
+        verify_is_value_equal$(set.try_insert(i), SetInsertResult::New);
+    }
+    verify_equal$(set.count(), 10'000);
+
+    verify_equal$(set.remove_all_matching([](u32 const& value) { return value % 2 == 0; }), 5'000);
+    for ( auto const i : u32::range(0, 10'000) ) {
+        verify_equal$(set.contains(i), i % 2 == 1);
+    }
+
+    /* the values are inserted again over the tombstones */
+    for ( auto const i : u32::range(0, 10'000) ) {
+        set.insert(i);
+    }
+    verify_equal$(set.count(), 10'000);
+}
+
+TEST_CASE(ordered_set_keeps_order_while_growing) {
+    auto ordered_set = OrderedSet<u32>::empty();
+    for ( auto const i : u32::range(0, 1'000) ) {
+        ordered_set.insert(i);
+    }
+    ordered_set.remove_all_matching([](u32 const& value) { return value % 3 == 0; });
+    for ( auto const i : u32::range(1'000, 5'000) ) {
+        ordered_set.insert(i);
+    }
+
+    u32 previous_value = 0;
+    for ( auto const& value : ordered_set ) {
+        verify_greater$(value, previous_value);
+        previous_value = value;
+    }
+    verify_equal$(previous_value, 4'999);
+}
+
+/**
+ * @brief Scattered keys, so the benchmarks do not depend on the distribution of the sequential integers
+ */
+static auto benchmark_key(usize index) -> u32 {
+    return static_cast<u32::NativeInt>(index.unwrap() * 2654435761u);
+}
+
+static auto benchmark_inserts(usize values_count) -> Set<u32> {
+    auto set = Set<u32>::empty();
+    for ( auto const i : usize::range(0, values_count) ) {
+        set.insert(benchmark_key(i));
+    }
+
+    verify_equal$(set.count(), values_count);
+    return set;
+}
+
+static auto benchmark_lookups(usize values_count) {
+    auto const set = benchmark_inserts(values_count);
+
+    /* one hit and one miss for each value */
+    usize found_count = 0;
+    for ( auto const i : usize::range(0, values_count * 2) ) {
+        if ( set.contains(benchmark_key(i)) ) {
+            ++found_count;
+        }
+    }
+    verify_equal$(found_count, values_count);
+}
+
+static auto benchmark_removes(usize values_count) {
+    auto set = benchmark_inserts(values_count);
+    for ( auto const i : usize::range(0, values_count) ) {
+        verify$(set.remove(benchmark_key(i)));
+    }
+    verify$(set.is_empty());
+}
+
+BENCHMARK_CASE(one_thousand_inserts) {
+    benchmark_inserts(1'000);
+}
+
+BENCHMARK_CASE(ten_thousand_inserts) {
+    benchmark_inserts(10'000);
+}
+
+BENCHMARK_CASE(one_hundred_thousand_inserts) {
+    benchmark_inserts(100'000);
+}
+
+BENCHMARK_CASE(one_million_inserts) {
+    benchmark_inserts(1'000'000);
+}
+
+BENCHMARK_CASE(one_thousand_lookups) {
+    benchmark_lookups(1'000);
+}
+
+BENCHMARK_CASE(ten_thousand_lookups) {
+    benchmark_lookups(10'000);
+}
+
+BENCHMARK_CASE(one_hundred_thousand_lookups) {
+    benchmark_lookups(100'000);
+}
+
+BENCHMARK_CASE(one_million_lookups) {
+    benchmark_lookups(1'000'000);
+}
+
+BENCHMARK_CASE(one_thousand_removes) {
+    benchmark_removes(1'000);
+}
+
+BENCHMARK_CASE(ten_thousand_removes) {
+    benchmark_removes(10'000);
+}
+
+BENCHMARK_CASE(one_hundred_thousand_removes) {
+    benchmark_removes(100'000);
+}
+
+BENCHMARK_CASE(one_million_removes) {
+    benchmark_removes(1'000'000);
+}
@@ -0,0 +1,95 @@
+/**
+ * @brief
+ * This file is part of the MeetiX Operating System.
+ * Copyright (c) 2017-2022, Marco Cicognani (marco.cicognani@meetixos.org)
+ *
+ * @developers
+ * Marco Cicognani (marco.cicognani@meetixos.org)
+ *
+ * @license
+ * GNU General Public License version 3
+ */
+
+#include <Api.h>
+#include <CCLang/Lang/SpscQueue.hh>
+#include <LibUnitTest/Assertions.hh>
+#include <LibUnitTest/Case.hh>
+
+static SpscQueue<u32, 1024> s_spsc_queue;
+
+/**
+ * The producer spins on the full queue, the consumer on the empty one
+ */
+static void produce_values(void* values_count) {
+    for ( auto const i : u32::range(0, reinterpret_cast<usize::NativeInt>(values_count)) ) {
+        while ( !s_spsc_queue.push(i) )
+            s_yield();
+    }
+}
+
+static auto consume_values(u32 values_count) -> bool {
+    for ( auto const i : u32::range(0, values_count) ) {
+        auto value_or_none = s_spsc_queue.pop();
+        while ( !value_or_none.is_present() ) {
+            s_yield();
+            value_or_none = s_spsc_queue.pop();
+        }
+
+        if ( value_or_none.unwrap() != i )
+            return false;
+    }
+    return s_spsc_queue.is_empty();
+}
+
+static auto transfer_values(u32 values_count) -> bool {
+    auto const producer_tid = s_create_thread_d(reinterpret_cast<void*>(produce_values), reinterpret_cast<void*>(values_count.unwrap()));
+    if ( producer_tid == -1 )
+        return false;
+
+    auto const all_in_order = consume_values(values_count);
+    s_join(producer_tid);
+    return all_in_order;
+}
+
+TEST_CASE(push_and_pop_in_order) {
+    auto spsc_queue = SpscQueue<i32, 8>{};
+    verify$(spsc_queue.is_empty());
+    verify_equal$(spsc_queue.capacity(), 8);
+
+    for ( auto const i : i32::range(0, 8) )
+        verify$(spsc_queue.push(i));
+    verify_false$(spsc_queue.push(8));
+    verify_equal$(spsc_queue.count(), 8);
+
+    for ( auto const i : i32::range(0, 8) )
+        verify_is_present_equal$(spsc_queue.pop(), i);
+    verify_is_none$(spsc_queue.pop());
+}
+
+TEST_CASE(wraps_around_many_times) {
+    auto spsc_queue = SpscQueue<usize, 4>{};
+    for ( auto const i : usize::range(0, 1000) ) {
+        verify$(spsc_queue.push(i));
+        verify$(spsc_queue.push(i * 2));
+        verify_is_present_equal$(spsc_queue.pop(), i);
+        verify_is_present_equal$(spsc_queue.pop(), i * 2);
+    }
+    verify$(spsc_queue.is_empty());
+}
+
+TEST_CASE(zero_filled_memory_is_an_empty_queue) {
+    alignas(SpscQueue<u64, 16>) static u8::NativeInt s_shared_area[sizeof(SpscQueue<u64, 16>)];
+
+    auto& spsc_queue = *new (s_shared_area) SpscQueue<u64, 16>;
+    verify_is_none$(spsc_queue.pop());
+    verify$(spsc_queue.push(0xcafe));
+    verify_is_present_equal$(spsc_queue.pop(), 0xcafe);
+}
+
+TEST_CASE(stress_between_two_threads) {
+    verify$(transfer_values(100'000));
+}
+
+BENCHMARK_CASE(one_million_values_between_two_threads) {
+    verify$(transfer_values(1'000'000));
+}
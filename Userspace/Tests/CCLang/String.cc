@@ -10,6 +10,7 @@
  * GNU General Public License version 3
  */
 
+#include <CCLang/Alloc/Map.hh>
 #include <CCLang/Alloc/String.hh>
 #include <CCLang/Lang/StringView.hh>
 #include <LibUnitTest/Assertions.hh>
@@ -272,4 +273,69 @@ TEST_CASE(reverse_iterator) {
         verify_equal$(c, i++);
 
     verify_equal$(i, '9' + 1);
-}
\ No newline at end of file
+}
+
+TEST_CASE(inline_storage) {
+    auto const short_string = String::from_view("MeetixOS"sv);
+    verify$(short_string.is_inline());
+    verify_equal$(short_string.as_cstr()[short_string.len()], '\0');
+
+    auto const limit_string = String::from_view("14 chars here!"sv);
+    verify$(limit_string.is_inline());
+
+    auto const long_string = String::from_view("Not so short to stay inline"sv);
+    verify_false$(long_string.is_inline());
+    verify_equal$(long_string.as_cstr()[long_string.len()], '\0');
+
+    verify$(String::empty().is_inline());
+}
+
+TEST_CASE(clone_and_move) {
+    auto const long_string = String::from_view("Shared between the clones"sv);
+    auto const long_clone  = long_string.clone();
+    verify_equal$(long_string.as_cstr(), long_clone.as_cstr());
+
+    auto const short_string = String::from_view("Copied"sv);
+    auto const short_clone  = short_string.clone();
+    verify_not_equal$(short_string.as_cstr(), short_clone.as_cstr());
+    verify_equal$(short_string, short_clone);
+
+    auto moved_string = String::from_view("Inline"sv);
+    auto moved_to     = Cxx::move(moved_string);
+    verify_equal$(moved_to, "Inline"sv);
+    verify$(moved_string.is_empty());
+}
+
+TEST_CASE(hash_code) {
+    auto const short_string = String::from_view("Key"sv);
+    verify_equal$(short_string.hash_code(), "Key"sv.hash_code());
+
+    auto const long_string = String::from_view("A key long enough for the heap"sv);
+    verify_equal$(long_string.hash_code(), "A key long enough for the heap"sv.hash_code());
+    verify_equal$(long_string.hash_code(), long_string.clone().hash_code());
+}
+
+BENCHMARK_CASE(one_hundred_thousand_short_strings) {
+    for ( auto const _ : usize::range(0, 100'000) ) {
+        auto const string = String::from_view("/Bins/MxSh"sv);
+        verify$(string.is_inline());
+    }
+}
+
+BENCHMARK_CASE(one_hundred_thousand_long_strings) {
+    for ( auto const _ : usize::range(0, 100'000) ) {
+        auto const string = String::from_view("/MeetiX/Configs/Startup.sh"sv);
+        verify_false$(string.is_inline());
+    }
+}
+
+BENCHMARK_CASE(one_hundred_thousand_map_lookups) {
+    auto map = Map<String, usize>::empty();
+    map.insert(String::from_view("/Applications/Terminal"sv), 1);
+    map.insert(String::from_view("/Applications/Calculator"sv), 2);
+    map.insert(String::from_view("/Applications/Editor"sv), 3);
+
+    auto const key = String::from_view("/Applications/Calculator"sv);
+    for ( auto const _ : usize::range(0, 100'000) )
+        verify_is_present_equal$(map.at(key), 2);
+}
@@ -10,10 +10,31 @@
  * GNU General Public License version 3
  */
 
+#include <CCLang/Alloc/Allocator.hh>
 #include <CCLang/Alloc/StringBuilder.hh>
 #include <LibUnitTest/Assertions.hh>
 #include <LibUnitTest/Case.hh>
 
+/**
+ * @brief Global heap allocator which counts the requests of new memory
+ */
+class CountingAllocator final : public Allocator {
+public:
+    auto try_alloc(usize size) -> ErrorOr<void*> override {
+        ++m_allocations_count;
+        return Details::internal_heap_alloc(size);
+    }
+    auto try_realloc(void* ptr, usize size, usize new_size) -> ErrorOr<void*> override {
+        ++m_allocations_count;
+        return Details::internal_heap_realloc(ptr, size, new_size);
+    }
+    auto dealloc(void* ptr, usize size) -> void override {
+        Details::internal_heap_dealloc(ptr, size);
+    }
+
+    usize m_allocations_count = 0;
+};
+
 TEST_CASE(append_char) {
     auto string_builder = StringBuilder::empty();
     verify$(string_builder.is_empty());
@@ -75,4 +96,106 @@ TEST_CASE(try_append_string) {
     verify_false$(string_builder.is_empty());
     verify_equal$(string_builder.as_string_view(), "Hi my little friend I'm happy"sv);
     verify_equal$(string_builder.to_string(), "Hi my little friend I'm happy"sv);
-}
\ No newline at end of file
+}
+
+TEST_CASE(into_string_adopts_the_buffer) {
+    auto       string_builder = StringBuilder::with_capacity(32);
+    auto const chars_ptr      = string_builder.as_string_view().as_cstr();
+    string_builder.append("Hi my little friend, I'm happy"sv);
+    string_builder.append("!!"sv);
+
+    auto const string = string_builder.into_string();
+    verify_equal$(string, "Hi my little friend, I'm happy!!"sv);
+    verify_equal$(string.as_cstr(), chars_ptr);
+    verify_equal$(string.as_cstr()[32], '\0');
+    verify$(string_builder.is_empty());
+}
+
+TEST_CASE(into_string_of_short_content) {
+    auto string_builder = StringBuilder::empty();
+    string_builder.append("Hello"sv);
+
+    auto const string = string_builder.into_string();
+    verify$(string.is_inline());
+    verify_equal$(string, "Hello"sv);
+    verify$(string_builder.is_empty());
+
+    string_builder.append("Reused"sv);
+    verify_equal$(string_builder.as_string_view(), "Reused"sv);
+}
+
+TEST_CASE(chunked_append) {
+    auto string_builder = StringBuilder::chunked(8);
+    verify$(string_builder.is_chunked());
+
+    string_builder.append("Hi my"sv);
+    string_builder.append(' ');
+    string_builder.append("little friend, the chunks are only 8 chars long"sv);
+
+    auto const string_view = "Hi my little friend, the chunks are only 8 chars long"sv;
+    verify_equal$(string_builder.len(), string_view.len());
+    verify_equal$(string_builder.to_string(), string_view);
+    verify_equal$(StringBuilder::from_other(string_builder).as_string_view(), string_view);
+    verify_equal$(string_builder.as_string_view(), string_view);
+
+    string_builder.append(" and more"sv);
+    verify_equal$(string_builder.into_string(), "Hi my little friend, the chunks are only 8 chars long and more"sv);
+}
+
+BENCHMARK_CASE(one_hundred_thousand_char_appends) {
+    auto counting_allocator = CountingAllocator{};
+    auto string_builder     = StringBuilder::with_allocator(counting_allocator);
+    for ( auto const _ : usize::range(0, 100'000) ) {
+        string_builder.append('x');
+    }
+
+    verify_equal$(string_builder.len(), 100'000);
+    verify_less_equal$(counting_allocator.m_allocations_count, 27);
+}
+
+BENCHMARK_CASE(one_hundred_thousand_string_appends) {
+    auto counting_allocator = CountingAllocator{};
+    auto string_builder     = StringBuilder::with_allocator(counting_allocator);
+    for ( auto const _ : usize::range(0, 100'000) ) {
+        string_builder.append("MeetiX "sv);
+    }
+
+    verify_equal$(string_builder.len(), 700'000);
+    verify_less_equal$(counting_allocator.m_allocations_count, 32);
+}
+
+auto const C_LOG_LINE = "[Kernel] Tasking: Spawned process 42 (/Apps/Terminal/Terminal.app) on core 0\n"sv;
+
+BENCHMARK_CASE(ten_megabytes_into_string) {
+    auto string_builder = StringBuilder::empty();
+    while ( string_builder.len() < 10 * 1024 * 1024 ) {
+        string_builder.append(C_LOG_LINE);
+    }
+
+    auto const len    = string_builder.len();
+    auto const string = string_builder.into_string();
+    verify_equal$(string.len(), len);
+    verify$(string.ends_with(C_LOG_LINE));
+}
+
+BENCHMARK_CASE(ten_megabytes_chunked_into_string) {
+    auto string_builder = StringBuilder::chunked();
+    while ( string_builder.len() < 10 * 1024 * 1024 ) {
+        string_builder.append(C_LOG_LINE);
+    }
+
+    auto const len    = string_builder.len();
+    auto const string = string_builder.into_string();
+    verify_equal$(string.len(), len);
+    verify$(string.ends_with(C_LOG_LINE));
+}
+
+BENCHMARK_CASE(ten_megabytes_copied_to_string) {
+    auto string_builder = StringBuilder::empty();
+    while ( string_builder.len() < 10 * 1024 * 1024 ) {
+        string_builder.append(C_LOG_LINE);
+    }
+
+    auto const string = string_builder.to_string();
+    verify_equal$(string.len(), string_builder.len());
+}
@@ -193,6 +193,11 @@ TEST_CASE(find) {
     verify_is_present_equal$(string_view.find("this"sv), 13);
     verify_is_present_equal$(string_view.find("tr"sv), 24);
     verify_is_none$(string_view.find('a', 35));
+
+    verify_is_present_equal$(string_view.find('i', 2), 15);
+    verify_is_present_equal$(string_view.find("is"sv, 16), 18);
+    verify_is_present_equal$(string_view.find("string_view"sv), 23);
+    verify_is_none$(string_view.find("string_views"sv));
 }
 
 TEST_CASE(find_last) {
@@ -201,6 +206,8 @@ TEST_CASE(find_last) {
     verify_is_present_equal$(string_view.find_last('i'), 31);
     verify_is_present_equal$(string_view.find_last('a'), 21);
     verify_is_none$(string_view.find_last('z'));
+    verify_is_present_equal$(string_view.find_last('H'), 0);
+    verify_is_none$(""sv.find_last('H'));
 }
 
 TEST_CASE(find_all) {
@@ -256,4 +263,42 @@ TEST_CASE(reverse_iterator) {
         verify_equal$(c, i++);
 
     verify_equal$(i, '9' + 1);
-}
\ No newline at end of file
+}
+
+static char s_long_haystack[64 * 1024];
+
+static auto long_haystack() -> StringView {
+    for ( auto const i : usize::range(0, sizeof(s_long_haystack)) ) {
+        s_long_haystack[i.unwrap()] = static_cast<char>('a' + (i % 23).unwrap());
+    }
+
+    auto const needle = "needle in the haystack"sv;
+    Cxx::memcpy(s_long_haystack + sizeof(s_long_haystack) - needle.len().unwrap(), needle.as_cstr(), needle.len());
+    return StringView::from_raw_parts(s_long_haystack, sizeof(s_long_haystack));
+}
+
+BENCHMARK_CASE(search_short_haystack_one_hundred_thousand_times) {
+    auto const haystack = "/Applications/Terminal/Terminal --no-verbose"sv;
+    for ( auto const _ : usize::range(0, 100'000) ) {
+        verify_is_present_equal$(haystack.find('-'), 32);
+        verify_is_present_equal$(haystack.find("verbose"sv), 37);
+        verify$(haystack.contains("Terminal"sv));
+    }
+}
+
+BENCHMARK_CASE(search_long_haystack_one_thousand_times) {
+    auto const haystack = long_haystack();
+    auto const offset   = sizeof(s_long_haystack) - "needle in the haystack"sv.len().unwrap();
+    for ( auto const _ : usize::range(0, 1'000) ) {
+        verify_is_present_equal$(haystack.find('y'), offset + 16);
+        verify_is_present_equal$(haystack.find("needle in the haystack"sv), offset);
+        verify_is_present_equal$(haystack.find_last('a'), sizeof(s_long_haystack) - 3);
+    }
+}
+
+BENCHMARK_CASE(split_long_haystack_one_hundred_times) {
+    auto const haystack = long_haystack();
+    for ( auto const _ : usize::range(0, 100) ) {
+        verify_equal$(haystack.split_view('w').count(), sizeof(s_long_haystack) / 23);
+    }
+}
@@ -10,11 +10,32 @@
  * GNU General Public License version 3
  */
 
+#include <CCLang/Alloc/Allocator.hh>
 #include <CCLang/Alloc/Vector.hh>
 #include <CCLang/Lang/Cxx.hh>
 #include <LibUnitTest/Assertions.hh>
 #include <LibUnitTest/Case.hh>
 
+/**
+ * @brief Global heap allocator which counts the requests of new memory
+ */
+class CountingAllocator final : public Allocator {
+public:
+    auto try_alloc(usize size) -> ErrorOr<void*> override {
+        ++m_allocations_count;
+        return Details::internal_heap_alloc(size);
+    }
+    auto try_realloc(void* ptr, usize size, usize new_size) -> ErrorOr<void*> override {
+        ++m_allocations_count;
+        return Details::internal_heap_realloc(ptr, size, new_size);
+    }
+    auto dealloc(void* ptr, usize size) -> void override {
+        Details::internal_heap_dealloc(ptr, size);
+    }
+
+    usize m_allocations_count = 0;
+};
+
 TEST_CASE(default_constructor) {
     auto const vector = Vector<i32>::empty();
 
@@ -365,4 +386,38 @@ BENCHMARK_CASE(one_hundred_thousand_append_unchecked_without_reallocations) {
 
     verify_equal$(vector.count(), 100'000);
     verify$(vector.capacity() >= 100'000);
-}
\ No newline at end of file
+}
+
+TEST_CASE(geometric_growth) {
+    auto counting_allocator = CountingAllocator{};
+    auto vector             = Vector<u64>::with_allocator(counting_allocator);
+    for ( auto const i : u64::range(0, 100'000) ) {
+        vector.append(i);
+    }
+
+    /* 4, 6, 9, 13, ... the 27th capacity already exceeds 100'000 */
+    verify_equal$(vector.count(), 100'000);
+    verify_less_equal$(counting_allocator.m_allocations_count, 27);
+}
+
+TEST_CASE(iterate_mutable) {
+    auto vector = Vector<i32>::from_list({ 1, 2, 3 });
+
+    i32 sum = 0;
+    for ( auto& value : vector ) {
+        value *= 2;
+        sum += value;
+    }
+    verify_equal$(sum, 12);
+}
+
+BENCHMARK_CASE(one_hundred_thousand_append_from_empty) {
+    auto counting_allocator = CountingAllocator{};
+    auto vector             = Vector<u64>::with_allocator(counting_allocator);
+    for ( auto const i : u64::range(0, 100'000) ) {
+        vector.append(i * 34);
+    }
+
+    verify_equal$(vector.count(), 100'000);
+    verify_less_equal$(counting_allocator.m_allocations_count, 27);
+}
@@ -0,0 +1,113 @@
+/**
+ * @brief
+ * This file is part of the MeetiX Operating System.
+ * Copyright (c) 2017-2022, Marco Cicognani (marco.cicognani@meetixos.org)
+ *
+ * @developers
+ * Marco Cicognani (marco.cicognani@meetixos.org)
+ *
+ * @license
+ * GNU General Public License version 3
+ */
+
+#include <Api.h>
+#include <CCLang/Lang/Cxx.hh>
+#include <CCLang/Lang/WorkStealingDeque.hh>
+#include <LibUnitTest/Assertions.hh>
+#include <LibUnitTest/Case.hh>
+
+static constexpr auto THIEF_THREADS   = 3;
+static constexpr auto MAX_TASKS_COUNT = 500'000;
+
+static WorkStealingDeque<u32, 4096> s_deque;
+static u8                           s_task_runs[MAX_TASKS_COUNT];
+static usize                        s_tasks_done = 0;
+
+static auto run_task(u32 task) -> void {
+    s_task_runs[task.unwrap()].atomic_add(1, MemOrder::Relaxed);
+    s_tasks_done.atomic_add(1, MemOrder::Release);
+}
+
+/**
+ * The thieves steal until the owner has run or handed out all the tasks
+ */
+static void steal_tasks(void* tasks_count) {
+    while ( s_tasks_done.atomic_load(MemOrder::Acquire) < reinterpret_cast<usize::NativeInt>(tasks_count) ) {
+        auto task_or_none = s_deque.steal();
+        if ( task_or_none.is_present() )
+            run_task(task_or_none.unwrap());
+        else
+            s_yield();
+    }
+}
+
+static auto run_tasks(u32 tasks_count) -> bool {
+    Cxx::memset(s_task_runs, 0, sizeof(s_task_runs));
+    s_tasks_done.atomic_store(0, MemOrder::Relaxed);
+
+    Tid thief_tids[THIEF_THREADS];
+    for ( auto& tid : thief_tids ) {
+        tid = s_create_thread_d(reinterpret_cast<void*>(steal_tasks), reinterpret_cast<void*>(tasks_count.unwrap()));
+        if ( tid == -1 )
+            return false;
+    }
+
+    /* the owner pushes the tasks in batches and runs some of them, racing with the thieves for the last ones */
+    for ( u32 task = 0; task < tasks_count; ) {
+        while ( task < tasks_count && s_deque.push(task) )
+            ++task;
+
+        for ( auto const _ : usize::range(0, 64) ) {
+            auto task_or_none = s_deque.take();
+            if ( !task_or_none.is_present() )
+                break;
+            run_task(task_or_none.unwrap());
+        }
+    }
+    while ( true ) {
+        auto task_or_none = s_deque.take();
+        if ( !task_or_none.is_present() )
+            break;
+        run_task(task_or_none.unwrap());
+    }
+
+    for ( auto const tid : thief_tids )
+        s_join(tid);
+
+    /* every task must have been run exactly once */
+    for ( auto const i : usize::range(0, tasks_count.as<usize>()) ) {
+        if ( s_task_runs[i.unwrap()] != 1 )
+            return false;
+    }
+    return s_tasks_done.atomic_load(MemOrder::Acquire) == tasks_count.as<usize>();
+}
+
+TEST_CASE(owner_takes_lifo_thieves_steal_fifo) {
+    auto deque = WorkStealingDeque<i32, 8>{};
+    verify$(deque.is_empty());
+
+    for ( auto const i : i32::range(0, 8) )
+        verify$(deque.push(i));
+    verify_false$(deque.push(8));
+
+    verify_is_present_equal$(deque.take(), 7);
+    verify_is_present_equal$(deque.steal(), 0);
+    verify_is_present_equal$(deque.take(), 6);
+    verify_is_present_equal$(deque.steal(), 1);
+    verify_equal$(deque.count(), 4);
+
+    for ( auto const i : i32::range(0, 4) )
+        verify_is_present_equal$(deque.take(), i32(5) - i);
+    verify_is_none$(deque.take());
+    verify_is_none$(deque.steal());
+    verify$(deque.push(42));
+    verify_is_present_equal$(deque.steal(), 42);
+}
+
+TEST_CASE(stress_with_three_thieves) {
+    verify$(run_tasks(50'000));
+}
+
+BENCHMARK_CASE(half_million_tasks_with_three_thieves) {
+    verify$(run_tasks(MAX_TASKS_COUNT));
+}
@@ -0,0 +1,195 @@
+/**
+ * @brief
+ * This file is part of the MeetiX Operating System.
+ * Copyright (c) 2017-2022, Marco Cicognani (marco.cicognani@meetixos.org)
+ *
+ * @developers
+ * Marco Cicognani (marco.cicognani@meetixos.org)
+ *
+ * @license
+ * GNU General Public License version 3
+ */
+
+#include <Api.h>
+#include <CCLang/Lang/IntTypes.hh>
+#include <EventRing.hpp>
+#include <LibUnitTest/Assertions.hh>
+#include <LibUnitTest/Case.hh>
+
+static constexpr auto LAST_SCANCODE      = 0xff;
+static constexpr auto MAX_LATENCY_MILLIS = 1000;
+
+/* a zero-filled ring, like the one into the memory allocated by the driver */
+static Input::EventRing s_event_ring;
+
+static auto key_event(u8::NativeInt scancode) -> Input::Event {
+    return Input::Event{ s_millis(), Input::EVENT_TYPE_KEYBOARD, scancode, 0, 0, 0 };
+}
+
+static auto mouse_event(i8::NativeInt flags, i16::NativeInt move_x, i16::NativeInt move_y) -> Input::Event {
+    return Input::Event{ s_millis(), Input::EVENT_TYPE_MOUSE, 0, flags, move_x, move_y };
+}
+
+static auto pop_event(Input::EventRing& event_ring) -> Input::Event {
+    Input::Event event;
+    verify$(event_ring.pop(event));
+    return event;
+}
+
+/**
+ * Injects a key each ten mouse packets like a user which types while moving the mouse, the last key tells that the
+ * injection is finished
+ */
+static void inject_synthetic_events(void* events_count) {
+    for ( auto const i : usize::range(0, reinterpret_cast<usize::NativeInt>(events_count)) ) {
+        if ( i % 10 == 0 )
+            s_event_ring.push(key_event((i / 10 % 128).unwrap()));
+        else
+            s_event_ring.push(mouse_event(0, 1, -1));
+    }
+    s_event_ring.push(key_event(LAST_SCANCODE));
+}
+
+static auto consume_synthetic_events(usize events_count) -> bool {
+    auto const producer_tid = s_create_thread_d(reinterpret_cast<void*>(inject_synthetic_events),
+                                                reinterpret_cast<void*>(events_count.unwrap()));
+    if ( producer_tid == -1 )
+        return false;
+
+    auto keys_count  = usize::NativeInt{ 0 };
+    auto total_x     = isize::NativeInt{ 0 };
+    auto total_y     = isize::NativeInt{ 0 };
+    auto max_latency = u64::NativeInt{ 0 };
+    auto last_stamp  = u64::NativeInt{ 0 };
+    while ( true ) {
+        s_event_ring.waitForEvents();
+
+        Input::Event event;
+        while ( s_event_ring.pop(event) ) {
+            auto const latency = s_millis() - event.m_timestamp;
+            if ( latency > max_latency )
+                max_latency = latency;
+
+            verify_greater_equal$(event.m_timestamp, last_stamp);
+            last_stamp = event.m_timestamp;
+
+            if ( event.m_type == Input::EVENT_TYPE_MOUSE ) {
+                total_x += event.m_move_x;
+                total_y += event.m_move_y;
+                continue;
+            }
+            if ( event.m_scancode == LAST_SCANCODE ) {
+                s_join(producer_tid);
+
+                auto const motions_count = static_cast<isize::NativeInt>(events_count.unwrap() - keys_count);
+                verify_equal$(keys_count, ((events_count + 9) / 10).unwrap());
+                verify_equal$(total_x, motions_count);
+                verify_equal$(total_y, -motions_count);
+                verify_less$(max_latency, MAX_LATENCY_MILLIS);
+                return true;
+            }
+
+            verify_equal$(event.m_scancode, keys_count % 128);
+            ++keys_count;
+        }
+    }
+}
+
+TEST_CASE(zero_filled_memory_is_an_empty_ring) {
+    Input::Event event;
+    verify_false$(s_event_ring.pop(event));
+}
+
+TEST_CASE(events_keep_their_order) {
+    auto event_ring = Input::EventRing{};
+    for ( auto const i : u8::range(1, 11) )
+        event_ring.push(key_event(i.unwrap()));
+
+    for ( auto const i : u8::range(1, 11) )
+        verify_equal$(pop_event(event_ring).m_scancode, i.unwrap());
+
+    Input::Event event;
+    verify_false$(event_ring.pop(event));
+}
+
+TEST_CASE(motion_with_the_same_buttons_is_coalesced) {
+    auto event_ring = Input::EventRing{};
+    event_ring.push(mouse_event(0, 1, 2));
+    event_ring.push(mouse_event(0, 3, 4));
+    event_ring.push(mouse_event(1, 5, 6));
+    event_ring.push(key_event(42));
+    event_ring.push(mouse_event(1, 7, 8));
+
+    auto const moved = pop_event(event_ring);
+    verify_equal$(moved.m_move_x, 4);
+    verify_equal$(moved.m_move_y, 6);
+
+    /* a button change and a key break the coalescing */
+    verify_equal$(pop_event(event_ring).m_move_x, 5);
+    verify_equal$(pop_event(event_ring).m_scancode, 42);
+    verify_equal$(pop_event(event_ring).m_move_y, 8);
+}
+
+TEST_CASE(full_ring_accumulates_the_motion) {
+    auto event_ring = Input::EventRing{};
+    for ( auto const i : usize::range(0, EVENT_RING_CAPACITY) )
+        event_ring.push(key_event((i % 128).unwrap()));
+
+    /* the driver doesn't wait for the consumer, the motion is parked */
+    for ( auto const _ : usize::range(0, 3) )
+        event_ring.push(mouse_event(0, 1, 1));
+
+    for ( auto const i : usize::range(0, EVENT_RING_CAPACITY) )
+        verify_equal$(pop_event(event_ring).m_scancode, (i % 128).unwrap());
+
+    /* the consumer takes the parked motion once the ring is empty, without waiting for another push */
+    event_ring.waitForEvents();
+    auto const moved = pop_event(event_ring);
+    verify_equal$(moved.m_type, Input::EVENT_TYPE_MOUSE);
+    verify_equal$(moved.m_move_x, 3);
+
+    Input::Event event;
+    verify_false$(event_ring.pop(event));
+
+    event_ring.push(mouse_event(0, 1, 1));
+    verify_equal$(pop_event(event_ring).m_move_x, 1);
+}
+
+static Input::EventRing s_full_event_ring;
+
+static void push_button_change(void*) {
+    s_full_event_ring.push(mouse_event(1, 0, 0));
+}
+
+TEST_CASE(button_change_waits_for_a_slot) {
+    for ( auto const i : usize::range(0, EVENT_RING_CAPACITY) )
+        s_full_event_ring.push(key_event((i % 128).unwrap()));
+
+    /* the click is never parked, the driver waits until the consumer frees a slot */
+    auto const producer_tid = s_create_thread_d(reinterpret_cast<void*>(push_button_change), nullptr);
+    verify_not_equal$(producer_tid, -1);
+
+    auto keys_count = usize::NativeInt{ 0 };
+    while ( true ) {
+        s_full_event_ring.waitForEvents();
+
+        Input::Event event;
+        if ( !s_full_event_ring.pop(event) )
+            continue;
+        if ( event.m_type == Input::EVENT_TYPE_MOUSE ) {
+            verify_equal$(keys_count, EVENT_RING_CAPACITY);
+            verify_equal$(event.m_flags, 1);
+            break;
+        }
+        ++keys_count;
+    }
+    s_join(producer_tid);
+}
+
+TEST_CASE(synthetic_events_latency) {
+    verify$(consume_synthetic_events(100'000));
+}
+
+BENCHMARK_CASE(ten_million_synthetic_events) {
+    verify$(consume_synthetic_events(10'000'000));
+}
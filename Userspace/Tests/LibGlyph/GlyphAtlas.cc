@@ -0,0 +1,234 @@
+/**
+ * @brief
+ * This file is part of the MeetiX Operating System.
+ * Copyright (c) 2017-2022, Marco Cicognani (marco.cicognani@meetixos.org)
+ *
+ * @developers
+ * Marco Cicognani (marco.cicognani@meetixos.org)
+ *
+ * @license
+ * GNU General Public License version 3
+ */
+
+#include <CCLang/Lang/Cxx.hh>
+#include <LibGlyph/AlphaBlit.hh>
+#include <LibGlyph/GlyphAtlas.hh>
+#include <LibUnitTest/Assertions.hh>
+#include <LibUnitTest/Case.hh>
+
+static constexpr auto GLYPH_WIDTH  = 8;
+static constexpr auto GLYPH_HEIGHT = 14;
+static constexpr auto SCREEN_COLS  = 128;
+static constexpr auto SCREEN_ROWS  = 51;
+
+static constexpr auto FULL_HD_PIXELS = 1920 * 1080;
+
+static u8::NativeInt s_coverage[GLYPH_HEIGHT * GLYPH_WIDTH];
+static u32::NativeInt s_screen_pixels[SCREEN_COLS * GLYPH_WIDTH * SCREEN_ROWS * GLYPH_HEIGHT];
+static u32::NativeInt s_full_hd_pixels[FULL_HD_PIXELS];
+static u32::NativeInt s_video_pixels[FULL_HD_PIXELS];
+
+/**
+ * Synthetic coverage with every kind of alpha: transparent, opaque and the partial ones in between
+ */
+static auto fill_coverage() -> void {
+    for ( auto const i : usize::range(0, GLYPH_HEIGHT * GLYPH_WIDTH) )
+        s_coverage[i.unwrap()] = static_cast<u8::NativeInt>((i * 37 % 256).unwrap());
+}
+
+static auto reference_blend(u32::NativeInt target_pixel, u32::NativeInt argb_color, u32::NativeInt alpha) -> u32::NativeInt {
+    u32::NativeInt blended_pixel = 0;
+    for ( auto shift = 0; shift < 32; shift += 8 ) {
+        auto const value = ((argb_color >> shift) & 0xff) * alpha + ((target_pixel >> shift) & 0xff) * (255 - alpha);
+        blended_pixel |= ((value + 127) / 255) << shift;
+    }
+    return blended_pixel;
+}
+
+static auto reference_over(u32::NativeInt target_pixel, u32::NativeInt source_pixel) -> u32::NativeInt {
+    auto const transparency = 255 - (source_pixel >> 24);
+
+    u32::NativeInt blended_pixel = 0;
+    for ( auto shift = 0; shift < 32; shift += 8 ) {
+        auto const value = ((target_pixel >> shift) & 0xff) * transparency;
+        blended_pixel |= (((source_pixel >> shift) & 0xff) + (value + 127) / 255) << shift;
+    }
+    return blended_pixel;
+}
+
+/**
+ * Synthetic premultiplied surface with runs of opaque and transparent pixels, like the windows with rounded borders
+ */
+static auto fill_surface(u32::NativeInt* pixels_ptr, usize pixels_count) -> void {
+    for ( auto const i : usize::range(0, pixels_count) ) {
+        auto const run   = (i / 8 % 4).unwrap();
+        auto const alpha = run == 0 ? 255u : run == 1 ? 0u : static_cast<u32::NativeInt>((i * 37 % 256).unwrap());
+        auto const hash  = static_cast<u32::NativeInt>((i * 2654435761u).unwrap());
+
+        u32::NativeInt pixel = alpha << 24;
+        for ( auto shift = 0; shift < 24; shift += 8 )
+            pixel |= ((hash >> shift) % (alpha + 1)) << shift;
+        pixels_ptr[i.unwrap()] = pixel;
+    }
+}
+
+static auto screen_target() -> Glyph::ArgbTarget {
+    return Glyph::ArgbTarget{ s_screen_pixels, SCREEN_COLS * GLYPH_WIDTH, SCREEN_COLS * GLYPH_WIDTH, SCREEN_ROWS * GLYPH_HEIGHT };
+}
+
+TEST_CASE(insert_and_find) {
+    fill_coverage();
+
+    auto glyph_atlas = Glyph::GlyphAtlas::empty();
+    auto const glyph_key = Glyph::GlyphKey{ 1, 14, 0, 'a' };
+    verify_is_none$(glyph_atlas.find(glyph_key));
+
+    auto const glyph_bitmap = glyph_atlas.try_insert(glyph_key, s_coverage, GLYPH_WIDTH, GLYPH_WIDTH, GLYPH_HEIGHT, 0, -10).unwrap();
+    verify_equal$(glyph_bitmap.m_width, GLYPH_WIDTH);
+    verify_equal$(glyph_bitmap.m_bearing_y, -10);
+    for ( auto const y : usize::range(0, GLYPH_HEIGHT) ) {
+        for ( auto const x : usize::range(0, GLYPH_WIDTH) )
+            verify_equal$(glyph_bitmap.m_alpha_ptr[(y * glyph_bitmap.m_stride + x).unwrap()], s_coverage[(y * GLYPH_WIDTH + x).unwrap()]);
+    }
+
+    auto found_bitmap = glyph_atlas.find(glyph_key);
+    verify_is_present$(found_bitmap);
+    verify_equal$(found_bitmap.unwrap().m_alpha_ptr, glyph_bitmap.m_alpha_ptr);
+
+    /* same codepoint with another size is another glyph */
+    verify_is_none$(glyph_atlas.find(Glyph::GlyphKey{ 1, 16, 0, 'a' }));
+    verify_equal$(glyph_atlas.glyphs_count(), 1);
+}
+
+TEST_CASE(pack_many_glyphs) {
+    fill_coverage();
+
+    auto glyph_atlas = Glyph::GlyphAtlas::empty();
+    for ( auto const codepoint : u32::range(0, 4096) )
+        verify_is_value$(glyph_atlas.try_insert(Glyph::GlyphKey{ 0, 14, 0, codepoint }, s_coverage, GLYPH_WIDTH, GLYPH_WIDTH, GLYPH_HEIGHT, 0, 0));
+
+    /* 64 glyphs per shelf, 36 shelves per page */
+    verify_equal$(glyph_atlas.glyphs_count(), 4096);
+    verify_equal$(glyph_atlas.pages_count(), 2);
+    verify_is_present$(glyph_atlas.find(Glyph::GlyphKey{ 0, 14, 0, 4095 }));
+
+    verify$(glyph_atlas.try_insert(Glyph::GlyphKey{ 0, 14, 0, 0x10000 }, s_coverage, 1, 1, 1024, 0, 0).is_error());
+}
+
+TEST_CASE(blend_matches_the_reference) {
+    fill_coverage();
+
+    auto glyph_atlas  = Glyph::GlyphAtlas::empty();
+    auto glyph_bitmap = glyph_atlas.try_insert(Glyph::GlyphKey{ 0, 14, 0, 'g' }, s_coverage, GLYPH_WIDTH, GLYPH_WIDTH, GLYPH_HEIGHT, 1, -12).unwrap();
+
+    auto const argb_target = screen_target();
+    Glyph::fill_rect(argb_target, 0, 0, 64, 64, 0xff204060);
+    Glyph::blend_glyph(argb_target, glyph_bitmap, 10, 20, 0xffc0e0ff);
+
+    for ( auto const y : usize::range(0, 64) ) {
+        for ( auto const x : usize::range(0, 64) ) {
+            auto const in_glyph = x >= 11 && x < 11 + GLYPH_WIDTH && y >= 8 && y < 8 + GLYPH_HEIGHT;
+            auto const alpha    = in_glyph ? s_coverage[((y - 8) * GLYPH_WIDTH + x - 11).unwrap()] : 0;
+            verify_equal$(s_screen_pixels[(y * argb_target.m_stride + x).unwrap()], reference_blend(0xff204060, 0xffc0e0ff, alpha));
+        }
+    }
+}
+
+TEST_CASE(blend_clips_to_the_target) {
+    fill_coverage();
+
+    auto glyph_atlas  = Glyph::GlyphAtlas::empty();
+    auto glyph_bitmap = glyph_atlas.try_insert(Glyph::GlyphKey{ 0, 14, 0, 'g' }, s_coverage, GLYPH_WIDTH, GLYPH_WIDTH, GLYPH_HEIGHT, 0, 0).unwrap();
+
+    /* a target of 4x4 pixels in the middle of the screen, the glyph straddles its top-left corner */
+    auto const screen = screen_target();
+    auto const argb_target = Glyph::ArgbTarget{ s_screen_pixels + 100 * screen.m_stride.unwrap() + 100, screen.m_stride, 4, 4 };
+    Glyph::fill_rect(screen, 0, 0, 200, 200, 0);
+    Glyph::blend_glyph(argb_target, glyph_bitmap, -6, -12, 0xffffffff);
+
+    for ( auto const y : usize::range(96, 108) ) {
+        for ( auto const x : usize::range(96, 108) ) {
+            auto const inside = x >= 100 && x < 102 && y >= 100 && y < 102;
+            auto const pixel  = s_screen_pixels[(y * screen.m_stride + x).unwrap()];
+            if ( inside )
+                verify_equal$(pixel, reference_blend(0, 0xffffffff, s_coverage[((y - 88) * GLYPH_WIDTH + x - 94).unwrap()]));
+            else
+                verify_equal$(pixel, 0);
+        }
+    }
+}
+
+TEST_CASE(stream_copy_matches_the_source) {
+    for ( auto const i : usize::range(0, 4096) )
+        s_full_hd_pixels[i.unwrap()] = static_cast<u32::NativeInt>((i * 2654435761u).unwrap());
+
+    /* every alignment of the target against every length around the 4 pixels blocks */
+    for ( auto const offset : usize::range(0, 4) ) {
+        for ( auto const count : { 0u, 1u, 3u, 4u, 5u, 17u, 1024u } ) {
+            Cxx::memset(s_video_pixels, 0, 2048 * sizeof(u32::NativeInt));
+            Glyph::stream_copy_pixels(s_video_pixels + offset.unwrap(), s_full_hd_pixels + 7, count);
+
+            for ( auto const i : usize::range(0, 2048) ) {
+                auto const copied = i >= offset && i < offset + count;
+                verify_equal$(s_video_pixels[i.unwrap()], copied ? s_full_hd_pixels[(i - offset + 7).unwrap()] : 0);
+            }
+        }
+    }
+}
+
+TEST_CASE(surface_blend_matches_the_reference) {
+    fill_surface(s_full_hd_pixels, 64 * 64);
+    auto const argb_source = Glyph::ArgbTarget{ s_full_hd_pixels, 64, 61, 64 };
+
+    /* the surface straddles the top-left corner, so every row starts at a different alignment */
+    auto const argb_target = screen_target();
+    Glyph::fill_rect(argb_target, 0, 0, 128, 128, 0xff204060);
+    Glyph::blend_surface(argb_target, argb_source, -3, -5);
+
+    for ( auto const y : usize::range(0, 128) ) {
+        for ( auto const x : usize::range(0, 128) ) {
+            auto const in_surface = x < 58 && y < 59;
+            auto const expected   = in_surface ? reference_over(0xff204060, s_full_hd_pixels[((y + 5) * 64 + x + 3).unwrap()]) : 0xff204060;
+            verify_equal$(s_screen_pixels[(y * argb_target.m_stride + x).unwrap()], expected);
+        }
+    }
+}
+
+BENCHMARK_CASE(one_million_glyphs) {
+    fill_coverage();
+
+    auto glyph_atlas = Glyph::GlyphAtlas::empty();
+    for ( auto const codepoint : u32::range(32, 127) )
+        verify_is_value$(glyph_atlas.try_insert(Glyph::GlyphKey{ 0, 14, 0, codepoint }, s_coverage, GLYPH_WIDTH, GLYPH_WIDTH, GLYPH_HEIGHT, 0, -11));
+
+    /* what a terminal does for each cell: find the glyph, fill the background and blend the glyph */
+    auto const argb_target = screen_target();
+    for ( auto const i : usize::range(0, 1'000'000) ) {
+        auto const cell   = i % (SCREEN_COLS * SCREEN_ROWS);
+        auto const x      = (cell % SCREEN_COLS * GLYPH_WIDTH).as<isize>();
+        auto const y      = (cell / SCREEN_COLS * GLYPH_HEIGHT).as<isize>();
+        auto glyph_bitmap = glyph_atlas.find(Glyph::GlyphKey{ 0, 14, 0, (i % 95 + 32).as<u32>() });
+
+        Glyph::fill_rect(argb_target, x, y, GLYPH_WIDTH, GLYPH_HEIGHT, 0xff000000);
+        Glyph::blend_glyph(argb_target, glyph_bitmap.unwrap(), x, y + 11, 0xffffffff);
+    }
+}
+
+BENCHMARK_CASE(one_hundred_full_hd_stream_copies) {
+    for ( auto const i : usize::range(0, 100) )
+        Glyph::stream_copy_pixels(s_video_pixels, s_full_hd_pixels, FULL_HD_PIXELS);
+}
+
+BENCHMARK_CASE(one_hundred_full_hd_memcpy) {
+    for ( auto const i : usize::range(0, 100) )
+        Cxx::memcpy(s_video_pixels, s_full_hd_pixels, FULL_HD_PIXELS * sizeof(u32::NativeInt));
+}
+
+BENCHMARK_CASE(one_hundred_full_hd_surface_blends) {
+    fill_surface(s_full_hd_pixels, FULL_HD_PIXELS);
+
+    auto const argb_target = Glyph::ArgbTarget{ s_video_pixels, 1920, 1920, 1080 };
+    auto const argb_source = Glyph::ArgbTarget{ s_full_hd_pixels, 1920, 1920, 1080 };
+    for ( auto const i : usize::range(0, 100) )
+        Glyph::blend_surface(argb_target, argb_source, 0, 0);
+}
@@ -0,0 +1,158 @@
+/**
+ * @brief
+ * This file is part of the MeetiX Operating System.
+ * Copyright (c) 2017-2022, Marco Cicognani (marco.cicognani@meetixos.org)
+ *
+ * @developers
+ * Marco Cicognani (marco.cicognani@meetixos.org)
+ *
+ * @license
+ * GNU General Public License version 3
+ */
+
+#include <Api.h>
+#include <LibRT/Heap.hh>
+#include <LibUnitTest/Assertions.hh>
+#include <LibUnitTest/Case.hh>
+#include <stdlib.h>
+
+static constexpr auto WORKER_THREADS  = 4;
+static constexpr auto LIVE_OBJECTS    = 64;
+static constexpr auto MAX_OBJECT_SIZE = 512;
+
+static auto is_filled_with(void* ptr, usize size, u8 value) -> bool {
+    for ( auto const i : usize::range(0, size) ) {
+        if ( static_cast<u8::NativeInt*>(ptr)[i.unwrap()] != value )
+            return false;
+    }
+    return true;
+}
+
+/**
+ * Each worker keeps a window of live objects of mixed sizes, freeing the oldest one at each round
+ */
+static void churn_objects_with_rt_heap(void* rounds_count) {
+    void* live_objects[LIVE_OBJECTS] = {};
+    usize live_sizes[LIVE_OBJECTS]   = {};
+
+    for ( auto const i : usize::range(0, reinterpret_cast<usize::NativeInt>(rounds_count)) ) {
+        auto const slot = i % LIVE_OBJECTS;
+        if ( live_objects[slot.unwrap()] != nullptr )
+            verify_is_value$(Heap::rt_dealloc(live_objects[slot.unwrap()], live_sizes[slot.unwrap()]));
+
+        live_sizes[slot.unwrap()]   = (i * 7) % MAX_OBJECT_SIZE + 1;
+        live_objects[slot.unwrap()] = Heap::rt_alloc(live_sizes[slot.unwrap()], Heap::CleanMem::No).unwrap();
+        *static_cast<u8::NativeInt*>(live_objects[slot.unwrap()]) = i.unwrap();
+    }
+
+    for ( auto const slot : usize::range(0, LIVE_OBJECTS) )
+        verify_is_value$(Heap::rt_dealloc(live_objects[slot.unwrap()], live_sizes[slot.unwrap()]));
+}
+
+static void churn_objects_with_malloc(void* rounds_count) {
+    void* live_objects[LIVE_OBJECTS] = {};
+
+    for ( auto const i : usize::range(0, reinterpret_cast<usize::NativeInt>(rounds_count)) ) {
+        auto const slot = i % LIVE_OBJECTS;
+        free(live_objects[slot.unwrap()]);
+
+        live_objects[slot.unwrap()] = malloc(((i * 7) % MAX_OBJECT_SIZE + 1).unwrap());
+        *static_cast<u8::NativeInt*>(live_objects[slot.unwrap()]) = i.unwrap();
+    }
+
+    for ( auto const slot : usize::range(0, LIVE_OBJECTS) )
+        free(live_objects[slot.unwrap()]);
+}
+
+static auto run_workers(void (*worker)(void*), usize rounds_per_worker) -> bool {
+    Tid worker_tids[WORKER_THREADS];
+    for ( auto& tid : worker_tids ) {
+        tid = s_create_thread_d(reinterpret_cast<void*>(worker), reinterpret_cast<void*>(rounds_per_worker.unwrap()));
+        if ( tid == -1 )
+            return false;
+    }
+
+    for ( auto const tid : worker_tids )
+        s_join(tid);
+    return true;
+}
+
+TEST_CASE(alloc_every_small_size) {
+    for ( auto const size : usize::range(1, 8193) ) {
+        auto const ptr = Heap::rt_alloc(size, Heap::CleanMem::No).unwrap();
+        verify_equal$(reinterpret_cast<usize::NativeInt>(ptr) % 8, 0);
+
+        Cxx::memset(ptr, 0xab, size);
+        verify$(is_filled_with(ptr, size, 0xab));
+        verify_is_value$(Heap::rt_dealloc(ptr, size));
+    }
+}
+
+TEST_CASE(alloc_and_dealloc_large) {
+    auto const ptr = Heap::rt_alloc(1024 * 1024, Heap::CleanMem::Yes).unwrap();
+    verify$(is_filled_with(ptr, 1024 * 1024, 0));
+    verify_is_value$(Heap::rt_dealloc(ptr, 1024 * 1024));
+}
+
+TEST_CASE(clean_mem_on_recycled_objects) {
+    auto const dirty_ptr = Heap::rt_alloc(64, Heap::CleanMem::No).unwrap();
+    Cxx::memset(dirty_ptr, 0xff, 64);
+    verify_is_value$(Heap::rt_dealloc(dirty_ptr, 64));
+
+    auto const clean_ptr = Heap::rt_alloc(64, Heap::CleanMem::Yes).unwrap();
+    verify$(is_filled_with(clean_ptr, 64, 0));
+    verify_is_value$(Heap::rt_dealloc(clean_ptr, 64));
+}
+
+TEST_CASE(recycle_objects_of_the_same_class) {
+    auto const first_ptr = Heap::rt_alloc(100, Heap::CleanMem::No).unwrap();
+    verify_is_value$(Heap::rt_dealloc(first_ptr, 100));
+
+    /* 100 and 104 share the same size class */
+    auto const second_ptr = Heap::rt_alloc(104, Heap::CleanMem::No).unwrap();
+    verify_equal$(first_ptr, second_ptr);
+    verify_is_value$(Heap::rt_dealloc(second_ptr, 104));
+}
+
+TEST_CASE(alloc_aligned) {
+    for ( auto const alignment : { 16u, 64u, 256u, 4096u, 8192u, 16384u } ) {
+        for ( auto const size : { 1u, 24u, 1000u, 10000u } ) {
+            auto const ptr = Heap::rt_alloc_aligned(size, alignment, Heap::CleanMem::Yes).unwrap();
+            verify_equal$(reinterpret_cast<usize::NativeInt>(ptr) % alignment, 0);
+            verify$(is_filled_with(ptr, size, 0));
+            verify_is_value$(Heap::rt_dealloc_aligned(ptr, size, alignment));
+        }
+    }
+
+    verify$(Heap::rt_alloc_aligned(16, 24, Heap::CleanMem::No).is_error());
+}
+
+TEST_CASE(realloc_keeps_the_content) {
+    auto ptr = Heap::rt_alloc(10, Heap::CleanMem::No).unwrap();
+    Cxx::memset(ptr, 0x5a, 10);
+
+    /* grows inside the same size class */
+    auto const same_ptr = Heap::rt_realloc(ptr, 10, 16).unwrap();
+    verify_equal$(same_ptr, ptr);
+
+    for ( auto const new_size : { 100u, 5000u, 70000u, 200000u } ) {
+        ptr = Heap::rt_realloc(ptr, 10, new_size).unwrap();
+        verify$(is_filled_with(ptr, 10, 0x5a));
+
+        ptr = Heap::rt_realloc(ptr, new_size, 10).unwrap();
+        verify$(is_filled_with(ptr, 10, 0x5a));
+    }
+    verify_is_value$(Heap::rt_dealloc(ptr, 10));
+}
+
+TEST_CASE(concurrent_churn) {
+    verify$(run_workers(churn_objects_with_rt_heap, 100'000));
+}
+
+BENCHMARK_CASE(four_threads_churn_rt_heap) {
+    verify$(run_workers(churn_objects_with_rt_heap, 1'000'000));
+}
+
+BENCHMARK_CASE(four_threads_churn_libc_malloc) {
+    verify$(run_workers(churn_objects_with_malloc, 1'000'000));
+}
@@ -0,0 +1,87 @@
+/**
+ * @brief
+ * This file is part of the MeetiX Operating System.
+ * Copyright (c) 2017-2022, Marco Cicognani (marco.cicognani@meetixos.org)
+ *
+ * @developers
+ * Marco Cicognani (marco.cicognani@meetixos.org)
+ *
+ * @license
+ * GNU General Public License version 3
+ */
+
+
+#include <Api.h>
+#include <LibUnitTest/Assertions.hh>
+#include <LibUnitTest/Case.hh>
+#include <stdio.h>
+
+static constexpr auto SCRIPT_PATH       = "/Bins/Tests/TestScriptLoop.sh";
+static constexpr auto SCRIPT_CACHE_PATH = "/Bins/Tests/TestScriptLoop.sh.mxc";
+static constexpr auto SCRIPT_SHELL_ARGS = "-s /Bins/Tests/TestScriptLoop.sh";
+static constexpr auto SCRIPT_RUNS       = 10;
+
+/**
+ * Nested loops which only count, so the measured time is the interpreter one
+ */
+static constexpr auto LOOP_SCRIPT = "set: I=0\n"
+                                    "while: I<1000\n"
+                                    "    set: J=0\n"
+                                    "    while: J<100\n"
+                                    "        increment: J\n"
+                                    "    end\n"
+                                    "    if: I==500\n"
+                                    "        set: HALF=$I\n"
+                                    "    else\n"
+                                    "        increment: OTHERS\n"
+                                    "    end\n"
+                                    "    increment: I\n"
+                                    "end\n";
+
+static auto run_loop_script() -> bool {
+    Pid        pid = -1;
+    FileHandle out_stdio[3];
+    FileHandle in_stdio[3] = { STDIN_FILENO, STDOUT_FILENO, STDERR_FILENO };
+    auto const spawn_status
+        = s_spawn_poi("/Bins/MxSh", SCRIPT_SHELL_ARGS, "/", SECURITY_LEVEL_APPLICATION, &pid, out_stdio, in_stdio);
+    if ( spawn_status != SPAWN_STATUS_SUCCESSFUL )
+        return false;
+
+    s_join(pid);
+    return true;
+}
+
+static auto write_loop_script() -> bool {
+    auto const script = fopen(SCRIPT_PATH, "w");
+    if ( script == nullptr )
+        return false;
+
+    fputs(LOOP_SCRIPT, script);
+    fclose(script);
+    return true;
+}
+
+TEST_CASE(compiled_script_is_cached_next_to_it) {
+    verify$(write_loop_script());
+    remove(SCRIPT_CACHE_PATH);
+
+    verify$(run_loop_script());
+
+    auto const cache = fopen(SCRIPT_CACHE_PATH, "r");
+    verify_not_null$(cache);
+    fclose(cache);
+}
+
+/**
+ * The first run compiles the script, the others load it from the cache
+ */
+BENCHMARK_CASE(ten_runs_of_a_loop_script) {
+    verify$(write_loop_script());
+    remove(SCRIPT_CACHE_PATH);
+
+    for ( auto i = 0; i < SCRIPT_RUNS; ++i )
+        verify$(run_loop_script());
+
+    remove(SCRIPT_PATH);
+    remove(SCRIPT_CACHE_PATH);
+}
@@ -0,0 +1,291 @@
+/**
+ * @brief
+ * This file is part of the MeetiX Operating System.
+ * Copyright (c) 2017-2022, Marco Cicognani (marco.cicognani@meetixos.org)
+ *
+ * @developers
+ * Marco Cicognani (marco.cicognani@meetixos.org)
+ *
+ * @license
+ * GNU General Public License version 3
+ */
+
+#include <Api.h>
+#include <Api/Memory.h>
+#include <LibUnitTest/Assertions.hh>
+#include <LibUnitTest/Case.hh>
+#include <stdio.h>
+#include <string.h>
+
+static constexpr auto TEST_EXECUTABLE     = "/Bins/Tests/TestImageCache";
+static constexpr auto REPORT_CASE         = "report_image_pages";
+static constexpr auto REPORT_MAPPING_CASE = "report_file_mapping";
+
+/**
+ * The copy is created at runtime, so it is not part of the ramdisk image and the spawner loads it through the
+ * kernel image cache instead of mapping it straight from the ramdisk
+ */
+static constexpr auto COPIED_EXECUTABLE = "/Bins/Tests/TestImageCacheCopy";
+
+/**
+ * Initialized page-aligned data, so it has a page of its own in the writable segment which nothing else writes
+ */
+alignas(PAGE_SIZE) static volatile int s_data_page[PAGE_SIZE / sizeof(int)] = { 1 };
+
+struct ReportedPage {
+    unsigned int m_physical_address{ 0 };
+    int          m_writable{ 0 };
+    int          m_value{ 0 };
+};
+
+struct ImageReport {
+    ReportedPage m_text;
+    ReportedPage m_data;
+    ReportedPage m_written_data;
+};
+
+static void print_page(char const* label, void* address, int value) {
+    unsigned int physical_address = 0;
+    bool         writable         = false;
+    if ( s_query_page(address, &physical_address, &writable, nullptr) )
+        printf("%s: %x %d %d\n", label, physical_address, writable ? 1 : 0, value);
+}
+
+/**
+ * Also run by the spawned copies, it prints the pages of the text and of the data of the process and
+ * the data page again after its first write, the spawning cases compare them between the copies
+ */
+TEST_CASE(report_image_pages) {
+    auto const text_address = reinterpret_cast<void*>(&print_page);
+    auto const data_address = const_cast<int*>(s_data_page);
+
+    bool text_writable = true;
+    verify$(s_query_page(text_address, nullptr, &text_writable, nullptr));
+    verify_false$(text_writable);
+
+    print_page("text", text_address, 0);
+    print_page("data", data_address, s_data_page[0]);
+    s_data_page[0] = s_data_page[0] + 1;
+    print_page("written-data", data_address, s_data_page[0]);
+
+    bool data_writable = false;
+    verify$(s_query_page(data_address, nullptr, &data_writable, nullptr));
+    verify$(data_writable);
+}
+
+/**
+ * Also run by a spawned process, it maps the first page of its executable, which is part of the ramdisk image,
+ * and prints the references of the physical page while the mapping is alive
+ */
+TEST_CASE(report_file_mapping) {
+    auto const fd = s_open(TEST_EXECUTABLE);
+    verify_not_equal$(fd, FD_NONE);
+
+    FsMapStatus map_status;
+    auto const  mapped_area = s_map_file_s(fd, 0, PAGE_SIZE, FS_MAP_MODE_SHARED, &map_status);
+    verify_equal$(map_status, FS_MAP_SUCCESSFUL);
+    verify_not_null$(mapped_area);
+
+    unsigned int physical_address = 0;
+    bool         writable         = true;
+    unsigned int references       = 0;
+    verify$(s_query_page(mapped_area, &physical_address, &writable, &references));
+    verify_false$(writable);
+    printf("file: %x %d %d\n", physical_address, writable ? 1 : 0, references);
+
+    s_unmap_mem(mapped_area);
+    s_close(fd);
+}
+
+static bool copy_executable() {
+    auto const source = fopen(TEST_EXECUTABLE, "r");
+    if ( !source )
+        return false;
+
+    auto const destination = fopen(COPIED_EXECUTABLE, "w");
+    if ( !destination ) {
+        fclose(source);
+        return false;
+    }
+
+    char buffer[PAGE_SIZE];
+    auto copied = true;
+    for ( size_t read_bytes; (read_bytes = fread(buffer, 1, sizeof(buffer), source)) > 0; ) {
+        if ( fwrite(buffer, 1, read_bytes, destination) != read_bytes ) {
+            copied = false;
+            break;
+        }
+    }
+
+    fclose(source);
+    fclose(destination);
+    return copied;
+}
+
+static bool parse_page(char const* output, char const* label, ReportedPage* page) {
+    char prefix[32];
+    snprintf(prefix, sizeof(prefix), "\n%s: ", label);
+
+    auto const line = strstr(output, prefix);
+    if ( !line )
+        return false;
+    return sscanf(line + strlen(prefix), "%x %d %d", &page->m_physical_address, &page->m_writable, &page->m_value) == 3;
+}
+
+/**
+ * Spawns the executable running only the given case, waits for it and collects what it printed.
+ * The output starts with a newline so each label is found at the start of its line
+ */
+static bool spawn_and_collect(char const* path, char const* case_name, char* output, unsigned int output_size) {
+    Pid        pid = -1;
+    FileHandle stdio[3];
+    if ( s_spawn_po(path, case_name, "/", SECURITY_LEVEL_APPLICATION, &pid, stdio) != SPAWN_STATUS_SUCCESSFUL )
+        return false;
+    s_join(pid);
+
+    output[0]               = '\n';
+    unsigned int output_len = 1;
+    while ( output_len < output_size - 1 ) {
+        FsReadStatus read_status;
+        auto const   read_bytes = s_read_s(stdio[1], output + output_len, output_size - 1 - output_len, &read_status);
+        if ( read_status != FS_READ_SUCCESSFUL || read_bytes == 0 || read_bytes == static_cast<unsigned int>(-1) )
+            break;
+        output_len += read_bytes;
+    }
+    output[output_len] = '\0';
+
+    for ( auto const fd : stdio )
+        s_close(fd);
+    return true;
+}
+
+static bool spawn_and_report(char const* path, ImageReport* report) {
+    char output[2048];
+    if ( !spawn_and_collect(path, REPORT_CASE, output, sizeof(output)) )
+        return false;
+
+    return parse_page(output, "text", &report->m_text) && parse_page(output, "data", &report->m_data)
+        && parse_page(output, "written-data", &report->m_written_data);
+}
+
+static unsigned int cached_image_pages() {
+    SystemInfo system_info;
+    s_system_info(&system_info);
+    return system_info.m_image_cache_amount;
+}
+
+/**
+ * The second spawn maps the pages cached by the first one: the same physical pages, read-only,
+ * and the first write to the data gives each process its own copy of the page
+ */
+TEST_CASE(spawned_copies_share_the_image_pages) {
+    verify$(copy_executable());
+
+    ImageReport first_report;
+    ImageReport second_report;
+    verify$(spawn_and_report(COPIED_EXECUTABLE, &first_report));
+    verify$(spawn_and_report(COPIED_EXECUTABLE, &second_report));
+
+    verify_equal$(first_report.m_text.m_physical_address, second_report.m_text.m_physical_address);
+    verify_equal$(first_report.m_text.m_writable, 0);
+    verify_equal$(second_report.m_text.m_writable, 0);
+
+    verify_equal$(first_report.m_data.m_physical_address, second_report.m_data.m_physical_address);
+    verify_equal$(first_report.m_data.m_writable, 0);
+    verify_equal$(second_report.m_data.m_writable, 0);
+
+    /* the write of the first copy didn't reach the cached page */
+    verify_equal$(second_report.m_data.m_value, 1);
+    verify_equal$(second_report.m_written_data.m_value, 2);
+
+    verify_not_equal$(first_report.m_written_data.m_physical_address, first_report.m_data.m_physical_address);
+    verify_not_equal$(second_report.m_written_data.m_physical_address, second_report.m_data.m_physical_address);
+    verify_equal$(second_report.m_written_data.m_writable, 1);
+
+    remove(COPIED_EXECUTABLE);
+}
+
+TEST_CASE(file_write_drops_the_cached_segments) {
+    verify$(copy_executable());
+
+    ImageReport report;
+    verify$(spawn_and_report(COPIED_EXECUTABLE, &report));
+    auto const cached_pages_before_write = cached_image_pages();
+
+    /* rewrite the first byte with the same value, the content doesn't matter only the write does */
+    auto const fd = s_open_f(COPIED_EXECUTABLE, FILE_FLAG_MODE_WRITE);
+    verify_not_equal$(fd, FD_NONE);
+    char const elf_magic_first_byte = 0x7f;
+    verify_equal$(s_write(fd, &elf_magic_first_byte, 1), 1u);
+    s_close(fd);
+
+    verify_less$(cached_image_pages(), cached_pages_before_write);
+
+    remove(COPIED_EXECUTABLE);
+}
+
+/**
+ * Both mappings start on the ramdisk page, the first write to the private one gives it a copy of its own
+ */
+TEST_CASE(private_file_mapping_copies_on_write) {
+    auto const fd = s_open(TEST_EXECUTABLE);
+    verify_not_equal$(fd, FD_NONE);
+
+    FsMapStatus map_status;
+    auto const  shared_area = static_cast<char*>(s_map_file_s(fd, 0, PAGE_SIZE, FS_MAP_MODE_SHARED, &map_status));
+    verify_equal$(map_status, FS_MAP_SUCCESSFUL);
+    auto const private_area = static_cast<char*>(s_map_file_s(fd, 0, PAGE_SIZE, FS_MAP_MODE_PRIVATE, &map_status));
+    verify_equal$(map_status, FS_MAP_SUCCESSFUL);
+
+    unsigned int shared_physical_address  = 0;
+    unsigned int private_physical_address = 0;
+    bool         shared_writable          = true;
+    bool         private_writable         = true;
+    verify$(s_query_page(shared_area, &shared_physical_address, &shared_writable, nullptr));
+    verify$(s_query_page(private_area, &private_physical_address, &private_writable, nullptr));
+    verify_equal$(private_physical_address, shared_physical_address);
+    verify_false$(shared_writable);
+    verify_false$(private_writable);
+
+    private_area[0] = 0;
+    verify$(s_query_page(private_area, &private_physical_address, &private_writable, nullptr));
+    verify_not_equal$(private_physical_address, shared_physical_address);
+    verify$(private_writable);
+
+    /* the file content seen by the shared mapping is untouched */
+    verify_equal$(shared_area[0], 0x7f);
+
+    s_unmap_mem(private_area);
+    s_unmap_mem(shared_area);
+    s_close(fd);
+}
+
+/**
+ * The references taken by the image and by the file mapping of a process go away with the process
+ */
+TEST_CASE(process_exit_releases_the_file_mappings) {
+    auto const fd = s_open(TEST_EXECUTABLE);
+    verify_not_equal$(fd, FD_NONE);
+
+    auto const mapped_area = s_map_file(fd, 0, PAGE_SIZE, FS_MAP_MODE_SHARED);
+    verify_not_null$(mapped_area);
+
+    unsigned int physical_address        = 0;
+    unsigned int references_before_spawn = 0;
+    verify$(s_query_page(mapped_area, &physical_address, nullptr, &references_before_spawn));
+
+    char output[2048];
+    verify$(spawn_and_collect(TEST_EXECUTABLE, REPORT_MAPPING_CASE, output, sizeof(output)));
+
+    ReportedPage child_mapping;
+    verify$(parse_page(output, "file", &child_mapping));
+    verify_equal$(child_mapping.m_physical_address, physical_address);
+    verify_greater$(static_cast<unsigned int>(child_mapping.m_value), references_before_spawn);
+
+    unsigned int references_after_exit = 0;
+    verify$(s_query_page(mapped_area, nullptr, nullptr, &references_after_exit));
+    verify_equal$(references_after_exit, references_before_spawn);
+
+    s_unmap_mem(mapped_area);
+    s_close(fd);
+}
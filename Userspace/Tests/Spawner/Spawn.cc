@@ -0,0 +1,173 @@
+/**
+ * @brief
+ * This file is part of the MeetiX Operating System.
+ * Copyright (c) 2017-2022, Marco Cicognani (marco.cicognani@meetixos.org)
+ *
+ * @developers
+ * Marco Cicognani (marco.cicognani@meetixos.org)
+ *
+ * @license
+ * GNU General Public License version 3
+ */
+
+#include <Api.h>
+#include <CCLang/Lang/IntTypes.hh>
+#include <LibUnitTest/Assertions.hh>
+#include <LibUnitTest/Case.hh>
+#include <spawn.h>
+#include <stdio.h>
+#include <string.h>
+
+static constexpr auto SPAWNING_THREADS   = 10;
+static constexpr auto SPAWNS_PER_THREAD  = 10;
+static constexpr auto SPAWNED_EXECUTABLE = "/Bins/Tests/TestSpawn";
+static constexpr auto SEQUENTIAL_SPAWNS  = 50;
+
+static constexpr auto SPAWNED_OUTPUT_DIRECTORY = "/Bins/Tests";
+static constexpr auto SPAWNED_OUTPUT_NAME      = "TestSpawnOutput.txt";
+static constexpr auto SPAWNED_OUTPUT_PATH      = "/Bins/Tests/TestSpawnOutput.txt";
+static constexpr auto SPAWNED_OUTPUT_HEADER    = "Starting test suite";
+
+static constexpr auto SCRIPT_PATH           = "/Bins/Tests/TestSpawnScript.sh";
+static constexpr auto SCRIPT_SHELL_ARGS     = "-s /Bins/Tests/TestSpawnScript.sh";
+static constexpr auto SCRIPT_COMMANDS       = 1000;
+static constexpr auto SCRIPT_MISSES_EACH    = 10;
+static constexpr auto SCRIPT_FOUND_COMMAND  = "spawn_app: Tests/TestSpawn args: --no-case\n";
+static constexpr auto SCRIPT_MISSED_COMMAND = "spawn_app: Tests/NotExistingCommand\n";
+
+static char* const s_spawned_argv[] = { const_cast<char*>(SPAWNED_EXECUTABLE), const_cast<char*>("--no-case"), nullptr };
+
+static usize s_failed_spawns = 0;
+
+/**
+ * The spawned child runs this same executable with a case name which doesn't exist,
+ * so it exits immediately and the measured time is the spawning path only
+ */
+static void spawn_short_lived_processes() {
+    Pid        pids[SPAWNS_PER_THREAD];
+    FileHandle stdio[SPAWNS_PER_THREAD][3];
+
+    for ( auto i = 0; i < SPAWNS_PER_THREAD; ++i ) {
+        auto const spawn_status
+            = s_spawn_po(SPAWNED_EXECUTABLE, "--no-case", "/", SECURITY_LEVEL_APPLICATION, &pids[i], stdio[i]);
+        if ( spawn_status != SPAWN_STATUS_SUCCESSFUL ) {
+            pids[i] = -1;
+            s_failed_spawns.atomic_add(1, MemOrder::Relaxed);
+        }
+    }
+
+    for ( auto i = 0; i < SPAWNS_PER_THREAD; ++i ) {
+        if ( pids[i] == -1 )
+            continue;
+
+        s_join(pids[i]);
+        for ( auto const fd : stdio[i] )
+            s_close(fd);
+    }
+}
+
+BENCHMARK_CASE(spawn_one_hundred_processes_in_parallel) {
+    Tid spawning_threads[SPAWNING_THREADS];
+
+    s_failed_spawns.atomic_store(0, MemOrder::Relaxed);
+    for ( auto& tid : spawning_threads ) {
+        tid = s_create_thread_d(reinterpret_cast<void*>(spawn_short_lived_processes), nullptr);
+        verify_not_equal$(tid, -1);
+    }
+    for ( auto const tid : spawning_threads )
+        s_join(tid);
+
+    verify_equal$(s_failed_spawns.atomic_load(MemOrder::Relaxed), 0);
+}
+
+/**
+ * The child opens its output relatively to the directory given by CHDIR, prints there also its errors through DUP2
+ * and starts without standard input, the suite header it prints tells that all the actions were applied
+ */
+TEST_CASE(posix_spawn_applies_file_actions) {
+    remove(SPAWNED_OUTPUT_PATH);
+
+    posix_spawn_file_actions_t file_actions;
+    verify_equal$(posix_spawn_file_actions_init(&file_actions), 0);
+    verify_equal$(posix_spawn_file_actions_addclose(&file_actions, STDIN_FILENO), 0);
+    verify_equal$(posix_spawn_file_actions_addchdir_np(&file_actions, SPAWNED_OUTPUT_DIRECTORY), 0);
+    verify_equal$(posix_spawn_file_actions_addopen(&file_actions, STDOUT_FILENO, SPAWNED_OUTPUT_NAME, O_WRONLY | O_CREAT | O_TRUNC, 0644), 0);
+    verify_equal$(posix_spawn_file_actions_adddup2(&file_actions, STDOUT_FILENO, STDERR_FILENO), 0);
+
+    pid_t pid = -1;
+    verify_equal$(posix_spawn(&pid, SPAWNED_EXECUTABLE, &file_actions, nullptr, s_spawned_argv, nullptr), 0);
+    verify_not_equal$(pid, -1);
+    s_join(pid);
+    verify_equal$(posix_spawn_file_actions_destroy(&file_actions), 0);
+
+    auto const output = fopen(SPAWNED_OUTPUT_PATH, "r");
+    verify_not_null$(output);
+
+    char line[256] = {};
+    verify_not_null$(fgets(line, sizeof(line), output));
+    verify_not_null$(strstr(line, SPAWNED_OUTPUT_HEADER));
+    fclose(output);
+
+    remove(SPAWNED_OUTPUT_PATH);
+}
+
+TEST_CASE(posix_spawn_fails_on_file_action_error) {
+    posix_spawn_file_actions_t file_actions;
+    verify_equal$(posix_spawn_file_actions_init(&file_actions), 0);
+    verify_equal$(posix_spawn_file_actions_addopen(&file_actions, STDIN_FILENO, "/NotExistingFile", O_RDONLY, 0), 0);
+
+    pid_t pid = -1;
+    verify_equal$(posix_spawn(&pid, SPAWNED_EXECUTABLE, &file_actions, nullptr, s_spawned_argv, nullptr), EBADF);
+    verify_equal$(pid, -1);
+
+    verify_equal$(posix_spawn_file_actions_destroy(&file_actions), 0);
+}
+
+BENCHMARK_CASE(posix_spawn_fifty_processes) {
+    for ( auto i = 0; i < SEQUENTIAL_SPAWNS; ++i ) {
+        pid_t pid = -1;
+        verify_equal$(posix_spawn(&pid, SPAWNED_EXECUTABLE, nullptr, nullptr, s_spawned_argv, nullptr), 0);
+        s_join(pid);
+    }
+}
+
+/**
+ * The classic way: the forked copy of this process asks the spawner for the executable and exits,
+ * paying the clone of the address space only to throw it away
+ */
+BENCHMARK_CASE(fork_and_spawn_fifty_processes) {
+    for ( auto i = 0; i < SEQUENTIAL_SPAWNS; ++i ) {
+        auto const forked_pid = s_fork();
+        if ( forked_pid == 0 ) {
+            Pid pid = -1;
+            if ( s_spawn_p(SPAWNED_EXECUTABLE, "--no-case", "/", SECURITY_LEVEL_APPLICATION, &pid) == SPAWN_STATUS_SUCCESSFUL )
+                s_join(pid);
+            s_exit(0);
+        }
+
+        verify_not_equal$(forked_pid, -1);
+        s_join(forked_pid);
+    }
+}
+
+/**
+ * The commands are given by name like a user would do, so each one goes through the hash of the
+ * shell and the resolutions of the spawner. One command each ten is not found to hit the misses too
+ */
+BENCHMARK_CASE(script_of_one_thousand_commands) {
+    auto const script = fopen(SCRIPT_PATH, "w");
+    verify_not_null$(script);
+    for ( auto i = 0; i < SCRIPT_COMMANDS; ++i )
+        fputs(i % SCRIPT_MISSES_EACH == 0 ? SCRIPT_MISSED_COMMAND : SCRIPT_FOUND_COMMAND, script);
+    fclose(script);
+
+    Pid        pid = -1;
+    FileHandle out_stdio[3];
+    FileHandle in_stdio[3] = { STDIN_FILENO, STDOUT_FILENO, STDERR_FILENO };
+    auto const spawn_status
+        = s_spawn_poi("/Bins/MxSh", SCRIPT_SHELL_ARGS, "/", SECURITY_LEVEL_APPLICATION, &pid, out_stdio, in_stdio);
+    verify_equal$(spawn_status, SPAWN_STATUS_SUCCESSFUL);
+    s_join(pid);
+
+    remove(SCRIPT_PATH);
+}
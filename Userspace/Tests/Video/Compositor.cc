@@ -0,0 +1,219 @@
+/**
+ * @brief
+ * This file is part of the MeetiX Operating System.
+ * Copyright (c) 2017-2022, Marco Cicognani (marco.cicognani@meetixos.org)
+ *
+ * @developers
+ * Marco Cicognani (marco.cicognani@meetixos.org)
+ *
+ * @license
+ * GNU General Public License version 3
+ */
+
+#include <Api.h>
+#include <CCLang/Lang/Cxx.hh>
+#include <CCLang/Lang/IntTypes.hh>
+#include <Compositor.hh>
+#include <LibUnitTest/Assertions.hh>
+#include <LibUnitTest/Case.hh>
+
+static constexpr auto SCREEN_WIDTH  = 64;
+static constexpr auto SCREEN_HEIGHT = 48;
+static constexpr auto SCREEN_STRIDE = 80;
+static constexpr auto OWNER         = 7;
+
+static constexpr auto FULL_HD_WIDTH  = 1920;
+static constexpr auto FULL_HD_HEIGHT = 1080;
+
+static u32::NativeInt s_framebuffer[SCREEN_STRIDE * SCREEN_HEIGHT];
+static u32::NativeInt s_full_hd_framebuffer[FULL_HD_WIDTH * FULL_HD_HEIGHT];
+
+static auto pixel_at(i32::NativeInt x, i32::NativeInt y) -> u32::NativeInt {
+    return s_framebuffer[y * SCREEN_STRIDE + x];
+}
+
+static auto fill_buffer(Compositor::Surface const& surface, u8::NativeInt buffer, u32::NativeInt pixel) -> void {
+    for ( auto i = 0; i < surface.m_bounds.m_width * surface.m_bounds.m_height; ++i )
+        surface.m_buffers[buffer][i] = pixel;
+}
+
+static auto submit_whole(Compositor& compositor, Compositor::Surface const& surface, u8::NativeInt buffer) -> bool {
+    u8::NativeInt next_buffer = 0;
+    auto const    damage      = Compositing::Rect{ 0, 0, surface.m_bounds.m_width, surface.m_bounds.m_height };
+    return compositor.submit_surface(OWNER, surface.m_id, buffer, damage, next_buffer) && next_buffer == (buffer ^ 1);
+}
+
+TEST_CASE(nothing_is_composed_before_the_first_submit) {
+    Cxx::memset(s_framebuffer, 0x5a, sizeof(s_framebuffer));
+
+    auto compositor = Compositor{ s_framebuffer, SCREEN_WIDTH, SCREEN_HEIGHT, SCREEN_STRIDE };
+    verify$(compositor.is_valid());
+    verify_false$(compositor.compose_frame());
+    verify_equal$(pixel_at(0, 0), 0x5a5a5a5a);
+}
+
+TEST_CASE(surface_is_shown_from_its_first_submit) {
+    Cxx::memset(s_framebuffer, 0, sizeof(s_framebuffer));
+    auto compositor = Compositor{ s_framebuffer, SCREEN_WIDTH, SCREEN_HEIGHT, SCREEN_STRIDE };
+
+    auto const surface = compositor.create_surface(OWNER, Compositing::Rect{ 10, 5, 20, 10 }, true);
+    verify$(surface != nullptr);
+    verify_false$(compositor.compose_frame());
+
+    fill_buffer(*surface, 0, 0xffff0000);
+    verify$(submit_whole(compositor, *surface, 0));
+    verify$(compositor.compose_frame());
+
+    verify_equal$(pixel_at(10, 5), 0xffff0000);
+    verify_equal$(pixel_at(29, 14), 0xffff0000);
+    verify_equal$(pixel_at(9, 5), 0);
+    verify_equal$(pixel_at(30, 14), 0);
+}
+
+TEST_CASE(translucent_surface_is_blended) {
+    auto compositor = Compositor{ s_framebuffer, SCREEN_WIDTH, SCREEN_HEIGHT, SCREEN_STRIDE };
+
+    auto const bottom = compositor.create_surface(OWNER, Compositing::Rect{ 0, 0, 32, 32 }, true);
+    auto const top    = compositor.create_surface(OWNER, Compositing::Rect{ 16, 16, 32, 32 }, false);
+    fill_buffer(*bottom, 0, 0xff0000ff);
+    fill_buffer(*top, 0, 0x80800000);
+    verify$(submit_whole(compositor, *bottom, 0));
+    verify$(submit_whole(compositor, *top, 0));
+    compositor.compose_frame();
+
+    /* half of the blue shows through the premultiplied half transparent red */
+    verify_equal$(pixel_at(8, 8), 0xff0000ff);
+    verify_equal$(pixel_at(20, 20), 0xff80007f);
+    verify_equal$(pixel_at(40, 40), 0xff880c10);
+}
+
+TEST_CASE(only_the_damage_is_copied) {
+    auto compositor = Compositor{ s_framebuffer, SCREEN_WIDTH, SCREEN_HEIGHT, SCREEN_STRIDE };
+
+    auto const surface = compositor.create_surface(OWNER, Compositing::Rect{ 0, 0, 32, 32 }, true);
+    fill_buffer(*surface, 0, 0xff00ff00);
+    verify$(submit_whole(compositor, *surface, 0));
+    compositor.compose_frame();
+
+    /* the client draws the whole back buffer but only a corner changed */
+    fill_buffer(*surface, 1, 0xffffffff);
+    u8::NativeInt next_buffer = 0;
+    verify$(compositor.submit_surface(OWNER, surface->m_id, 1, Compositing::Rect{ 0, 0, 4, 4 }, next_buffer));
+    verify_equal$(next_buffer, 0);
+    compositor.compose_frame();
+
+    verify_equal$(pixel_at(3, 3), 0xffffffff);
+    verify_equal$(pixel_at(4, 4), 0xff00ff00);
+}
+
+TEST_CASE(destroyed_surface_uncovers_the_background) {
+    auto compositor = Compositor{ s_framebuffer, SCREEN_WIDTH, SCREEN_HEIGHT, SCREEN_STRIDE };
+
+    auto const surface = compositor.create_surface(OWNER, Compositing::Rect{ 4, 4, 8, 8 }, true);
+    auto const surface_id = surface->m_id;
+    fill_buffer(*surface, 0, 0xff123456);
+    verify$(submit_whole(compositor, *surface, 0));
+    compositor.compose_frame();
+    verify_equal$(pixel_at(5, 5), 0xff123456);
+
+    /* only the owner can submit or destroy its surfaces */
+    u8::NativeInt next_buffer = 0;
+    verify_false$(compositor.submit_surface(OWNER + 1, surface_id, 0, Compositing::Rect{ 0, 0, 1, 1 }, next_buffer));
+    verify_false$(compositor.destroy_surface(OWNER + 1, surface_id));
+
+    verify$(compositor.destroy_surface(OWNER, surface_id));
+    verify$(compositor.compose_frame());
+    verify_equal$(pixel_at(5, 5), COMPOSITOR_BACKGROUND_COLOR);
+}
+
+TEST_CASE(bounds_outside_of_the_screen_are_refused) {
+    auto compositor = Compositor{ s_framebuffer, SCREEN_WIDTH, SCREEN_HEIGHT, SCREEN_STRIDE };
+
+    verify$(compositor.create_surface(OWNER, Compositing::Rect{ 0, 0, 0, 8 }, true) == nullptr);
+    verify$(compositor.create_surface(OWNER, Compositing::Rect{ 0, 0, 8, -8 }, true) == nullptr);
+    verify$(compositor.create_surface(OWNER, Compositing::Rect{ 0, 0, SCREEN_WIDTH + 1, 8 }, true) == nullptr);
+    verify$(compositor.create_surface(OWNER, Compositing::Rect{ 0, 0, 0x10000, 0x10000 }, true) == nullptr);
+    verify$(compositor.create_surface(OWNER, Compositing::Rect{ 0x7fffffff, 0, 8, 8 }, true) == nullptr);
+    verify$(compositor.create_surface(OWNER, Compositing::Rect{ 0, -SCREEN_HEIGHT - 1, 8, 8 }, true) == nullptr);
+
+    /* a screen sized surface partially out of the screen is still valid */
+    auto const surface = compositor.create_surface(OWNER, Compositing::Rect{ -8, -8, SCREEN_WIDTH, SCREEN_HEIGHT }, true);
+    verify$(surface != nullptr);
+
+    fill_buffer(*surface, 0, 0xff00ff00);
+    verify$(submit_whole(compositor, *surface, 0));
+    verify$(compositor.compose_frame());
+    verify_equal$(pixel_at(0, 0), 0xff00ff00);
+
+    /* the damage is clipped to the surface, outside of it there is nothing to compose */
+    fill_buffer(*surface, 1, 0xffff0000);
+    u8::NativeInt next_buffer = 0;
+    verify$(compositor.submit_surface(OWNER, surface->m_id, 1, Compositing::Rect{ 0x7ffffff0, 0, 0x7ffffff0, 8 }, next_buffer));
+    verify_false$(compositor.compose_frame());
+    verify_equal$(pixel_at(0, 0), 0xff00ff00);
+}
+
+TEST_CASE(surfaces_of_dead_clients_are_released) {
+    Cxx::memset(s_framebuffer, 0, sizeof(s_framebuffer));
+    auto compositor = Compositor{ s_framebuffer, SCREEN_WIDTH, SCREEN_HEIGHT, SCREEN_STRIDE };
+
+    auto const dead_surface  = compositor.create_surface(OWNER + 1, Compositing::Rect{ 0, 0, 8, 8 }, true);
+    auto const dead_id       = dead_surface->m_id;
+    auto const alive_surface = compositor.create_surface(OWNER, Compositing::Rect{ 16, 16, 8, 8 }, true);
+    auto const alive_id      = alive_surface->m_id;
+    verify$(compositor.create_surface(OWNER + 1, Compositing::Rect{ 32, 32, 8, 8 }, true) != nullptr);
+
+    fill_buffer(*dead_surface, 0, 0xff123456);
+    u8::NativeInt next_buffer = 0;
+    verify$(compositor.submit_surface(OWNER + 1, dead_id, 0, Compositing::Rect{ 0, 0, 8, 8 }, next_buffer));
+    compositor.compose_frame();
+    verify_equal$(pixel_at(1, 1), 0xff123456);
+
+    verify_equal$(compositor.release_dead_clients([](Pid pid) { return pid == OWNER; }), 2);
+    verify_false$(compositor.destroy_surface(OWNER + 1, dead_id));
+    verify$(compositor.compose_frame());
+    verify_equal$(pixel_at(1, 1), COMPOSITOR_BACKGROUND_COLOR);
+
+    verify_equal$(compositor.release_dead_clients([](Pid pid) { return pid == OWNER; }), 0);
+    verify$(compositor.destroy_surface(OWNER, alive_id));
+}
+
+TEST_CASE(frame_time_histogram) {
+    auto compositor = Compositor{ s_framebuffer, SCREEN_WIDTH, SCREEN_HEIGHT, SCREEN_STRIDE };
+    auto const surface = compositor.create_surface(OWNER, Compositing::Rect{ 0, 0, 8, 8 }, true);
+    verify$(submit_whole(compositor, *surface, 0));
+    compositor.compose_frame();
+    compositor.record_frame_time(0);
+    compositor.record_frame_time(3);
+    compositor.record_frame_time(3);
+    compositor.record_frame_time(1000);
+
+    Compositing::FrameStatsResponse stats;
+    compositor.frame_stats(stats);
+    verify_equal$(stats.m_composed_frames, 1);
+    verify_equal$(stats.m_frame_time_histogram[0], 1);
+    verify_equal$(stats.m_frame_time_histogram[3], 2);
+    verify_equal$(stats.m_frame_time_histogram[COMPOSITING_FRAME_TIME_BUCKETS - 1], 1);
+}
+
+BENCHMARK_CASE(one_hundred_full_hd_frames_of_four_windows) {
+    auto compositor = Compositor{ s_full_hd_framebuffer, FULL_HD_WIDTH, FULL_HD_HEIGHT, FULL_HD_WIDTH };
+
+    /* a wallpaper, two overlapping opaque windows and a translucent panel */
+    Compositor::Surface const* surfaces[] = {
+        compositor.create_surface(OWNER, Compositing::Rect{ 0, 0, FULL_HD_WIDTH, FULL_HD_HEIGHT }, true),
+        compositor.create_surface(OWNER, Compositing::Rect{ 100, 100, 800, 600 }, true),
+        compositor.create_surface(OWNER, Compositing::Rect{ 600, 300, 800, 600 }, true),
+        compositor.create_surface(OWNER, Compositing::Rect{ 0, FULL_HD_HEIGHT - 40, FULL_HD_WIDTH, 40 }, false),
+    };
+    for ( auto const surface : surfaces ) {
+        fill_buffer(*surface, 0, surface->m_opaque ? 0xff336699 : 0x80202020);
+        fill_buffer(*surface, 1, surface->m_opaque ? 0xff996633 : 0x80404040);
+    }
+
+    for ( auto const frame : u32::range(0, 100) ) {
+        for ( auto const surface : surfaces )
+            verify$(submit_whole(compositor, *surface, (frame % 2).unwrap()));
+        verify$(compositor.compose_frame());
+    }
+}
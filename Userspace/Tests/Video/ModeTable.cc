@@ -0,0 +1,105 @@
+/**
+ * @brief
+ * This file is part of the MeetiX Operating System.
+ * Copyright (c) 2017-2022, Marco Cicognani (marco.cicognani@meetixos.org)
+ *
+ * @developers
+ * Marco Cicognani (marco.cicognani@meetixos.org)
+ *
+ * @license
+ * GNU General Public License version 3
+ */
+
+#include <CCLang/Lang/IntTypes.hh>
+#include <LibUnitTest/Assertions.hh>
+#include <LibUnitTest/Case.hh>
+#include <ModeTable.hh>
+
+static constexpr auto USABLE_ATTRIBUTES = 0x91;
+static constexpr auto DIRECT_COLOR      = 6;
+
+static auto mode_info(u16::NativeInt width, u16::NativeInt height, u8::NativeInt bpp) -> ModeInfoBlock {
+    ModeInfoBlock mode_info{};
+    mode_info.modeAttributes      = USABLE_ATTRIBUTES;
+    mode_info.memoryModel         = DIRECT_COLOR;
+    mode_info.resolutionX         = width;
+    mode_info.resolutionY         = height;
+    mode_info.bpp                 = bpp;
+    mode_info.linBytesPerScanline = width * bpp / 8;
+    mode_info.lfbPhysicalBase     = 0xfd000000;
+    return mode_info;
+}
+
+/**
+ * The modes of the QEMU standard VGA, in the order of its BIOS
+ */
+static auto fill_qemu_modes(ModeTable& mode_table) -> void {
+    u16::NativeInt number = 0x100;
+    for ( auto const bpp : { 8, 16, 24, 32 } ) {
+        mode_table.add_mode(number++, mode_info(640, 480, bpp));
+        mode_table.add_mode(number++, mode_info(800, 600, bpp));
+        mode_table.add_mode(number++, mode_info(1024, 768, bpp));
+        mode_table.add_mode(number++, mode_info(1280, 1024, bpp));
+        mode_table.add_mode(number++, mode_info(1920, 1080, bpp));
+    }
+}
+
+TEST_CASE(unusable_modes_are_skipped) {
+    auto mode_table = ModeTable{};
+
+    auto without_lfb           = mode_info(800, 600, 32);
+    without_lfb.modeAttributes = 0x1;
+    verify_false$(mode_table.add_mode(0x100, without_lfb));
+
+    auto palette_mode        = mode_info(800, 600, 8);
+    palette_mode.memoryModel = 4;
+    verify_false$(mode_table.add_mode(0x101, palette_mode));
+
+    verify$(mode_table.add_mode(0x102, mode_info(800, 600, 32)));
+    verify_equal$(mode_table.count(), 1);
+}
+
+TEST_CASE(best_mode_prefers_the_resolution_then_the_depth) {
+    auto mode_table = ModeTable{};
+    verify$(mode_table.find_best(800, 600, 32) == nullptr);
+    fill_qemu_modes(mode_table);
+
+    auto const exact_mode = mode_table.find_best(1024, 768, 32);
+    verify_equal$(exact_mode->m_width, 1024);
+    verify_equal$(exact_mode->m_bpp, 32);
+    verify_equal$(exact_mode->m_bytes_per_scanline, 4096);
+
+    /* the nearest resolution wins over the exact depth */
+    auto const near_mode = mode_table.find_best(1000, 750, 24);
+    verify_equal$(near_mode->m_width, 1024);
+    verify_equal$(near_mode->m_bpp, 24);
+
+    auto const deep_mode = mode_table.find_best(640, 480, 30);
+    verify_equal$(deep_mode->m_bpp, 32);
+}
+
+TEST_CASE(list_modes_for_the_clients) {
+    auto mode_table = ModeTable{};
+    fill_qemu_modes(mode_table);
+
+    VideoModes::ListModesResponse response{};
+    mode_table.list_modes(response);
+    verify_equal$(response.m_modes_count, 20);
+    verify_equal$(response.m_modes[19].m_width, 1920);
+    verify_equal$(response.m_modes[19].m_bit_per_pixel, 32);
+}
+
+TEST_CASE(table_is_bounded) {
+    auto mode_table = ModeTable{};
+    for ( auto const number : u16::range(0, VIDEO_MAX_MODES + 10) )
+        mode_table.add_mode(number.unwrap(), mode_info(640, 480, 32));
+    verify_equal$(mode_table.count(), VIDEO_MAX_MODES);
+}
+
+BENCHMARK_CASE(one_million_mode_lookups) {
+    auto mode_table = ModeTable{};
+    fill_qemu_modes(mode_table);
+
+    for ( auto const i : u32::range(0, 1'000'000) )
+        verify$(mode_table.find_best(1920, 1080 - (i % 2).unwrap(), 32) != nullptr);
+}